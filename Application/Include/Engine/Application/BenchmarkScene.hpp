@@ -0,0 +1,29 @@
+#ifndef ENGINE_APPLICATION_BENCHMARK_SCENE_INCLUDED
+#define ENGINE_APPLICATION_BENCHMARK_SCENE_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Engine::Application
+{
+    struct BenchmarkSceneStats
+    {
+        std::size_t frames = 0;
+        double setupMilliseconds = 0.0;
+        double averageFrameMilliseconds = 0.0;
+        double medianFrameMilliseconds = 0.0;
+        double p95FrameMilliseconds = 0.0;
+        // Summed over all frames, printed so the work can't be optimized away and builds can be compared.
+        std::uint64_t checksum = 0;
+    };
+
+    // Fixed, headless CPU workload of a frame: culling, LOD selection, meshlet culling, sprite batching
+    // into a software renderer and pixel conversion of the result. Needs no window or GPU, so it runs
+    // anywhere, and `Scripts/Build.py` uses it to train and measure profile-guided builds.
+    BenchmarkSceneStats RunBenchmarkScene(std::size_t frames);
+
+    // Prints "Benchmark scene: ..." with the frame times, the line `Scripts/Build.py` parses.
+    void ReportBenchmarkScene(const BenchmarkSceneStats& stats);
+}
+
+#endif
@@ -0,0 +1,254 @@
+#include <Engine/Application/BenchmarkScene.hpp>
+
+#include <Engine/Core/FlightRecorder.hpp>
+#include <Engine/Core/Math.hpp>
+#include <Engine/Core/PerfCounters.hpp>
+#include <Engine/Core/PixelConversion.hpp>
+#include <Engine/Graphics/Culling.hpp>
+#include <Engine/Graphics/Lod.hpp>
+#include <Engine/Graphics/Mesh.hpp>
+#include <Engine/Graphics/MeshOptimizer.hpp>
+#include <Engine/Graphics/Meshlet.hpp>
+#include <Engine/Graphics/SpriteBatcher.hpp>
+
+#include <SDL2/SDL_render.h>
+#include <SDL2/SDL_surface.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace Engine::Application
+{
+    namespace
+    {
+        constexpr float Pi = 3.14159265358979f;
+
+        constexpr int ScreenWidth = 640;
+        constexpr int ScreenHeight = 360;
+        constexpr float VerticalFov = Pi / 3.0f;
+
+        // Instances on a grid of `GridSize` by `GridSize`, the one at the origin doubles as occluder.
+        constexpr int GridSize = 32;
+        constexpr float GridSpacing = 4.0f;
+        constexpr std::size_t SpriteCount = 20000;
+
+        // Unit sphere with ripples, so that simplification and meshlet cones have something to work with.
+        Graphics::Mesh MakeRippledSphere(std::uint32_t rings, std::uint32_t segments)
+        {
+            Graphics::Mesh mesh;
+            for (std::uint32_t ring = 0; ring <= rings; ++ring)
+            {
+                for (std::uint32_t segment = 0; segment <= segments; ++segment)
+                {
+                    float theta = Pi * static_cast<float>(ring) / static_cast<float>(rings);
+                    float phi = 2.0f * Pi * static_cast<float>(segment) / static_cast<float>(segments);
+                    Core::Vector3 normal(std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi));
+                    Core::Vector3 position = normal * (1.0f + 0.05f * std::sin(7.0f * phi) * std::sin(5.0f * theta));
+
+                    Graphics::Vertex vertex;
+                    vertex.position[0] = position.x;
+                    vertex.position[1] = position.y;
+                    vertex.position[2] = position.z;
+                    vertex.normal[0] = normal.x;
+                    vertex.normal[1] = normal.y;
+                    vertex.normal[2] = normal.z;
+                    vertex.uv[0] = static_cast<float>(segment) / static_cast<float>(segments);
+                    vertex.uv[1] = static_cast<float>(ring) / static_cast<float>(rings);
+                    mesh.vertices.push_back(vertex);
+                }
+            }
+
+            // Counter-clockwise seen from outside.
+            for (std::uint32_t ring = 0; ring < rings; ++ring)
+            {
+                for (std::uint32_t segment = 0; segment < segments; ++segment)
+                {
+                    std::uint32_t a = ring * (segments + 1) + segment;
+                    std::uint32_t b = a + segments + 1;
+                    mesh.indices.insert(mesh.indices.end(), { a, a + 1, b, a + 1, b + 1, b });
+                }
+            }
+
+            return mesh;
+        }
+
+        struct SurfaceDeleter
+        {
+            void operator()(SDL_Surface* surface) const { SDL_FreeSurface(surface); }
+        };
+
+        struct RendererDeleter
+        {
+            void operator()(SDL_Renderer* renderer) const { SDL_DestroyRenderer(renderer); }
+        };
+
+        struct TextureDeleter
+        {
+            void operator()(SDL_Texture* texture) const { SDL_DestroyTexture(texture); }
+        };
+    }
+
+    BenchmarkSceneStats RunBenchmarkScene(std::size_t frames)
+    {
+        BenchmarkSceneStats stats;
+        auto setupStart = std::chrono::steady_clock::now();
+
+        // Cook the mesh like the asset pipeline would, this is part of the workload as well.
+        Graphics::Mesh mesh = MakeRippledSphere(96, 192);
+        Graphics::OptimizeMesh(mesh);
+        Graphics::LodChain chain = Graphics::GenerateLodChain(mesh);
+        Graphics::MeshletMesh meshlets = Graphics::BuildMeshlets(mesh);
+        Graphics::QuantizedMesh quantized = Graphics::QuantizeMesh(mesh);
+        stats.checksum += quantized.vertices.size();
+
+        // Everything draws into surfaces through the software renderer, no window needed.
+        std::unique_ptr<SDL_Surface, SurfaceDeleter> target(SDL_CreateRGBSurfaceWithFormat(0, ScreenWidth, ScreenHeight, 32, SDL_PIXELFORMAT_ARGB8888));
+        std::unique_ptr<SDL_Surface, SurfaceDeleter> output(SDL_CreateRGBSurfaceWithFormat(0, ScreenWidth, ScreenHeight, 32, SDL_PIXELFORMAT_ABGR8888));
+        std::unique_ptr<SDL_Surface, SurfaceDeleter> checker(SDL_CreateRGBSurfaceWithFormat(0, 32, 32, 32, SDL_PIXELFORMAT_ARGB8888));
+        if (!target || !output || !checker)
+        {
+            std::cout << "Something went wrong creating the benchmark surfaces: " << SDL_GetError() << std::endl;
+            return stats;
+        }
+
+        std::unique_ptr<SDL_Renderer, RendererDeleter> renderer(SDL_CreateSoftwareRenderer(target.get()));
+        if (!renderer)
+        {
+            std::cout << "Something went wrong creating the benchmark renderer: " << SDL_GetError() << std::endl;
+            return stats;
+        }
+
+        std::uint32_t* checkerPixels = static_cast<std::uint32_t*>(checker->pixels);
+        for (int y = 0; y < checker->h; ++y)
+            for (int x = 0; x < checker->w; ++x)
+                checkerPixels[y * checker->pitch / 4 + x] = ((x ^ y) & 8) ? 0xFFFFFFFF : 0x80FF4020;
+
+        std::unique_ptr<SDL_Texture, TextureDeleter> texture(SDL_CreateTextureFromSurface(renderer.get(), checker.get()));
+        Graphics::SpriteBatcher batcher(renderer.get());
+
+        Graphics::OcclusionBuffer occlusion(256, 128);
+        Graphics::LodSelector selector(1.0f);
+        std::vector<Graphics::LodInstanceId> instances;
+        for (int i = 0; i < GridSize * GridSize; ++i)
+            instances.push_back(selector.AddInstance());
+
+        float projectionScale = Graphics::ComputeProjectionScale(VerticalFov, static_cast<float>(ScreenHeight));
+        Core::Matrix4 projection = Core::Matrix4::Perspective(VerticalFov, static_cast<float>(ScreenWidth) / ScreenHeight, 0.1f, 200.0f);
+        std::vector<std::uint32_t> visibleMeshlets;
+        std::vector<std::uint32_t> meshletIndices;
+
+        stats.setupMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - setupStart).count();
+
+        std::vector<double> frameMilliseconds;
+        frameMilliseconds.reserve(frames);
+        for (std::size_t frame = 0; frame < frames; ++frame)
+        {
+            auto frameStart = std::chrono::steady_clock::now();
+            float time = static_cast<float>(frame) / 60.0f;
+
+            // Orbit the origin, coming close enough for the LOD levels to change.
+            float orbit = 30.0f + 25.0f * std::sin(time * 0.5f);
+            Core::Vector3 eye(orbit * std::cos(time * 0.3f), 3.0f, orbit * std::sin(time * 0.3f));
+            Core::Matrix4 viewProjection = projection * Core::Matrix4::LookAt(eye, Core::Vector3(), Core::Vector3(0.0f, 1.0f, 0.0f));
+            Graphics::Frustum frustum = Graphics::Frustum::FromViewProjection(viewProjection);
+
+            {
+                ENGINE_PERF_SCOPE("Culling and LOD");
+                occlusion.Clear();
+                occlusion.RasterizeTriangles(viewProjection, mesh.vertices[0].position, sizeof(Graphics::Vertex),
+                                             chain.levels.back().indices.data(), chain.levels.back().indices.size());
+                occlusion.BuildPyramid();
+
+                for (int z = 0; z < GridSize; ++z)
+                {
+                    for (int x = 0; x < GridSize; ++x)
+                    {
+                        Core::Vector3 center((x - GridSize / 2) * GridSpacing, 0.0f, (z - GridSize / 2) * GridSpacing);
+                        bool occluder = x == GridSize / 2 && z == GridSize / 2;
+                        if (!frustum.IsSphereVisible(center, 1.1f) || (!occluder && occlusion.IsSphereOccluded(viewProjection, center, 1.1f)))
+                            continue;
+
+                        Graphics::LodSelection selection = selector.Select(instances[z * GridSize + x], chain, Core::Length(center - eye), projectionScale, 1.0f / 60.0f);
+                        stats.checksum += selection.level;
+                    }
+                }
+                stats.checksum += selector.ResetStats().triangles;
+            }
+
+            {
+                ENGINE_PERF_SCOPE("Meshlet culling");
+                // The instance at the origin goes through meshlet culling, it's in the space of the mesh.
+                Graphics::MeshletCullView view = { viewProjection, frustum, eye, nullptr };
+                Graphics::MeshletCullStats cullStats;
+                visibleMeshlets.clear();
+                meshletIndices.clear();
+                Graphics::CullMeshlets(meshlets, view, visibleMeshlets, cullStats);
+                Graphics::AppendMeshletIndices(meshlets, visibleMeshlets, meshletIndices);
+                stats.checksum += meshletIndices.size();
+            }
+
+            {
+                ENGINE_PERF_SCOPE("Sprites");
+                // A HUD's worth of sprites, then convert the frame like a readback or screenshot would.
+                SDL_SetRenderDrawColor(renderer.get(), 16, 16, 32, 255);
+                SDL_RenderClear(renderer.get());
+                batcher.Begin();
+                for (std::size_t i = 0; i < SpriteCount; ++i)
+                {
+                    float phase = time + static_cast<float>(i) * 0.01f;
+
+                    Graphics::Sprite sprite;
+                    sprite.texture = i % 2 == 0 ? texture.get() : nullptr;
+                    sprite.destination = { static_cast<float>(i * 37 % ScreenWidth) + 8.0f * std::sin(phase),
+                                           static_cast<float>(i * 53 % ScreenHeight) + 8.0f * std::cos(phase), 12.0f, 12.0f };
+                    sprite.color = { static_cast<Uint8>(i), static_cast<Uint8>(i >> 3), 200, 160 };
+                    sprite.rotation = i % 8 == 0 ? phase : 0.0f;
+                    sprite.layer = static_cast<std::int32_t>(i % 4);
+                    batcher.Draw(sprite);
+                }
+                batcher.End();
+                SDL_RenderFlush(renderer.get());
+                stats.checksum += batcher.GetStats().batches;
+            }
+
+            {
+                ENGINE_PERF_SCOPE("Pixel conversion");
+                Core::ConvertSurfacePixels(target.get(), output.get());
+                Core::PremultiplySurfaceAlpha(output.get());
+                stats.checksum += static_cast<const std::uint32_t*>(output->pixels)[frame % (ScreenWidth * ScreenHeight)];
+            }
+
+            frameMilliseconds.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - frameStart).count());
+            Core::EndFlightFrame();
+        }
+
+        stats.frames = frames;
+        if (frames == 0)
+            return stats;
+
+        for (double milliseconds : frameMilliseconds)
+            stats.averageFrameMilliseconds += milliseconds;
+        stats.averageFrameMilliseconds /= static_cast<double>(frames);
+
+        std::sort(frameMilliseconds.begin(), frameMilliseconds.end());
+        stats.medianFrameMilliseconds = frameMilliseconds[frames / 2];
+        stats.p95FrameMilliseconds = frameMilliseconds[std::min(frames - 1, frames * 95 / 100)];
+
+        return stats;
+    }
+
+    void ReportBenchmarkScene(const BenchmarkSceneStats& stats)
+    {
+        std::cout << std::fixed << std::setprecision(3)
+                  << "Benchmark scene: " << stats.frames << " frames, setup " << stats.setupMilliseconds << " ms, average "
+                  << stats.averageFrameMilliseconds << " ms, median " << stats.medianFrameMilliseconds << " ms, p95 "
+                  << stats.p95FrameMilliseconds << " ms, checksum " << stats.checksum << std::endl;
+
+        // Per stage, with IPC and misses where hardware counters are available.
+        Core::ReportPerfScopes();
+    }
+}
@@ -1,13 +1,135 @@
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
 #include <iostream>
+#include <memory>
+#include <string>
+#include <Engine/Application/BenchmarkScene.hpp>
 #include <Engine/Core/Core.hpp>
+#include <Engine/Core/CpuDispatch.hpp>
+#include <Engine/Core/FlightRecorder.hpp>
+#include <Engine/Core/InitGraph.hpp>
+#include <Engine/Core/MemoryTracking.hpp>
+#include <Engine/Core/PackFile.hpp>
+#include <Engine/Core/SamplingProfiler.hpp>
+#include <Engine/Core/StartupPrefetch.hpp>
 #include <Engine/Graphics/Graphics.hpp>
+#include <SDL2/SDL_filesystem.h>
+#include <SDL2/SDL_stdinc.h>
 
-int main()
+namespace
 {
+    // `ENGINE_SAMPLING_PROFILE=<path>` samples the main thread and the workers while this lives, then
+    // writes the profile for `Scripts/CollapseProfile.py`.
+    class SamplingSession
+    {
+    public:
+        SamplingSession()
+        {
+            const char* path = std::getenv("ENGINE_SAMPLING_PROFILE");
+            if (path == nullptr || *path == '\0')
+                return;
+
+            profilePath = path;
+            profiler = std::make_unique<Engine::Core::SamplingProfiler>();
+            Engine::Core::RegisterSamplingThread("Main");
+            if (!profiler->Start())
+                std::cout << "The sampling profiler isn't supported here." << std::endl;
+        }
+
+        ~SamplingSession()
+        {
+            if (profiler == nullptr)
+                return;
+
+            profiler->Stop();
+            profiler->Report();
+            if (profiler->Save(profilePath))
+                std::cout << "Sampling profile written to \"" << profilePath << "\"" << std::endl;
+        }
+
+        SamplingSession(const SamplingSession&) = delete;
+        SamplingSession& operator=(const SamplingSession&) = delete;
+
+    private:
+        std::string profilePath;
+        std::unique_ptr<Engine::Core::SamplingProfiler> profiler;
+    };
+}
+
+int main(int argc, char* argv[])
+{
+    // Core and Graphics charge their own allocations, the rest belongs to the Application.
+    Engine::Core::MemoryTagScope memoryTag(Engine::Core::MemoryTag::Application);
+    SamplingSession sampling;
+
+    // `--benchmark [frames]` runs the headless benchmark scene only, see `Scripts/Build.py`.
+    if (argc > 1 && std::strcmp(argv[1], "--benchmark") == 0)
+    {
+        std::size_t frames = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 600;
+
+        // Always on like in a shipping build, so its overhead is part of the measurement.
+        Engine::Core::FlightRecorder recorder;
+        Engine::Core::SetFlightRecorder(&recorder);
+        Engine::Application::BenchmarkSceneStats stats = Engine::Application::RunBenchmarkScene(frames);
+        Engine::Core::SetFlightRecorder(nullptr);
+
+        Engine::Application::ReportBenchmarkScene(stats);
+        recorder.Report();
+        Engine::Core::ReportMemory();
+        return 0;
+    }
+
     std::cout << "Hello from Application!" << std::endl;
     Engine::Core::Hello();
+    Engine::Core::ReportCpuDispatch();
     Engine::Graphics::Hello();
-    Engine::Core::TestSDL();
+
+    Engine::Core::ThreadPool workers;
+
+    // Warm the page cache with what the last run read during startup, and record this run's reads.
+    Engine::Core::StartupPrefetch prefetch(Engine::Core::StartupPrefetch::GetDefaultManifestPath());
+    prefetch.Prefetch(workers);
+    Engine::Core::SetStartupPrefetch(&prefetch);
+
+    // `Assets.pack` next to the executable, if there is one. Opening it reads the table of contents,
+    // which is what the prefetch manifest picks up.
+    std::unique_ptr<Engine::Core::PackFile> assets;
+    std::string assetsPath = "Assets.pack";
+    if (char* basePath = SDL_GetBasePath())
+    {
+        assetsPath = basePath + assetsPath;
+        SDL_free(basePath);
+    }
+
+    Engine::Core::InitGraph startup;
+    Engine::Core::AddSDLSubsystems(startup);
+
+    Engine::Core::SubsystemDesc assetsDesc;
+    assetsDesc.name = "Assets";
+    assetsDesc.initialize = [&assets, &assetsPath]
+    {
+        std::error_code error;
+        if (!std::filesystem::exists(assetsPath, error))
+            return true;
+
+        assets = Engine::Core::PackFile::Open(assetsPath);
+        return assets != nullptr;
+    };
+    assetsDesc.shutdown = [&assets] { assets.reset(); };
+    startup.Add(std::move(assetsDesc));
+
+    startup.Run(workers);
+    startup.MarkFirstFrame();
+
+    Engine::Core::SetStartupPrefetch(nullptr);
+    prefetch.Save();
+
+    startup.Report();
+    prefetch.Report();
+
+    Engine::Core::ReportMemory();
+
     std::cout << "Done." << std::endl;
     return 0;
 }
\ No newline at end of file
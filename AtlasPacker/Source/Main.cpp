@@ -0,0 +1,278 @@
+#include <Engine/Core/StringId.hpp>
+#include <Engine/Graphics/AtlasPacker.hpp>
+#include <Engine/Graphics/TextureAtlas.hpp>
+
+#include <SDL2/SDL.h>
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace Engine;
+
+namespace
+{
+    struct Image
+    {
+        std::string name;
+        SDL_Surface* surface = nullptr;
+    };
+
+    void PrintUsage()
+    {
+        std::cout << "Usage: AtlasPacker [options] <output> <input>...\n"
+                     "  Packs BMP images into atlas pages <output>_<page>.bmp and the lookup table <output>.atlas.\n"
+                     "  Inputs are BMP files or directories searched recursively. Regions are named by their path\n"
+                     "  relative to the input directory, without extension and with '/' separators.\n"
+                     "Options:\n"
+                     "  --size <pixels>    Maximum page width and height (default 2048).\n"
+                     "  --padding <pixels> Empty pixels between images (default 2).\n"
+                     "  --extrude <pixels> Edge pixels repeated around images (default 1).\n"
+                     "  --no-rotation      Never rotate images.\n"
+                     "  --no-trim          Keep every page at the maximum size.\n"
+                     "  --sample <count>   Pack a generated corpus of <count> images and only report.\n";
+    }
+
+    // Glyphs, icons and UI panels in roughly the proportions of our HUD content.
+    std::vector<Graphics::AtlasImageSize> GenerateSampleCorpus(std::uint32_t count)
+    {
+        std::uint32_t state = 12345;
+        auto next = [&state](std::uint32_t low, std::uint32_t high)
+        {
+            state = state * 1664525u + 1013904223u;
+            return low + (state >> 8) % (high - low + 1);
+        };
+
+        std::vector<Graphics::AtlasImageSize> sizes(count);
+        for (Graphics::AtlasImageSize& size : sizes)
+        {
+            std::uint32_t kind = next(0, 9);
+            if (kind < 6)
+                size = { next(6, 32), next(12, 36) };
+            else if (kind < 9)
+                size = { next(16, 64), next(16, 64) };
+            else
+                size = { next(64, 256), next(32, 128) };
+        }
+
+        return sizes;
+    }
+
+    void CollectImages(const std::filesystem::path& input, std::vector<Image>& images)
+    {
+        auto load = [&images](const std::filesystem::path& file, const std::string& name)
+        {
+            SDL_Surface* loaded = SDL_LoadBMP(file.string().c_str());
+            if (loaded == nullptr)
+            {
+                std::cout << "Something went wrong loading \"" << file.string() << "\": " << SDL_GetError() << std::endl;
+                return;
+            }
+
+            Image image;
+            image.name = name;
+            image.surface = SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_RGBA32, 0);
+            SDL_FreeSurface(loaded);
+            if (image.surface != nullptr)
+                images.push_back(image);
+        };
+
+        if (!std::filesystem::is_directory(input))
+        {
+            load(input, input.stem().generic_string());
+            return;
+        }
+
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(input))
+        {
+            std::string extension = entry.path().extension().string();
+            std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+            if (!entry.is_regular_file() || extension != ".bmp")
+                continue;
+
+            std::filesystem::path relative = std::filesystem::relative(entry.path(), input);
+            load(entry.path(), relative.replace_extension().generic_string());
+        }
+    }
+
+    // Copy `image` into `page` at its placement, repeating its edge pixels over the extruded border.
+    void Blit(const SDL_Surface* image, const Graphics::AtlasPlacement& placement, std::uint32_t extrude, SDL_Surface* page)
+    {
+        auto source = [image](int x, int y)
+        {
+            const unsigned char* row = static_cast<const unsigned char*>(image->pixels) + y * image->pitch;
+            return reinterpret_cast<const std::uint32_t*>(row)[x];
+        };
+
+        int border = static_cast<int>(extrude);
+        int width = static_cast<int>(placement.width);
+        int height = static_cast<int>(placement.height);
+        for (int y = -border; y < height + border; ++y)
+        {
+            unsigned char* row = static_cast<unsigned char*>(page->pixels) + (static_cast<int>(placement.y) + y) * page->pitch;
+            std::uint32_t* destination = reinterpret_cast<std::uint32_t*>(row) + placement.x;
+
+            for (int x = -border; x < width + border; ++x)
+            {
+                int clampedX = std::clamp(x, 0, width - 1);
+                int clampedY = std::clamp(y, 0, height - 1);
+
+                // Rotated clockwise: the page column is the source row counted from the bottom.
+                destination[x] = placement.rotated ? source(clampedY, image->h - 1 - clampedX) : source(clampedX, clampedY);
+            }
+        }
+    }
+
+    void Report(const Graphics::AtlasPackResult& result, std::size_t imageCount)
+    {
+        std::size_t rotated = std::count_if(result.placements.begin(), result.placements.end(),
+                                            [](const Graphics::AtlasPlacement& placement) { return placement.rotated; });
+
+        std::cout << std::fixed << std::setprecision(1);
+        std::cout << imageCount << " images, " << rotated << " rotated, " << result.pages.size() << " pages" << std::endl;
+        for (std::size_t i = 0; i < result.pages.size(); ++i)
+        {
+            const Graphics::AtlasPage& page = result.pages[i];
+            double occupancy = 100.0 * page.usedPixels / (double(page.width) * page.height);
+            std::cout << "  page " << i << ": " << page.width << "x" << page.height << ", " << occupancy << "% used" << std::endl;
+        }
+
+        std::cout << "Efficiency: " << 100.0f * result.GetEfficiency() << "%" << std::endl;
+        // The sprite batcher draws one batch per texture, so drawing every image once takes one batch
+        // per page instead of one per image.
+        std::cout << "Batches to draw every image once: " << result.pages.size() << " (" << imageCount << " unpacked)" << std::endl;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Graphics::AtlasPackOptions options;
+    std::uint32_t sampleCount = 0;
+    std::vector<std::string> positional;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string argument = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (argument == "--size" && hasValue)
+            options.maxPageWidth = options.maxPageHeight = static_cast<std::uint32_t>(std::atoi(argv[++i]));
+        else if (argument == "--padding" && hasValue)
+            options.padding = static_cast<std::uint32_t>(std::atoi(argv[++i]));
+        else if (argument == "--extrude" && hasValue)
+            options.extrude = static_cast<std::uint32_t>(std::atoi(argv[++i]));
+        else if (argument == "--no-rotation")
+            options.allowRotation = false;
+        else if (argument == "--no-trim")
+            options.trimPages = false;
+        else if (argument == "--sample" && hasValue)
+            sampleCount = static_cast<std::uint32_t>(std::atoi(argv[++i]));
+        else if (argument.rfind("--", 0) == 0)
+        {
+            PrintUsage();
+            return 1;
+        }
+        else
+            positional.push_back(argument);
+    }
+
+    if (options.maxPageWidth == 0 || options.maxPageWidth > 16384)
+    {
+        std::cout << "The page size must be between 1 and 16384." << std::endl;
+        return 1;
+    }
+
+    if (sampleCount > 0)
+    {
+        Graphics::AtlasPackResult result;
+        if (!Graphics::PackAtlas(GenerateSampleCorpus(sampleCount), options, result))
+            return 1;
+
+        Report(result, sampleCount);
+        return 0;
+    }
+
+    if (positional.size() < 2)
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    std::string output = positional[0];
+    std::vector<Image> images;
+    for (std::size_t i = 1; i < positional.size(); ++i)
+        CollectImages(positional[i], images);
+
+    if (images.empty())
+    {
+        std::cout << "No images to pack." << std::endl;
+        return 1;
+    }
+
+    std::vector<Graphics::AtlasImageSize> sizes;
+    std::vector<Core::StringId> names;
+    for (const Image& image : images)
+    {
+        sizes.push_back({ static_cast<std::uint32_t>(image.surface->w), static_cast<std::uint32_t>(image.surface->h) });
+        names.push_back(Core::StringId::Intern(image.name));
+    }
+
+    Graphics::AtlasPackResult result;
+    if (!Graphics::PackAtlas(sizes, options, result))
+        return 1;
+
+    std::vector<SDL_Surface*> pages;
+    std::vector<std::string> pageNames;
+    for (std::size_t i = 0; i < result.pages.size(); ++i)
+    {
+        const Graphics::AtlasPage& page = result.pages[i];
+        pages.push_back(SDL_CreateRGBSurfaceWithFormat(0, page.width, page.height, 32, SDL_PIXELFORMAT_RGBA32));
+        SDL_FillRect(pages.back(), nullptr, 0);
+        pageNames.push_back(std::filesystem::path(output).filename().string() + "_" + std::to_string(i) + ".bmp");
+    }
+
+    std::vector<Graphics::AtlasRegion> regions;
+    for (std::size_t i = 0; i < images.size(); ++i)
+    {
+        const Graphics::AtlasPlacement& placement = result.placements[i];
+        const Graphics::AtlasPage& page = result.pages[placement.page];
+        Blit(images[i].surface, placement, options.extrude, pages[placement.page]);
+
+        Graphics::AtlasRegion region;
+        region.u0 = static_cast<float>(placement.x) / page.width;
+        region.v0 = static_cast<float>(placement.y) / page.height;
+        region.u1 = static_cast<float>(placement.x + placement.width) / page.width;
+        region.v1 = static_cast<float>(placement.y + placement.height) / page.height;
+        region.page = static_cast<std::uint16_t>(placement.page);
+        region.width = static_cast<std::uint16_t>(images[i].surface->w);
+        region.height = static_cast<std::uint16_t>(images[i].surface->h);
+        region.rotated = placement.rotated ? 1 : 0;
+        regions.push_back(region);
+
+        SDL_FreeSurface(images[i].surface);
+    }
+
+    bool success = true;
+    std::filesystem::path directory = std::filesystem::path(output).parent_path();
+    for (std::size_t i = 0; i < pages.size(); ++i)
+    {
+        std::string path = (directory / pageNames[i]).string();
+        if (SDL_SaveBMP(pages[i], path.c_str()) != 0)
+        {
+            std::cout << "Something went wrong writing \"" << path << "\": " << SDL_GetError() << std::endl;
+            success = false;
+        }
+
+        SDL_FreeSurface(pages[i]);
+    }
+
+    success = Graphics::TextureAtlas::Write(output + ".atlas", pageNames, names, regions) && success;
+
+    Report(result, images.size());
+    return success ? 0 : 1;
+}
@@ -0,0 +1,163 @@
+#ifndef ENGINE_BENCHMARKS_BENCHMARK_INCLUDED
+#define ENGINE_BENCHMARKS_BENCHMARK_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace Engine::Benchmarks
+{
+    struct BenchmarkOptions
+    {
+        // Iterations per sample grow until a sample takes at least this long.
+        double minSampleSeconds = 0.01;
+        std::size_t sampleCount = 30;
+        // Run before calibrating, to fault in memory and settle caches and clocks.
+        double warmupSeconds = 0.1;
+        // Only benchmarks whose name contains this run.
+        std::string filter;
+        // Count cycles, instructions, LLC and branch misses of the benchmark thread while sampling,
+        // where perf events are available.
+        bool perfCounters = true;
+    };
+
+    enum class BenchmarkStatus : std::uint8_t
+    {
+        Ok,
+        Skipped,
+        Failed
+    };
+
+    struct BenchmarkResult
+    {
+        // "<registered name>/<variant>".
+        std::string name;
+        BenchmarkStatus status = BenchmarkStatus::Ok;
+        // Why it was skipped or failed.
+        std::string message;
+
+        std::uint64_t iterationsPerSample = 0;
+        // Nanoseconds per iteration, one per sample, in measurement order.
+        std::vector<double> samples;
+        double median = 0.0;
+        // Median absolute deviation from the median, unscaled.
+        double mad = 0.0;
+        double minimum = 0.0;
+        double p5 = 0.0;
+        double p95 = 0.0;
+        double maximum = 0.0;
+
+        // Pixels, sprites, loads... per iteration, 0 if throughput makes no sense.
+        double itemsPerIteration = 0.0;
+        // Values that aren't times, like ACMR or pack efficiency.
+        std::vector<std::pair<std::string, double>> counters;
+    };
+
+    // Handed to a registered benchmark. The benchmark sets up its data, then calls `Measure` once per
+    // variant it compares, with the setup excluded from the timing.
+    class BenchmarkContext
+    {
+    public:
+        BenchmarkContext(std::string name, const BenchmarkOptions& options);
+
+        BenchmarkContext(const BenchmarkContext&) = delete;
+        BenchmarkContext& operator=(const BenchmarkContext&) = delete;
+
+        // Time `body` as "<name>/<variant>": warm up, scale the iterations per sample, then take the samples.
+        // Variants not matching the filter are skipped. Returns the result, valid until the next `Measure`,
+        // or `nullptr` if the variant was skipped.
+        template <typename Body>
+        const BenchmarkResult* Measure(const std::string& variant, Body&& body, double itemsPerIteration = 0.0)
+        {
+            return MeasureBatches(variant, [&body](std::uint64_t iterations)
+            {
+                for (std::uint64_t i = 0; i < iterations; ++i)
+                    body();
+            }, itemsPerIteration);
+        }
+
+        // Attach a value to the last measured variant, or to "<name>" if nothing was measured yet.
+        void SetCounter(const std::string& counter, double value);
+
+        // Skip the whole benchmark, for example without an OpenGL context.
+        void Skip(const std::string& reason);
+        // Report a correctness failure, the run exits with an error.
+        void Fail(const std::string& reason);
+
+        bool IsSkipped() const { return skipped; }
+        const BenchmarkOptions& GetOptions() const { return options; }
+
+        // Results in measurement order.
+        std::vector<BenchmarkResult>& GetResults() { return results; }
+
+    private:
+        const BenchmarkResult* MeasureBatches(const std::string& variant, const std::function<void(std::uint64_t)>& batch, double itemsPerIteration);
+        BenchmarkResult& GetCurrentResult();
+
+        std::string name;
+        const BenchmarkOptions& options;
+        std::vector<BenchmarkResult> results;
+        bool skipped = false;
+        // The last variant didn't match `BenchmarkOptions::filter` and wasn't measured.
+        bool filteredOut = false;
+    };
+
+    using BenchmarkFunction = void (*)(BenchmarkContext& context);
+
+    // Adds a benchmark to the global registry, done by `ENGINE_BENCHMARK`.
+    struct BenchmarkRegistration
+    {
+        BenchmarkRegistration(const char* name, BenchmarkFunction function);
+    };
+
+    // Keeps the compiler from optimizing `value` and the computation behind it away.
+#if defined(_MSC_VER) && !defined(__clang__)
+    namespace Detail
+    {
+        void UseCharPointer(const volatile char* pointer);
+    }
+
+    template <typename T>
+    inline void DoNotOptimize(const T& value)
+    {
+        Detail::UseCharPointer(&reinterpret_cast<const volatile char&>(value));
+        _ReadWriteBarrier();
+    }
+#else
+    template <typename T>
+    inline void DoNotOptimize(const T& value)
+    {
+        asm volatile("" : : "g"(&value) : "memory");
+    }
+#endif
+
+    // Pin the calling thread to logical CPU `cpu`. Threads it starts afterwards inherit the pin. Returns
+    // false where that isn't supported.
+    bool PinThreadToCpu(std::uint32_t cpu);
+
+    // Run every registered benchmark matching `options.filter`, in registration order, printing each result.
+    std::vector<BenchmarkResult> RunBenchmarks(const BenchmarkOptions& options);
+
+    // Print the benchmark names.
+    void ListBenchmarks();
+}
+
+// Defines and registers benchmark `Name`, its body gets a `BenchmarkContext& context`:
+//
+//     ENGINE_BENCHMARK(StringIdIntern)
+//     {
+//         context.Measure("Existing", [&] { ... });
+//     }
+#define ENGINE_BENCHMARK(Name) \
+    static void Name##Benchmark(Engine::Benchmarks::BenchmarkContext& context); \
+    static const Engine::Benchmarks::BenchmarkRegistration Name##Registration(#Name, &Name##Benchmark); \
+    static void Name##Benchmark(Engine::Benchmarks::BenchmarkContext& context)
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef ENGINE_BENCHMARKS_BENCHMARK_REPORT_INCLUDED
+#define ENGINE_BENCHMARKS_BENCHMARK_REPORT_INCLUDED
+
+#include <Engine/Benchmarks/Benchmark.hpp>
+
+#include <string>
+#include <vector>
+
+namespace Engine::Benchmarks
+{
+    struct BenchmarkComparisonOptions
+    {
+        // Two-sided significance level of the Mann-Whitney U test on the samples.
+        double significance = 0.01;
+        // Significant changes of the median smaller than this fraction are reported as unchanged,
+        // they are usually noise between runs rather than in the samples of one run.
+        double minimumChange = 0.02;
+    };
+
+    struct BenchmarkComparison
+    {
+        std::string name;
+        double baselineMedian = 0.0;
+        double currentMedian = 0.0;
+        // current / baseline - 1, negative is faster.
+        double change = 0.0;
+        double pValue = 1.0;
+        // Significant and above the minimum change.
+        bool regressed = false;
+        bool improved = false;
+    };
+
+    // Write the results with every sample, so that a later run can be compared against them.
+    bool WriteBenchmarkJson(const std::string& path, const std::vector<BenchmarkResult>& results);
+    // Reads files written by `WriteBenchmarkJson`. Returns false and reports why on malformed files.
+    bool ReadBenchmarkJson(const std::string& path, std::vector<BenchmarkResult>& results);
+
+    // Compare benchmarks measured in both runs, by name.
+    std::vector<BenchmarkComparison> CompareBenchmarks(const std::vector<BenchmarkResult>& baseline, const std::vector<BenchmarkResult>& current,
+                                                       const BenchmarkComparisonOptions& options);
+    // Two-sided p-value that `a` and `b` come from the same distribution, with the normal approximation
+    // and tie correction. Needs a handful of samples on each side to mean anything.
+    double MannWhitneyPValue(const std::vector<double>& a, const std::vector<double>& b);
+
+    void PrintComparisons(const std::vector<BenchmarkComparison>& comparisons);
+}
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef ENGINE_BENCHMARKS_MESH_CORPUS_INCLUDED
+#define ENGINE_BENCHMARKS_MESH_CORPUS_INCLUDED
+
+#include <Engine/Graphics/Mesh.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Engine::Benchmarks
+{
+    struct CorpusMesh
+    {
+        std::string name;
+        Graphics::Mesh mesh;
+    };
+
+    // Sphere with ripples, so that simplification and meshlet cones have something to work with.
+    Graphics::Mesh MakeRippledSphere(std::uint32_t rings, std::uint32_t segments);
+    // Height field of `size` by `size` quads.
+    Graphics::Mesh MakeTerrain(std::uint32_t size);
+    Graphics::Mesh MakeTorus(std::uint32_t rings, std::uint32_t segments);
+
+    // Shuffle triangles with a fixed seed, like exporters that don't care about vertex cache order.
+    void ShuffleTriangles(Graphics::Mesh& mesh, std::uint32_t seed);
+
+    // Procedural stand-ins for props, terrain and characters, between 10k and 130k triangles, with
+    // shuffled triangle order.
+    std::vector<CorpusMesh> GenerateMeshCorpus();
+}
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef ENGINE_BENCHMARKS_SCRATCH_DIRECTORY_INCLUDED
+#define ENGINE_BENCHMARKS_SCRATCH_DIRECTORY_INCLUDED
+
+#include <filesystem>
+#include <string>
+
+namespace Engine::Benchmarks
+{
+    // Directory in the system's temporary directory, removed with everything in it.
+    class ScratchDirectory
+    {
+    public:
+        explicit ScratchDirectory(const char* name);
+        ~ScratchDirectory();
+
+        ScratchDirectory(const ScratchDirectory&) = delete;
+        ScratchDirectory& operator=(const ScratchDirectory&) = delete;
+
+        // Remove everything in it.
+        void Clear();
+
+        std::string GetPath() const { return path.string(); }
+        std::string GetFile(const std::string& name) const { return (path / name).string(); }
+
+    private:
+        std::filesystem::path path;
+    };
+}
+
+#endif
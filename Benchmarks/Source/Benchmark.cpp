@@ -0,0 +1,307 @@
+#include <Engine/Benchmarks/Benchmark.hpp>
+#include <Engine/Core/PerfCounters.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace Engine::Benchmarks
+{
+    namespace
+    {
+        // Samples taken even when a single iteration exceeds the time budget.
+        constexpr std::size_t MinSampleCount = 5;
+        // Sampling stops early once a variant took this long, so slow benchmarks like mesh simplification
+        // don't hold up the run.
+        constexpr double MaxSamplingSeconds = 3.0;
+
+        struct RegisteredBenchmark
+        {
+            const char* name;
+            BenchmarkFunction function;
+        };
+
+        std::vector<RegisteredBenchmark>& GetRegistry()
+        {
+            static std::vector<RegisteredBenchmark> registry;
+            return registry;
+        }
+
+        double GetSeconds(std::chrono::steady_clock::time_point start)
+        {
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+
+        // Linear interpolation between the closest ranks, `sorted` must not be empty.
+        double GetPercentile(const std::vector<double>& sorted, double percentile)
+        {
+            double rank = percentile / 100.0 * static_cast<double>(sorted.size() - 1);
+            std::size_t lower = static_cast<std::size_t>(rank);
+            std::size_t upper = std::min(lower + 1, sorted.size() - 1);
+            return sorted[lower] + (sorted[upper] - sorted[lower]) * (rank - static_cast<double>(lower));
+        }
+
+        void ComputeStatistics(BenchmarkResult& result)
+        {
+            if (result.samples.empty())
+                return;
+
+            std::vector<double> sorted = result.samples;
+            std::sort(sorted.begin(), sorted.end());
+            result.median = GetPercentile(sorted, 50.0);
+            result.minimum = sorted.front();
+            result.p5 = GetPercentile(sorted, 5.0);
+            result.p95 = GetPercentile(sorted, 95.0);
+            result.maximum = sorted.back();
+
+            for (double& sample : sorted)
+                sample = std::abs(sample - result.median);
+            std::sort(sorted.begin(), sorted.end());
+            result.mad = GetPercentile(sorted, 50.0);
+        }
+
+        // IPC and misses per item, or per iteration without items. Only counts the benchmark thread.
+        void AddPerfCounters(BenchmarkResult& result, const Core::PerfCounterValues& counters, double iterations)
+        {
+            if (counters.GetInstructionsPerCycle() > 0.0)
+                result.counters.emplace_back("IPC", counters.GetInstructionsPerCycle());
+
+            double items = iterations * (result.itemsPerIteration > 0.0 ? result.itemsPerIteration : 1.0);
+            const char* unit = result.itemsPerIteration > 0.0 ? "/item" : "/iter";
+            if (counters.IsValid(Core::PerfCounter::CacheMisses))
+                result.counters.emplace_back(std::string("LLC misses") + unit, static_cast<double>(counters.Get(Core::PerfCounter::CacheMisses)) / items);
+            if (counters.IsValid(Core::PerfCounter::BranchMisses))
+                result.counters.emplace_back(std::string("branch misses") + unit, static_cast<double>(counters.Get(Core::PerfCounter::BranchMisses)) / items);
+        }
+
+        std::string FormatNanoseconds(double nanoseconds)
+        {
+            std::ostringstream stream;
+            stream << std::fixed << std::setprecision(nanoseconds < 10.0 ? 2 : 1);
+            if (nanoseconds < 1e3)
+                stream << nanoseconds << " ns";
+            else if (nanoseconds < 1e6)
+                stream << nanoseconds / 1e3 << " us";
+            else if (nanoseconds < 1e9)
+                stream << nanoseconds / 1e6 << " ms";
+            else
+                stream << nanoseconds / 1e9 << " s";
+
+            return stream.str();
+        }
+
+        void PrintResult(const BenchmarkResult& result)
+        {
+            std::cout << std::left << std::setw(44) << result.name << std::right;
+
+            if (result.status == BenchmarkStatus::Skipped)
+            {
+                std::cout << "skipped: " << result.message << std::endl;
+                return;
+            }
+
+            if (!result.samples.empty())
+            {
+                std::cout << std::setw(11) << FormatNanoseconds(result.median) << " +- " << std::fixed << std::setprecision(1)
+                          << std::setw(4) << (result.median > 0.0 ? result.mad / result.median * 100.0 : 0.0) << "%  [p5 "
+                          << FormatNanoseconds(result.p5) << ", p95 " << FormatNanoseconds(result.p95) << "]";
+
+                if (result.itemsPerIteration > 0.0 && result.median > 0.0)
+                    std::cout << "  " << std::setprecision(2) << result.itemsPerIteration / result.median * 1e3 << " M items/s";
+            }
+
+            for (const auto& [counter, value] : result.counters)
+                std::cout << "  " << counter << " " << std::setprecision(3) << value;
+
+            if (result.status == BenchmarkStatus::Failed)
+                std::cout << "  FAILED: " << result.message;
+
+            std::cout << std::endl;
+        }
+    }
+
+#if defined(_MSC_VER) && !defined(__clang__)
+    namespace Detail
+    {
+        void UseCharPointer(const volatile char*)
+        {
+        }
+    }
+#endif
+
+    BenchmarkContext::BenchmarkContext(std::string name, const BenchmarkOptions& options)
+        : name(std::move(name)), options(options)
+    {
+    }
+
+    const BenchmarkResult* BenchmarkContext::MeasureBatches(const std::string& variant, const std::function<void(std::uint64_t)>& batch, double itemsPerIteration)
+    {
+        if (skipped)
+            return nullptr;
+
+        BenchmarkResult result;
+        result.name = variant.empty() ? name : name + "/" + variant;
+        result.itemsPerIteration = itemsPerIteration;
+
+        // Counters set until the next variant belong to this one and are dropped with it.
+        filteredOut = !options.filter.empty() && name.find(options.filter) == std::string::npos && result.name.find(options.filter) == std::string::npos;
+        if (filteredOut)
+            return nullptr;
+
+        auto warmupStart = std::chrono::steady_clock::now();
+        do
+            batch(1);
+        while (GetSeconds(warmupStart) < options.warmupSeconds);
+
+        // Grow the batch until it is long enough for the clock and the loop overhead not to matter,
+        // aiming a bit above the minimum so the next attempt usually is the last.
+        std::uint64_t iterations = 1;
+        for (;;)
+        {
+            auto start = std::chrono::steady_clock::now();
+            batch(iterations);
+            double seconds = GetSeconds(start);
+            if (seconds >= options.minSampleSeconds)
+                break;
+
+            double scale = seconds > 0.0 ? options.minSampleSeconds * 1.2 / seconds : 100.0;
+            iterations = std::max(iterations + 1, static_cast<std::uint64_t>(static_cast<double>(iterations) * std::min(scale, 100.0)));
+        }
+        result.iterationsPerSample = iterations;
+
+        // Counters are read outside the timed region, so the reads don't show up in the samples.
+        Core::PerfCounterValues counters;
+        auto samplingStart = std::chrono::steady_clock::now();
+        while (result.samples.size() < std::max(options.sampleCount, MinSampleCount))
+        {
+            Core::PerfCounterValues before;
+            if (options.perfCounters)
+                Core::ReadThreadPerfCounters(before);
+
+            auto start = std::chrono::steady_clock::now();
+            batch(iterations);
+            result.samples.push_back(GetSeconds(start) * 1e9 / static_cast<double>(iterations));
+
+            Core::PerfCounterValues after;
+            if (options.perfCounters && Core::ReadThreadPerfCounters(after))
+                counters += after - before;
+
+            if (result.samples.size() >= MinSampleCount && GetSeconds(samplingStart) > MaxSamplingSeconds)
+                break;
+        }
+
+        ComputeStatistics(result);
+        AddPerfCounters(result, counters, static_cast<double>(iterations * result.samples.size()));
+        results.push_back(std::move(result));
+        return &results.back();
+    }
+
+    BenchmarkResult& BenchmarkContext::GetCurrentResult()
+    {
+        if (results.empty())
+        {
+            results.emplace_back();
+            results.back().name = name;
+        }
+
+        return results.back();
+    }
+
+    void BenchmarkContext::SetCounter(const std::string& counter, double value)
+    {
+        if (!skipped && !filteredOut)
+            GetCurrentResult().counters.emplace_back(counter, value);
+    }
+
+    void BenchmarkContext::Skip(const std::string& reason)
+    {
+        BenchmarkResult result;
+        result.name = name;
+        result.status = BenchmarkStatus::Skipped;
+        result.message = reason;
+
+        results.clear();
+        results.push_back(std::move(result));
+        skipped = true;
+    }
+
+    void BenchmarkContext::Fail(const std::string& reason)
+    {
+        // A failure must not go unnoticed because its variant was filtered out.
+        if (filteredOut)
+        {
+            results.emplace_back();
+            results.back().name = name;
+            filteredOut = false;
+        }
+
+        BenchmarkResult& result = GetCurrentResult();
+        result.status = BenchmarkStatus::Failed;
+        result.message += result.message.empty() ? reason : "; " + reason;
+    }
+
+    BenchmarkRegistration::BenchmarkRegistration(const char* name, BenchmarkFunction function)
+    {
+        GetRegistry().push_back({ name, function });
+    }
+
+    bool PinThreadToCpu(std::uint32_t cpu)
+    {
+#if defined(_WIN32)
+        return cpu < 64 && SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << cpu) != 0;
+#elif defined(__linux__)
+        if (cpu >= CPU_SETSIZE)
+            return false;
+
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+        // macOS only has affinity hints, which aren't worth it for measurements.
+        (void)cpu;
+        return false;
+#endif
+    }
+
+    std::vector<BenchmarkResult> RunBenchmarks(const BenchmarkOptions& options)
+    {
+        std::vector<BenchmarkResult> results;
+        for (const RegisteredBenchmark& benchmark : GetRegistry())
+        {
+            // "<name>/<variant>" filters run the benchmark for that variant only, see `MeasureBatches`.
+            std::string name = benchmark.name;
+            if (!options.filter.empty() && name.find(options.filter) == std::string::npos && options.filter.compare(0, name.size() + 1, name + "/") != 0)
+                continue;
+
+            BenchmarkContext context(name, options);
+            benchmark.function(context);
+
+            for (BenchmarkResult& result : context.GetResults())
+            {
+                PrintResult(result);
+                results.push_back(std::move(result));
+            }
+        }
+
+        return results;
+    }
+
+    void ListBenchmarks()
+    {
+        for (const RegisteredBenchmark& benchmark : GetRegistry())
+            std::cout << benchmark.name << std::endl;
+    }
+}
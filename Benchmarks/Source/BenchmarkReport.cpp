@@ -0,0 +1,438 @@
+#include <Engine/Benchmarks/BenchmarkReport.hpp>
+
+#include <Engine/Core/AtomicFile.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <unordered_map>
+
+namespace Engine::Benchmarks
+{
+    namespace
+    {
+        constexpr int Version = 1;
+
+        const char* GetStatusName(BenchmarkStatus status)
+        {
+            switch (status)
+            {
+            case BenchmarkStatus::Ok: return "ok";
+            case BenchmarkStatus::Skipped: return "skipped";
+            case BenchmarkStatus::Failed: return "failed";
+            }
+
+            return "ok";
+        }
+
+        void WriteString(std::ostream& stream, const std::string& string)
+        {
+            stream << '"';
+            for (char character : string)
+            {
+                if (character == '"' || character == '\\')
+                    stream << '\\' << character;
+                else if (static_cast<unsigned char>(character) < 0x20)
+                    stream << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(character) << std::dec << std::setfill(' ');
+                else
+                    stream << character;
+            }
+            stream << '"';
+        }
+
+        // Just enough JSON for the files written above: objects, arrays, strings, numbers and literals.
+        struct JsonValue
+        {
+            enum class Type : std::uint8_t
+            {
+                Null,
+                Boolean,
+                Number,
+                String,
+                Array,
+                Object
+            };
+
+            Type type = Type::Null;
+            double number = 0.0;
+            std::string string;
+            std::vector<JsonValue> elements;
+            // Object members, `keys[i]` names `elements[i]`.
+            std::vector<std::string> keys;
+
+            const JsonValue* Find(const std::string& key) const
+            {
+                for (std::size_t i = 0; i < keys.size(); ++i)
+                    if (keys[i] == key)
+                        return &elements[i];
+
+                return nullptr;
+            }
+
+            double GetNumber(const std::string& key) const
+            {
+                const JsonValue* value = Find(key);
+                return value != nullptr && value->type == Type::Number ? value->number : 0.0;
+            }
+
+            std::string GetString(const std::string& key) const
+            {
+                const JsonValue* value = Find(key);
+                return value != nullptr && value->type == Type::String ? value->string : std::string();
+            }
+        };
+
+        class JsonParser
+        {
+        public:
+            explicit JsonParser(const std::string& text) : text(text) {}
+
+            bool Parse(JsonValue& value)
+            {
+                return ParseValue(value, 0) && (SkipWhitespace(), position == text.size());
+            }
+
+        private:
+            static constexpr int MaxDepth = 32;
+
+            void SkipWhitespace()
+            {
+                while (position < text.size() && (text[position] == ' ' || text[position] == '\t' || text[position] == '\n' || text[position] == '\r'))
+                    ++position;
+            }
+
+            bool Consume(char character)
+            {
+                SkipWhitespace();
+                if (position >= text.size() || text[position] != character)
+                    return false;
+
+                ++position;
+                return true;
+            }
+
+            bool ParseString(std::string& string)
+            {
+                if (!Consume('"'))
+                    return false;
+
+                while (position < text.size() && text[position] != '"')
+                {
+                    char character = text[position++];
+                    if (character != '\\')
+                    {
+                        string += character;
+                        continue;
+                    }
+
+                    if (position >= text.size())
+                        return false;
+
+                    char escape = text[position++];
+                    switch (escape)
+                    {
+                    case 'n': string += '\n'; break;
+                    case 't': string += '\t'; break;
+                    case 'r': string += '\r'; break;
+                    case 'b': string += '\b'; break;
+                    case 'f': string += '\f'; break;
+                    case 'u':
+                        // Only the control characters written above, anything else becomes '?'.
+                        if (position + 4 > text.size())
+                            return false;
+                        {
+                            unsigned long code = std::strtoul(text.substr(position, 4).c_str(), nullptr, 16);
+                            string += code < 0x80 ? static_cast<char>(code) : '?';
+                        }
+                        position += 4;
+                        break;
+                    default: string += escape; break;
+                    }
+                }
+
+                return position++ < text.size();
+            }
+
+            bool ParseValue(JsonValue& value, int depth)
+            {
+                if (depth > MaxDepth)
+                    return false;
+
+                SkipWhitespace();
+                if (position >= text.size())
+                    return false;
+
+                char character = text[position];
+                if (character == '{')
+                {
+                    value.type = JsonValue::Type::Object;
+                    ++position;
+                    if (Consume('}'))
+                        return true;
+
+                    do
+                    {
+                        value.keys.emplace_back();
+                        value.elements.emplace_back();
+                        if (!ParseString(value.keys.back()) || !Consume(':') || !ParseValue(value.elements.back(), depth + 1))
+                            return false;
+                    }
+                    while (Consume(','));
+
+                    return Consume('}');
+                }
+
+                if (character == '[')
+                {
+                    value.type = JsonValue::Type::Array;
+                    ++position;
+                    if (Consume(']'))
+                        return true;
+
+                    do
+                    {
+                        value.elements.emplace_back();
+                        if (!ParseValue(value.elements.back(), depth + 1))
+                            return false;
+                    }
+                    while (Consume(','));
+
+                    return Consume(']');
+                }
+
+                if (character == '"')
+                {
+                    value.type = JsonValue::Type::String;
+                    return ParseString(value.string);
+                }
+
+                for (const char* literal : { "true", "false", "null" })
+                {
+                    std::size_t length = std::char_traits<char>::length(literal);
+                    if (text.compare(position, length, literal) == 0)
+                    {
+                        value.type = literal[0] == 'n' ? JsonValue::Type::Null : JsonValue::Type::Boolean;
+                        value.number = literal[0] == 't' ? 1.0 : 0.0;
+                        position += length;
+                        return true;
+                    }
+                }
+
+                const char* start = text.c_str() + position;
+                char* end = nullptr;
+                value.type = JsonValue::Type::Number;
+                value.number = std::strtod(start, &end);
+                if (end == start)
+                    return false;
+
+                position += static_cast<std::size_t>(end - start);
+                return true;
+            }
+
+            const std::string& text;
+            std::size_t position = 0;
+        };
+
+        std::string FormatChange(double change)
+        {
+            std::ostringstream stream;
+            stream << std::fixed << std::setprecision(1) << std::showpos << change * 100.0 << "%";
+            return stream.str();
+        }
+    }
+
+    bool WriteBenchmarkJson(const std::string& path, const std::vector<BenchmarkResult>& results)
+    {
+        return Core::WriteFileAtomically(path, [&](std::ostream& file)
+        {
+            file << std::setprecision(10);
+            file << "{\n  \"version\": " << Version << ",\n  \"benchmarks\": [";
+
+            for (std::size_t i = 0; i < results.size(); ++i)
+            {
+                const BenchmarkResult& result = results[i];
+                file << (i == 0 ? "\n" : ",\n") << "    {\n      \"name\": ";
+                WriteString(file, result.name);
+                file << ",\n      \"status\": \"" << GetStatusName(result.status) << "\",\n      \"message\": ";
+                WriteString(file, result.message);
+                file << ",\n      \"iterationsPerSample\": " << result.iterationsPerSample
+                     << ",\n      \"itemsPerIteration\": " << result.itemsPerIteration
+                     << ",\n      \"median\": " << result.median
+                     << ",\n      \"mad\": " << result.mad
+                     << ",\n      \"min\": " << result.minimum
+                     << ",\n      \"p5\": " << result.p5
+                     << ",\n      \"p95\": " << result.p95
+                     << ",\n      \"max\": " << result.maximum
+                     << ",\n      \"counters\": {";
+
+                for (std::size_t counter = 0; counter < result.counters.size(); ++counter)
+                {
+                    file << (counter == 0 ? " " : ", ");
+                    WriteString(file, result.counters[counter].first);
+                    file << ": " << result.counters[counter].second;
+                }
+
+                file << (result.counters.empty() ? "}" : " }") << ",\n      \"samples\": [";
+                for (std::size_t sample = 0; sample < result.samples.size(); ++sample)
+                    file << (sample == 0 ? "" : ", ") << result.samples[sample];
+                file << "]\n    }";
+            }
+
+            file << "\n  ]\n}\n";
+        });
+    }
+
+    bool ReadBenchmarkJson(const std::string& path, std::vector<BenchmarkResult>& results)
+    {
+        std::ifstream file(path);
+        if (!file)
+        {
+            std::cout << "Something went wrong opening the benchmark results \"" << path << "\"." << std::endl;
+            return false;
+        }
+
+        std::stringstream text;
+        text << file.rdbuf();
+        std::string contents = text.str();
+
+        JsonValue root;
+        if (!JsonParser(contents).Parse(root) || root.type != JsonValue::Type::Object)
+        {
+            std::cout << "\"" << path << "\" is not valid JSON." << std::endl;
+            return false;
+        }
+
+        const JsonValue* benchmarks = root.Find("benchmarks");
+        if (root.GetNumber("version") != Version || benchmarks == nullptr || benchmarks->type != JsonValue::Type::Array)
+        {
+            std::cout << "\"" << path << "\" are no benchmark results of version " << Version << "." << std::endl;
+            return false;
+        }
+
+        for (const JsonValue& benchmark : benchmarks->elements)
+        {
+            BenchmarkResult result;
+            result.name = benchmark.GetString("name");
+            std::string status = benchmark.GetString("status");
+            result.status = status == "skipped" ? BenchmarkStatus::Skipped : status == "failed" ? BenchmarkStatus::Failed : BenchmarkStatus::Ok;
+            result.message = benchmark.GetString("message");
+            result.iterationsPerSample = static_cast<std::uint64_t>(benchmark.GetNumber("iterationsPerSample"));
+            result.itemsPerIteration = benchmark.GetNumber("itemsPerIteration");
+            result.median = benchmark.GetNumber("median");
+            result.mad = benchmark.GetNumber("mad");
+            result.minimum = benchmark.GetNumber("min");
+            result.p5 = benchmark.GetNumber("p5");
+            result.p95 = benchmark.GetNumber("p95");
+            result.maximum = benchmark.GetNumber("max");
+
+            if (const JsonValue* counters = benchmark.Find("counters"))
+                for (std::size_t i = 0; i < counters->keys.size(); ++i)
+                    result.counters.emplace_back(counters->keys[i], counters->elements[i].number);
+
+            if (const JsonValue* samples = benchmark.Find("samples"))
+                for (const JsonValue& sample : samples->elements)
+                    result.samples.push_back(sample.number);
+
+            results.push_back(std::move(result));
+        }
+
+        return true;
+    }
+
+    double MannWhitneyPValue(const std::vector<double>& a, const std::vector<double>& b)
+    {
+        if (a.empty() || b.empty())
+            return 1.0;
+
+        // Rank both samples together, ties get the average of their ranks.
+        std::vector<std::pair<double, bool>> pooled;
+        for (double value : a)
+            pooled.emplace_back(value, true);
+        for (double value : b)
+            pooled.emplace_back(value, false);
+        std::sort(pooled.begin(), pooled.end(), [](const auto& x, const auto& y) { return x.first < y.first; });
+
+        double rankSumA = 0.0;
+        double tieTerm = 0.0;
+        for (std::size_t i = 0; i < pooled.size();)
+        {
+            std::size_t j = i;
+            while (j < pooled.size() && pooled[j].first == pooled[i].first)
+                ++j;
+
+            double rank = (static_cast<double>(i + 1) + static_cast<double>(j)) * 0.5;
+            for (std::size_t k = i; k < j; ++k)
+                if (pooled[k].second)
+                    rankSumA += rank;
+
+            double ties = static_cast<double>(j - i);
+            tieTerm += ties * ties * ties - ties;
+            i = j;
+        }
+
+        double n1 = static_cast<double>(a.size());
+        double n2 = static_cast<double>(b.size());
+        double n = n1 + n2;
+        double u = rankSumA - n1 * (n1 + 1.0) * 0.5;
+        double mean = n1 * n2 * 0.5;
+        double variance = n1 * n2 / 12.0 * ((n + 1.0) - tieTerm / (n * (n - 1.0)));
+        if (variance <= 0.0)
+            return 1.0;
+
+        // Continuity correction, then both tails of the standard normal distribution.
+        double z = (std::abs(u - mean) - 0.5) / std::sqrt(variance);
+        return std::min(1.0, std::erfc(std::max(z, 0.0) / std::sqrt(2.0)));
+    }
+
+    std::vector<BenchmarkComparison> CompareBenchmarks(const std::vector<BenchmarkResult>& baseline, const std::vector<BenchmarkResult>& current,
+                                                       const BenchmarkComparisonOptions& options)
+    {
+        std::unordered_map<std::string, const BenchmarkResult*> baselineByName;
+        for (const BenchmarkResult& result : baseline)
+            if (result.status == BenchmarkStatus::Ok && !result.samples.empty())
+                baselineByName[result.name] = &result;
+
+        std::vector<BenchmarkComparison> comparisons;
+        for (const BenchmarkResult& result : current)
+        {
+            auto it = baselineByName.find(result.name);
+            if (result.status != BenchmarkStatus::Ok || result.samples.empty() || it == baselineByName.end() || it->second->median <= 0.0)
+                continue;
+
+            BenchmarkComparison comparison;
+            comparison.name = result.name;
+            comparison.baselineMedian = it->second->median;
+            comparison.currentMedian = result.median;
+            comparison.change = result.median / it->second->median - 1.0;
+            comparison.pValue = MannWhitneyPValue(it->second->samples, result.samples);
+
+            bool significant = comparison.pValue < options.significance && std::abs(comparison.change) >= options.minimumChange;
+            comparison.regressed = significant && comparison.change > 0.0;
+            comparison.improved = significant && comparison.change < 0.0;
+            comparisons.push_back(comparison);
+        }
+
+        return comparisons;
+    }
+
+    void PrintComparisons(const std::vector<BenchmarkComparison>& comparisons)
+    {
+        std::size_t regressions = 0;
+        std::size_t improvements = 0;
+        for (const BenchmarkComparison& comparison : comparisons)
+        {
+            const char* verdict = comparison.regressed ? "SLOWER" : comparison.improved ? "faster" : "same";
+            std::cout << std::left << std::setw(44) << comparison.name << std::right << std::setw(8) << FormatChange(comparison.change)
+                      << "  p " << std::setprecision(4) << std::defaultfloat << comparison.pValue << "  " << verdict << std::endl;
+
+            regressions += comparison.regressed ? 1 : 0;
+            improvements += comparison.improved ? 1 : 0;
+        }
+
+        std::cout << comparisons.size() << " compared, " << improvements << " faster, " << regressions << " slower." << std::endl;
+    }
+}
@@ -0,0 +1,553 @@
+#include <Engine/Benchmarks/Benchmark.hpp>
+#include <Engine/Benchmarks/ScratchDirectory.hpp>
+#include <Engine/Core/FlightRecorder.hpp>
+#include <Engine/Core/MemoryTracking.hpp>
+#include <Engine/Core/PackFile.hpp>
+#include <Engine/Core/ResourceManager.hpp>
+#include <Engine/Core/StartupPrefetch.hpp>
+#include <Engine/Core/StringId.hpp>
+#include <Engine/Core/ThreadPool.hpp>
+#include <Engine/Core/TlsfHeap.hpp>
+
+#include <SDL2/SDL_audio.h>
+#include <SDL2/SDL_rwops.h>
+#include <SDL2/SDL_surface.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace Engine;
+
+namespace
+{
+    struct Blob
+    {
+        std::vector<char> bytes;
+    };
+
+    bool WriteBlob(const std::string& path, std::size_t size, char fill)
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        std::vector<char> bytes(size, fill);
+        file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        return static_cast<bool>(file);
+    }
+
+    // Evict a file from the page cache, so that the next read goes to the disk. Returns false where
+    // that isn't possible, reads are then served from the cache.
+    bool DropFromPageCache(const std::string& path)
+    {
+#if defined(__linux__)
+        int file = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (file < 0)
+            return false;
+
+        // Dirty pages stay, write them back first.
+        bool dropped = fdatasync(file) == 0 && posix_fadvise(file, 0, 0, POSIX_FADV_DONTNEED) == 0;
+        close(file);
+        return dropped;
+#else
+        (void)path;
+        return false;
+#endif
+    }
+
+    // 16-bit mono PCM, a short sound effect.
+    bool WriteWav(const std::string& path, std::uint32_t sampleCount, std::uint32_t seed)
+    {
+        std::uint32_t dataSize = sampleCount * 2;
+        std::uint32_t riffSize = 36 + dataSize;
+        std::uint32_t formatSize = 16;
+        std::uint16_t format = 1;
+        std::uint16_t channels = 1;
+        std::uint32_t rate = 22050;
+        std::uint32_t byteRate = rate * 2;
+        std::uint16_t blockAlign = 2;
+        std::uint16_t bits = 16;
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        auto write = [&file](const auto& value) { file.write(reinterpret_cast<const char*>(&value), sizeof(value)); };
+        file.write("RIFF", 4);
+        write(riffSize);
+        file.write("WAVEfmt ", 8);
+        write(formatSize);
+        write(format);
+        write(channels);
+        write(rate);
+        write(byteRate);
+        write(blockAlign);
+        write(bits);
+        file.write("data", 4);
+        write(dataSize);
+
+        std::uint32_t state = seed;
+        for (std::uint32_t i = 0; i < sampleCount; ++i)
+        {
+            state = state * 1664525u + 1013904223u;
+            std::int16_t sample = static_cast<std::int16_t>(state >> 16);
+            write(sample);
+        }
+
+        return static_cast<bool>(file);
+    }
+
+    bool WriteBmp(const std::string& path, int size, std::uint32_t color)
+    {
+        SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, size, size, 32, SDL_PIXELFORMAT_ARGB8888);
+        if (surface == nullptr)
+            return false;
+
+        SDL_FillRect(surface, nullptr, color);
+        bool saved = SDL_SaveBMP(surface, path.c_str()) == 0;
+        SDL_FreeSurface(surface);
+        return saved;
+    }
+
+    constexpr std::size_t ChurnSlotCount = 4096;
+    constexpr std::size_t ChurnBatch = 1000;
+    constexpr std::size_t ChurnLatencyOperations = 200000;
+
+    // Replace the allocation in `slot` with one of `size` bytes.
+    struct ChurnOperation
+    {
+        std::uint32_t slot;
+        std::uint32_t size;
+    };
+
+    // Mostly small nodes and strings, some buffers, now and then something large enough for malloc to
+    // map it on its own. Generated up front so the generator isn't timed.
+    std::vector<ChurnOperation> MakeChurnOperations(std::size_t count)
+    {
+        std::vector<ChurnOperation> operations(count);
+        std::uint32_t state = 0x9E3779B9u;
+        auto next = [&state]
+        {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            return state;
+        };
+
+        for (ChurnOperation& operation : operations)
+        {
+            operation.slot = next() % ChurnSlotCount;
+            std::uint32_t kind = next() % 1000;
+            if (kind < 800)
+                operation.size = 8 + next() % 249;
+            else if (kind < 990)
+                operation.size = 256 + next() % (16 << 10);
+            else
+                operation.size = (64 << 10) + next() % (448 << 10);
+        }
+
+        return operations;
+    }
+
+    // Throughput over batches, then the latency of single calls, clock reads included. `report` runs
+    // while the slots are still full.
+    template <typename Allocate, typename Free, typename Report>
+    void MeasureChurn(Benchmarks::BenchmarkContext& context, const std::string& variant, const std::vector<ChurnOperation>& operations,
+                      Allocate allocate, Free free, Report report)
+    {
+        std::vector<void*> slots(ChurnSlotCount, nullptr);
+        std::size_t next = 0;
+        auto replace = [&](const ChurnOperation& operation)
+        {
+            void*& slot = slots[operation.slot];
+            free(slot);
+            slot = allocate(operation.size);
+            static_cast<char*>(slot)[0] = 1;
+        };
+
+        bool measured = context.Measure(variant, [&]
+        {
+            for (std::size_t i = 0; i < ChurnBatch; ++i)
+                replace(operations[next++ % operations.size()]);
+        }, ChurnBatch) != nullptr;
+
+        if (measured)
+        {
+            std::vector<double> latencies;
+            latencies.reserve(2 * ChurnLatencyOperations);
+            for (std::size_t i = 0; i < ChurnLatencyOperations; ++i)
+            {
+                const ChurnOperation& operation = operations[next++ % operations.size()];
+                void*& slot = slots[operation.slot];
+                auto start = std::chrono::steady_clock::now();
+                free(slot);
+                auto freed = std::chrono::steady_clock::now();
+                slot = allocate(operation.size);
+                auto allocated = std::chrono::steady_clock::now();
+                static_cast<char*>(slot)[0] = 1;
+
+                latencies.push_back(std::chrono::duration<double, std::nano>(freed - start).count());
+                latencies.push_back(std::chrono::duration<double, std::nano>(allocated - freed).count());
+            }
+
+            std::sort(latencies.begin(), latencies.end());
+            context.SetCounter("p99 ns", latencies[latencies.size() * 99 / 100]);
+            context.SetCounter("p99.9 ns", latencies[latencies.size() * 999 / 1000]);
+            context.SetCounter("worst ns", latencies.back());
+            report();
+        }
+
+        for (void* slot : slots)
+            free(slot);
+    }
+}
+
+ENGINE_BENCHMARK(StringId)
+{
+    std::vector<std::string> names;
+    for (int i = 0; i < 4096; ++i)
+        names.push_back("Textures/Props/Crate_" + std::to_string(i) + "_Diffuse.bmp");
+
+    context.Measure("HashString", [&]
+    {
+        std::uint64_t combined = 0;
+        for (const std::string& name : names)
+            combined ^= Core::HashString(name);
+        Benchmarks::DoNotOptimize(combined);
+    }, static_cast<double>(names.size()));
+
+    std::vector<Core::StringId> ids;
+    for (const std::string& name : names)
+        ids.push_back(Core::StringId::Intern(name));
+
+    // Interning a string again is what loaders do for every name they read.
+    context.Measure("InternExisting", [&]
+    {
+        for (const std::string& name : names)
+            Benchmarks::DoNotOptimize(Core::StringId::Intern(name));
+    }, static_cast<double>(names.size()));
+
+    std::unordered_map<Core::StringId, std::uint32_t> byId;
+    std::unordered_map<std::string, std::uint32_t> byString;
+    for (std::uint32_t i = 0; i < names.size(); ++i)
+    {
+        byId[ids[i]] = i;
+        byString[names[i]] = i;
+    }
+
+    context.Measure("LookupById", [&]
+    {
+        std::uint32_t sum = 0;
+        for (Core::StringId id : ids)
+            sum += byId.find(id)->second;
+        Benchmarks::DoNotOptimize(sum);
+    }, static_cast<double>(ids.size()));
+
+    context.Measure("LookupByString", [&]
+    {
+        std::uint32_t sum = 0;
+        for (const std::string& name : names)
+            sum += byString.find(name)->second;
+        Benchmarks::DoNotOptimize(sum);
+    }, static_cast<double>(names.size()));
+}
+
+ENGINE_BENCHMARK(ResourceManager)
+{
+    constexpr int FileCount = 256;
+    constexpr std::size_t FileSize = 16 * 1024;
+    constexpr std::size_t Budget = 64 * 1024 * 1024;
+
+    Benchmarks::ScratchDirectory scratch("ResourceManager");
+    std::vector<std::string> paths;
+    for (int i = 0; i < FileCount; ++i)
+    {
+        paths.push_back(scratch.GetFile("Blob" + std::to_string(i) + ".bin"));
+        if (!WriteBlob(paths.back(), FileSize, static_cast<char>(i)))
+        {
+            context.Skip("couldn't write the test files");
+            return;
+        }
+    }
+
+    Core::ResourceManager manager(Budget);
+    manager.RegisterType<Blob>("Blob", [](const std::string& path, std::size_t& size) -> std::unique_ptr<Blob>
+    {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file)
+            return nullptr;
+
+        auto blob = std::make_unique<Blob>();
+        blob->bytes.resize(static_cast<std::size_t>(file.tellg()));
+        file.seekg(0);
+        file.read(blob->bytes.data(), static_cast<std::streamsize>(blob->bytes.size()));
+        size = blob->bytes.size();
+        return blob;
+    });
+
+    std::vector<Core::ResourceHandle<Blob>> handles;
+
+    // Files come from the page cache, this is the manager's overhead plus the file reads on its workers.
+    context.Measure("LoadAndEvict", [&]
+    {
+        for (const std::string& path : paths)
+            handles.push_back(manager.Load<Blob>(path));
+        manager.Wait();
+        handles.clear();
+
+        manager.SetMemoryBudget(0);
+        manager.SetMemoryBudget(Budget);
+    }, FileCount);
+
+    for (const std::string& path : paths)
+        handles.push_back(manager.Load<Blob>(path));
+    manager.Wait();
+
+    context.Measure("CachedLoad", [&]
+    {
+        for (const std::string& path : paths)
+            Benchmarks::DoNotOptimize(manager.Load<Blob>(path));
+    }, FileCount);
+}
+
+// Cold start reading 300 files of 512 KB, without a prefetch manifest and with the one the previous
+// run recorded. The files are dropped from the page cache before every iteration, which is part of
+// both measurements. Where the OS doesn't allow that, "page cache dropped" is 0 and both read from
+// the cache.
+ENGINE_BENCHMARK(StartupPrefetch)
+{
+    constexpr int FileCount = 300;
+    constexpr std::size_t FileSize = 512 * 1024;
+
+    Benchmarks::ScratchDirectory scratch("StartupPrefetch");
+    std::vector<std::string> paths;
+    for (int i = 0; i < FileCount; ++i)
+    {
+        paths.push_back(scratch.GetFile("Blob" + std::to_string(i) + ".bin"));
+        if (!WriteBlob(paths.back(), FileSize, static_cast<char>(i)))
+        {
+            context.Skip("couldn't write the test files");
+            return;
+        }
+    }
+
+    // Like a loader during startup, recording each file while a recorder is set.
+    std::vector<char> buffer(FileSize);
+    auto readFiles = [&]
+    {
+        for (const std::string& path : paths)
+        {
+            Core::RecordFileAccess(path, 0, 0);
+            std::ifstream file(path, std::ios::binary);
+            file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            Benchmarks::DoNotOptimize(file.gcount());
+        }
+    };
+
+    bool dropped = true;
+    auto dropFiles = [&]
+    {
+        for (const std::string& path : paths)
+            dropped = DropFromPageCache(path) && dropped;
+    };
+
+    std::string manifestPath = scratch.GetFile("Startup.prefetch");
+    {
+        Core::StartupPrefetch recorder(manifestPath);
+        Core::SetStartupPrefetch(&recorder);
+        readFiles();
+        Core::SetStartupPrefetch(nullptr);
+        if (!recorder.Save())
+        {
+            context.Skip("couldn't write the manifest");
+            return;
+        }
+    }
+
+    if (context.Measure("WithoutManifest", [&]
+    {
+        dropFiles();
+        readFiles();
+    }, FileCount) != nullptr)
+        context.SetCounter("page cache dropped", dropped);
+
+    Core::ThreadPool workers;
+    if (context.Measure("WithManifest", [&]
+    {
+        dropFiles();
+        Core::StartupPrefetch prefetch(manifestPath);
+        prefetch.Prefetch(workers);
+        readFiles();
+    }, FileCount) != nullptr)
+        context.SetCounter("page cache dropped", dropped);
+}
+
+ENGINE_BENCHMARK(PackFile)
+{
+    constexpr int SoundCount = 500;
+    constexpr int ImageCount = 500;
+
+    Benchmarks::ScratchDirectory scratch("PackFile");
+    std::vector<Core::StringId> names;
+    std::vector<std::string> paths;
+    bool written = true;
+    for (int i = 0; i < SoundCount; ++i)
+    {
+        std::string name = "Sound" + std::to_string(i) + ".wav";
+        paths.push_back(scratch.GetFile(name));
+        names.push_back(Core::StringId(name));
+        written = written && WriteWav(paths.back(), 2205, static_cast<std::uint32_t>(i));
+    }
+    for (int i = 0; i < ImageCount; ++i)
+    {
+        std::string name = "Image" + std::to_string(i) + ".bmp";
+        paths.push_back(scratch.GetFile(name));
+        names.push_back(Core::StringId(name));
+        written = written && WriteBmp(paths.back(), 64, 0xFF000000u | static_cast<std::uint32_t>(i) * 2654435761u);
+    }
+
+    std::string packPath = scratch.GetFile("Assets.pack");
+    std::unique_ptr<Core::PackFile> pack = written && Core::PackFile::Write(packPath, names, paths) ? Core::PackFile::Open(packPath) : nullptr;
+    if (pack == nullptr)
+    {
+        context.Skip("couldn't write the test files");
+        return;
+    }
+
+    // Both sides decode the same files, the difference is how the bytes get to the loader.
+    auto load = [](SDL_RWops* stream, bool sound)
+    {
+        if (stream == nullptr)
+            return false;
+
+        if (sound)
+        {
+            SDL_AudioSpec spec;
+            Uint8* buffer = nullptr;
+            Uint32 length = 0;
+            if (SDL_LoadWAV_RW(stream, 1, &spec, &buffer, &length) == nullptr)
+                return false;
+
+            SDL_FreeWAV(buffer);
+            return true;
+        }
+
+        SDL_Surface* surface = SDL_LoadBMP_RW(stream, 1);
+        SDL_FreeSurface(surface);
+        return surface != nullptr;
+    };
+
+    bool failed = false;
+    context.Measure("SDL_RWFromFile", [&]
+    {
+        for (std::size_t i = 0; i < paths.size(); ++i)
+            failed = !load(SDL_RWFromFile(paths[i].c_str(), "rb"), i < SoundCount) || failed;
+    }, static_cast<double>(paths.size()));
+
+    context.Measure("OpenStream", [&]
+    {
+        for (std::size_t i = 0; i < names.size(); ++i)
+            failed = !load(pack->OpenStream(names[i]), i < SoundCount) || failed;
+    }, static_cast<double>(names.size()));
+
+    if (failed)
+        context.Fail("SDL couldn't load some of the files");
+}
+
+// Cost per event of the always-on flight recorder, which has to stay well under 1% of a frame.
+ENGINE_BENCHMARK(FlightRecorder)
+{
+    constexpr int EventCount = 1000;
+
+    Benchmarks::ScratchDirectory directory("FlightRecorder");
+    Core::FlightRecorderOptions options;
+    options.frameBudgetMilliseconds = 0.0;
+    options.directory = directory.GetFile("Hitches");
+
+    context.Measure("ScopeInactive", [&]
+    {
+        for (int i = 0; i < EventCount; ++i)
+        {
+            ENGINE_FLIGHT_SCOPE("Benchmark");
+        }
+    }, EventCount);
+
+    Core::FlightRecorder recorder(options);
+    Core::SetFlightRecorder(&recorder);
+
+    context.Measure("Scope", [&]
+    {
+        for (int i = 0; i < EventCount; ++i)
+        {
+            ENGINE_FLIGHT_SCOPE("Benchmark");
+        }
+    }, EventCount);
+
+    context.Measure("Counter", [&]
+    {
+        for (int i = 0; i < EventCount; ++i)
+            Core::RecordFlightCounter("Benchmark", i);
+    }, EventCount);
+
+    Core::SetFlightRecorder(nullptr);
+}
+
+// What the tracking in `operator new` adds over the heap underneath, on small mixed sizes.
+ENGINE_BENCHMARK(MemoryTracking)
+{
+    constexpr std::size_t AllocationCount = 1000;
+    std::vector<void*> pointers(AllocationCount);
+
+    context.Measure("MallocFree", [&]
+    {
+        for (std::size_t i = 0; i < AllocationCount; ++i)
+            pointers[i] = std::malloc(16 + i % 8 * 24);
+        for (void* pointer : pointers)
+            std::free(pointer);
+    }, AllocationCount);
+
+    context.Measure("NewDelete", [&]
+    {
+        for (std::size_t i = 0; i < AllocationCount; ++i)
+            pointers[i] = ::operator new(16 + i % 8 * 24);
+        for (void* pointer : pointers)
+            ::operator delete(pointer);
+    }, AllocationCount);
+
+    context.Measure("SampleStats", [&] { Benchmarks::DoNotOptimize(Core::SampleMemoryStats().total.liveBytes); });
+}
+
+// Worst-case and tail latency of the TLSF heap against malloc, replacing random allocations of mixed
+// sizes in a full working set.
+ENGINE_BENCHMARK(AllocatorChurn)
+{
+    std::vector<ChurnOperation> operations = MakeChurnOperations(1 << 16);
+
+    MeasureChurn(context, "Malloc", operations, [](std::size_t size) { return std::malloc(size); }, [](void* memory) { std::free(memory); }, [] {});
+
+    auto measureTlsf = [&](const std::string& variant, const Core::TlsfHeapOptions& options)
+    {
+        Core::TlsfHeap heap(options);
+        MeasureChurn(context, variant, operations, [&heap](std::size_t size) { return heap.Allocate(size); }, [&heap](void* memory) { heap.Free(memory); }, [&]
+        {
+            Core::TlsfHeapStats stats = heap.GetStats();
+            context.SetCounter("fragmentation %", stats.fragmentation * 100.0);
+            context.SetCounter("pool MB", static_cast<double>(stats.poolBytes) / (1024.0 * 1024.0));
+        });
+    };
+
+    Core::TlsfHeapOptions options;
+    measureTlsf("Tlsf", options);
+
+    options.threadCaches = false;
+    measureTlsf("TlsfNoCaches", options);
+
+    options.threadCaches = true;
+    options.hugePages = true;
+    options.prefault = true;
+    measureTlsf("TlsfHugePages", options);
+}
@@ -0,0 +1,133 @@
+#include <Engine/Benchmarks/Benchmark.hpp>
+#include <Engine/Benchmarks/BenchmarkReport.hpp>
+#include <Engine/Core/CpuDispatch.hpp>
+#include <Engine/Core/PerfCounters.hpp>
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace Engine;
+
+namespace
+{
+    void PrintUsage()
+    {
+        std::cout << "Usage: Benchmarks [options]\n"
+                     "  Runs the registered benchmarks and prints the median time per iteration, its median\n"
+                     "  absolute deviation and the 5th and 95th percentiles over all samples.\n"
+                     "Options:\n"
+                     "  --filter <text>        Only run benchmarks whose name contains <text>.\n"
+                     "  --list                 Print the benchmark names and exit.\n"
+                     "  --samples <count>      Samples per benchmark (default 30).\n"
+                     "  --min-time <seconds>   Minimum duration of a sample (default 0.01).\n"
+                     "  --warmup <seconds>     Warmup before calibrating (default 0.1).\n"
+                     "  --cpu <index>          Pin the benchmark thread to this logical CPU (default -1, not pinned).\n"
+                     "                         Threads started by benchmarks inherit the pin and share that CPU.\n"
+                     "  --json <path>          Write the results with all samples.\n"
+                     "  --baseline <path>      Compare against results written by --json before.\n"
+                     "  --significance <p>     Significance level of the comparison (default 0.01).\n"
+                     "  --min-change <percent> Smaller changes are reported as unchanged (default 2).\n"
+                     "  --fail-on-regression   Exit with an error if a benchmark got significantly slower.\n"
+                     "  --no-perf-counters     Don't count cycles, instructions, LLC and branch misses.\n";
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Benchmarks::BenchmarkOptions options;
+    Benchmarks::BenchmarkComparisonOptions comparisonOptions;
+    std::string jsonPath;
+    std::string baselinePath;
+    int cpu = -1;
+    bool failOnRegression = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string argument = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (argument == "--filter" && hasValue)
+            options.filter = argv[++i];
+        else if (argument == "--list")
+        {
+            Benchmarks::ListBenchmarks();
+            return 0;
+        }
+        else if (argument == "--samples" && hasValue)
+            options.sampleCount = static_cast<std::size_t>(std::atoi(argv[++i]));
+        else if (argument == "--min-time" && hasValue)
+            options.minSampleSeconds = std::atof(argv[++i]);
+        else if (argument == "--warmup" && hasValue)
+            options.warmupSeconds = std::atof(argv[++i]);
+        else if (argument == "--cpu" && hasValue)
+            cpu = std::atoi(argv[++i]);
+        else if (argument == "--json" && hasValue)
+            jsonPath = argv[++i];
+        else if (argument == "--baseline" && hasValue)
+            baselinePath = argv[++i];
+        else if (argument == "--significance" && hasValue)
+            comparisonOptions.significance = std::atof(argv[++i]);
+        else if (argument == "--min-change" && hasValue)
+            comparisonOptions.minimumChange = std::atof(argv[++i]) / 100.0;
+        else if (argument == "--fail-on-regression")
+            failOnRegression = true;
+        else if (argument == "--no-perf-counters")
+            options.perfCounters = false;
+        else
+        {
+            PrintUsage();
+            return argument == "--help" ? 0 : 1;
+        }
+    }
+
+    // Read the baseline first, a typo shouldn't cost a whole run.
+    std::vector<Benchmarks::BenchmarkResult> baseline;
+    if (!baselinePath.empty() && !Benchmarks::ReadBenchmarkJson(baselinePath, baseline))
+        return 1;
+
+    // Migrating between cores costs cold caches and shows up as outliers. Off by default: threads
+    // started later, like thread pool and resource manager workers, inherit the affinity and would all
+    // share this one CPU, which makes multi-threaded results meaningless.
+    if (cpu >= 0 && !Benchmarks::PinThreadToCpu(static_cast<std::uint32_t>(cpu)))
+        std::cout << "Couldn't pin the benchmark thread to CPU " << cpu << ", results may be noisier." << std::endl;
+
+    Core::ReportCpuDispatch();
+
+    // Opens the events of the benchmark thread, which is the only one they count.
+    if (options.perfCounters)
+    {
+        std::cout << "Perf counters:";
+        if (Core::GetThreadPerfCounterMask() == 0)
+            std::cout << " none";
+        for (std::size_t counter = 0; counter < Core::PerfCounterCount; ++counter)
+        {
+            if ((Core::GetThreadPerfCounterMask() >> counter) & 1)
+                std::cout << " " << Core::GetPerfCounterName(static_cast<Core::PerfCounter>(counter));
+        }
+
+        std::string error = Core::GetThreadPerfCounterError();
+        std::cout << (error.empty() ? "" : ", unavailable: " + error) << std::endl;
+    }
+
+    std::vector<Benchmarks::BenchmarkResult> results = Benchmarks::RunBenchmarks(options);
+
+    bool failed = false;
+    for (const Benchmarks::BenchmarkResult& result : results)
+        failed = failed || result.status == Benchmarks::BenchmarkStatus::Failed;
+
+    if (!jsonPath.empty() && !Benchmarks::WriteBenchmarkJson(jsonPath, results))
+        failed = true;
+
+    if (!baseline.empty())
+    {
+        std::cout << "Compared to \"" << baselinePath << "\":" << std::endl;
+        std::vector<Benchmarks::BenchmarkComparison> comparisons = Benchmarks::CompareBenchmarks(baseline, results, comparisonOptions);
+        Benchmarks::PrintComparisons(comparisons);
+
+        for (const Benchmarks::BenchmarkComparison& comparison : comparisons)
+            failed = failed || (failOnRegression && comparison.regressed);
+    }
+
+    return failed ? 1 : 0;
+}
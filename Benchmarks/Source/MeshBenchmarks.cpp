@@ -0,0 +1,213 @@
+#include <Engine/Benchmarks/Benchmark.hpp>
+#include <Engine/Benchmarks/MeshCorpus.hpp>
+#include <Engine/Core/Math.hpp>
+#include <Engine/Graphics/Culling.hpp>
+#include <Engine/Graphics/Lod.hpp>
+#include <Engine/Graphics/MeshOptimizer.hpp>
+#include <Engine/Graphics/Meshlet.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using namespace Engine;
+
+namespace
+{
+    constexpr float Pi = 3.14159265358979f;
+    constexpr float VerticalFov = Pi / 3.0f;
+    constexpr float ScreenHeight = 1080.0f;
+
+    Core::Matrix4 MakeViewProjection(const Core::Vector3& eye, const Core::Vector3& target)
+    {
+        return Core::Matrix4::Perspective(VerticalFov, 16.0f / 9.0f, 0.05f, 500.0f) *
+               Core::Matrix4::LookAt(eye, target, Core::Vector3(0.0f, 1.0f, 0.0f));
+    }
+}
+
+// Vertex cache efficiency of the corpus before and after optimization, and the optimizer's speed.
+ENGINE_BENCHMARK(MeshCorpus)
+{
+    std::vector<Benchmarks::CorpusMesh> corpus = Benchmarks::GenerateMeshCorpus();
+
+    std::size_t triangles = 0;
+    for (const Benchmarks::CorpusMesh& entry : corpus)
+        triangles += entry.mesh.indices.size() / 3;
+
+    // Triangle weighted, so that big meshes count as much as they cost.
+    auto getAcmr = [&](const std::vector<Benchmarks::CorpusMesh>& meshes, float& atvr)
+    {
+        double acmr = 0.0;
+        double weightedAtvr = 0.0;
+        for (const Benchmarks::CorpusMesh& entry : meshes)
+        {
+            Graphics::VertexCacheStats stats = Graphics::AnalyzeVertexCache(entry.mesh.indices.data(), entry.mesh.indices.size(), entry.mesh.vertices.size());
+            acmr += stats.acmr * static_cast<double>(entry.mesh.indices.size() / 3);
+            weightedAtvr += stats.atvr * static_cast<double>(entry.mesh.indices.size() / 3);
+        }
+
+        atvr = static_cast<float>(weightedAtvr / static_cast<double>(triangles));
+        return acmr / static_cast<double>(triangles);
+    };
+
+    float atvrBefore = 0.0f;
+    double acmrBefore = getAcmr(corpus, atvrBefore);
+
+    std::vector<Benchmarks::CorpusMesh> optimized = corpus;
+    for (Benchmarks::CorpusMesh& entry : optimized)
+        Graphics::OptimizeMesh(entry.mesh);
+
+    float atvrAfter = 0.0f;
+    double acmrAfter = getAcmr(optimized, atvrAfter);
+
+    // Copying the corpus back is part of every iteration, it's small next to the optimization.
+    std::vector<Benchmarks::CorpusMesh> scratch;
+    context.Measure("OptimizeVertexCache", [&]
+    {
+        scratch = corpus;
+        for (Benchmarks::CorpusMesh& entry : scratch)
+            Graphics::OptimizeVertexCache(entry.mesh.indices.data(), entry.mesh.indices.size(), entry.mesh.vertices.size());
+    }, static_cast<double>(triangles));
+
+    context.Measure("OptimizeMesh", [&]
+    {
+        scratch = corpus;
+        for (Benchmarks::CorpusMesh& entry : scratch)
+            Graphics::OptimizeMesh(entry.mesh);
+    }, static_cast<double>(triangles));
+
+    context.SetCounter("ACMR before", acmrBefore);
+    context.SetCounter("ACMR after", acmrAfter);
+    context.SetCounter("ATVR before", atvrBefore);
+    context.SetCounter("ATVR after", atvrAfter);
+
+    for (const Benchmarks::CorpusMesh& entry : optimized)
+    {
+        Graphics::VertexCacheStats stats = Graphics::AnalyzeVertexCache(entry.mesh.indices.data(), entry.mesh.indices.size(), entry.mesh.vertices.size());
+        context.SetCounter(entry.name + " ACMR", stats.acmr);
+    }
+
+    context.Measure("QuantizeMesh", [&]
+    {
+        for (const Benchmarks::CorpusMesh& entry : optimized)
+            Benchmarks::DoNotOptimize(Graphics::QuantizeMesh(entry.mesh));
+    }, static_cast<double>(triangles));
+}
+
+// Building meshlets of the character mesh, and culling them from cameras all around it.
+ENGINE_BENCHMARK(Meshlets)
+{
+    Graphics::Mesh mesh = Benchmarks::MakeRippledSphere(160, 320);
+    Graphics::OptimizeMesh(mesh);
+
+    // Built outside the measurement too, a filter may skip it.
+    Graphics::MeshletMesh meshletMesh = Graphics::BuildMeshlets(mesh);
+    context.Measure("Build", [&] { Benchmarks::DoNotOptimize(Graphics::BuildMeshlets(mesh)); }, static_cast<double>(mesh.indices.size() / 3));
+    context.SetCounter("meshlets", static_cast<double>(meshletMesh.meshlets.size()));
+
+    // Close enough for part of the mesh to leave the frustum.
+    std::vector<Graphics::MeshletCullView> views;
+    for (int i = 0; i < 64; ++i)
+    {
+        float angle = 2.0f * Pi * static_cast<float>(i) / 64.0f;
+        Core::Vector3 eye(1.6f * std::cos(angle), 0.3f * std::sin(angle * 3.0f), 1.6f * std::sin(angle));
+
+        Graphics::MeshletCullView view;
+        view.viewProjection = MakeViewProjection(eye, Core::Vector3(0.3f * std::sin(angle), 0.0f, 0.0f));
+        view.frustum = Graphics::Frustum::FromViewProjection(view.viewProjection);
+        view.cameraPosition = eye;
+        views.push_back(view);
+    }
+
+    std::vector<std::uint32_t> visible;
+    Graphics::MeshletCullStats stats;
+    auto cull = [&]
+    {
+        stats = Graphics::MeshletCullStats();
+        for (const Graphics::MeshletCullView& view : views)
+        {
+            visible.clear();
+            Graphics::CullMeshlets(meshletMesh, view, visible, stats);
+        }
+    };
+
+    cull();
+    if (context.Measure("Cull", cull, static_cast<double>(meshletMesh.meshlets.size() * views.size())) != nullptr && stats.meshlets > 0)
+    {
+        context.SetCounter("frustum culled", static_cast<double>(stats.frustumCulled) / static_cast<double>(stats.meshlets));
+        context.SetCounter("backface culled", static_cast<double>(stats.backfaceCulled) / static_cast<double>(stats.meshlets));
+        context.SetCounter("visible triangles", static_cast<double>(stats.visibleTriangles) / static_cast<double>(stats.triangles));
+    }
+
+    std::vector<std::uint32_t> indices;
+    context.Measure("AppendIndices", [&]
+    {
+        indices.clear();
+        Graphics::AppendMeshletIndices(meshletMesh, visible, indices);
+    }, static_cast<double>(visible.size()));
+}
+
+// LOD chain generation, and selection for a field of instances while the camera flies through it.
+ENGINE_BENCHMARK(LodFlythrough)
+{
+    constexpr int GridSize = 64;
+    constexpr float GridSpacing = 6.0f;
+    constexpr int FrameCount = 600;
+
+    Graphics::Mesh mesh = Benchmarks::MakeRippledSphere(96, 192);
+    Graphics::OptimizeMesh(mesh);
+
+    Graphics::LodChain chain = Graphics::GenerateLodChain(mesh);
+    context.Measure("GenerateLodChain", [&] { Benchmarks::DoNotOptimize(Graphics::GenerateLodChain(mesh)); }, static_cast<double>(mesh.indices.size() / 3));
+    context.SetCounter("levels", static_cast<double>(chain.levels.size()));
+
+    Graphics::LodSelector selector(1.0f);
+    std::vector<Graphics::LodInstanceId> instances;
+    std::vector<Core::Vector3> centers;
+    for (int z = 0; z < GridSize; ++z)
+    {
+        for (int x = 0; x < GridSize; ++x)
+        {
+            instances.push_back(selector.AddInstance());
+            centers.emplace_back((x - GridSize / 2) * GridSpacing, 0.0f, (z - GridSize / 2) * GridSpacing);
+        }
+    }
+
+    float projectionScale = Graphics::ComputeProjectionScale(VerticalFov, ScreenHeight);
+    int frame = 0;
+    std::size_t triangles = 0;
+    std::size_t fullDetailTriangles = 0;
+    std::size_t fadingInstances = 0;
+    std::size_t visibleInstances = 0;
+
+    // Low over the field along a figure eight, one iteration is one frame of culling and selection.
+    context.Measure("Frame", [&]
+    {
+        float time = static_cast<float>(frame++ % FrameCount) / static_cast<float>(FrameCount) * 2.0f * Pi;
+        float extent = GridSize * GridSpacing * 0.4f;
+        Core::Vector3 eye(extent * std::sin(time), 4.0f, extent * std::sin(time) * std::cos(time));
+        Core::Vector3 target(extent * std::sin(time + 0.1f), 2.0f, extent * std::sin(time + 0.1f) * std::cos(time + 0.1f));
+        Graphics::Frustum frustum = Graphics::Frustum::FromViewProjection(MakeViewProjection(eye, target));
+
+        for (std::size_t i = 0; i < instances.size(); ++i)
+        {
+            if (!frustum.IsSphereVisible(centers[i], 1.1f))
+                continue;
+
+            Graphics::LodSelection selection = selector.Select(instances[i], chain, Core::Length(centers[i] - eye), projectionScale, 1.0f / 60.0f);
+            Benchmarks::DoNotOptimize(selection);
+        }
+
+        Graphics::LodStats stats = selector.ResetStats();
+        triangles += stats.triangles;
+        fullDetailTriangles += stats.fullDetailTriangles;
+        fadingInstances += stats.fadingInstances;
+        visibleInstances += stats.instances;
+    }, static_cast<double>(instances.size()));
+
+    if (fullDetailTriangles > 0 && visibleInstances > 0)
+    {
+        context.SetCounter("triangle ratio", static_cast<double>(triangles) / static_cast<double>(fullDetailTriangles));
+        context.SetCounter("fading", static_cast<double>(fadingInstances) / static_cast<double>(visibleInstances));
+    }
+}
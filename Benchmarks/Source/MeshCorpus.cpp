@@ -0,0 +1,143 @@
+#include <Engine/Benchmarks/MeshCorpus.hpp>
+
+#include <Engine/Core/Math.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace Engine::Benchmarks
+{
+    namespace
+    {
+        constexpr float Pi = 3.14159265358979f;
+
+        Graphics::Vertex MakeVertex(const Core::Vector3& position, const Core::Vector3& normal, float u, float v)
+        {
+            Graphics::Vertex vertex;
+            vertex.position[0] = position.x;
+            vertex.position[1] = position.y;
+            vertex.position[2] = position.z;
+            vertex.normal[0] = normal.x;
+            vertex.normal[1] = normal.y;
+            vertex.normal[2] = normal.z;
+            vertex.uv[0] = u;
+            vertex.uv[1] = v;
+            return vertex;
+        }
+
+        // Two counter-clockwise triangles per cell of a (rows + 1) by (columns + 1) vertex grid.
+        void AddGridIndices(Graphics::Mesh& mesh, std::uint32_t rows, std::uint32_t columns)
+        {
+            for (std::uint32_t row = 0; row < rows; ++row)
+            {
+                for (std::uint32_t column = 0; column < columns; ++column)
+                {
+                    std::uint32_t a = row * (columns + 1) + column;
+                    std::uint32_t b = a + columns + 1;
+                    mesh.indices.insert(mesh.indices.end(), { a, a + 1, b, a + 1, b + 1, b });
+                }
+            }
+        }
+    }
+
+    Graphics::Mesh MakeRippledSphere(std::uint32_t rings, std::uint32_t segments)
+    {
+        Graphics::Mesh mesh;
+        for (std::uint32_t ring = 0; ring <= rings; ++ring)
+        {
+            for (std::uint32_t segment = 0; segment <= segments; ++segment)
+            {
+                float u = static_cast<float>(segment) / static_cast<float>(segments);
+                float v = static_cast<float>(ring) / static_cast<float>(rings);
+                float theta = Pi * v;
+                float phi = 2.0f * Pi * u;
+                Core::Vector3 normal(std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi));
+                float radius = 1.0f + 0.05f * std::sin(7.0f * phi) * std::sin(5.0f * theta);
+                mesh.vertices.push_back(MakeVertex(normal * radius, normal, u, v));
+            }
+        }
+
+        AddGridIndices(mesh, rings, segments);
+        return mesh;
+    }
+
+    Graphics::Mesh MakeTerrain(std::uint32_t size)
+    {
+        auto height = [size](float x, float z)
+        {
+            float scale = 1.0f / static_cast<float>(size);
+            return 0.08f * std::sin(x * scale * 13.0f) * std::cos(z * scale * 11.0f) + 0.02f * std::sin((x + z) * scale * 57.0f);
+        };
+
+        Graphics::Mesh mesh;
+        for (std::uint32_t z = 0; z <= size; ++z)
+        {
+            for (std::uint32_t x = 0; x <= size; ++x)
+            {
+                float fx = static_cast<float>(x);
+                float fz = static_cast<float>(z);
+                float scale = 1.0f / static_cast<float>(size);
+                Core::Vector3 position(fx * scale - 0.5f, height(fx, fz), fz * scale - 0.5f);
+                Core::Vector3 normal = Core::Normalize(Core::Vector3((height(fx - 1.0f, fz) - height(fx + 1.0f, fz)) * static_cast<float>(size), 2.0f,
+                                                                     (height(fx, fz - 1.0f) - height(fx, fz + 1.0f)) * static_cast<float>(size)));
+                mesh.vertices.push_back(MakeVertex(position, normal, fx * scale, fz * scale));
+            }
+        }
+
+        AddGridIndices(mesh, size, size);
+        return mesh;
+    }
+
+    Graphics::Mesh MakeTorus(std::uint32_t rings, std::uint32_t segments)
+    {
+        constexpr float MajorRadius = 0.7f;
+        constexpr float MinorRadius = 0.3f;
+
+        Graphics::Mesh mesh;
+        for (std::uint32_t ring = 0; ring <= rings; ++ring)
+        {
+            for (std::uint32_t segment = 0; segment <= segments; ++segment)
+            {
+                float u = static_cast<float>(segment) / static_cast<float>(segments);
+                float v = static_cast<float>(ring) / static_cast<float>(rings);
+                float phi = 2.0f * Pi * u;
+                float theta = 2.0f * Pi * v;
+                Core::Vector3 center(MajorRadius * std::cos(phi), 0.0f, MajorRadius * std::sin(phi));
+                Core::Vector3 normal(std::cos(theta) * std::cos(phi), std::sin(theta), std::cos(theta) * std::sin(phi));
+                mesh.vertices.push_back(MakeVertex(center + normal * MinorRadius, normal, u, v));
+            }
+        }
+
+        AddGridIndices(mesh, rings, segments);
+        return mesh;
+    }
+
+    void ShuffleTriangles(Graphics::Mesh& mesh, std::uint32_t seed)
+    {
+        std::uint32_t state = seed;
+        std::size_t triangleCount = mesh.indices.size() / 3;
+        for (std::size_t i = triangleCount; i > 1; --i)
+        {
+            state = state * 1664525u + 1013904223u;
+            std::size_t j = (state >> 8) % i;
+            for (std::size_t corner = 0; corner < 3; ++corner)
+                std::swap(mesh.indices[(i - 1) * 3 + corner], mesh.indices[j * 3 + corner]);
+        }
+    }
+
+    std::vector<CorpusMesh> GenerateMeshCorpus()
+    {
+        std::vector<CorpusMesh> corpus;
+        corpus.push_back({ "Prop", MakeRippledSphere(48, 96) });
+        corpus.push_back({ "Character", MakeRippledSphere(160, 320) });
+        corpus.push_back({ "Ring", MakeTorus(64, 128) });
+        corpus.push_back({ "Terrain", MakeTerrain(256) });
+
+        std::uint32_t seed = 1;
+        for (CorpusMesh& entry : corpus)
+            ShuffleTriangles(entry.mesh, seed++);
+
+        return corpus;
+    }
+}
@@ -0,0 +1,182 @@
+#include <Engine/Benchmarks/Benchmark.hpp>
+#include <Engine/Benchmarks/MeshCorpus.hpp>
+#include <Engine/Benchmarks/ScratchDirectory.hpp>
+#include <Engine/Core/Math.hpp>
+#include <Engine/Graphics/MeshOptimizer.hpp>
+#include <Engine/Graphics/OpenGL/GLDevice.hpp>
+#include <Engine/Graphics/OpenGL/GLMeshRenderer.hpp>
+#include <Engine/Graphics/OpenGL/GLProgramCache.hpp>
+#include <Engine/Graphics/OpenGL/GLStateTracker.hpp>
+
+#include <SDL2/SDL.h>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace Engine;
+
+namespace
+{
+    // Hidden window with an OpenGL 4.5 context, headless with SDL_VIDEODRIVER=offscreen. Skips the
+    // benchmark if there is none.
+    class OffscreenGL
+    {
+    public:
+        explicit OffscreenGL(Benchmarks::BenchmarkContext& context)
+        {
+            if (SDL_InitSubSystem(SDL_INIT_VIDEO) != 0)
+            {
+                context.Skip(std::string("couldn't initialize video: ") + SDL_GetError());
+                return;
+            }
+
+            videoInitialized = true;
+            window = Graphics::CreateGLWindow("Benchmarks", 1280, 720, true);
+            device = window != nullptr ? Graphics::GLDevice::Create(window) : nullptr;
+            if (device == nullptr)
+                context.Skip("no OpenGL 4.5 context");
+        }
+
+        ~OffscreenGL()
+        {
+            device.reset();
+            if (window != nullptr)
+                SDL_DestroyWindow(window);
+            if (videoInitialized)
+                SDL_QuitSubSystem(SDL_INIT_VIDEO);
+        }
+
+        OffscreenGL(const OffscreenGL&) = delete;
+        OffscreenGL& operator=(const OffscreenGL&) = delete;
+
+        // `nullptr` if the benchmark was skipped.
+        Graphics::GLDevice* GetDevice() const { return device.get(); }
+
+    private:
+        bool videoInitialized = false;
+        SDL_Window* window = nullptr;
+        std::unique_ptr<Graphics::GLDevice> device;
+    };
+}
+
+// CPU cost of 10k mesh draws through the multi-draw-indirect renderer, and with the GPU waited for
+// to include the driver and GPU. Needs an OpenGL 4.5 context, headless with SDL_VIDEODRIVER=offscreen.
+ENGINE_BENCHMARK(GLDrawThroughput)
+{
+    constexpr std::uint32_t DrawCount = 10000;
+    constexpr int GridSize = 100;
+
+    OffscreenGL offscreen(context);
+    if (offscreen.GetDevice() == nullptr)
+        return;
+
+    const Graphics::GLFunctions& gl = offscreen.GetDevice()->GetFunctions();
+    Graphics::GLStateTracker state(gl);
+
+    std::vector<Graphics::QuantizedMesh> meshes;
+    std::size_t vertexCount = 0;
+    std::size_t indexCount = 0;
+    for (Benchmarks::CorpusMesh& entry : Benchmarks::GenerateMeshCorpus())
+    {
+        meshes.push_back(Graphics::CookMesh(std::move(entry.mesh)));
+        vertexCount += meshes.back().vertices.size();
+        indexCount += meshes.back().indices.size();
+    }
+
+    Graphics::GLMeshRenderer renderer(state, vertexCount, indexCount, DrawCount);
+    std::vector<std::uint32_t> meshIds;
+    for (const Graphics::QuantizedMesh& mesh : meshes)
+        meshIds.push_back(renderer.AddMesh(mesh));
+
+    if (!renderer.IsValid() || meshIds.back() == Graphics::GLMeshRenderer::InvalidMesh)
+    {
+        context.Fail("couldn't create the mesh renderer");
+    }
+    else
+    {
+        // A grid of small instances in front of the camera, all of them drawn.
+        std::vector<Core::Matrix4> models(DrawCount);
+        for (std::uint32_t i = 0; i < DrawCount; ++i)
+        {
+            models[i](0, 0) = models[i](1, 1) = models[i](2, 2) = 0.2f;
+            models[i](0, 3) = static_cast<float>(static_cast<int>(i) % GridSize - GridSize / 2) * 0.5f;
+            models[i](1, 3) = static_cast<float>(static_cast<int>(i) / GridSize - GridSize / 2) * 0.5f;
+            models[i](2, 3) = -40.0f;
+        }
+
+        Core::Matrix4 viewProjection = Core::Matrix4::Perspective(1.0f, 16.0f / 9.0f, 0.1f, 100.0f);
+        gl.Viewport(0, 0, 1280, 720);
+
+        auto frame = [&]
+        {
+            gl.Clear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            renderer.BeginFrame(viewProjection);
+            for (std::uint32_t i = 0; i < DrawCount; ++i)
+                renderer.Draw(meshIds[i % meshIds.size()], models[i]);
+            renderer.EndFrame();
+        };
+
+        // Without waiting, the ring buffer's fences throttle to the GPU once frames in flight run out.
+        if (context.Measure("Submit", frame, DrawCount) != nullptr)
+            context.SetCounter("multi draw calls", renderer.GetStats().multiDrawCalls);
+
+        context.Measure("SubmitAndFinish", [&]
+        {
+            frame();
+            gl.Finish();
+        }, DrawCount);
+
+        // Every redundant call the tracker skipped above relied on its shadow state.
+        if (!state.Validate())
+            context.Fail("the state tracker's shadow state differs from the driver's");
+    }
+}
+
+// Creating the mesh renderer, which is mostly compiling and linking its program: without a program
+// cache, with an empty one that compiles and stores the binary, and with the binary on disk. Mesa keeps
+// its own shader cache, run with MESA_SHADER_CACHE_DISABLE=true to see the cost of compiling.
+ENGINE_BENCHMARK(GLProgramCache)
+{
+    OffscreenGL offscreen(context);
+    if (offscreen.GetDevice() == nullptr)
+        return;
+
+    const Graphics::GLDevice& device = *offscreen.GetDevice();
+    Graphics::GLStateTracker state(device.GetFunctions());
+    Benchmarks::ScratchDirectory scratch("GLProgramCache");
+    Graphics::GLProgramCache coldCache(device, scratch.GetPath());
+    Graphics::GLProgramCache warmCache(device, scratch.GetPath());
+
+    bool valid = true;
+    auto createRenderer = [&](Graphics::GLProgramCache* programCache)
+    {
+        Graphics::GLMeshRenderer renderer(state, 1, 1, 1, 1, programCache);
+        valid = valid && renderer.IsValid();
+    };
+
+    // Of the programs a cache created, those loaded from a binary instead of compiled.
+    auto getLoadedShare = [](const Graphics::GLProgramCacheStats& stats)
+    {
+        return stats.loaded / std::max(1.0, static_cast<double>(stats.loaded + stats.compiled));
+    };
+
+    context.Measure("NoCache", [&] { createRenderer(nullptr); });
+
+    // Emptying the directory is part of the measurement, it's small next to compiling.
+    if (context.Measure("ColdCache", [&]
+    {
+        scratch.Clear();
+        createRenderer(&coldCache);
+    }) != nullptr)
+        context.SetCounter("loaded share", getLoadedShare(coldCache.GetStats()));
+
+    // Stores the binary in case `ColdCache` was filtered out.
+    createRenderer(&coldCache);
+    if (context.Measure("WarmCache", [&] { createRenderer(&warmCache); }) != nullptr)
+        context.SetCounter("loaded share", getLoadedShare(warmCache.GetStats()));
+
+    if (!valid)
+        context.Fail("couldn't create the mesh renderer");
+}
@@ -0,0 +1,273 @@
+#include <Engine/Benchmarks/Benchmark.hpp>
+#include <Engine/Core/CpuDispatch.hpp>
+#include <Engine/Core/PixelConversion.hpp>
+
+#include <SDL2/SDL_pixels.h>
+#include <SDL2/SDL_surface.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace Engine;
+
+namespace
+{
+    constexpr int Width4K = 3840;
+    constexpr int Height4K = 2160;
+    constexpr std::size_t Pixels4K = static_cast<std::size_t>(Width4K) * Height4K;
+
+    constexpr Core::CpuLevel AllLevels[] = { Core::CpuLevel::Scalar, Core::CpuLevel::NEON, Core::CpuLevel::SSE2, Core::CpuLevel::AVX2, Core::CpuLevel::AVX512F };
+
+    std::vector<std::uint32_t> MakeRandomPixels(std::size_t count, std::uint32_t seed)
+    {
+        std::vector<std::uint32_t> pixels(count);
+        std::uint32_t state = seed;
+        for (std::uint32_t& pixel : pixels)
+        {
+            state = state * 1664525u + 1013904223u;
+            pixel = state ^ (state >> 15);
+        }
+
+        // Fully transparent and opaque pixels are the common special cases.
+        for (std::size_t i = 0; i < count; i += 7)
+            pixels[i] |= 0xFF000000u;
+        for (std::size_t i = 3; i < count; i += 11)
+            pixels[i] &= 0x00FFFFFFu;
+
+        return pixels;
+    }
+
+    // Restores the CPU level limit when leaving the scope.
+    class CpuLevelLimitScope
+    {
+    public:
+        CpuLevelLimitScope() : previous(Core::GetCpuLevelLimit()) {}
+        ~CpuLevelLimitScope() { Core::SetCpuLevelLimit(previous); }
+
+        CpuLevelLimitScope(const CpuLevelLimitScope&) = delete;
+        CpuLevelLimitScope& operator=(const CpuLevelLimitScope&) = delete;
+
+        // Returns false if the CPU lacks `level` or the pixel kernels have no variant for it.
+        bool Select(Core::CpuLevel level)
+        {
+            if (!Core::IsCpuLevelSupported(level))
+                return false;
+
+            Core::SetCpuLevelLimit(level);
+            return Core::GetPixelKernelLevel() == level;
+        }
+
+    private:
+        Core::CpuLevel previous;
+    };
+
+    int GetMaxByteError(const void* a, const void* b, std::size_t bytes)
+    {
+        const std::uint8_t* x = static_cast<const std::uint8_t*>(a);
+        const std::uint8_t* y = static_cast<const std::uint8_t*>(b);
+
+        int error = 0;
+        for (std::size_t i = 0; i < bytes; ++i)
+            error = std::max(error, std::abs(x[i] - y[i]));
+
+        return error;
+    }
+
+    // The piecewise sRGB transfer function of IEC 61966-2-1, from encoded to linear in [0, 1].
+    double DecodeSRGB(double value)
+    {
+        return value <= 0.04045 ? value / 12.92 : std::pow((value + 0.055) / 1.055, 2.4);
+    }
+
+    // Per channel, in units of the 5 and 6 bit channels.
+    int GetMaxRGB565Error(const std::vector<std::uint16_t>& a, const std::vector<std::uint16_t>& b)
+    {
+        int error = 0;
+        for (std::size_t i = 0; i < a.size(); ++i)
+        {
+            error = std::max(error, std::abs((a[i] >> 11) - (b[i] >> 11)));
+            error = std::max(error, std::abs(((a[i] >> 5) & 63) - ((b[i] >> 5) & 63)));
+            error = std::max(error, std::abs((a[i] & 31) - (b[i] & 31)));
+        }
+
+        return error;
+    }
+}
+
+// Every kernel over a 4K frame with the level selected at startup, next to SDL's generic paths.
+ENGINE_BENCHMARK(PixelConversion4K)
+{
+    std::vector<std::uint32_t> source = MakeRandomPixels(Pixels4K, 1);
+    std::vector<std::uint32_t> destination = MakeRandomPixels(Pixels4K, 2);
+    std::vector<std::uint16_t> rgb565(Pixels4K);
+    std::vector<float> linear(Pixels4K * 4);
+    Core::ConvertRGBAToRGB565(source.data(), rgb565.data(), Pixels4K);
+    Core::ConvertSRGBToLinear(source.data(), linear.data(), Pixels4K);
+
+    auto measure = [&context](const char* variant, auto&& body)
+    {
+        if (const Benchmarks::BenchmarkResult* result = context.Measure(variant, body, static_cast<double>(Pixels4K)))
+            context.SetCounter("fps", 1e9 / result->median);
+    };
+
+    measure("SwapRedBlue", [&] { Core::SwapRedBlue(source.data(), destination.data(), Pixels4K); });
+    measure("RGBAToRGB565", [&] { Core::ConvertRGBAToRGB565(source.data(), rgb565.data(), Pixels4K); });
+    measure("RGB565ToRGBA", [&] { Core::ConvertRGB565ToRGBA(rgb565.data(), destination.data(), Pixels4K); });
+    measure("SRGBToLinear", [&] { Core::ConvertSRGBToLinear(source.data(), linear.data(), Pixels4K); });
+    measure("LinearToSRGB", [&] { Core::ConvertLinearToSRGB(linear.data(), destination.data(), Pixels4K); });
+    measure("PremultiplyAlpha", [&] { Core::PremultiplyAlpha(source.data(), destination.data(), Pixels4K); });
+    measure("BlendAlpha", [&] { Core::BlendAlpha(source.data(), destination.data(), Pixels4K); });
+
+    measure("SDL_ConvertPixels", [&]
+    {
+        SDL_ConvertPixels(Width4K, Height4K, SDL_PIXELFORMAT_RGBA32, source.data(), Width4K * 4,
+                          SDL_PIXELFORMAT_BGRA32, destination.data(), Width4K * 4);
+    });
+    measure("SDL_PremultiplyAlpha", [&]
+    {
+        SDL_PremultiplyAlpha(Width4K, Height4K, SDL_PIXELFORMAT_BGRA32, source.data(), Width4K * 4,
+                             SDL_PIXELFORMAT_BGRA32, destination.data(), Width4K * 4);
+    });
+}
+
+// Compares every kernel at every level the CPU supports with SDL, allowing rounding differences of 1,
+// and the sRGB kernels, which SDL doesn't have, with the sRGB transfer function.
+ENGINE_BENCHMARK(PixelConversionCorrectness)
+{
+    constexpr int Width = 1031;
+    constexpr int Height = 17;
+    constexpr std::size_t Pixels = static_cast<std::size_t>(Width) * Height;
+
+    std::vector<std::uint32_t> source = MakeRandomPixels(Pixels, 3);
+    std::vector<std::uint32_t> background = MakeRandomPixels(Pixels, 4);
+
+    // SDL's results, the same for every level.
+    std::vector<std::uint32_t> sdlSwapped(Pixels);
+    std::vector<std::uint16_t> sdlFromRGBA(Pixels);
+    std::vector<std::uint16_t> sdlFromBGRA(Pixels);
+    std::vector<std::uint32_t> sdlToRGBA(Pixels);
+    std::vector<std::uint32_t> sdlToBGRA(Pixels);
+    std::vector<std::uint32_t> sdlPremultiplied(Pixels);
+    std::vector<std::uint32_t> sdlBlended = background;
+
+    SDL_ConvertPixels(Width, Height, SDL_PIXELFORMAT_RGBA32, source.data(), Width * 4, SDL_PIXELFORMAT_BGRA32, sdlSwapped.data(), Width * 4);
+    SDL_ConvertPixels(Width, Height, SDL_PIXELFORMAT_RGBA32, source.data(), Width * 4, SDL_PIXELFORMAT_RGB565, sdlFromRGBA.data(), Width * 2);
+    SDL_ConvertPixels(Width, Height, SDL_PIXELFORMAT_BGRA32, source.data(), Width * 4, SDL_PIXELFORMAT_RGB565, sdlFromBGRA.data(), Width * 2);
+    SDL_ConvertPixels(Width, Height, SDL_PIXELFORMAT_RGB565, sdlFromRGBA.data(), Width * 2, SDL_PIXELFORMAT_RGBA32, sdlToRGBA.data(), Width * 4);
+    SDL_ConvertPixels(Width, Height, SDL_PIXELFORMAT_RGB565, sdlFromRGBA.data(), Width * 2, SDL_PIXELFORMAT_BGRA32, sdlToBGRA.data(), Width * 4);
+    SDL_PremultiplyAlpha(Width, Height, SDL_PIXELFORMAT_BGRA32, source.data(), Width * 4, SDL_PIXELFORMAT_BGRA32, sdlPremultiplied.data(), Width * 4);
+
+    SDL_Surface* sourceSurface = SDL_CreateRGBSurfaceWithFormatFrom(source.data(), Width, Height, 32, Width * 4, SDL_PIXELFORMAT_RGBA32);
+    SDL_Surface* blendSurface = SDL_CreateRGBSurfaceWithFormatFrom(sdlBlended.data(), Width, Height, 32, Width * 4, SDL_PIXELFORMAT_RGBA32);
+    bool blended = sourceSurface != nullptr && blendSurface != nullptr &&
+                   SDL_SetSurfaceBlendMode(sourceSurface, SDL_BLENDMODE_BLEND) == 0 && SDL_BlitSurface(sourceSurface, nullptr, blendSurface, nullptr) == 0;
+    SDL_FreeSurface(sourceSurface);
+    SDL_FreeSurface(blendSurface);
+    if (!blended)
+    {
+        context.Skip("SDL couldn't blend the reference surfaces");
+        return;
+    }
+
+    // The sRGB kernels have no SDL equivalent. Decoding is checked against the transfer function, and
+    // encoding by round-tripping every byte value, which has to be exact.
+    std::vector<double> referenceLinear(Pixels * 4);
+    const std::uint8_t* sourceBytes = reinterpret_cast<const std::uint8_t*>(source.data());
+    for (std::size_t i = 0; i < referenceLinear.size(); ++i)
+        referenceLinear[i] = i % 4 == 3 ? sourceBytes[i] / 255.0 : DecodeSRGB(sourceBytes[i] / 255.0);
+
+    std::vector<std::uint32_t> allBytes(256 / 4);
+    for (std::size_t i = 0; i < 256; ++i)
+        reinterpret_cast<std::uint8_t*>(allBytes.data())[i] = static_cast<std::uint8_t>(i);
+    std::vector<float> allBytesLinear(256);
+    std::vector<std::uint32_t> allBytesEncoded(256 / 4);
+
+    std::vector<std::uint32_t> swapped(Pixels);
+    std::vector<std::uint16_t> fromRGBA(Pixels);
+    std::vector<std::uint16_t> fromBGRA(Pixels);
+    std::vector<std::uint32_t> toRGBA(Pixels);
+    std::vector<std::uint32_t> toBGRA(Pixels);
+    std::vector<std::uint32_t> premultiplied(Pixels);
+    std::vector<std::uint32_t> blendedPixels(Pixels);
+    std::vector<float> linear(Pixels * 4);
+    std::vector<std::uint32_t> encoded(Pixels);
+
+    std::vector<std::pair<std::string, int>> maxErrors;
+    auto check = [&](const std::string& kernel, Core::CpuLevel level, int error, int tolerance = 1)
+    {
+        auto it = std::find_if(maxErrors.begin(), maxErrors.end(), [&kernel](const auto& entry) { return entry.first == kernel; });
+        if (it == maxErrors.end())
+            maxErrors.emplace_back(kernel, error);
+        else
+            it->second = std::max(it->second, error);
+
+        if (error > tolerance)
+            context.Fail(kernel + " at " + Core::GetCpuLevelName(level) + " is off by " + std::to_string(error));
+    };
+
+    CpuLevelLimitScope scope;
+    for (Core::CpuLevel level : AllLevels)
+    {
+        if (!scope.Select(level))
+            continue;
+
+        Core::SwapRedBlue(source.data(), swapped.data(), Pixels);
+        Core::ConvertRGBAToRGB565(source.data(), fromRGBA.data(), Pixels);
+        Core::ConvertBGRAToRGB565(source.data(), fromBGRA.data(), Pixels);
+        Core::ConvertRGB565ToRGBA(sdlFromRGBA.data(), toRGBA.data(), Pixels);
+        Core::ConvertRGB565ToBGRA(sdlFromRGBA.data(), toBGRA.data(), Pixels);
+        Core::PremultiplyAlpha(source.data(), premultiplied.data(), Pixels);
+        blendedPixels = background;
+        Core::BlendAlpha(source.data(), blendedPixels.data(), Pixels);
+        Core::ConvertSRGBToLinear(source.data(), linear.data(), Pixels);
+        Core::ConvertLinearToSRGB(linear.data(), encoded.data(), Pixels);
+        Core::ConvertSRGBToLinear(allBytes.data(), allBytesLinear.data(), allBytes.size());
+        Core::ConvertLinearToSRGB(allBytesLinear.data(), allBytesEncoded.data(), allBytes.size());
+
+        check("SwapRedBlue", level, GetMaxByteError(swapped.data(), sdlSwapped.data(), Pixels * 4));
+        check("RGBAToRGB565", level, GetMaxRGB565Error(fromRGBA, sdlFromRGBA));
+        check("BGRAToRGB565", level, GetMaxRGB565Error(fromBGRA, sdlFromBGRA));
+        check("RGB565ToRGBA", level, GetMaxByteError(toRGBA.data(), sdlToRGBA.data(), Pixels * 4));
+        check("RGB565ToBGRA", level, GetMaxByteError(toBGRA.data(), sdlToBGRA.data(), Pixels * 4));
+        check("PremultiplyAlpha", level, GetMaxByteError(premultiplied.data(), sdlPremultiplied.data(), Pixels * 4));
+        check("BlendAlpha", level, GetMaxByteError(blendedPixels.data(), sdlBlended.data(), Pixels * 4));
+
+        // In 16-bit steps, float precision is well within one.
+        double linearError = 0.0;
+        for (std::size_t i = 0; i < linear.size(); ++i)
+            linearError = std::max(linearError, std::abs(linear[i] - referenceLinear[i]));
+        check("SRGBToLinear", level, static_cast<int>(linearError * 65535.0));
+        int roundTripError = std::max(GetMaxByteError(encoded.data(), source.data(), Pixels * 4), GetMaxByteError(allBytesEncoded.data(), allBytes.data(), 256));
+        check("LinearToSRGB", level, roundTripError, 0);
+    }
+
+    for (const auto& [kernel, error] : maxErrors)
+        context.SetCounter(kernel + " max error", error);
+}
+
+// The kernels at every level this CPU supports, by lowering the CPU level limit.
+ENGINE_BENCHMARK(PixelKernelLevels)
+{
+    constexpr std::size_t Pixels = 1920 * 1080;
+
+    std::vector<std::uint32_t> source = MakeRandomPixels(Pixels, 5);
+    std::vector<std::uint32_t> destination = MakeRandomPixels(Pixels, 6);
+    std::vector<std::uint16_t> rgb565(Pixels);
+
+    // sRGB conversions are table based and not dispatched, `PixelConversion4K` times them once.
+    CpuLevelLimitScope scope;
+    for (Core::CpuLevel level : AllLevels)
+    {
+        if (!scope.Select(level))
+            continue;
+
+        std::string suffix = std::string("/") + Core::GetCpuLevelName(level);
+        context.Measure("SwapRedBlue" + suffix, [&] { Core::SwapRedBlue(source.data(), destination.data(), Pixels); }, Pixels);
+        context.Measure("RGBAToRGB565" + suffix, [&] { Core::ConvertRGBAToRGB565(source.data(), rgb565.data(), Pixels); }, Pixels);
+        context.Measure("PremultiplyAlpha" + suffix, [&] { Core::PremultiplyAlpha(source.data(), destination.data(), Pixels); }, Pixels);
+        context.Measure("BlendAlpha" + suffix, [&] { Core::BlendAlpha(source.data(), destination.data(), Pixels); }, Pixels);
+    }
+}
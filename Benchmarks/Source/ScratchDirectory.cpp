@@ -0,0 +1,23 @@
+#include <Engine/Benchmarks/ScratchDirectory.hpp>
+
+namespace Engine::Benchmarks
+{
+    ScratchDirectory::ScratchDirectory(const char* name)
+        : path(std::filesystem::temp_directory_path() / "EngineBenchmarks" / name)
+    {
+        Clear();
+    }
+
+    ScratchDirectory::~ScratchDirectory()
+    {
+        std::error_code error;
+        std::filesystem::remove_all(path, error);
+    }
+
+    void ScratchDirectory::Clear()
+    {
+        std::error_code error;
+        std::filesystem::remove_all(path, error);
+        std::filesystem::create_directories(path, error);
+    }
+}
@@ -0,0 +1,111 @@
+#include <Engine/Benchmarks/Benchmark.hpp>
+#include <Engine/Graphics/SpriteBatcher.hpp>
+
+#include <SDL2/SDL.h>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace Engine;
+
+namespace
+{
+    struct SurfaceDeleter
+    {
+        void operator()(SDL_Surface* surface) const { SDL_FreeSurface(surface); }
+    };
+
+    struct RendererDeleter
+    {
+        void operator()(SDL_Renderer* renderer) const { SDL_DestroyRenderer(renderer); }
+    };
+
+    struct TextureDeleter
+    {
+        void operator()(SDL_Texture* texture) const { SDL_DestroyTexture(texture); }
+    };
+}
+
+// 100k small sprites over 4 textures into a 1080p surface with the software renderer, batched versus
+// one SDL_RenderCopyExF per sprite. The dummy video driver keeps it headless and comparable across machines.
+ENGINE_BENCHMARK(Sprites)
+{
+    constexpr int ScreenWidth = 1920;
+    constexpr int ScreenHeight = 1080;
+    constexpr std::size_t SpriteCount = 100000;
+    constexpr std::size_t TextureCount = 4;
+
+    // Picked explicitly rather than through SDL_VIDEODRIVER, which the OpenGL benchmarks need for a real driver.
+    if (SDL_VideoInit("dummy") != 0)
+    {
+        context.Skip(std::string("couldn't initialize the dummy video driver: ") + SDL_GetError());
+        return;
+    }
+
+    // Scoped so everything is destroyed before the video subsystem goes.
+    {
+        std::unique_ptr<SDL_Surface, SurfaceDeleter> target(SDL_CreateRGBSurfaceWithFormat(0, ScreenWidth, ScreenHeight, 32, SDL_PIXELFORMAT_ARGB8888));
+        std::unique_ptr<SDL_Renderer, RendererDeleter> renderer(target ? SDL_CreateSoftwareRenderer(target.get()) : nullptr);
+        std::vector<std::unique_ptr<SDL_Texture, TextureDeleter>> textures;
+        for (std::size_t i = 0; renderer && i < TextureCount; ++i)
+        {
+            std::unique_ptr<SDL_Surface, SurfaceDeleter> image(SDL_CreateRGBSurfaceWithFormat(0, 16, 16, 32, SDL_PIXELFORMAT_ARGB8888));
+            if (!image)
+                break;
+
+            SDL_FillRect(image.get(), nullptr, 0xFF000000u | (0x3F5FFFu << (i * 2)));
+            textures.emplace_back(SDL_CreateTextureFromSurface(renderer.get(), image.get()));
+            if (!textures.back())
+                break;
+        }
+
+        if (!renderer || textures.size() != TextureCount || !textures.back())
+        {
+            context.Skip(std::string("couldn't create the software renderer: ") + SDL_GetError());
+            SDL_VideoQuit();
+            return;
+        }
+
+        std::vector<Graphics::Sprite> sprites(SpriteCount);
+        for (std::size_t i = 0; i < SpriteCount; ++i)
+        {
+            Graphics::Sprite& sprite = sprites[i];
+            sprite.texture = textures[i % TextureCount].get();
+            sprite.destination = { static_cast<float>(i * 37 % ScreenWidth), static_cast<float>(i * 53 % ScreenHeight), 8.0f, 8.0f };
+            sprite.color = { static_cast<Uint8>(i), static_cast<Uint8>(i >> 3), 200, 255 };
+            sprite.rotation = i % 8 == 0 ? static_cast<float>(i) * 0.01f : 0.0f;
+        }
+
+        Graphics::SpriteBatcher batcher(renderer.get());
+        bool failed = false;
+        if (context.Measure("SpriteBatcher", [&]
+        {
+            batcher.Begin();
+            for (const Graphics::Sprite& sprite : sprites)
+                batcher.Draw(sprite);
+            failed = !batcher.End() || failed;
+            SDL_RenderFlush(renderer.get());
+        }, SpriteCount) != nullptr)
+            context.SetCounter("batches", batcher.GetStats().batches);
+
+        // What drawing the sprites one by one costs, with the same per-sprite color and rotation.
+        context.Measure("RenderCopy", [&]
+        {
+            for (const Graphics::Sprite& sprite : sprites)
+            {
+                SDL_SetTextureColorMod(sprite.texture, sprite.color.r, sprite.color.g, sprite.color.b);
+                SDL_SetTextureAlphaMod(sprite.texture, sprite.color.a);
+                failed = SDL_RenderCopyExF(renderer.get(), sprite.texture, nullptr, &sprite.destination,
+                                           sprite.rotation * 180.0 / 3.14159265358979, nullptr, SDL_FLIP_NONE) != 0 || failed;
+            }
+            SDL_RenderFlush(renderer.get());
+        }, SpriteCount);
+
+        if (failed)
+            context.Fail(std::string("SDL reported an error: ") + SDL_GetError());
+    }
+
+    SDL_VideoQuit();
+}
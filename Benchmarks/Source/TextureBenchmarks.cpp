@@ -0,0 +1,145 @@
+#include <Engine/Benchmarks/Benchmark.hpp>
+#include <Engine/Core/Math.hpp>
+#include <Engine/Graphics/AtlasPacker.hpp>
+#include <Engine/Graphics/TextureStreamer.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using namespace Engine;
+
+namespace
+{
+    constexpr float Pi = 3.14159265358979f;
+
+    // Same mix as the AtlasPacker tool's sample corpus: glyphs, icons and UI panels.
+    std::vector<Graphics::AtlasImageSize> GenerateAtlasCorpus(std::uint32_t count)
+    {
+        std::uint32_t state = 12345;
+        auto next = [&state](std::uint32_t low, std::uint32_t high)
+        {
+            state = state * 1664525u + 1013904223u;
+            return low + (state >> 8) % (high - low + 1);
+        };
+
+        std::vector<Graphics::AtlasImageSize> sizes(count);
+        for (Graphics::AtlasImageSize& size : sizes)
+        {
+            std::uint32_t kind = next(0, 9);
+            if (kind < 6)
+                size = { next(6, 32), next(12, 36) };
+            else if (kind < 9)
+                size = { next(16, 64), next(16, 64) };
+            else
+                size = { next(64, 256), next(32, 128) };
+        }
+
+        return sizes;
+    }
+}
+
+// A level's worth of 1024x1024 textures on objects scattered over a square kilometer, seen from
+// a camera circling through it. Stream ins complete immediately, this is the streamer's own cost.
+ENGINE_BENCHMARK(TextureStreaming)
+{
+    constexpr std::uint32_t TextureCount = 2048;
+    constexpr std::size_t MemoryBudget = 256 * 1024 * 1024;
+    constexpr std::size_t UploadBudget = 8 * 1024 * 1024;
+    constexpr float VerticalFov = Pi / 3.0f;
+    constexpr float ScreenHeight = 1080.0f;
+    constexpr float WorldSize = 1000.0f;
+    constexpr int FrameCount = 1200;
+
+    Graphics::TextureStreamer streamer(MemoryBudget, UploadBudget,
+                                       [](Graphics::StreamedTextureId, std::uint32_t) { return true; },
+                                       [](Graphics::StreamedTextureId, std::uint32_t) {});
+
+    std::vector<Graphics::StreamedTextureId> textures;
+    std::vector<Core::Vector3> centers;
+    std::vector<float> radii;
+    std::uint32_t state = 12345;
+    auto next = [&state]
+    {
+        state = state * 1664525u + 1013904223u;
+        return static_cast<float>(state >> 8) / static_cast<float>(1u << 24);
+    };
+
+    for (std::uint32_t i = 0; i < TextureCount; ++i)
+    {
+        Graphics::StreamedTextureDesc desc;
+        desc.width = 1024;
+        desc.height = 1024;
+        desc.mipCount = 11;
+        textures.push_back(streamer.AddTexture(desc));
+        centers.emplace_back((next() - 0.5f) * WorldSize, 0.0f, (next() - 0.5f) * WorldSize);
+        radii.push_back(1.0f + next() * 4.0f);
+    }
+
+    int frame = 0;
+    double underResolved = 0.0;
+    double streamedIn = 0.0;
+    double residentRatio = 0.0;
+    std::size_t frames = 0;
+
+    // Objects behind the camera aren't requested, which makes turning around stream in and out.
+    context.Measure("Frame", [&]
+    {
+        float time = static_cast<float>(frame++ % FrameCount) / static_cast<float>(FrameCount) * 2.0f * Pi;
+        Core::Vector3 eye(std::cos(time) * WorldSize * 0.3f, 2.0f, std::sin(time) * WorldSize * 0.3f);
+        Core::Vector3 forward(-std::sin(time), 0.0f, std::cos(time));
+
+        for (std::uint32_t i = 0; i < TextureCount; ++i)
+        {
+            Core::Vector3 offset = centers[i] - eye;
+            if (Core::Dot(offset, forward) < -radii[i])
+                continue;
+
+            streamer.Request(textures[i], Graphics::ComputeProjectedSize(radii[i], Core::Length(offset), VerticalFov, ScreenHeight));
+        }
+
+        streamer.Update();
+
+        const Graphics::TextureStreamingStats& stats = streamer.GetStats();
+        underResolved += static_cast<double>(stats.texturesBelowRequest);
+        streamedIn += static_cast<double>(stats.streamedInBytes);
+        residentRatio += static_cast<double>(stats.residentBytes) / static_cast<double>(stats.fullyResidentBytes);
+        ++frames;
+    }, TextureCount);
+
+    if (frames > 0)
+    {
+        context.SetCounter("textures below request", underResolved / static_cast<double>(frames));
+        context.SetCounter("MB streamed in/frame", streamedIn / static_cast<double>(frames) / (1024.0 * 1024.0));
+        context.SetCounter("resident ratio", residentRatio / static_cast<double>(frames));
+    }
+}
+
+ENGINE_BENCHMARK(AtlasPacking)
+{
+    std::vector<Graphics::AtlasImageSize> images = GenerateAtlasCorpus(1000);
+
+    auto measure = [&](const char* variant, const Graphics::AtlasPackOptions& options)
+    {
+        Graphics::AtlasPackResult result;
+        bool packed = true;
+        const Benchmarks::BenchmarkResult* measured = context.Measure(variant, [&] { packed = Graphics::PackAtlas(images, options, result); }, static_cast<double>(images.size()));
+        if (measured == nullptr)
+            return;
+
+        if (!packed)
+        {
+            context.Fail("an image didn't fit on an empty page");
+            return;
+        }
+
+        context.SetCounter("efficiency", result.GetEfficiency());
+        context.SetCounter("pages", static_cast<double>(result.pages.size()));
+    };
+
+    Graphics::AtlasPackOptions options;
+    measure("Rotation", options);
+
+    options.allowRotation = false;
+    measure("NoRotation", options);
+}
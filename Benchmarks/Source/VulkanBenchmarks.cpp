@@ -0,0 +1,87 @@
+#include <Engine/Benchmarks/Benchmark.hpp>
+#include <Engine/Graphics/Vulkan/VKDevice.hpp>
+#include <Engine/Graphics/Vulkan/VKFrameScheduler.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+
+using namespace Engine;
+
+// CPU cost of recording and submitting a frame of 64 command buffers, each with 256 uniform
+// allocations and commands, on one worker versus all of them. Needs a headless Vulkan 1.2 device
+// with timeline semaphores and is skipped without one. Not yet run on a software device like lavapipe.
+ENGINE_BENCHMARK(VulkanSubmission)
+{
+    constexpr std::uint32_t TaskCount = 64;
+    constexpr std::uint32_t CommandsPerTask = 256;
+    constexpr std::size_t UniformSize = 256;
+
+    std::unique_ptr<Graphics::VKDevice> device = Graphics::VKDevice::Create(nullptr);
+    if (device == nullptr)
+    {
+        context.Skip("no Vulkan device");
+        return;
+    }
+
+    const Graphics::VKFunctions& vk = device->GetFunctions();
+    std::atomic<bool> outOfUniforms = false;
+
+    // A memory barrier stands in for a draw: no pipeline needed, and the driver still has to record it.
+    auto record = [&](Graphics::VKRecordContext& recordContext, std::uint32_t task)
+    {
+        VkMemoryBarrier barrier = {};
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_UNIFORM_READ_BIT;
+
+        for (std::uint32_t i = 0; i < CommandsPerTask; ++i)
+        {
+            Graphics::VKUniformAllocation uniforms = recordContext.AllocateUniforms(UniformSize);
+            if (uniforms.data == nullptr)
+            {
+                outOfUniforms = true;
+                continue;
+            }
+
+            std::memset(uniforms.data, static_cast<int>(task + i), UniformSize);
+            vk.vkCmdPipelineBarrier(recordContext.GetCommandBuffer(), VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                    VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+        }
+    };
+
+    auto measure = [&](const char* variant, std::uint32_t workerCount)
+    {
+        Graphics::VKFrameScheduler scheduler(*device, workerCount, 2, TaskCount * CommandsPerTask * UniformSize * 2);
+        std::uint64_t recordNanoseconds = 0;
+        std::uint64_t submitNanoseconds = 0;
+        std::uint64_t frames = 0;
+
+        const Benchmarks::BenchmarkResult* result = context.Measure(variant, [&]
+        {
+            scheduler.BeginFrame();
+            scheduler.Record(TaskCount, record);
+            scheduler.Submit();
+
+            recordNanoseconds += scheduler.GetStats().recordNanoseconds;
+            submitNanoseconds += scheduler.GetStats().submitNanoseconds;
+            ++frames;
+        }, TaskCount * CommandsPerTask);
+
+        scheduler.WaitIdle();
+        if (result == nullptr || frames == 0)
+            return;
+
+        context.SetCounter("workers", scheduler.GetWorkerCount());
+        context.SetCounter("record us", static_cast<double>(recordNanoseconds) / static_cast<double>(frames) / 1e3);
+        context.SetCounter("submit us", static_cast<double>(submitNanoseconds) / static_cast<double>(frames) / 1e3);
+    };
+
+    measure("OneWorker", 1);
+    measure("AllWorkers", 0);
+
+    if (outOfUniforms)
+        context.Fail("the uniform ring ran out of space");
+}
@@ -0,0 +1,18 @@
+#ifndef ENGINE_CORE_ATOMIC_FILE_INCLUDED
+#define ENGINE_CORE_ATOMIC_FILE_INCLUDED
+
+#include <cstddef>
+#include <functional>
+#include <ostream>
+#include <string>
+
+namespace Engine::Core
+{
+    // Write `path` through `write` into "<path>.tmp", then rename it over `path`, which replaces an
+    // existing file atomically: a crash never leaves a truncated file behind. Returns false and removes
+    // the temporary file if a write or the rename failed.
+    bool WriteFileAtomically(const std::string& path, const std::function<void(std::ostream& file)>& write);
+    bool WriteFileAtomically(const std::string& path, const void* data, std::size_t size);
+}
+
+#endif
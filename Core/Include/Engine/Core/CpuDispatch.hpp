@@ -0,0 +1,110 @@
+#ifndef ENGINE_CORE_CPU_DISPATCH_INCLUDED
+#define ENGINE_CORE_CPU_DISPATCH_INCLUDED
+
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+// Compiles a function for an instruction set beyond the build's baseline. Such functions may only be
+// called through a dispatch table that checked the level first.
+#if defined(__GNUC__)
+#define ENGINE_CORE_TARGET(isa) __attribute__((target(isa)))
+#else
+#define ENGINE_CORE_TARGET(isa)
+#endif
+
+namespace Engine::Core
+{
+    // Instruction sets kernels are compiled for. NEON and SSE2 are the same tier on their architectures.
+    enum class CpuLevel : std::uint8_t
+    {
+        Scalar,
+        NEON,
+        SSE2,
+        AVX2,
+        AVX512F,
+    };
+
+    const char* GetCpuLevelName(CpuLevel level);
+
+    // Whether this CPU and OS run `level`, from `SDL_cpuinfo.h`. `Scalar` is always supported.
+    bool IsCpuLevelSupported(CpuLevel level);
+    // Supported and not above the limit.
+    bool IsCpuLevelEnabled(CpuLevel level);
+
+    // Highest level tables may select. Starts at the `ENGINE_CPU_LEVEL` environment variable, a level
+    // name like "sse2", or `AVX512F` without it.
+    CpuLevel GetCpuLevelLimit();
+    // Reselects every table. Only call while no dispatched kernels run, it is meant for comparing levels.
+    void SetCpuLevelLimit(CpuLevel limit);
+
+    // Print the supported levels and the level each table selected.
+    void ReportCpuDispatch();
+
+    // Base of `CpuDispatch`, linking every table into the report. Tables must have static storage duration.
+    class CpuDispatchTable
+    {
+    public:
+        CpuDispatchTable(const CpuDispatchTable&) = delete;
+        CpuDispatchTable& operator=(const CpuDispatchTable&) = delete;
+
+        const char* GetName() const { return name; }
+        CpuLevel GetLevel() const { return level; }
+
+    protected:
+        explicit CpuDispatchTable(const char* name);
+        ~CpuDispatchTable() = default;
+
+        virtual void Select() = 0;
+
+        CpuLevel level = CpuLevel::Scalar;
+
+    private:
+        friend void SetCpuLevelLimit(CpuLevel limit);
+        friend void ReportCpuDispatch();
+
+        const char* name;
+        CpuDispatchTable* next = nullptr;
+    };
+
+    // A struct of function pointers per compiled level, resolved once at static initialization so calls
+    // cost one indirection.
+    template<typename Kernels>
+    class CpuDispatch final : public CpuDispatchTable
+    {
+    public:
+        struct Variant
+        {
+            CpuLevel level;
+            const Kernels* kernels;
+        };
+
+        // `variants` are ordered best first and end with a `Scalar` one.
+        CpuDispatch(const char* name, std::initializer_list<Variant> variants) : CpuDispatchTable(name), variants(variants)
+        {
+            Select();
+        }
+
+        const Kernels& operator*() const { return *kernels; }
+        const Kernels* operator->() const { return kernels; }
+
+    private:
+        void Select() override
+        {
+            for (const Variant& variant : variants)
+            {
+                if (IsCpuLevelEnabled(variant.level))
+                {
+                    level = variant.level;
+                    kernels = variant.kernels;
+                    return;
+                }
+            }
+        }
+
+        std::vector<Variant> variants;
+        const Kernels* kernels = nullptr;
+    };
+}
+
+#endif
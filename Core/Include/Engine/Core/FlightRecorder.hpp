@@ -0,0 +1,183 @@
+#ifndef ENGINE_CORE_FLIGHT_RECORDER_INCLUDED
+#define ENGINE_CORE_FLIGHT_RECORDER_INCLUDED
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Engine::Core
+{
+    struct FlightRecorderOptions
+    {
+        // History a dump covers.
+        double windowSeconds = 10.0;
+        // Frames longer than this dump the history, 0 to never dump automatically.
+        double frameBudgetMilliseconds = 50.0;
+        // Events kept per thread, rounded up to a power of two. Older ones are overwritten, so this
+        // bounds the window on threads recording many events.
+        std::size_t eventsPerThread = 1 << 16;
+        // A run of slow frames, like a level load, dumps once.
+        double minSecondsBetweenDumps = 10.0;
+        std::size_t maxDumps = 16;
+        // `Hitches` next to the executable if empty.
+        std::string directory;
+    };
+
+    struct FlightRecorderStats
+    {
+        std::uint64_t frames = 0;
+        std::uint64_t events = 0;
+        // Frames over budget, dumped or not.
+        std::uint64_t hitches = 0;
+        std::uint64_t dumps = 0;
+        double slowestFrameMilliseconds = 0.0;
+    };
+
+    // Always-on history of scope timings, counters and frames in a ring buffer per thread. Frames over
+    // the budget write the last seconds as a Chrome trace (chrome://tracing, Perfetto) on a background
+    // thread, so hitches that don't reproduce under a profiler still leave something to look at.
+    // Recording an event is a clock read and a few stores, no locks or allocations.
+    class FlightRecorder
+    {
+    public:
+        explicit FlightRecorder(FlightRecorderOptions options = FlightRecorderOptions());
+        // Waits for dumps still being written.
+        ~FlightRecorder();
+
+        FlightRecorder(const FlightRecorder&) = delete;
+        FlightRecorder& operator=(const FlightRecorder&) = delete;
+
+        // `name` must outlive the recorder, usually a string literal. Timestamps are from
+        // `GetFlightTimestamp`. Thread-safe.
+        void RecordScope(const char* name, std::uint64_t start, std::uint64_t end);
+        void RecordCounter(const char* name, std::int64_t value);
+
+        // Ends the frame that started at the previous call, and records the SDL event queue depth and
+        // the allocations of the frame.
+        // Returns true if the frame was over budget. Called by the thread running the frame loop.
+        bool EndFrame();
+
+        // Write the history now, for example on a bug report. Returns the path the trace goes to.
+        std::string Dump(const std::string& reason);
+
+        FlightRecorderStats GetStats() const;
+        void Report() const;
+
+        static std::string GetDefaultDirectory();
+
+    private:
+        // Fields are written by one thread and may be read while it overwrites them, torn events are
+        // detected by their index instead.
+        struct Event
+        {
+            std::atomic<const char*> name { nullptr };
+            std::atomic<std::uint64_t> start { 0 };
+            // `CounterDuration` for counters.
+            std::atomic<std::uint64_t> duration { 0 };
+            std::atomic<std::int64_t> value { 0 };
+        };
+
+        struct ThreadRing
+        {
+            std::thread::id owner;
+            // In order of the first event, the thread id in dumps.
+            std::uint32_t thread = 0;
+            std::unique_ptr<Event[]> events;
+            std::atomic<std::uint64_t> written { 0 };
+        };
+
+        struct SnapshotEvent
+        {
+            const char* name;
+            std::uint32_t thread;
+            std::uint64_t start;
+            std::uint64_t duration;
+            std::int64_t value;
+        };
+
+        struct Snapshot
+        {
+            std::string path;
+            std::string reason;
+            std::vector<SnapshotEvent> events;
+        };
+
+        static constexpr std::uint64_t CounterDuration = ~std::uint64_t(0);
+
+        ThreadRing& GetThreadRing();
+        void Record(const char* name, std::uint64_t start, std::uint64_t duration, std::int64_t value);
+        Snapshot TakeSnapshot(std::uint64_t now) const;
+        void WriterMain();
+
+        FlightRecorderOptions options;
+        std::uint64_t generation;
+        std::uint64_t creation;
+        std::uint64_t ringMask;
+
+        mutable std::mutex ringsMutex;
+        std::vector<std::unique_ptr<ThreadRing>> rings;
+
+        // Frame loop thread only.
+        std::uint64_t lastFrameEnd = 0;
+        std::uint64_t lastAllocations = 0;
+
+        mutable std::mutex statsMutex;
+        FlightRecorderStats stats;
+        std::uint64_t lastDump = 0;
+
+        std::mutex writerMutex;
+        std::condition_variable snapshotAvailable;
+        std::deque<Snapshot> snapshots;
+        bool stopping = false;
+        std::thread writer;
+    };
+
+    // Nanoseconds on the steady clock.
+    std::uint64_t GetFlightTimestamp();
+
+    // Make the functions below record into `recorder`, `nullptr` to stop. They're cheap while nothing
+    // is recording. Returns once no call uses the previous recorder anymore, so it may be destroyed.
+    void SetFlightRecorder(FlightRecorder* recorder);
+    FlightRecorder* GetFlightRecorder();
+
+    void RecordFlightScope(const char* name, std::uint64_t start, std::uint64_t end);
+    void RecordFlightCounter(const char* name, std::int64_t value);
+    bool EndFlightFrame();
+
+    // Records the rest of the enclosing block, usually through `ENGINE_FLIGHT_SCOPE`.
+    class FlightScope
+    {
+    public:
+        // Doesn't read the clock while nothing is recording. The recorder is looked up again at the end,
+        // it may have been replaced meanwhile.
+        explicit FlightScope(const char* name) : recording(GetFlightRecorder() != nullptr), name(name), start(recording ? GetFlightTimestamp() : 0) {}
+        ~FlightScope()
+        {
+            if (recording)
+                RecordFlightScope(name, start, GetFlightTimestamp());
+        }
+
+        FlightScope(const FlightScope&) = delete;
+        FlightScope& operator=(const FlightScope&) = delete;
+
+    private:
+        bool recording;
+        const char* name;
+        std::uint64_t start;
+    };
+}
+
+#define ENGINE_FLIGHT_SCOPE_CONCAT_INNER(a, b) a##b
+#define ENGINE_FLIGHT_SCOPE_CONCAT(a, b) ENGINE_FLIGHT_SCOPE_CONCAT_INNER(a, b)
+
+// Record the rest of the enclosing block as `name`, a string literal.
+#define ENGINE_FLIGHT_SCOPE(name) Engine::Core::FlightScope ENGINE_FLIGHT_SCOPE_CONCAT(flightScope, __LINE__)(name)
+
+#endif
@@ -0,0 +1,142 @@
+#ifndef ENGINE_CORE_INIT_GRAPH_INCLUDED
+#define ENGINE_CORE_INIT_GRAPH_INCLUDED
+
+#include <Engine/Core/ThreadPool.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Engine::Core
+{
+    struct SubsystemDesc
+    {
+        std::string name;
+        // Names of subsystems that must be initialized first.
+        std::vector<std::string> dependencies;
+        // Returns false on failure, subsystems depending on it are skipped then.
+        std::function<bool()> initialize;
+        // Called in reverse initialization order, only if `initialize` succeeded.
+        std::function<void()> shutdown;
+        // Initialized on the first `Require` instead of by `Run`, unless an eager subsystem depends on it.
+        bool lazy = false;
+        // Initialized on the thread calling `Run`, for APIs like SDL video that must stay on the main thread.
+        bool mainThread = false;
+    };
+
+    enum class SubsystemState : std::uint8_t
+    {
+        Pending,
+        Running,
+        Ready,
+        Failed,
+        Skipped
+    };
+
+    struct SubsystemStats
+    {
+        std::string name;
+        SubsystemState state = SubsystemState::Pending;
+        bool lazy = false;
+        bool mainThread = false;
+        // Relative to the creation of the graph.
+        double startMilliseconds = 0.0;
+        double durationMilliseconds = 0.0;
+    };
+
+    // Startup dependency graph. Subsystems whose dependencies are ready initialize concurrently on a
+    // thread pool, lazy ones when first required.
+    class InitGraph
+    {
+    public:
+        InitGraph();
+        // Shuts down everything that was initialized.
+        ~InitGraph();
+
+        InitGraph(const InitGraph&) = delete;
+        InitGraph& operator=(const InitGraph&) = delete;
+
+        // Add all subsystems before `Run`.
+        void Add(SubsystemDesc desc);
+
+        // Initialize every eager subsystem and the lazy ones they depend on, using `workers` and the
+        // calling thread. Returns false if one failed, an unknown dependency or a cycle was found.
+        bool Run(ThreadPool& workers);
+
+        // Initializes a lazy subsystem and its dependencies on the calling thread on first use, waits if
+        // another thread is initializing it. Returns whether it is ready. Thread-safe.
+        bool Require(const std::string& name);
+
+        bool IsReady(const std::string& name) const;
+
+        // Shut down in reverse initialization order.
+        void Shutdown();
+
+        // Ends the time to first frame measurement. Later calls are ignored.
+        void MarkFirstFrame();
+        // Negative until `MarkFirstFrame`.
+        double GetTimeToFirstFrameMilliseconds() const;
+
+        std::vector<SubsystemStats> GetStats() const;
+        // Print every subsystem's timing and the time to first frame.
+        void Report() const;
+
+    private:
+        struct Node
+        {
+            SubsystemDesc desc;
+            std::vector<std::size_t> dependencies;
+            std::vector<std::size_t> dependents;
+            SubsystemStats stats;
+            // Part of the eager set `Run` initializes.
+            bool scheduled = false;
+            // Still to be finished by the current `Run`.
+            bool counted = false;
+            std::size_t remainingDependencies = 0;
+        };
+
+        // `nodes.size()` if there is no subsystem `name`.
+        std::size_t Find(const std::string& name) const;
+        bool Resolve();
+        bool HasCycle() const;
+
+        // Initializes a node claimed as running, dropping the lock meanwhile.
+        void Execute(std::size_t index, std::unique_lock<std::mutex>& lock);
+        // Marks a node finished and releases or skips its dependents. Called with the lock held.
+        void Finish(std::size_t index, SubsystemState state);
+        void Dispatch(std::size_t index);
+        double GetMilliseconds() const;
+
+        std::vector<std::unique_ptr<Node>> nodes;
+        bool resolved = false;
+
+        mutable std::mutex mutex;
+        std::condition_variable changed;
+        ThreadPool* runWorkers = nullptr;
+        // Ready main thread subsystems for the thread in `Run`.
+        std::vector<std::size_t> mainThreadQueue;
+        std::size_t runRemaining = 0;
+        // Jobs on `runWorkers` that haven't returned yet, `Run` waits for them before returning.
+        std::size_t pendingJobs = 0;
+        std::vector<std::size_t> initializationOrder;
+
+        std::chrono::steady_clock::time_point creation;
+        double firstFrameMilliseconds = -1.0;
+    };
+
+    // Subsystem calling `SDL_InitSubSystem` and `SDL_QuitSubSystem` with `flags`. SDL's subsystem
+    // reference counts aren't thread-safe, so these calls are serialized with each other while engine
+    // subsystems still run alongside.
+    SubsystemDesc MakeSDLSubsystem(const std::string& name, std::uint32_t flags, std::vector<std::string> dependencies = {});
+
+    // Adds "SDL events", "SDL timer", "SDL video" and "SDL audio", and the rarely used "SDL game
+    // controller", "SDL haptic" and "SDL sensor" as lazy subsystems.
+    void AddSDLSubsystems(InitGraph& graph);
+}
+
+#endif
@@ -0,0 +1,144 @@
+#ifndef ENGINE_CORE_MATH_INCLUDED
+#define ENGINE_CORE_MATH_INCLUDED
+
+#include <cmath>
+
+namespace Engine::Core
+{
+    struct Vector3
+    {
+        float x = 0.0f;
+        float y = 0.0f;
+        float z = 0.0f;
+
+        Vector3() = default;
+        Vector3(float x, float y, float z) : x(x), y(y), z(z) {}
+        explicit Vector3(const float values[3]) : x(values[0]), y(values[1]), z(values[2]) {}
+
+        Vector3 operator+(const Vector3& other) const { return Vector3(x + other.x, y + other.y, z + other.z); }
+        Vector3 operator-(const Vector3& other) const { return Vector3(x - other.x, y - other.y, z - other.z); }
+        Vector3 operator*(float scalar) const { return Vector3(x * scalar, y * scalar, z * scalar); }
+        Vector3 operator/(float scalar) const { return Vector3(x / scalar, y / scalar, z / scalar); }
+        Vector3 operator-() const { return Vector3(-x, -y, -z); }
+
+        Vector3& operator+=(const Vector3& other) { x += other.x; y += other.y; z += other.z; return *this; }
+        Vector3& operator-=(const Vector3& other) { x -= other.x; y -= other.y; z -= other.z; return *this; }
+        Vector3& operator*=(float scalar) { x *= scalar; y *= scalar; z *= scalar; return *this; }
+    };
+
+    struct Vector4
+    {
+        float x = 0.0f;
+        float y = 0.0f;
+        float z = 0.0f;
+        float w = 0.0f;
+
+        Vector4() = default;
+        Vector4(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {}
+        Vector4(const Vector3& vector, float w) : x(vector.x), y(vector.y), z(vector.z), w(w) {}
+    };
+
+    inline float Dot(const Vector3& a, const Vector3& b)
+    {
+        return a.x * b.x + a.y * b.y + a.z * b.z;
+    }
+
+    inline Vector3 Cross(const Vector3& a, const Vector3& b)
+    {
+        return Vector3(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x);
+    }
+
+    inline float Length(const Vector3& vector)
+    {
+        return std::sqrt(Dot(vector, vector));
+    }
+
+    // Returns the zero vector for zero length input.
+    inline Vector3 Normalize(const Vector3& vector)
+    {
+        float length = Length(vector);
+        return length > 0.0f ? vector / length : Vector3();
+    }
+
+    // Column-major 4x4 matrix, `elements[column * 4 + row]`, transforming column vectors.
+    struct Matrix4
+    {
+        float elements[16] = { 1.0f, 0.0f, 0.0f, 0.0f,
+                               0.0f, 1.0f, 0.0f, 0.0f,
+                               0.0f, 0.0f, 1.0f, 0.0f,
+                               0.0f, 0.0f, 0.0f, 1.0f };
+
+        float& operator()(int row, int column) { return elements[column * 4 + row]; }
+        float operator()(int row, int column) const { return elements[column * 4 + row]; }
+
+        Matrix4 operator*(const Matrix4& other) const
+        {
+            Matrix4 result;
+            for (int column = 0; column < 4; ++column)
+            {
+                for (int row = 0; row < 4; ++row)
+                {
+                    float sum = 0.0f;
+                    for (int i = 0; i < 4; ++i)
+                        sum += (*this)(row, i) * other(i, column);
+                    result(row, column) = sum;
+                }
+            }
+            return result;
+        }
+
+        Vector4 operator*(const Vector4& vector) const
+        {
+            const float* e = elements;
+            return Vector4(e[0] * vector.x + e[4] * vector.y + e[8] * vector.z + e[12] * vector.w,
+                           e[1] * vector.x + e[5] * vector.y + e[9] * vector.z + e[13] * vector.w,
+                           e[2] * vector.x + e[6] * vector.y + e[10] * vector.z + e[14] * vector.w,
+                           e[3] * vector.x + e[7] * vector.y + e[11] * vector.z + e[15] * vector.w);
+        }
+
+        Vector3 TransformPoint(const Vector3& point) const
+        {
+            Vector4 result = (*this) * Vector4(point, 1.0f);
+            return Vector3(result.x, result.y, result.z);
+        }
+
+        // OpenGL convention, right-handed view space looking down -Z, clip space depth in [-w, w].
+        static Matrix4 Perspective(float verticalFov, float aspectRatio, float nearPlane, float farPlane)
+        {
+            float focalLength = 1.0f / std::tan(verticalFov * 0.5f);
+
+            Matrix4 result;
+            result(0, 0) = focalLength / aspectRatio;
+            result(1, 1) = focalLength;
+            result(2, 2) = (farPlane + nearPlane) / (nearPlane - farPlane);
+            result(2, 3) = 2.0f * farPlane * nearPlane / (nearPlane - farPlane);
+            result(3, 2) = -1.0f;
+            result(3, 3) = 0.0f;
+            return result;
+        }
+
+        static Matrix4 LookAt(const Vector3& eye, const Vector3& target, const Vector3& up)
+        {
+            Vector3 forward = Normalize(target - eye);
+            Vector3 right = Normalize(Cross(forward, up));
+            Vector3 trueUp = Cross(right, forward);
+
+            Matrix4 result;
+            result(0, 0) = right.x;
+            result(0, 1) = right.y;
+            result(0, 2) = right.z;
+            result(1, 0) = trueUp.x;
+            result(1, 1) = trueUp.y;
+            result(1, 2) = trueUp.z;
+            result(2, 0) = -forward.x;
+            result(2, 1) = -forward.y;
+            result(2, 2) = -forward.z;
+            result(0, 3) = -Dot(right, eye);
+            result(1, 3) = -Dot(trueUp, eye);
+            result(2, 3) = Dot(forward, eye);
+            return result;
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,127 @@
+#ifndef ENGINE_CORE_MEMORY_TRACKING_INCLUDED
+#define ENGINE_CORE_MEMORY_TRACKING_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+namespace Engine::Core
+{
+    // Subsystem an allocation is charged to. Debug builds report the tagged allocations still live
+    // at exit.
+    enum class MemoryTag : std::uint8_t
+    {
+        Untagged,
+        Core,
+        Graphics,
+        Application
+    };
+
+    constexpr std::size_t MemoryTagCount = 4;
+
+    const char* GetMemoryTagName(MemoryTag tag);
+
+    // Tag of the calling thread's allocations through `operator new`, `Untagged` by default.
+    // `ThreadPool` jobs run with the tag of the thread that submitted them.
+    MemoryTag GetMemoryTag();
+
+    // Charge the calling thread's allocations to `tag` until destruction. Nests.
+    class MemoryTagScope
+    {
+    public:
+        explicit MemoryTagScope(MemoryTag tag);
+        ~MemoryTagScope();
+
+        MemoryTagScope(const MemoryTagScope&) = delete;
+        MemoryTagScope& operator=(const MemoryTagScope&) = delete;
+
+    private:
+        MemoryTag previous;
+    };
+
+    // Same heap and bookkeeping as `operator new`, with an explicit tag. Returns `nullptr` if out of
+    // memory. Either `FreeTagged` or `operator delete` frees.
+    void* AllocateTagged(std::size_t size, MemoryTag tag, std::size_t alignment = alignof(std::max_align_t));
+    void FreeTagged(void* memory);
+
+    // For containers charged to a tag regardless of the thread's, e.g.
+    // `std::vector<Vertex, TaggedAllocator<Vertex, MemoryTag::Graphics>>`.
+    template <typename T, MemoryTag Tag>
+    class TaggedAllocator
+    {
+    public:
+        using value_type = T;
+
+        template <typename U>
+        struct rebind
+        {
+            using other = TaggedAllocator<U, Tag>;
+        };
+
+        TaggedAllocator() = default;
+        template <typename U>
+        TaggedAllocator(const TaggedAllocator<U, Tag>&) {}
+
+        T* allocate(std::size_t count)
+        {
+            if (count > static_cast<std::size_t>(-1) / sizeof(T))
+                throw std::bad_array_new_length();
+
+            void* memory = AllocateTagged(count * sizeof(T), Tag, alignof(T));
+            if (memory == nullptr)
+                throw std::bad_alloc();
+            return static_cast<T*>(memory);
+        }
+
+        void deallocate(T* memory, std::size_t) { FreeTagged(memory); }
+
+        template <typename U>
+        bool operator==(const TaggedAllocator<U, Tag>&) const { return true; }
+        template <typename U>
+        bool operator!=(const TaggedAllocator<U, Tag>&) const { return false; }
+    };
+
+    struct MemoryTagStats
+    {
+        std::uint64_t liveBytes = 0;
+        std::uint64_t liveAllocations = 0;
+        // Highest `liveBytes` any sample saw, see `SampleMemoryStats`.
+        std::uint64_t peakBytes = 0;
+        std::uint64_t totalAllocations = 0;
+        std::uint64_t totalBytes = 0;
+        // Over the last full second between samples, or since startup during the first.
+        double allocationsPerSecond = 0.0;
+        double bytesPerSecond = 0.0;
+    };
+
+    struct MemoryStats
+    {
+        MemoryTagStats tags[MemoryTagCount];
+        MemoryTagStats total;
+    };
+
+    class TlsfHeap;
+
+    // Heap behind `operator new` and `AllocateTagged`, picked before the first allocation with the
+    // environment variable `ENGINE_ALLOCATOR`: "malloc" (default), "tlsf" or "tlsf-hugepages".
+    enum class DefaultAllocator : std::uint8_t
+    {
+        Malloc,
+        Tlsf
+    };
+
+    DefaultAllocator GetDefaultAllocator();
+    const char* GetDefaultAllocatorName();
+    // `nullptr` unless the default allocator is `Tlsf`.
+    TlsfHeap* GetDefaultTlsfHeap();
+
+    // Merge the counters of all threads. Allocating only bumps counters of the calling thread, so high-
+    // water marks are those of the samples: the flight recorder takes one every frame.
+    MemoryStats SampleMemoryStats();
+
+    // Print live, peak and rate per tag, and the TLSF heap's fragmentation if it's the default
+    // allocator.
+    void ReportMemory();
+}
+
+#endif
@@ -0,0 +1,74 @@
+#ifndef ENGINE_CORE_PACK_FILE_INCLUDED
+#define ENGINE_CORE_PACK_FILE_INCLUDED
+
+#include <Engine/Core/StringId.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+struct SDL_RWops;
+
+namespace Engine::Core
+{
+    namespace Detail
+    {
+        struct PackMapping;
+    }
+
+    // Read-only archive of files looked up by string id, memory-mapped as a whole. Streams opened from
+    // it read straight from the mapping, so SDL loaders taking an `SDL_RWops` don't copy through stdio
+    // buffers first.
+    class PackFile
+    {
+    public:
+        // Returns `nullptr` if the file can't be mapped or isn't a pack.
+        static std::unique_ptr<PackFile> Open(const std::string& path);
+
+        // Writes the files at `paths` as entries named `names`.
+        static bool Write(const std::string& path, const std::vector<StringId>& names, const std::vector<std::string>& paths);
+
+        ~PackFile();
+
+        PackFile(const PackFile&) = delete;
+        PackFile& operator=(const PackFile&) = delete;
+
+        bool Contains(StringId name) const;
+
+        // Bytes of entry `name`, valid as long as the pack. Returns `nullptr` if there is no such entry.
+        const void* GetData(StringId name, std::size_t& size) const;
+
+        // Read-only stream over entry `name`, closed with `SDL_RWclose` or by loaders told to free it. It
+        // keeps the mapping alive, so it may outlive the pack. Returns `nullptr` if there is no such entry.
+        SDL_RWops* OpenStream(StringId name) const;
+
+        // Ask the OS to start reading entry `name` or the whole pack in the background, so the first
+        // access doesn't fault page by page.
+        void Prefetch(StringId name) const;
+        void PrefetchAll() const;
+
+        std::size_t GetEntryCount() const { return hashes.size(); }
+        std::size_t GetSize() const;
+
+    private:
+        struct Entry
+        {
+            std::uint64_t offset;
+            std::uint64_t size;
+        };
+
+        PackFile() = default;
+
+        const Entry* Find(StringId name) const;
+
+        std::string path;
+        std::shared_ptr<Detail::PackMapping> mapping;
+        // Sorted, `entries` in the same order.
+        std::vector<std::uint64_t> hashes;
+        std::vector<Entry> entries;
+    };
+}
+
+#endif
@@ -0,0 +1,122 @@
+#ifndef ENGINE_CORE_PERF_COUNTERS_INCLUDED
+#define ENGINE_CORE_PERF_COUNTERS_INCLUDED
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Engine::Core
+{
+    enum class PerfCounter : std::uint8_t
+    {
+        Cycles,
+        Instructions,
+        // Last level cache misses.
+        CacheMisses,
+        BranchMisses
+    };
+
+    constexpr std::size_t PerfCounterCount = 4;
+
+    const char* GetPerfCounterName(PerfCounter counter);
+
+    struct PerfCounterValues
+    {
+        std::uint64_t values[PerfCounterCount] = {};
+        // Bit per `PerfCounter` that was counted, the others stay 0.
+        std::uint32_t validMask = 0;
+
+        bool IsValid(PerfCounter counter) const { return (validMask >> static_cast<std::uint32_t>(counter)) & 1; }
+        std::uint64_t Get(PerfCounter counter) const { return values[static_cast<std::size_t>(counter)]; }
+
+        // Instructions per cycle, 0 if either wasn't counted.
+        double GetInstructionsPerCycle() const;
+
+        // Deltas between two reads are only valid for counters valid in both.
+        PerfCounterValues operator-(const PerfCounterValues& other) const;
+        PerfCounterValues& operator+=(const PerfCounterValues& other);
+    };
+
+    // Read the hardware counters of the calling thread, user space only. The events are opened on the
+    // first read of every thread with `perf_event_open`. Returns false, with no counter valid, if none
+    // could be opened: not Linux, `perf_event_paranoid` above 2, VMs without a PMU or seccomp filters.
+    // Counters the CPU lacks are left out. Multiplexed counters are scaled to the full time.
+    bool ReadThreadPerfCounters(PerfCounterValues& values);
+
+    // Counters that could be opened on the calling thread, and why the others couldn't.
+    std::uint32_t GetThreadPerfCounterMask();
+    std::string GetThreadPerfCounterError();
+
+    struct PerfScopeStats
+    {
+        const char* name = nullptr;
+        std::uint64_t calls = 0;
+        double milliseconds = 0.0;
+        // Summed over all calls and threads. Nested scopes are counted in their parents as well.
+        PerfCounterValues counters;
+    };
+
+    // Sites that ran at least once, in order of their first run.
+    std::vector<PerfScopeStats> GetPerfScopeStats();
+    void ResetPerfScopeStats();
+
+    // Print time, IPC and misses per call of every site that ran.
+    void ReportPerfScopes();
+
+    // Accumulated by every `PerfScope` of a call site, usually through `ENGINE_PERF_SCOPE`.
+    // Must have static storage duration.
+    class PerfScopeSite
+    {
+    public:
+        explicit PerfScopeSite(const char* name);
+
+        PerfScopeSite(const PerfScopeSite&) = delete;
+        PerfScopeSite& operator=(const PerfScopeSite&) = delete;
+
+        void Add(std::uint64_t nanoseconds, const PerfCounterValues& delta);
+
+        const char* GetName() const { return name; }
+
+    private:
+        friend std::vector<PerfScopeStats> GetPerfScopeStats();
+        friend void ResetPerfScopeStats();
+
+        const char* name;
+        PerfScopeSite* next = nullptr;
+
+        std::atomic<std::uint64_t> calls = 0;
+        std::atomic<std::uint64_t> nanoseconds = 0;
+        std::atomic<std::uint64_t> values[PerfCounterCount] = {};
+        std::atomic<std::uint32_t> validMask = 0;
+    };
+
+    // Wall time and counter deltas of the calling thread from construction to destruction. The time
+    // goes to the flight recorder as well.
+    class PerfScope
+    {
+    public:
+        explicit PerfScope(PerfScopeSite& site);
+        ~PerfScope();
+
+        PerfScope(const PerfScope&) = delete;
+        PerfScope& operator=(const PerfScope&) = delete;
+
+    private:
+        PerfScopeSite& site;
+        std::chrono::steady_clock::time_point start;
+        PerfCounterValues counters;
+    };
+}
+
+#define ENGINE_PERF_SCOPE_CONCAT_INNER(a, b) a##b
+#define ENGINE_PERF_SCOPE_CONCAT(a, b) ENGINE_PERF_SCOPE_CONCAT_INNER(a, b)
+
+// Measure the rest of the enclosing block as `name`, a string literal.
+#define ENGINE_PERF_SCOPE(name) \
+    static Engine::Core::PerfScopeSite ENGINE_PERF_SCOPE_CONCAT(perfScopeSite, __LINE__)(name); \
+    Engine::Core::PerfScope ENGINE_PERF_SCOPE_CONCAT(perfScope, __LINE__)(ENGINE_PERF_SCOPE_CONCAT(perfScopeSite, __LINE__))
+
+#endif
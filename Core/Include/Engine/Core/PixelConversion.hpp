@@ -0,0 +1,52 @@
+#ifndef ENGINE_CORE_PIXEL_CONVERSION_INCLUDED
+#define ENGINE_CORE_PIXEL_CONVERSION_INCLUDED
+
+#include <Engine/Core/CpuDispatch.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+struct SDL_Surface;
+
+namespace Engine::Core
+{
+    // Pixel kernels working on rows of memory. 32-bit formats are named by their byte order in memory,
+    // like `SDL_PIXELFORMAT_RGBA32` and `SDL_PIXELFORMAT_BGRA32`, with alpha always in the last byte.
+    // RGB565 is `SDL_PIXELFORMAT_RGB565`, red in the high bits. Source and destination may be the same
+    // row when the pixel size is the same, otherwise they must not overlap.
+
+    // Swap red and blue, RGBA to BGRA and back.
+    void SwapRedBlue(const void* source, void* destination, std::size_t pixelCount);
+
+    // Truncates to 5-6-5 bits like SDL, alpha is dropped.
+    void ConvertRGBAToRGB565(const void* source, void* destination, std::size_t pixelCount);
+    void ConvertBGRAToRGB565(const void* source, void* destination, std::size_t pixelCount);
+    // Expands by replicating the high bits like SDL, alpha is opaque.
+    void ConvertRGB565ToRGBA(const void* source, void* destination, std::size_t pixelCount);
+    void ConvertRGB565ToBGRA(const void* source, void* destination, std::size_t pixelCount);
+
+    // Four 8-bit sRGB channels to four linear floats, alpha is linear already and only scaled to [0, 1].
+    void ConvertSRGBToLinear(const void* source, float* destination, std::size_t pixelCount);
+    // Four linear floats, clamped to [0, 1], to 8-bit sRGB with alpha stored linearly.
+    void ConvertLinearToSRGB(const float* source, void* destination, std::size_t pixelCount);
+
+    // Multiply color by alpha, for 32-bit formats with alpha last.
+    void PremultiplyAlpha(const void* source, void* destination, std::size_t pixelCount);
+
+    // Blend non-premultiplied `source` over `destination` like `SDL_BLENDMODE_BLEND`, both 32-bit with alpha last.
+    void BlendAlpha(const void* source, void* destination, std::size_t pixelCount);
+
+    // Level of the kernels selected for this CPU, reported as "Pixel conversion".
+    CpuLevel GetPixelKernelLevel();
+
+    // Surface variants of the kernels, for the formats above. They return false for format combinations
+    // they don't handle, callers fall back to `SDL_ConvertSurface` and `SDL_BlitSurface` then.
+
+    // Same size surfaces.
+    bool ConvertSurfacePixels(const SDL_Surface* source, SDL_Surface* destination);
+    bool PremultiplySurfaceAlpha(SDL_Surface* surface);
+    // Blend `source` over `destination` at `x`, `y`, clipped to `destination`. Both must have the same format.
+    bool BlendSurface(const SDL_Surface* source, SDL_Surface* destination, int x, int y);
+}
+
+#endif
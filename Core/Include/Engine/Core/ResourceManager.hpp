@@ -0,0 +1,212 @@
+#ifndef ENGINE_CORE_RESOURCE_MANAGER_INCLUDED
+#define ENGINE_CORE_RESOURCE_MANAGER_INCLUDED
+
+#include <Engine/Core/StringId.hpp>
+#include <Engine/Core/ThreadPool.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Engine::Core
+{
+    using ResourceTypeIndex = std::uint32_t;
+
+    enum class ResourceState : std::uint8_t
+    {
+        Loading,
+        Ready,
+        Failed
+    };
+
+    struct ResourceTypeStats
+    {
+        std::string name;
+        std::size_t residentBytes = 0;
+        std::size_t peakResidentBytes = 0;
+        std::size_t residentCount = 0;
+        std::size_t loadCount = 0;
+        std::size_t failedLoadCount = 0;
+        std::size_t evictionCount = 0;
+    };
+
+    namespace Detail
+    {
+        struct ResourceEntry
+        {
+            StringId id;
+            ResourceTypeIndex type = 0;
+            std::string path;
+            std::atomic<std::uint32_t> referenceCount { 0 };
+            std::atomic<ResourceState> state { ResourceState::Loading };
+            std::shared_ptr<void> data;
+            std::size_t size = 0;
+            std::list<ResourceEntry*>::iterator lruPosition;
+            bool inLru = false;
+        };
+
+        // Constructs a handle from a reference that was already counted.
+        struct AdoptReference {};
+
+        ResourceTypeIndex NextResourceTypeIndex();
+
+        template <typename T>
+        ResourceTypeIndex GetResourceTypeIndex()
+        {
+            static const ResourceTypeIndex index = NextResourceTypeIndex();
+            return index;
+        }
+    }
+
+    // Reference-counted handle to a resource owned by a `ResourceManager`.
+    // A resource is only evicted while no handle references it.
+    // Handles must not outlive the manager they came from.
+    template <typename T>
+    class ResourceHandle
+    {
+    public:
+        ResourceHandle() = default;
+
+        explicit ResourceHandle(Detail::ResourceEntry* entry) : entry(entry)
+        {
+            if (entry != nullptr)
+                entry->referenceCount.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        ResourceHandle(Detail::ResourceEntry* entry, Detail::AdoptReference) : entry(entry) {}
+
+        ResourceHandle(const ResourceHandle& other) : ResourceHandle(other.entry) {}
+
+        ResourceHandle(ResourceHandle&& other) noexcept : entry(other.entry)
+        {
+            other.entry = nullptr;
+        }
+
+        ResourceHandle& operator=(ResourceHandle other) noexcept
+        {
+            std::swap(entry, other.entry);
+            return *this;
+        }
+
+        ~ResourceHandle()
+        {
+            if (entry != nullptr)
+                entry->referenceCount.fetch_sub(1, std::memory_order_release);
+        }
+
+        bool IsValid() const { return entry != nullptr; }
+        bool IsReady() const { return GetState() == ResourceState::Ready; }
+        bool IsFailed() const { return GetState() == ResourceState::Failed; }
+
+        ResourceState GetState() const
+        {
+            return entry != nullptr ? entry->state.load(std::memory_order_acquire) : ResourceState::Failed;
+        }
+
+        // Returns `nullptr` until the resource finished loading.
+        T* Get() const
+        {
+            return IsReady() ? static_cast<T*>(entry->data.get()) : nullptr;
+        }
+
+        StringId GetId() const { return entry != nullptr ? entry->id : StringId(); }
+
+    private:
+        Detail::ResourceEntry* entry = nullptr;
+    };
+
+    // Loads resources on background threads and keeps them cached until the memory budget
+    // is exceeded, at which point the least recently requested unreferenced resources are evicted.
+    class ResourceManager
+    {
+    public:
+        // Loads the resource at `path`, writes its memory footprint in bytes to `size`.
+        // Returns `nullptr` on failure. Called on worker threads.
+        template <typename T>
+        using Loader = std::function<std::unique_ptr<T>(const std::string& path, std::size_t& size)>;
+
+        // A `workerCount` of 0 picks a count based on the hardware concurrency.
+        explicit ResourceManager(std::size_t memoryBudget, std::size_t workerCount = 0);
+        ~ResourceManager();
+
+        ResourceManager(const ResourceManager&) = delete;
+        ResourceManager& operator=(const ResourceManager&) = delete;
+
+        template <typename T>
+        void RegisterType(const std::string& name, Loader<T> loader)
+        {
+            RegisterType(Detail::GetResourceTypeIndex<T>(), name,
+                [loader = std::move(loader)](const std::string& path, std::size_t& size) -> std::shared_ptr<void>
+                {
+                    return loader(path, size);
+                });
+        }
+
+        // Returns immediately. Concurrent and repeated requests for the same path share one load.
+        template <typename T>
+        ResourceHandle<T> Load(const std::string& path)
+        {
+            return ResourceHandle<T>(Acquire(Detail::GetResourceTypeIndex<T>(), path), Detail::AdoptReference());
+        }
+
+        template <typename T>
+        ResourceTypeStats GetStats() const
+        {
+            return GetStats(Detail::GetResourceTypeIndex<T>());
+        }
+
+        // Statistics of all registered types.
+        std::vector<ResourceTypeStats> GetAllStats() const;
+
+        std::size_t GetMemoryBudget() const;
+        std::size_t GetResidentBytes() const;
+
+        // Evicts immediately if the new budget is exceeded.
+        void SetMemoryBudget(std::size_t bytes);
+
+        // Evict unreferenced resources until the budget is met. Normally happens after every load.
+        void Trim();
+
+        // Block until all pending loads have finished.
+        void Wait();
+
+    private:
+        using ErasedLoader = std::function<std::shared_ptr<void>(const std::string&, std::size_t&)>;
+
+        struct TypeInfo
+        {
+            ErasedLoader loader;
+            ResourceTypeStats stats;
+        };
+
+        void RegisterType(ResourceTypeIndex type, const std::string& name, ErasedLoader loader);
+        // Returns the entry with its reference count already incremented, so it cannot be
+        // evicted before the caller wraps it in a handle.
+        Detail::ResourceEntry* Acquire(ResourceTypeIndex type, const std::string& path);
+        ResourceTypeStats GetStats(ResourceTypeIndex type) const;
+        void LoadEntry(Detail::ResourceEntry* entry, const ErasedLoader& loader);
+        void EvictToBudget();
+
+        mutable std::mutex mutex;
+        std::unordered_map<ResourceTypeIndex, TypeInfo> types;
+        std::unordered_map<StringId, std::unique_ptr<Detail::ResourceEntry>> entries;
+
+        // Ready resources, most recently requested first.
+        std::list<Detail::ResourceEntry*> lru;
+
+        std::size_t memoryBudget;
+        std::size_t residentBytes = 0;
+
+        // Declared last so workers are joined before anything else is destroyed.
+        ThreadPool workers;
+    };
+}
+
+#endif
@@ -0,0 +1,80 @@
+#ifndef ENGINE_CORE_SAMPLING_PROFILER_INCLUDED
+#define ENGINE_CORE_SAMPLING_PROFILER_INCLUDED
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace Engine::Core
+{
+    struct SamplingProfilerOptions
+    {
+        // Samples per second of CPU time on each thread, prime so it doesn't beat with the frame rate.
+        std::uint32_t frequency = 997;
+        // Preallocated, later samples are dropped and counted.
+        std::size_t maxSamples = 1 << 14;
+    };
+
+    struct SamplingProfilerStats
+    {
+        std::uint64_t samples = 0;
+        std::uint64_t dropped = 0;
+        // Threads registered so far, including those that exited.
+        std::size_t threads = 0;
+    };
+
+    // Statistical profiler for release builds, sampling code that has no scopes. Every registered thread
+    // gets a CPU time timer delivering SIGPROF to it, the handler unwinds with frame pointers into a
+    // preallocated buffer without locks or allocations. `Save` writes the raw addresses with the module
+    // map, `Scripts/CollapseProfile.py` symbolizes them offline into collapsed stacks for flame graphs.
+    // Linux only, `Start` fails elsewhere. Builds keep frame pointers with `ENABLE_FRAME_POINTERS`.
+    class SamplingProfiler
+    {
+    public:
+        static constexpr std::size_t MaxDepth = 64;
+
+        explicit SamplingProfiler(SamplingProfilerOptions options = SamplingProfilerOptions());
+        ~SamplingProfiler();
+
+        SamplingProfiler(const SamplingProfiler&) = delete;
+        SamplingProfiler& operator=(const SamplingProfiler&) = delete;
+
+        // Sample the registered threads, and threads registering later, until `Stop`. Returns false if
+        // sampling isn't supported or another profiler is running.
+        bool Start();
+        void Stop();
+
+        // Identical stacks are merged. Can be called while running.
+        bool Save(const std::string& path) const;
+
+        SamplingProfilerStats GetStats() const;
+        void Report() const;
+
+        // Called by the signal handler, async-signal-safe. `frames` starts with the interrupted
+        // instruction, followed by return addresses.
+        void RecordSample(std::uint32_t thread, const std::uintptr_t* frames, std::size_t depth);
+
+    private:
+        struct Sample
+        {
+            std::atomic<bool> ready { false };
+            std::uint32_t thread = 0;
+            std::uint32_t depth = 0;
+            std::uintptr_t frames[MaxDepth];
+        };
+
+        SamplingProfilerOptions options;
+        std::unique_ptr<Sample[]> samples;
+        std::atomic<std::uint64_t> nextSample { 0 };
+        std::atomic<std::uint64_t> dropped { 0 };
+        bool running = false;
+    };
+
+    // Threads that should be sampled call this once, `name` shows up at the root of their stacks.
+    // `ThreadPool` workers register themselves. Unregisters when the thread exits.
+    void RegisterSamplingThread(const std::string& name);
+}
+
+#endif
@@ -0,0 +1,88 @@
+#ifndef ENGINE_CORE_STARTUP_PREFETCH_INCLUDED
+#define ENGINE_CORE_STARTUP_PREFETCH_INCLUDED
+
+#include <Engine/Core/ThreadPool.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Engine::Core
+{
+    struct PrefetchRange
+    {
+        std::string path;
+        std::uint64_t offset = 0;
+        // 0 for the whole file.
+        std::uint64_t size = 0;
+    };
+
+    struct StartupPrefetchStats
+    {
+        // Read from the manifest of the previous run.
+        std::size_t prefetchedRanges = 0;
+        std::uint64_t prefetchedBytes = 0;
+        double prefetchMilliseconds = 0.0;
+        // Recorded during this run.
+        std::size_t recordedRanges = 0;
+    };
+
+    // Cold starts are dominated by page cache misses. This records the files and byte ranges read
+    // during the first seconds of a run into a manifest, and on the next start asks the OS to read
+    // them ahead, in parallel, before the engine gets to them.
+    class StartupPrefetch
+    {
+    public:
+        // Records accesses for `recordSeconds` after construction.
+        explicit StartupPrefetch(std::string manifestPath, double recordSeconds = 10.0);
+        // Waits for running prefetch jobs and stops receiving accesses.
+        ~StartupPrefetch();
+
+        StartupPrefetch(const StartupPrefetch&) = delete;
+        StartupPrefetch& operator=(const StartupPrefetch&) = delete;
+
+        // `Startup.prefetch` next to the executable, in `Binary/<System>/<Arch>/<BuildType>`.
+        static std::string GetDefaultManifestPath();
+
+        // Issue read-ahead hints for the previous run's manifest on `workers`, one job per file, and
+        // return without waiting. Returns false if there is no usable manifest.
+        bool Prefetch(ThreadPool& workers);
+
+        // Called by loaders through `RecordFileAccess`. Thread-safe.
+        void Record(const std::string& path, std::uint64_t offset, std::uint64_t size);
+
+        // Write the recorded ranges, merged per file in first access order.
+        bool Save() const;
+
+        StartupPrefetchStats GetStats() const;
+        void Report() const;
+
+    private:
+        std::string manifestPath;
+        std::chrono::steady_clock::time_point recordEnd;
+
+        mutable std::mutex mutex;
+        // Files in first access order, with the ranges read from each.
+        std::vector<std::string> files;
+        std::unordered_map<std::string, std::vector<PrefetchRange>> ranges;
+
+        StartupPrefetchStats stats;
+        // Prefetch jobs still running, the destructor waits for them.
+        std::size_t pendingFiles = 0;
+        std::condition_variable filesDone;
+    };
+
+    // Make `prefetch` receive the accesses reported by `RecordFileAccess`, `nullptr` to stop. Returns once
+    // no call is recording into the previous one anymore, so it can be destroyed.
+    void SetStartupPrefetch(StartupPrefetch* prefetch);
+
+    // Loaders report the byte ranges they read here, a `size` of 0 meaning the whole file. Cheap while
+    // nothing is recording.
+    void RecordFileAccess(const std::string& path, std::uint64_t offset, std::uint64_t size);
+}
+
+#endif
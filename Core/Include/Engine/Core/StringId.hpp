@@ -0,0 +1,73 @@
+#ifndef ENGINE_CORE_STRING_ID_INCLUDED
+#define ENGINE_CORE_STRING_ID_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+
+namespace Engine::Core
+{
+    // 64-bit FNV-1a hash, usable at compile time.
+    constexpr std::uint64_t HashString(std::string_view string)
+    {
+        std::uint64_t hash = 14695981039346656037ull;
+        for (char character : string)
+        {
+            hash ^= static_cast<std::uint8_t>(character);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    // Identifies a string by its hash so that comparisons are integer compares.
+    // Literals are hashed at compile time, runtime strings should go through `Intern`
+    // which checks for collisions and remembers the string.
+    class StringId
+    {
+    public:
+        constexpr StringId() : hash(0) {}
+        constexpr explicit StringId(std::uint64_t hash) : hash(hash) {}
+        constexpr explicit StringId(std::string_view string) : hash(HashString(string)) {}
+
+        // Hash `string` and add it to the global intern table.
+        // Reports an error if a different string with the same hash was interned before.
+        static StringId Intern(std::string_view string);
+
+        // Returns the number of strings in the global intern table.
+        static std::size_t GetInternedCount();
+
+        // Reverse lookup of interned strings. Only available with `ENGINE_CORE_DEBUG`,
+        // otherwise (or if the string was never interned) returns `nullptr`.
+        const char* GetDebugString() const;
+
+        constexpr std::uint64_t GetHash() const { return hash; }
+        constexpr bool IsValid() const { return hash != 0; }
+
+        constexpr bool operator==(StringId other) const { return hash == other.hash; }
+        constexpr bool operator!=(StringId other) const { return hash != other.hash; }
+        constexpr bool operator<(StringId other) const { return hash < other.hash; }
+
+    private:
+        std::uint64_t hash;
+    };
+
+    namespace Literals
+    {
+        constexpr StringId operator""_sid(const char* string, std::size_t length)
+        {
+            return StringId(std::string_view(string, length));
+        }
+    }
+}
+
+template <>
+struct std::hash<Engine::Core::StringId>
+{
+    std::size_t operator()(Engine::Core::StringId id) const noexcept
+    {
+        return static_cast<std::size_t>(id.GetHash());
+    }
+};
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef ENGINE_CORE_THREAD_POOL_INCLUDED
+#define ENGINE_CORE_THREAD_POOL_INCLUDED
+
+#include <Engine/Core/MemoryTracking.hpp>
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Engine::Core
+{
+    // Fixed set of worker threads consuming a FIFO job queue.
+    class ThreadPool
+    {
+    public:
+        // A `threadCount` of 0 uses one thread less than the hardware concurrency (at least one).
+        explicit ThreadPool(std::size_t threadCount = 0);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        void Submit(std::function<void()> job);
+
+        // Block until the queue is empty and no job is running.
+        void Wait();
+
+        std::size_t GetThreadCount() const { return threads.size(); }
+
+    private:
+        struct Job
+        {
+            std::function<void()> function;
+            MemoryTag tag;
+        };
+
+        void WorkerMain();
+
+        std::vector<std::thread> threads;
+        std::deque<Job> jobs;
+        std::mutex mutex;
+        std::condition_variable jobAvailable;
+        std::condition_variable jobsFinished;
+        std::size_t runningJobs = 0;
+        bool stopping = false;
+    };
+}
+
+#endif
@@ -0,0 +1,134 @@
+#ifndef ENGINE_CORE_TLSF_HEAP_INCLUDED
+#define ENGINE_CORE_TLSF_HEAP_INCLUDED
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace Engine::Core
+{
+    namespace Detail
+    {
+        struct TlsfBlock;
+    }
+
+    struct TlsfHeapOptions
+    {
+        // Mapped up front. When it runs out the heap maps another pool, each twice the size of the one
+        // before (or as big as a larger request). Untouched pages cost no memory, unless `prefault`.
+        std::size_t poolSize = std::size_t(64) << 20;
+        // Back pools with 2 MB pages: transparent huge pages on Linux, large pages on Windows if the
+        // process may lock memory. Falls back to normal pages.
+        bool hugePages = false;
+        // Touch every page when mapping a pool, so that allocations never wait for a page fault. Costs
+        // the pool's size in resident memory right away.
+        bool prefault = false;
+        // Allocations of up to `TlsfHeap::MaxCachedSize` bytes go through caches of the calling thread.
+        bool threadCaches = true;
+    };
+
+    struct TlsfHeapStats
+    {
+        std::size_t pools = 0;
+        std::size_t poolBytes = 0;
+        // Of `poolBytes`, those mapped with huge pages or advised to use them.
+        std::size_t hugePageBytes = 0;
+        // Blocks handed out, including those held by thread caches.
+        std::size_t usedBytes = 0;
+        std::size_t peakUsedBytes = 0;
+        std::size_t cachedBytes = 0;
+        std::size_t freeBytes = 0;
+        std::size_t freeBlocks = 0;
+        std::size_t largestFreeBlock = 0;
+        // 1 - sum of each pool's largest free block / free bytes: 0 while the free memory of each pool is
+        // in one piece, close to 1 when it's splintered into blocks too small for bigger requests.
+        double fragmentation = 0.0;
+    };
+
+    // Two-level segregated fit heap (TLSF). Allocating and freeing take constant time whatever the state
+    // of the heap: two bitmap scans find a free block, freed blocks merge with their neighbours right
+    // away. For allocations that aren't frame-scoped or of a fixed size, where malloc's occasional long
+    // pauses show up as hitches. Small blocks go through per-thread caches, which take the heap's lock
+    // only to refill or trim in batches. Thread-safe.
+    class TlsfHeap
+    {
+    public:
+        static constexpr std::size_t Alignment = 16;
+        static constexpr std::size_t MaxCachedSize = 256;
+        // Threads beyond this many at once bypass the caches. Blocks in the cache of a thread that
+        // exited go to the next thread starting.
+        static constexpr std::size_t MaxCacheThreads = 64;
+        static constexpr std::size_t MaxAllocationSize = std::size_t(1) << 38;
+
+        explicit TlsfHeap(TlsfHeapOptions options = TlsfHeapOptions());
+        // Unmaps the pools, with everything still allocated from them.
+        ~TlsfHeap();
+
+        TlsfHeap(const TlsfHeap&) = delete;
+        TlsfHeap& operator=(const TlsfHeap&) = delete;
+
+        // `alignment` is a power of 2. Returns `nullptr` if out of memory.
+        void* Allocate(std::size_t size, std::size_t alignment = Alignment);
+        // `memory` is `nullptr` or was allocated from this heap.
+        void Free(void* memory);
+
+        // Usable bytes at `memory`, at least what was asked for.
+        static std::size_t GetSize(const void* memory);
+
+        TlsfHeapStats GetStats() const;
+        void Report() const;
+
+    private:
+        static constexpr std::size_t FirstLevelCount = 32;
+        static constexpr std::size_t SecondLevelCount = 32;
+        static constexpr std::size_t MaxPools = 64;
+        static constexpr std::size_t CacheClassCount = MaxCachedSize / Alignment;
+
+        struct Pool
+        {
+            void* memory;
+            std::size_t size;
+            bool hugePages;
+        };
+
+        // Used by one thread at a time, see `TlsfHeap.cpp`.
+        struct alignas(64) ThreadCache
+        {
+            // Per size class, linked through their payload.
+            Detail::TlsfBlock* blocks[CacheClassCount] = {};
+            std::uint32_t counts[CacheClassCount] = {};
+            // Written by the owning thread only, read by `GetStats`.
+            std::atomic<std::size_t> bytes { 0 };
+        };
+
+        static void MapSize(std::size_t size, std::size_t& firstLevel, std::size_t& secondLevel);
+
+        // With `mutex` held.
+        bool AddPool(std::size_t minimumSize);
+        Detail::TlsfBlock* TakeFree(std::size_t size);
+        void InsertFree(Detail::TlsfBlock* block);
+        void RemoveFree(Detail::TlsfBlock* block);
+        void* AllocateLocked(std::size_t size, std::size_t alignment);
+        void FreeLocked(Detail::TlsfBlock* block);
+
+        void* AllocateCached(ThreadCache& cache, std::size_t sizeClass);
+        void FreeCached(ThreadCache& cache, Detail::TlsfBlock* block, std::size_t sizeClass);
+
+        TlsfHeapOptions options;
+        mutable std::mutex mutex;
+        // Bit per first level with a non-empty list, bit per non-empty list of a first level.
+        std::uint32_t firstLevelMap = 0;
+        std::uint32_t secondLevelMaps[FirstLevelCount] = {};
+        Detail::TlsfBlock* freeLists[FirstLevelCount][SecondLevelCount] = {};
+        Pool pools[MaxPools] = {};
+        std::size_t poolCount = 0;
+        std::size_t usedBytes = 0;
+        std::size_t peakUsedBytes = 0;
+        std::size_t freeBytes = 0;
+        std::size_t freeBlockCount = 0;
+        ThreadCache caches[MaxCacheThreads];
+    };
+}
+
+#endif
@@ -0,0 +1,47 @@
+#include <Engine/Core/AtomicFile.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#endif
+
+namespace Engine::Core
+{
+    bool WriteFileAtomically(const std::string& path, const std::function<void(std::ostream& file)>& write)
+    {
+        std::string temporaryPath = path + ".tmp";
+        bool written;
+        {
+            std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+            if (file)
+                write(file);
+            file.flush();
+            written = static_cast<bool>(file);
+        }
+
+        // `std::rename` doesn't replace existing files on Windows.
+#if defined(_WIN32)
+        bool renamed = written && MoveFileExA(temporaryPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+        bool renamed = written && std::rename(temporaryPath.c_str(), path.c_str()) == 0;
+#endif
+
+        if (!renamed)
+        {
+            std::cout << "Something went wrong writing \"" << path << "\"." << std::endl;
+            std::remove(temporaryPath.c_str());
+        }
+
+        return renamed;
+    }
+
+    bool WriteFileAtomically(const std::string& path, const void* data, std::size_t size)
+    {
+        return WriteFileAtomically(path, [data, size](std::ostream& file) { file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size)); });
+    }
+}
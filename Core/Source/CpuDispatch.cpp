@@ -0,0 +1,118 @@
+#include <Engine/Core/CpuDispatch.hpp>
+
+#include <SDL2/SDL_cpuinfo.h>
+#include <SDL2/SDL_stdinc.h>
+#include <cstdlib>
+#include <iostream>
+
+namespace Engine::Core
+{
+    namespace
+    {
+        constexpr CpuLevel Levels[] = { CpuLevel::Scalar, CpuLevel::NEON, CpuLevel::SSE2, CpuLevel::AVX2, CpuLevel::AVX512F };
+
+        // Constant initialized, so tables constructed during static initialization can link in.
+        CpuDispatchTable* tables = nullptr;
+
+        int GetRank(CpuLevel level)
+        {
+            switch (level)
+            {
+                case CpuLevel::Scalar: return 0;
+                case CpuLevel::NEON: return 1;
+                case CpuLevel::SSE2: return 1;
+                case CpuLevel::AVX2: return 2;
+                case CpuLevel::AVX512F: return 3;
+            }
+
+            return 0;
+        }
+
+        CpuLevel ReadLimit()
+        {
+            const char* value = std::getenv("ENGINE_CPU_LEVEL");
+            if (value == nullptr)
+                return CpuLevel::AVX512F;
+
+            for (CpuLevel level : Levels)
+            {
+                if (SDL_strcasecmp(value, GetCpuLevelName(level)) == 0)
+                    return level;
+            }
+
+            std::cout << "Unknown ENGINE_CPU_LEVEL \"" << value << "\", using every supported level." << std::endl;
+            return CpuLevel::AVX512F;
+        }
+
+        CpuLevel& GetLimit()
+        {
+            static CpuLevel limit = ReadLimit();
+            return limit;
+        }
+    }
+
+    const char* GetCpuLevelName(CpuLevel level)
+    {
+        switch (level)
+        {
+            case CpuLevel::Scalar: return "Scalar";
+            case CpuLevel::NEON: return "NEON";
+            case CpuLevel::SSE2: return "SSE2";
+            case CpuLevel::AVX2: return "AVX2";
+            case CpuLevel::AVX512F: return "AVX512F";
+        }
+
+        return "Unknown";
+    }
+
+    bool IsCpuLevelSupported(CpuLevel level)
+    {
+        switch (level)
+        {
+            case CpuLevel::Scalar: return true;
+            case CpuLevel::NEON: return SDL_HasNEON() == SDL_TRUE;
+            case CpuLevel::SSE2: return SDL_HasSSE2() == SDL_TRUE;
+            case CpuLevel::AVX2: return SDL_HasAVX2() == SDL_TRUE;
+            case CpuLevel::AVX512F: return SDL_HasAVX512F() == SDL_TRUE;
+        }
+
+        return false;
+    }
+
+    bool IsCpuLevelEnabled(CpuLevel level)
+    {
+        return GetRank(level) <= GetRank(GetLimit()) && IsCpuLevelSupported(level);
+    }
+
+    CpuLevel GetCpuLevelLimit()
+    {
+        return GetLimit();
+    }
+
+    void SetCpuLevelLimit(CpuLevel limit)
+    {
+        GetLimit() = limit;
+        for (CpuDispatchTable* table = tables; table != nullptr; table = table->next)
+            table->Select();
+    }
+
+    void ReportCpuDispatch()
+    {
+        std::cout << "CPU levels: Scalar";
+        for (CpuLevel level : Levels)
+        {
+            if (level != CpuLevel::Scalar && IsCpuLevelSupported(level))
+                std::cout << " " << GetCpuLevelName(level);
+        }
+
+        std::cout << " (limit " << GetCpuLevelName(GetLimit()) << ")" << std::endl;
+
+        for (const CpuDispatchTable* table = tables; table != nullptr; table = table->next)
+            std::cout << "  " << table->name << ": " << GetCpuLevelName(table->level) << std::endl;
+    }
+
+    CpuDispatchTable::CpuDispatchTable(const char* name) : name(name), next(tables)
+    {
+        tables = this;
+    }
+}
@@ -0,0 +1,455 @@
+#include <Engine/Core/FlightRecorder.hpp>
+#include <Engine/Core/MemoryTracking.hpp>
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_filesystem.h>
+#include <SDL2/SDL_stdinc.h>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace Engine::Core
+{
+    namespace
+    {
+        std::atomic<FlightRecorder*> active { nullptr };
+        std::atomic<std::uint64_t> nextGeneration { 1 };
+
+        // Calls into `active` in progress, per thread so that threads recording at the same time don't
+        // share a cache line. `SetFlightRecorder` waits for all of them.
+        struct alignas(64) CallCount
+        {
+            std::atomic<std::uint32_t> calls { 0 };
+            CallCount* next = nullptr;
+        };
+
+        std::mutex callCountsMutex;
+        CallCount* firstCallCount = nullptr;
+        // Calls during thread exit, after the thread's slot is destroyed.
+        CallCount exitingThreads;
+
+        class CallCountSlot
+        {
+        public:
+            CallCountSlot()
+            {
+                std::lock_guard<std::mutex> lock(callCountsMutex);
+                count.next = firstCallCount;
+                firstCallCount = &count;
+            }
+
+            ~CallCountSlot();
+
+            CallCountSlot(const CallCountSlot&) = delete;
+            CallCountSlot& operator=(const CallCountSlot&) = delete;
+
+            CallCount count;
+        };
+
+        thread_local bool slotDestroyed = false;
+        thread_local CallCountSlot slot;
+
+        CallCountSlot::~CallCountSlot()
+        {
+            std::lock_guard<std::mutex> lock(callCountsMutex);
+            CallCount** link = &firstCallCount;
+            while (*link != &count)
+                link = &(*link)->next;
+            *link = count.next;
+            slotDestroyed = true;
+        }
+
+        // The active recorder, counted as in use until destruction.
+        class ActiveRecorder
+        {
+        public:
+            ActiveRecorder()
+            {
+                // While nothing records this stays a single load.
+                if (active.load(std::memory_order_relaxed) == nullptr)
+                    return;
+
+                // Sequentially consistent like the store in `SetFlightRecorder`: either it sees this call
+                // counted, or this call sees its new recorder.
+                count = slotDestroyed ? &exitingThreads : &slot.count;
+                count->calls.fetch_add(1);
+                recorder = active.load();
+            }
+
+            ~ActiveRecorder()
+            {
+                if (count != nullptr)
+                    count->calls.fetch_sub(1, std::memory_order_release);
+            }
+
+            ActiveRecorder(const ActiveRecorder&) = delete;
+            ActiveRecorder& operator=(const ActiveRecorder&) = delete;
+
+            FlightRecorder* Get() const { return recorder; }
+
+        private:
+            CallCount* count = nullptr;
+            FlightRecorder* recorder = nullptr;
+        };
+
+        void WaitForCalls()
+        {
+            std::lock_guard<std::mutex> lock(callCountsMutex);
+            for (const CallCount* count = firstCallCount; count != nullptr; count = count->next)
+            {
+                while (count->calls.load() != 0)
+                    std::this_thread::yield();
+            }
+
+            while (exitingThreads.calls.load() != 0)
+                std::this_thread::yield();
+        }
+
+        std::size_t RoundUpToPowerOfTwo(std::size_t value)
+        {
+            std::size_t result = 1;
+            while (result < value)
+                result <<= 1;
+            return result;
+        }
+
+        void WriteJsonString(std::ostream& stream, const char* text)
+        {
+            stream << '"';
+            for (const char* c = text; *c != '\0'; ++c)
+            {
+                if (*c == '"' || *c == '\\')
+                    stream << '\\' << *c;
+                else if (static_cast<unsigned char>(*c) < 0x20)
+                    stream << ' ';
+                else
+                    stream << *c;
+            }
+            stream << '"';
+        }
+    }
+
+    FlightRecorder::FlightRecorder(FlightRecorderOptions options)
+        : options(std::move(options)), generation(nextGeneration.fetch_add(1, std::memory_order_relaxed)), creation(GetFlightTimestamp()),
+          ringMask(RoundUpToPowerOfTwo(std::max<std::size_t>(this->options.eventsPerThread, 2)) - 1)
+    {
+        if (this->options.directory.empty())
+            this->options.directory = GetDefaultDirectory();
+        lastAllocations = SampleMemoryStats().total.totalAllocations;
+
+        writer = std::thread(&FlightRecorder::WriterMain, this);
+    }
+
+    FlightRecorder::~FlightRecorder()
+    {
+        {
+            std::lock_guard<std::mutex> lock(writerMutex);
+            stopping = true;
+        }
+
+        snapshotAvailable.notify_one();
+        writer.join();
+    }
+
+    void FlightRecorder::RecordScope(const char* name, std::uint64_t start, std::uint64_t end)
+    {
+        Record(name, start, end > start ? end - start : 0, 0);
+    }
+
+    void FlightRecorder::RecordCounter(const char* name, std::int64_t value)
+    {
+        Record(name, GetFlightTimestamp(), CounterDuration, value);
+    }
+
+    bool FlightRecorder::EndFrame()
+    {
+        std::uint64_t now = GetFlightTimestamp();
+
+        // Only what's queued between pumps, a growing number means the frame loop falls behind input.
+        if (SDL_WasInit(SDL_INIT_EVENTS) != 0)
+        {
+            int depth = SDL_PeepEvents(nullptr, 0, SDL_PEEKEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT);
+            if (depth >= 0)
+                Record("Event queue", now, CounterDuration, depth);
+        }
+
+        // Merging the allocation counters once a frame also gives their high-water marks.
+        MemoryStats memory = SampleMemoryStats();
+        Record("Allocations", now, CounterDuration, static_cast<std::int64_t>(memory.total.totalAllocations - lastAllocations));
+        Record("Live KB", now, CounterDuration, static_cast<std::int64_t>(memory.total.liveBytes / 1024));
+        lastAllocations = memory.total.totalAllocations;
+
+        if (lastFrameEnd == 0)
+        {
+            lastFrameEnd = now;
+            return false;
+        }
+
+        Record("Frame", lastFrameEnd, now - lastFrameEnd, 0);
+        double milliseconds = static_cast<double>(now - lastFrameEnd) / 1e6;
+        lastFrameEnd = now;
+
+        bool hitch = options.frameBudgetMilliseconds > 0.0 && milliseconds > options.frameBudgetMilliseconds;
+        bool dump = false;
+        {
+            std::lock_guard<std::mutex> lock(statsMutex);
+            ++stats.frames;
+            stats.slowestFrameMilliseconds = std::max(stats.slowestFrameMilliseconds, milliseconds);
+            if (hitch)
+            {
+                ++stats.hitches;
+                dump = stats.dumps < options.maxDumps &&
+                       (lastDump == 0 || static_cast<double>(now - lastDump) / 1e9 >= options.minSecondsBetweenDumps);
+            }
+        }
+
+        if (dump)
+        {
+            std::ostringstream reason;
+            reason << std::fixed << std::setprecision(1) << "frame took " << milliseconds << " ms, budget " << options.frameBudgetMilliseconds << " ms";
+            Dump(reason.str());
+        }
+
+        return hitch;
+    }
+
+    std::string FlightRecorder::Dump(const std::string& reason)
+    {
+        std::uint64_t now = GetFlightTimestamp();
+
+        // The copy is the only part on the calling thread, formatting and writing happen on the writer.
+        Snapshot snapshot = TakeSnapshot(now);
+        snapshot.reason = reason;
+
+        {
+            std::lock_guard<std::mutex> lock(statsMutex);
+            lastDump = now;
+            std::uint64_t seconds = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+            snapshot.path = (std::filesystem::path(options.directory) / ("Hitch-" + std::to_string(seconds) + "-" + std::to_string(stats.dumps) + ".json")).string();
+            ++stats.dumps;
+        }
+
+        std::string path = snapshot.path;
+        {
+            std::lock_guard<std::mutex> lock(writerMutex);
+            snapshots.push_back(std::move(snapshot));
+        }
+
+        snapshotAvailable.notify_one();
+        return path;
+    }
+
+    FlightRecorderStats FlightRecorder::GetStats() const
+    {
+        FlightRecorderStats current;
+        {
+            std::lock_guard<std::mutex> lock(statsMutex);
+            current = stats;
+        }
+
+        std::lock_guard<std::mutex> lock(ringsMutex);
+        for (const std::unique_ptr<ThreadRing>& ring : rings)
+            current.events += ring->written.load(std::memory_order_relaxed);
+
+        return current;
+    }
+
+    void FlightRecorder::Report() const
+    {
+        FlightRecorderStats current = GetStats();
+
+        std::cout << std::fixed << std::setprecision(1) << "Flight recorder: " << current.events << " events over " << current.frames
+                  << " frames, slowest " << current.slowestFrameMilliseconds << " ms, " << current.hitches << " over the "
+                  << options.frameBudgetMilliseconds << " ms budget, " << current.dumps << " dumped to \"" << options.directory << "\"" << std::endl;
+    }
+
+    std::string FlightRecorder::GetDefaultDirectory()
+    {
+        std::string path = "Hitches";
+        if (char* basePath = SDL_GetBasePath())
+        {
+            path = basePath + path;
+            SDL_free(basePath);
+        }
+
+        return path;
+    }
+
+    FlightRecorder::ThreadRing& FlightRecorder::GetThreadRing()
+    {
+        // Threads keep the ring of the recorder they last recorded into.
+        thread_local std::uint64_t cachedGeneration = 0;
+        thread_local ThreadRing* cachedRing = nullptr;
+        if (cachedGeneration == generation)
+            return *cachedRing;
+
+        std::lock_guard<std::mutex> lock(ringsMutex);
+        std::thread::id id = std::this_thread::get_id();
+        auto found = std::find_if(rings.begin(), rings.end(), [id](const std::unique_ptr<ThreadRing>& ring) { return ring->owner == id; });
+        if (found == rings.end())
+        {
+            std::unique_ptr<ThreadRing> ring = std::make_unique<ThreadRing>();
+            ring->owner = id;
+            ring->thread = static_cast<std::uint32_t>(rings.size());
+            ring->events = std::make_unique<Event[]>(ringMask + 1);
+            found = rings.insert(rings.end(), std::move(ring));
+        }
+
+        cachedGeneration = generation;
+        cachedRing = found->get();
+        return *cachedRing;
+    }
+
+    void FlightRecorder::Record(const char* name, std::uint64_t start, std::uint64_t duration, std::int64_t value)
+    {
+        ThreadRing& ring = GetThreadRing();
+        std::uint64_t index = ring.written.load(std::memory_order_relaxed);
+        Event& event = ring.events[index & ringMask];
+        // Pairs with the fence in `TakeSnapshot`: a reader that sees any of the stores below also sees
+        // `written` at `index` or later, the previous event's release store.
+        std::atomic_thread_fence(std::memory_order_release);
+        event.name.store(name, std::memory_order_relaxed);
+        event.start.store(start, std::memory_order_relaxed);
+        event.duration.store(duration, std::memory_order_relaxed);
+        event.value.store(value, std::memory_order_relaxed);
+        ring.written.store(index + 1, std::memory_order_release);
+    }
+
+    FlightRecorder::Snapshot FlightRecorder::TakeSnapshot(std::uint64_t now) const
+    {
+        std::uint64_t windowStart = now - std::min(now, static_cast<std::uint64_t>(options.windowSeconds * 1e9));
+        std::uint64_t capacity = ringMask + 1;
+
+        Snapshot snapshot;
+        std::lock_guard<std::mutex> lock(ringsMutex);
+        for (const std::unique_ptr<ThreadRing>& ring : rings)
+        {
+            std::uint64_t end = ring->written.load(std::memory_order_acquire);
+            std::uint64_t begin = end - std::min(end, capacity);
+            std::size_t first = snapshot.events.size();
+
+            for (std::uint64_t index = begin; index < end; ++index)
+            {
+                const Event& event = ring->events[index & ringMask];
+                SnapshotEvent copy;
+                copy.name = event.name.load(std::memory_order_relaxed);
+                copy.thread = ring->thread;
+                copy.start = event.start.load(std::memory_order_relaxed);
+                copy.duration = event.duration.load(std::memory_order_relaxed);
+                copy.value = event.value.load(std::memory_order_relaxed);
+                snapshot.events.push_back(copy);
+            }
+
+            // Events the owner overwrote while they were copied are dropped, along with the ones
+            // outside the window. The fence keeps the copies above from being read after `written`.
+            std::atomic_thread_fence(std::memory_order_acquire);
+            std::uint64_t overwritten = ring->written.load(std::memory_order_relaxed);
+            auto kept = snapshot.events.begin() + static_cast<std::ptrdiff_t>(first);
+            std::uint64_t index = begin;
+            for (auto copy = kept; copy != snapshot.events.end(); ++copy, ++index)
+            {
+                std::uint64_t copyEnd = copy->duration == CounterDuration ? copy->start : copy->start + copy->duration;
+                if (index + capacity > overwritten && copy->name != nullptr && copyEnd >= windowStart)
+                    *kept++ = *copy;
+            }
+            snapshot.events.erase(kept, snapshot.events.end());
+        }
+
+        return snapshot;
+    }
+
+    void FlightRecorder::WriterMain()
+    {
+        std::unique_lock<std::mutex> lock(writerMutex);
+        while (true)
+        {
+            snapshotAvailable.wait(lock, [this] { return stopping || !snapshots.empty(); });
+            if (snapshots.empty())
+                return;
+
+            Snapshot snapshot = std::move(snapshots.front());
+            snapshots.pop_front();
+            lock.unlock();
+
+            std::sort(snapshot.events.begin(), snapshot.events.end(), [](const SnapshotEvent& a, const SnapshotEvent& b) { return a.start < b.start; });
+
+            std::error_code error;
+            std::filesystem::create_directories(std::filesystem::path(snapshot.path).parent_path(), error);
+
+            // Chrome's trace event format, timestamps in microseconds since the recorder was created.
+            std::ofstream file(snapshot.path, std::ios::trunc);
+            file << std::fixed << std::setprecision(3) << "{\"otherData\":{\"reason\":";
+            WriteJsonString(file, snapshot.reason.c_str());
+            file << "},\"traceEvents\":[";
+
+            std::uint32_t threads = 0;
+            for (const SnapshotEvent& event : snapshot.events)
+                threads = std::max(threads, event.thread + 1);
+            for (std::uint32_t thread = 0; thread < threads; ++thread)
+                file << (thread == 0 ? "" : ",") << "\n{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << thread
+                     << ",\"args\":{\"name\":\"Thread " << thread << "\"}}";
+
+            for (const SnapshotEvent& event : snapshot.events)
+            {
+                double timestamp = static_cast<double>(event.start - std::min(event.start, creation)) / 1e3;
+                file << ",\n{\"name\":";
+                WriteJsonString(file, event.name);
+                if (event.duration == CounterDuration)
+                    file << ",\"ph\":\"C\",\"ts\":" << timestamp << ",\"pid\":1,\"tid\":" << event.thread << ",\"args\":{\"value\":" << event.value << "}}";
+                else
+                    file << ",\"ph\":\"X\",\"ts\":" << timestamp << ",\"dur\":" << static_cast<double>(event.duration) / 1e3
+                         << ",\"pid\":1,\"tid\":" << event.thread << "}";
+            }
+
+            file << "\n]}\n";
+            file.close();
+
+            if (file)
+                std::cout << "Flight recorder: " << snapshot.reason << ", wrote \"" << snapshot.path << "\"" << std::endl;
+            else
+                std::cout << "Something went wrong writing the flight recorder dump \"" << snapshot.path << "\"" << std::endl;
+
+            lock.lock();
+        }
+    }
+
+    std::uint64_t GetFlightTimestamp()
+    {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    void SetFlightRecorder(FlightRecorder* recorder)
+    {
+        active.store(recorder);
+        WaitForCalls();
+    }
+
+    FlightRecorder* GetFlightRecorder()
+    {
+        return active.load(std::memory_order_acquire);
+    }
+
+    void RecordFlightScope(const char* name, std::uint64_t start, std::uint64_t end)
+    {
+        ActiveRecorder recorder;
+        if (recorder.Get() != nullptr)
+            recorder.Get()->RecordScope(name, start, end);
+    }
+
+    void RecordFlightCounter(const char* name, std::int64_t value)
+    {
+        ActiveRecorder recorder;
+        if (recorder.Get() != nullptr)
+            recorder.Get()->RecordCounter(name, value);
+    }
+
+    bool EndFlightFrame()
+    {
+        ActiveRecorder recorder;
+        return recorder.Get() != nullptr && recorder.Get()->EndFrame();
+    }
+}
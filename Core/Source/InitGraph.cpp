@@ -0,0 +1,459 @@
+#include <Engine/Core/InitGraph.hpp>
+
+#include <SDL2/SDL.h>
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <utility>
+
+namespace Engine::Core
+{
+    namespace
+    {
+        std::mutex sdlMutex;
+
+        const char* GetStateName(SubsystemState state)
+        {
+            switch (state)
+            {
+                case SubsystemState::Pending: return "not initialized";
+                case SubsystemState::Running: return "initializing";
+                case SubsystemState::Ready: return "ready";
+                case SubsystemState::Failed: return "failed";
+                case SubsystemState::Skipped: return "skipped";
+            }
+
+            return "unknown";
+        }
+
+        bool IsFinished(SubsystemState state)
+        {
+            return state == SubsystemState::Ready || state == SubsystemState::Failed || state == SubsystemState::Skipped;
+        }
+    }
+
+    InitGraph::InitGraph() : creation(std::chrono::steady_clock::now())
+    {
+    }
+
+    InitGraph::~InitGraph()
+    {
+        Shutdown();
+    }
+
+    void InitGraph::Add(SubsystemDesc desc)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        auto node = std::make_unique<Node>();
+        node->stats.name = desc.name;
+        node->stats.lazy = desc.lazy;
+        node->stats.mainThread = desc.mainThread;
+        node->desc = std::move(desc);
+        nodes.push_back(std::move(node));
+        resolved = false;
+    }
+
+    bool InitGraph::Run(ThreadPool& workers)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (!resolved && !Resolve())
+            return false;
+
+        runWorkers = &workers;
+        runRemaining = 0;
+
+        for (const std::unique_ptr<Node>& node : nodes)
+        {
+            if (!node->scheduled || IsFinished(node->stats.state))
+                continue;
+
+            node->counted = true;
+            node->remainingDependencies = 0;
+            ++runRemaining;
+        }
+
+        for (std::size_t i = 0; i < nodes.size(); ++i)
+        {
+            Node& node = *nodes[i];
+            if (!node.counted || node.stats.state != SubsystemState::Pending)
+                continue;
+
+            bool dependencyFailed = false;
+            for (std::size_t dependency : node.dependencies)
+            {
+                SubsystemState state = nodes[dependency]->stats.state;
+                dependencyFailed = dependencyFailed || state == SubsystemState::Failed || state == SubsystemState::Skipped;
+                if (!IsFinished(state))
+                    ++node.remainingDependencies;
+            }
+
+            if (dependencyFailed)
+                Finish(i, SubsystemState::Skipped);
+        }
+
+        for (std::size_t i = 0; i < nodes.size(); ++i)
+        {
+            if (nodes[i]->counted && nodes[i]->stats.state == SubsystemState::Pending && nodes[i]->remainingDependencies == 0)
+                Dispatch(i);
+        }
+
+        // Run main thread subsystems as they become ready, until the workers finished the rest.
+        while (true)
+        {
+            changed.wait(lock, [this] { return !mainThreadQueue.empty() || (runRemaining == 0 && pendingJobs == 0); });
+            if (mainThreadQueue.empty())
+                break;
+
+            std::size_t index = mainThreadQueue.back();
+            mainThreadQueue.pop_back();
+            if (nodes[index]->stats.state != SubsystemState::Pending)
+                continue;
+
+            nodes[index]->stats.state = SubsystemState::Running;
+            Execute(index, lock);
+        }
+
+        runWorkers = nullptr;
+
+        return std::all_of(nodes.begin(), nodes.end(), [](const std::unique_ptr<Node>& node)
+        {
+            return !node->scheduled || node->stats.state == SubsystemState::Ready;
+        });
+    }
+
+    bool InitGraph::Require(const std::string& name)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (!resolved && !Resolve())
+            return false;
+
+        std::size_t index = Find(name);
+        if (index == nodes.size())
+        {
+            std::cout << "Something went wrong requiring the unknown subsystem \"" << name << "\"." << std::endl;
+            return false;
+        }
+
+        Node& node = *nodes[index];
+
+        if (node.stats.state == SubsystemState::Pending)
+        {
+            // Claim it first so concurrent callers wait below instead of initializing it twice.
+            node.stats.state = SubsystemState::Running;
+            lock.unlock();
+
+            bool dependenciesReady = true;
+            for (std::size_t dependency : node.dependencies)
+                dependenciesReady = Require(nodes[dependency]->desc.name) && dependenciesReady;
+
+            lock.lock();
+            if (dependenciesReady)
+                Execute(index, lock);
+            else
+                Finish(index, SubsystemState::Skipped);
+        }
+
+        changed.wait(lock, [&node] { return IsFinished(node.stats.state); });
+        return node.stats.state == SubsystemState::Ready;
+    }
+
+    bool InitGraph::IsReady(const std::string& name) const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::size_t index = Find(name);
+        return index != nodes.size() && nodes[index]->stats.state == SubsystemState::Ready;
+    }
+
+    void InitGraph::Shutdown()
+    {
+        std::vector<std::size_t> order;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.swap(initializationOrder);
+            for (const std::unique_ptr<Node>& node : nodes)
+                node->stats.state = SubsystemState::Pending;
+        }
+
+        for (auto it = order.rbegin(); it != order.rend(); ++it)
+        {
+            if (nodes[*it]->desc.shutdown)
+                nodes[*it]->desc.shutdown();
+        }
+    }
+
+    void InitGraph::MarkFirstFrame()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (firstFrameMilliseconds < 0.0)
+            firstFrameMilliseconds = GetMilliseconds();
+    }
+
+    double InitGraph::GetTimeToFirstFrameMilliseconds() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return firstFrameMilliseconds;
+    }
+
+    std::vector<SubsystemStats> InitGraph::GetStats() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        std::vector<SubsystemStats> stats;
+        for (const std::unique_ptr<Node>& node : nodes)
+            stats.push_back(node->stats);
+
+        return stats;
+    }
+
+    void InitGraph::Report() const
+    {
+        std::vector<SubsystemStats> stats = GetStats();
+        std::stable_sort(stats.begin(), stats.end(), [](const SubsystemStats& a, const SubsystemStats& b)
+        {
+            return a.startMilliseconds < b.startMilliseconds;
+        });
+
+        std::size_t width = 0;
+        for (const SubsystemStats& subsystem : stats)
+            width = std::max(width, subsystem.name.size());
+
+        std::cout << std::fixed << std::setprecision(1) << "Subsystems:" << std::endl;
+        for (const SubsystemStats& subsystem : stats)
+        {
+            std::cout << "  " << std::left << std::setw(static_cast<int>(width)) << subsystem.name << std::right << "  ";
+            if (subsystem.state == SubsystemState::Ready || subsystem.state == SubsystemState::Failed)
+            {
+                std::cout << "at " << std::setw(7) << subsystem.startMilliseconds << " ms, took " << std::setw(7)
+                          << subsystem.durationMilliseconds << " ms";
+                if (subsystem.state == SubsystemState::Failed)
+                    std::cout << ", failed";
+            }
+            else
+                std::cout << GetStateName(subsystem.state);
+
+            if (subsystem.lazy)
+                std::cout << " (lazy)";
+            if (subsystem.mainThread)
+                std::cout << " (main thread)";
+            std::cout << std::endl;
+        }
+
+        double firstFrame = GetTimeToFirstFrameMilliseconds();
+        if (firstFrame >= 0.0)
+            std::cout << "Time to first frame: " << firstFrame << " ms" << std::endl;
+    }
+
+    std::size_t InitGraph::Find(const std::string& name) const
+    {
+        auto it = std::find_if(nodes.begin(), nodes.end(), [&name](const std::unique_ptr<Node>& node) { return node->desc.name == name; });
+        return static_cast<std::size_t>(it - nodes.begin());
+    }
+
+    bool InitGraph::Resolve()
+    {
+        for (const std::unique_ptr<Node>& node : nodes)
+        {
+            node->dependencies.clear();
+            node->dependents.clear();
+            node->scheduled = false;
+        }
+
+        for (std::size_t i = 0; i < nodes.size(); ++i)
+        {
+            for (const std::string& name : nodes[i]->desc.dependencies)
+            {
+                std::size_t dependency = Find(name);
+                if (dependency == nodes.size())
+                {
+                    std::cout << "Something went wrong resolving the subsystem \"" << nodes[i]->desc.name << "\", it depends on the unknown \""
+                              << name << "\"." << std::endl;
+                    return false;
+                }
+
+                nodes[i]->dependencies.push_back(dependency);
+                nodes[dependency]->dependents.push_back(i);
+            }
+        }
+
+        if (HasCycle())
+        {
+            std::cout << "Something went wrong resolving the subsystems, their dependencies form a cycle." << std::endl;
+            return false;
+        }
+
+        // Eager subsystems and everything they depend on.
+        std::vector<std::size_t> stack;
+        for (std::size_t i = 0; i < nodes.size(); ++i)
+        {
+            if (!nodes[i]->desc.lazy)
+                stack.push_back(i);
+        }
+
+        while (!stack.empty())
+        {
+            Node& node = *nodes[stack.back()];
+            stack.pop_back();
+            if (node.scheduled)
+                continue;
+
+            node.scheduled = true;
+            stack.insert(stack.end(), node.dependencies.begin(), node.dependencies.end());
+        }
+
+        resolved = true;
+        return true;
+    }
+
+    bool InitGraph::HasCycle() const
+    {
+        // Kahn's algorithm, a cycle leaves nodes that never reach zero remaining dependencies.
+        std::vector<std::size_t> remaining(nodes.size());
+        std::vector<std::size_t> ready;
+        for (std::size_t i = 0; i < nodes.size(); ++i)
+        {
+            remaining[i] = nodes[i]->dependencies.size();
+            if (remaining[i] == 0)
+                ready.push_back(i);
+        }
+
+        std::size_t visited = 0;
+        while (!ready.empty())
+        {
+            std::size_t index = ready.back();
+            ready.pop_back();
+            ++visited;
+
+            for (std::size_t dependent : nodes[index]->dependents)
+            {
+                if (--remaining[dependent] == 0)
+                    ready.push_back(dependent);
+            }
+        }
+
+        return visited != nodes.size();
+    }
+
+    void InitGraph::Execute(std::size_t index, std::unique_lock<std::mutex>& lock)
+    {
+        Node& node = *nodes[index];
+
+        lock.unlock();
+        double start = GetMilliseconds();
+        bool success = !node.desc.initialize || node.desc.initialize();
+        double end = GetMilliseconds();
+        lock.lock();
+
+        node.stats.startMilliseconds = start;
+        node.stats.durationMilliseconds = end - start;
+        Finish(index, success ? SubsystemState::Ready : SubsystemState::Failed);
+    }
+
+    void InitGraph::Finish(std::size_t index, SubsystemState state)
+    {
+        Node& node = *nodes[index];
+        node.stats.state = state;
+        if (state == SubsystemState::Ready)
+            initializationOrder.push_back(index);
+
+        if (node.counted)
+        {
+            node.counted = false;
+            --runRemaining;
+        }
+
+        for (std::size_t dependent : node.dependents)
+        {
+            Node& next = *nodes[dependent];
+            if (!next.counted || next.stats.state != SubsystemState::Pending)
+                continue;
+
+            if (state != SubsystemState::Ready)
+                Finish(dependent, SubsystemState::Skipped);
+            else if (--next.remainingDependencies == 0)
+                Dispatch(dependent);
+        }
+
+        changed.notify_all();
+    }
+
+    void InitGraph::Dispatch(std::size_t index)
+    {
+        if (nodes[index]->desc.mainThread)
+        {
+            mainThreadQueue.push_back(index);
+            changed.notify_all();
+            return;
+        }
+
+        ++pendingJobs;
+        runWorkers->Submit([this, index]
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+
+            // `Require` may have taken it over in the meantime.
+            if (nodes[index]->stats.state == SubsystemState::Pending)
+            {
+                nodes[index]->stats.state = SubsystemState::Running;
+                Execute(index, lock);
+            }
+
+            --pendingJobs;
+            changed.notify_all();
+        });
+    }
+
+    double InitGraph::GetMilliseconds() const
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - creation).count();
+    }
+
+    SubsystemDesc MakeSDLSubsystem(const std::string& name, std::uint32_t flags, std::vector<std::string> dependencies)
+    {
+        SubsystemDesc desc;
+        desc.name = name;
+        desc.dependencies = std::move(dependencies);
+        desc.mainThread = (flags & SDL_INIT_VIDEO) != 0;
+
+        desc.initialize = [name, flags]
+        {
+            std::lock_guard<std::mutex> lock(sdlMutex);
+            if (SDL_InitSubSystem(flags) != 0)
+            {
+                std::cout << "Something went wrong initializing " << name << ": " << SDL_GetError() << std::endl;
+                return false;
+            }
+
+            return true;
+        };
+
+        desc.shutdown = [flags]
+        {
+            std::lock_guard<std::mutex> lock(sdlMutex);
+            SDL_QuitSubSystem(flags);
+        };
+
+        return desc;
+    }
+
+    void AddSDLSubsystems(InitGraph& graph)
+    {
+        graph.Add(MakeSDLSubsystem("SDL events", SDL_INIT_EVENTS));
+        graph.Add(MakeSDLSubsystem("SDL timer", SDL_INIT_TIMER));
+        graph.Add(MakeSDLSubsystem("SDL video", SDL_INIT_VIDEO, { "SDL events" }));
+        graph.Add(MakeSDLSubsystem("SDL audio", SDL_INIT_AUDIO, { "SDL events" }));
+
+        std::pair<const char*, std::uint32_t> lazySubsystems[] = {
+            { "SDL game controller", SDL_INIT_GAMECONTROLLER },
+            { "SDL haptic", SDL_INIT_HAPTIC },
+            { "SDL sensor", SDL_INIT_SENSOR },
+        };
+
+        for (const auto& [name, flags] : lazySubsystems)
+        {
+            SubsystemDesc desc = MakeSDLSubsystem(name, flags, { "SDL events" });
+            desc.lazy = true;
+            graph.Add(std::move(desc));
+        }
+    }
+}
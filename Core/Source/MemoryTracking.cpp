@@ -0,0 +1,538 @@
+#include <Engine/Core/MemoryTracking.hpp>
+
+#include <Engine/Core/TlsfHeap.hpp>
+
+#include <SDL2/SDL_stdinc.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace Engine::Core
+{
+    namespace
+    {
+        // In front of every allocation, keeps the default alignment of 16.
+        struct alignas(16) AllocationHeader
+        {
+#if defined(ENGINE_CORE_DEBUG)
+            // Live allocations, for the leak report.
+            AllocationHeader* previous;
+            AllocationHeader* next;
+            void* caller;
+#endif
+            std::uint64_t size;
+            // From the start of the block to the memory handed out, more than the header if over-aligned.
+            std::uint32_t offset;
+            MemoryTag tag;
+        };
+
+        // Written by their thread only. Relaxed loads and stores compile to plain ones, and other threads
+        // can still read them while merging.
+        struct ThreadCounters
+        {
+            std::atomic<std::uint64_t> allocations[MemoryTagCount] = {};
+            std::atomic<std::uint64_t> frees[MemoryTagCount] = {};
+            std::atomic<std::uint64_t> allocatedBytes[MemoryTagCount] = {};
+            std::atomic<std::uint64_t> freedBytes[MemoryTagCount] = {};
+            ThreadCounters* next = nullptr;
+        };
+
+        struct Totals
+        {
+            std::uint64_t allocations[MemoryTagCount] = {};
+            std::uint64_t frees[MemoryTagCount] = {};
+            std::uint64_t allocatedBytes[MemoryTagCount] = {};
+            std::uint64_t freedBytes[MemoryTagCount] = {};
+        };
+
+        // None of this allocates, `operator new` uses it.
+        std::mutex threadsMutex;
+        ThreadCounters* firstThread = nullptr;
+        // Threads that exited, and allocations of threads whose counters are already destroyed.
+        Totals retired;
+        ThreadCounters exitingThreads;
+
+        void Add(std::atomic<std::uint64_t>& counter, std::uint64_t value)
+        {
+            counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        }
+
+        class ThreadCountersSlot
+        {
+        public:
+            ThreadCountersSlot()
+            {
+                std::lock_guard<std::mutex> lock(threadsMutex);
+                counters.next = firstThread;
+                firstThread = &counters;
+            }
+
+            ~ThreadCountersSlot();
+
+            ThreadCountersSlot(const ThreadCountersSlot&) = delete;
+            ThreadCountersSlot& operator=(const ThreadCountersSlot&) = delete;
+
+            ThreadCounters counters;
+        };
+
+        thread_local MemoryTag currentTag = MemoryTag::Untagged;
+        // Allocations during thread exit, after the slot's destructor, go to `exitingThreads`.
+        thread_local bool slotDestroyed = false;
+        thread_local ThreadCountersSlot slot;
+
+        ThreadCountersSlot::~ThreadCountersSlot()
+        {
+            std::lock_guard<std::mutex> lock(threadsMutex);
+            for (std::size_t tag = 0; tag < MemoryTagCount; ++tag)
+            {
+                retired.allocations[tag] += counters.allocations[tag].load(std::memory_order_relaxed);
+                retired.frees[tag] += counters.frees[tag].load(std::memory_order_relaxed);
+                retired.allocatedBytes[tag] += counters.allocatedBytes[tag].load(std::memory_order_relaxed);
+                retired.freedBytes[tag] += counters.freedBytes[tag].load(std::memory_order_relaxed);
+            }
+
+            ThreadCounters** link = &firstThread;
+            while (*link != &counters)
+                link = &(*link)->next;
+            *link = counters.next;
+            slotDestroyed = true;
+        }
+
+        void CountAllocation(MemoryTag tag, std::uint64_t size)
+        {
+            std::size_t index = static_cast<std::size_t>(tag);
+            if (slotDestroyed)
+            {
+                exitingThreads.allocations[index].fetch_add(1, std::memory_order_relaxed);
+                exitingThreads.allocatedBytes[index].fetch_add(size, std::memory_order_relaxed);
+                return;
+            }
+
+            ThreadCounters& counters = slot.counters;
+            Add(counters.allocations[index], 1);
+            Add(counters.allocatedBytes[index], size);
+        }
+
+        void CountFree(MemoryTag tag, std::uint64_t size)
+        {
+            std::size_t index = static_cast<std::size_t>(tag);
+            if (slotDestroyed)
+            {
+                exitingThreads.frees[index].fetch_add(1, std::memory_order_relaxed);
+                exitingThreads.freedBytes[index].fetch_add(size, std::memory_order_relaxed);
+                return;
+            }
+
+            ThreadCounters& counters = slot.counters;
+            Add(counters.frees[index], 1);
+            Add(counters.freedBytes[index], size);
+        }
+
+        Totals MergeCounters()
+        {
+            std::lock_guard<std::mutex> lock(threadsMutex);
+            Totals totals = retired;
+            auto add = [&totals](const ThreadCounters& counters)
+            {
+                for (std::size_t tag = 0; tag < MemoryTagCount; ++tag)
+                {
+                    totals.allocations[tag] += counters.allocations[tag].load(std::memory_order_relaxed);
+                    totals.frees[tag] += counters.frees[tag].load(std::memory_order_relaxed);
+                    totals.allocatedBytes[tag] += counters.allocatedBytes[tag].load(std::memory_order_relaxed);
+                    totals.freedBytes[tag] += counters.freedBytes[tag].load(std::memory_order_relaxed);
+                }
+            };
+
+            add(exitingThreads);
+            for (const ThreadCounters* counters = firstThread; counters != nullptr; counters = counters->next)
+                add(*counters);
+
+            return totals;
+        }
+
+#if defined(ENGINE_CORE_DEBUG)
+        std::mutex liveMutex;
+        AllocationHeader* firstLive = nullptr;
+
+        // At exit, registered by `TrackLive`. Lists the tagged allocations never freed, with their callers.
+        void ReportLeaks()
+        {
+            // Static objects destroyed after this was registered are gone by now, what's left leaked.
+            Totals totals = MergeCounters();
+            bool leaked = false;
+            for (std::size_t tag = 1; tag < MemoryTagCount; ++tag)
+                leaked = leaked || totals.allocations[tag] != totals.frees[tag];
+            if (!leaked)
+                return;
+
+            std::cout << "Memory leaked at exit:" << std::endl;
+            for (std::size_t tag = 1; tag < MemoryTagCount; ++tag)
+            {
+                if (totals.allocations[tag] != totals.frees[tag])
+                    std::cout << "  " << GetMemoryTagName(static_cast<MemoryTag>(tag)) << ": " << totals.allocations[tag] - totals.frees[tag]
+                              << " allocations, " << totals.allocatedBytes[tag] - totals.freedBytes[tag] << " bytes" << std::endl;
+            }
+
+            // Untagged ones are mostly the runtime's own.
+            std::lock_guard<std::mutex> lock(liveMutex);
+            std::size_t listed = 0;
+            for (const AllocationHeader* header = firstLive; header != nullptr && listed < 32; header = header->next)
+            {
+                if (header->tag == MemoryTag::Untagged)
+                    continue;
+
+                std::cout << "  " << header->size << " bytes of " << GetMemoryTagName(header->tag) << ", allocated from " << header->caller << std::endl;
+                ++listed;
+            }
+        }
+
+        void TrackLive(AllocationHeader* header, void* caller)
+        {
+            // The first allocation registers the report, so that it runs after the destructors of
+            // everything allocated later.
+            static bool registered = std::atexit(ReportLeaks) == 0;
+            (void)registered;
+
+            std::lock_guard<std::mutex> lock(liveMutex);
+            header->caller = caller;
+            header->previous = nullptr;
+            header->next = firstLive;
+            if (firstLive != nullptr)
+                firstLive->previous = header;
+            firstLive = header;
+        }
+
+        void UntrackLive(AllocationHeader* header)
+        {
+            std::lock_guard<std::mutex> lock(liveMutex);
+            (header->previous != nullptr ? header->previous->next : firstLive) = header->next;
+            if (header->next != nullptr)
+                header->next->previous = header->previous;
+        }
+#endif
+
+        struct Backend
+        {
+            DefaultAllocator allocator;
+            TlsfHeap* heap;
+        };
+
+        Backend CreateBackend()
+        {
+            // No output here, `std::cout` may not exist yet.
+            const char* value = std::getenv("ENGINE_ALLOCATOR");
+            bool tlsf = value != nullptr && SDL_strcasecmp(value, "tlsf") == 0;
+            bool hugePages = value != nullptr && SDL_strcasecmp(value, "tlsf-hugepages") == 0;
+            if (!tlsf && !hugePages)
+                return { DefaultAllocator::Malloc, nullptr };
+
+            // Never destroyed, static objects free into it until the very end.
+            alignas(TlsfHeap) static unsigned char storage[sizeof(TlsfHeap)];
+            TlsfHeapOptions options;
+            options.poolSize = std::size_t(32) << 20;
+            options.hugePages = hugePages;
+            return { DefaultAllocator::Tlsf, new (storage) TlsfHeap(options) };
+        }
+
+        const Backend& GetBackend()
+        {
+            static const Backend backend = CreateBackend();
+            return backend;
+        }
+
+        void* Allocate(std::size_t size, MemoryTag tag, std::size_t alignment, void* caller)
+        {
+            alignment = std::max(alignment, alignof(AllocationHeader));
+            std::size_t padding = alignment > alignof(AllocationHeader) ? alignment : 0;
+            if (size > static_cast<std::size_t>(-1) - sizeof(AllocationHeader) - padding)
+                return nullptr;
+
+            TlsfHeap* heap = GetBackend().heap;
+            std::size_t blockSize = sizeof(AllocationHeader) + padding + size;
+            void* block = heap != nullptr ? heap->Allocate(blockSize) : std::malloc(blockSize);
+            if (block == nullptr)
+                return nullptr;
+
+            std::uintptr_t start = reinterpret_cast<std::uintptr_t>(block);
+            std::uintptr_t memory = (start + sizeof(AllocationHeader) + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+            AllocationHeader* header = reinterpret_cast<AllocationHeader*>(memory) - 1;
+            header->size = size;
+            header->offset = static_cast<std::uint32_t>(memory - start);
+            header->tag = tag;
+            CountAllocation(tag, size);
+
+#if defined(ENGINE_CORE_DEBUG)
+            TrackLive(header, caller);
+#else
+            (void)caller;
+#endif
+
+            return reinterpret_cast<void*>(memory);
+        }
+
+        void Free(void* memory)
+        {
+            if (memory == nullptr)
+                return;
+
+            AllocationHeader* header = static_cast<AllocationHeader*>(memory) - 1;
+            CountFree(header->tag, header->size);
+
+#if defined(ENGINE_CORE_DEBUG)
+            UntrackLive(header);
+#endif
+
+            void* block = static_cast<char*>(memory) - header->offset;
+            if (TlsfHeap* heap = GetBackend().heap)
+                heap->Free(block);
+            else
+                std::free(block);
+        }
+
+        void* AllocateOrThrow(std::size_t size, std::size_t alignment, void* caller)
+        {
+            // `operator new(0)` returns a unique pointer.
+            size = std::max<std::size_t>(size, 1);
+            while (true)
+            {
+                if (void* memory = Allocate(size, currentTag, alignment, caller))
+                    return memory;
+
+                std::new_handler handler = std::get_new_handler();
+                if (handler == nullptr)
+                    throw std::bad_alloc();
+                handler();
+            }
+        }
+
+        void* AllocateOrNull(std::size_t size, std::size_t alignment, void* caller) noexcept
+        {
+            try
+            {
+                return AllocateOrThrow(size, alignment, caller);
+            }
+            catch (...)
+            {
+                return nullptr;
+            }
+        }
+
+        // Rates are measured over windows of at least a second.
+        std::mutex samplesMutex;
+        std::uint64_t peakBytes[MemoryTagCount + 1] = {};
+        const std::chrono::steady_clock::time_point trackingStart = std::chrono::steady_clock::now();
+        std::chrono::steady_clock::time_point rateStart = trackingStart;
+        Totals rateStartTotals;
+        double allocationRates[MemoryTagCount + 1] = {};
+        double byteRates[MemoryTagCount + 1] = {};
+    }
+
+    const char* GetMemoryTagName(MemoryTag tag)
+    {
+        switch (tag)
+        {
+            case MemoryTag::Untagged: return "Untagged";
+            case MemoryTag::Core: return "Core";
+            case MemoryTag::Graphics: return "Graphics";
+            case MemoryTag::Application: return "Application";
+        }
+
+        return "Unknown";
+    }
+
+    MemoryTag GetMemoryTag()
+    {
+        return currentTag;
+    }
+
+    MemoryTagScope::MemoryTagScope(MemoryTag tag) : previous(currentTag)
+    {
+        currentTag = tag;
+    }
+
+    MemoryTagScope::~MemoryTagScope()
+    {
+        currentTag = previous;
+    }
+
+#if defined(_MSC_VER)
+#define ENGINE_CORE_RETURN_ADDRESS() _ReturnAddress()
+#else
+#define ENGINE_CORE_RETURN_ADDRESS() __builtin_return_address(0)
+#endif
+
+    DefaultAllocator GetDefaultAllocator()
+    {
+        return GetBackend().allocator;
+    }
+
+    const char* GetDefaultAllocatorName()
+    {
+        switch (GetDefaultAllocator())
+        {
+            case DefaultAllocator::Malloc: return "malloc";
+            case DefaultAllocator::Tlsf: return "TLSF";
+        }
+
+        return "Unknown";
+    }
+
+    TlsfHeap* GetDefaultTlsfHeap()
+    {
+        return GetBackend().heap;
+    }
+
+    void* AllocateTagged(std::size_t size, MemoryTag tag, std::size_t alignment)
+    {
+        return Allocate(std::max<std::size_t>(size, 1), tag, alignment, ENGINE_CORE_RETURN_ADDRESS());
+    }
+
+    void FreeTagged(void* memory)
+    {
+        Free(memory);
+    }
+
+    MemoryStats SampleMemoryStats()
+    {
+        Totals totals = MergeCounters();
+        auto now = std::chrono::steady_clock::now();
+
+        std::lock_guard<std::mutex> lock(samplesMutex);
+        double rateSeconds = std::chrono::duration<double>(now - rateStart).count();
+        bool newWindow = rateSeconds >= 1.0 || rateStart == trackingStart;
+
+        MemoryStats stats;
+        for (std::size_t tag = 0; tag <= MemoryTagCount; ++tag)
+        {
+            MemoryTagStats& entry = tag < MemoryTagCount ? stats.tags[tag] : stats.total;
+            std::uint64_t startAllocations = 0;
+            std::uint64_t startBytes = 0;
+            // Threads are read one after another, a free can be counted before its allocation on another
+            // thread: the difference can come out negative for a moment.
+            std::int64_t liveAllocations = 0;
+            std::int64_t liveBytes = 0;
+            for (std::size_t part = 0; part < MemoryTagCount; ++part)
+            {
+                if (tag < MemoryTagCount && part != tag)
+                    continue;
+
+                entry.totalAllocations += totals.allocations[part];
+                entry.totalBytes += totals.allocatedBytes[part];
+                liveAllocations += static_cast<std::int64_t>(totals.allocations[part] - totals.frees[part]);
+                liveBytes += static_cast<std::int64_t>(totals.allocatedBytes[part] - totals.freedBytes[part]);
+                startAllocations += rateStartTotals.allocations[part];
+                startBytes += rateStartTotals.allocatedBytes[part];
+            }
+
+            entry.liveAllocations = static_cast<std::uint64_t>(std::max<std::int64_t>(liveAllocations, 0));
+            entry.liveBytes = static_cast<std::uint64_t>(std::max<std::int64_t>(liveBytes, 0));
+            peakBytes[tag] = std::max(peakBytes[tag], entry.liveBytes);
+            entry.peakBytes = peakBytes[tag];
+
+            if (newWindow && rateSeconds > 0.0)
+            {
+                allocationRates[tag] = static_cast<double>(entry.totalAllocations - startAllocations) / rateSeconds;
+                byteRates[tag] = static_cast<double>(entry.totalBytes - startBytes) / rateSeconds;
+            }
+            entry.allocationsPerSecond = allocationRates[tag];
+            entry.bytesPerSecond = byteRates[tag];
+        }
+
+        if (newWindow && rateSeconds >= 1.0)
+        {
+            rateStart = now;
+            rateStartTotals = totals;
+        }
+
+        return stats;
+    }
+
+    void ReportMemory()
+    {
+        MemoryStats stats = SampleMemoryStats();
+
+        std::cout << std::left << std::setw(16) << (std::string("Memory (") + GetDefaultAllocatorName() + ")") << std::right << std::setw(12) << "live MB" << std::setw(12) << "peak MB"
+                  << std::setw(12) << "live allocs" << std::setw(14) << "total allocs" << std::setw(12) << "allocs/s" << std::setw(10) << "MB/s" << std::endl;
+
+        auto print = [](const char* name, const MemoryTagStats& entry)
+        {
+            std::cout << std::left << std::setw(16) << name << std::right << std::fixed << std::setprecision(2)
+                      << std::setw(12) << static_cast<double>(entry.liveBytes) / (1024.0 * 1024.0)
+                      << std::setw(12) << static_cast<double>(entry.peakBytes) / (1024.0 * 1024.0)
+                      << std::setw(12) << entry.liveAllocations << std::setw(14) << entry.totalAllocations
+                      << std::setprecision(0) << std::setw(12) << entry.allocationsPerSecond
+                      << std::setprecision(2) << std::setw(10) << entry.bytesPerSecond / (1024.0 * 1024.0) << std::endl;
+        };
+
+        for (std::size_t tag = 0; tag < MemoryTagCount; ++tag)
+            print(GetMemoryTagName(static_cast<MemoryTag>(tag)), stats.tags[tag]);
+        print("Total", stats.total);
+
+        if (TlsfHeap* heap = GetDefaultTlsfHeap())
+            heap->Report();
+    }
+}
+
+// Everything allocated with `new` goes through the tracking above, charged to the thread's tag.
+
+void* operator new(std::size_t size)
+{
+    return Engine::Core::AllocateOrThrow(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__, ENGINE_CORE_RETURN_ADDRESS());
+}
+
+void* operator new[](std::size_t size)
+{
+    return Engine::Core::AllocateOrThrow(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__, ENGINE_CORE_RETURN_ADDRESS());
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return Engine::Core::AllocateOrNull(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__, ENGINE_CORE_RETURN_ADDRESS());
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return Engine::Core::AllocateOrNull(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__, ENGINE_CORE_RETURN_ADDRESS());
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    return Engine::Core::AllocateOrThrow(size, static_cast<std::size_t>(alignment), ENGINE_CORE_RETURN_ADDRESS());
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return Engine::Core::AllocateOrThrow(size, static_cast<std::size_t>(alignment), ENGINE_CORE_RETURN_ADDRESS());
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return Engine::Core::AllocateOrNull(size, static_cast<std::size_t>(alignment), ENGINE_CORE_RETURN_ADDRESS());
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return Engine::Core::AllocateOrNull(size, static_cast<std::size_t>(alignment), ENGINE_CORE_RETURN_ADDRESS());
+}
+
+void operator delete(void* memory) noexcept { Engine::Core::Free(memory); }
+void operator delete[](void* memory) noexcept { Engine::Core::Free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { Engine::Core::Free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { Engine::Core::Free(memory); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept { Engine::Core::Free(memory); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept { Engine::Core::Free(memory); }
+void operator delete(void* memory, std::align_val_t) noexcept { Engine::Core::Free(memory); }
+void operator delete[](void* memory, std::align_val_t) noexcept { Engine::Core::Free(memory); }
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept { Engine::Core::Free(memory); }
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept { Engine::Core::Free(memory); }
+void operator delete(void* memory, std::align_val_t, const std::nothrow_t&) noexcept { Engine::Core::Free(memory); }
+void operator delete[](void* memory, std::align_val_t, const std::nothrow_t&) noexcept { Engine::Core::Free(memory); }
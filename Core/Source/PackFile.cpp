@@ -0,0 +1,381 @@
+#include <Engine/Core/PackFile.hpp>
+#include <Engine/Core/AtomicFile.hpp>
+#include <Engine/Core/MemoryTracking.hpp>
+#include <Engine/Core/StartupPrefetch.hpp>
+
+#include <SDL2/SDL_rwops.h>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <numeric>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Engine::Core
+{
+    namespace Detail
+    {
+        // The mapped file, shared by the pack and its open streams.
+        struct PackMapping
+        {
+            ~PackMapping()
+            {
+                if (data == nullptr)
+                    return;
+
+#if defined(_WIN32)
+                UnmapViewOfFile(data);
+#else
+                munmap(data, size);
+#endif
+            }
+
+            void* data = nullptr;
+            std::size_t size = 0;
+        };
+    }
+
+    namespace
+    {
+        constexpr std::uint32_t Magic = 0x4B434150; // "PACK"
+        constexpr std::uint32_t Version = 1;
+        // Entry data alignment, enough for any SIMD load of the contents.
+        constexpr std::uint64_t Alignment = 64;
+
+        struct Header
+        {
+            std::uint32_t magic;
+            std::uint32_t version;
+            std::uint64_t entryCount;
+        };
+
+        std::shared_ptr<Detail::PackMapping> Map(const std::string& path)
+        {
+            auto mapping = std::make_shared<Detail::PackMapping>();
+
+#if defined(_WIN32)
+            HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (file == INVALID_HANDLE_VALUE)
+                return nullptr;
+
+            LARGE_INTEGER size;
+            HANDLE section = nullptr;
+            if (GetFileSizeEx(file, &size) && size.QuadPart > 0)
+                section = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+            if (section != nullptr)
+            {
+                mapping->data = MapViewOfFile(section, FILE_MAP_READ, 0, 0, 0);
+                mapping->size = static_cast<std::size_t>(size.QuadPart);
+                CloseHandle(section);
+            }
+
+            CloseHandle(file);
+#else
+            int file = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (file < 0)
+                return nullptr;
+
+            struct stat status;
+            if (fstat(file, &status) == 0 && status.st_size > 0)
+            {
+                void* data = mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_SHARED, file, 0);
+                if (data != MAP_FAILED)
+                {
+                    mapping->data = data;
+                    mapping->size = static_cast<std::size_t>(status.st_size);
+                }
+            }
+
+            // The mapping stays valid without the descriptor.
+            close(file);
+#endif
+
+            return mapping->data != nullptr ? mapping : nullptr;
+        }
+
+        void AdviseWillNeed(const void* data, std::size_t size)
+        {
+            if (size == 0)
+                return;
+
+#if defined(_WIN32)
+            WIN32_MEMORY_RANGE_ENTRY range = { const_cast<void*>(data), size };
+            PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#else
+            // `madvise` wants a page aligned start.
+            std::uintptr_t pageSize = static_cast<std::uintptr_t>(sysconf(_SC_PAGESIZE));
+            std::uintptr_t begin = reinterpret_cast<std::uintptr_t>(data) & ~(pageSize - 1);
+            std::uintptr_t end = reinterpret_cast<std::uintptr_t>(data) + size;
+            madvise(reinterpret_cast<void*>(begin), end - begin, MADV_WILLNEED);
+#endif
+        }
+
+        // State of an open stream, in `SDL_RWops::hidden.unknown.data1`.
+        struct Stream
+        {
+            std::shared_ptr<Detail::PackMapping> mapping;
+            const std::uint8_t* begin;
+            const std::uint8_t* position;
+            const std::uint8_t* end;
+        };
+
+        Stream* GetStream(SDL_RWops* context)
+        {
+            return static_cast<Stream*>(context->hidden.unknown.data1);
+        }
+
+        Sint64 SDLCALL StreamSize(SDL_RWops* context)
+        {
+            Stream* stream = GetStream(context);
+            return stream->end - stream->begin;
+        }
+
+        Sint64 SDLCALL StreamSeek(SDL_RWops* context, Sint64 offset, int whence)
+        {
+            Stream* stream = GetStream(context);
+
+            const std::uint8_t* base = stream->begin;
+            if (whence == RW_SEEK_CUR)
+                base = stream->position;
+            else if (whence == RW_SEEK_END)
+                base = stream->end;
+            else if (whence != RW_SEEK_SET)
+                return SDL_SetError("Unknown seek origin %d", whence);
+
+            // Clamped like SDL's memory streams.
+            Sint64 target = std::clamp<Sint64>((base - stream->begin) + offset, 0, stream->end - stream->begin);
+            stream->position = stream->begin + target;
+            return target;
+        }
+
+        std::size_t SDLCALL StreamRead(SDL_RWops* context, void* destination, std::size_t size, std::size_t count)
+        {
+            Stream* stream = GetStream(context);
+            if (size == 0)
+                return 0;
+
+            std::size_t available = static_cast<std::size_t>(stream->end - stream->position) / size;
+            count = std::min(count, available);
+
+            std::memcpy(destination, stream->position, count * size);
+            stream->position += count * size;
+            return count;
+        }
+
+        std::size_t SDLCALL StreamWrite(SDL_RWops*, const void*, std::size_t, std::size_t)
+        {
+            SDL_SetError("Pack file streams are read-only");
+            return 0;
+        }
+
+        int SDLCALL StreamClose(SDL_RWops* context)
+        {
+            delete GetStream(context);
+            SDL_FreeRW(context);
+            return 0;
+        }
+    }
+
+    std::unique_ptr<PackFile> PackFile::Open(const std::string& path)
+    {
+        MemoryTagScope memoryTag(MemoryTag::Core);
+        std::shared_ptr<Detail::PackMapping> mapping = Map(path);
+        if (mapping == nullptr)
+        {
+            std::cout << "Something went wrong mapping the pack file \"" << path << "\"." << std::endl;
+            return nullptr;
+        }
+
+        const std::uint8_t* data = static_cast<const std::uint8_t*>(mapping->data);
+
+        Header header = {};
+        if (mapping->size >= sizeof(header))
+            std::memcpy(&header, data, sizeof(header));
+
+        if (header.magic != Magic || header.version != Version)
+        {
+            std::cout << "\"" << path << "\" is not a pack file of version " << Version << "." << std::endl;
+            return nullptr;
+        }
+
+        std::uint64_t tableSize = header.entryCount * (sizeof(std::uint64_t) + sizeof(Entry));
+        if (header.entryCount > mapping->size || tableSize > mapping->size - sizeof(header))
+        {
+            std::cout << "The pack file \"" << path << "\" is truncated." << std::endl;
+            return nullptr;
+        }
+
+        std::unique_ptr<PackFile> pack(new PackFile());
+        pack->hashes.resize(header.entryCount);
+        pack->entries.resize(header.entryCount);
+        std::memcpy(pack->hashes.data(), data + sizeof(header), pack->hashes.size() * sizeof(std::uint64_t));
+        std::memcpy(pack->entries.data(), data + sizeof(header) + pack->hashes.size() * sizeof(std::uint64_t), pack->entries.size() * sizeof(Entry));
+
+        // `Find` binary searches the hashes, which `Write` stores sorted and unique.
+        if (std::adjacent_find(pack->hashes.begin(), pack->hashes.end(), std::greater_equal<std::uint64_t>()) != pack->hashes.end())
+        {
+            std::cout << "The pack file \"" << path << "\" has an unsorted or duplicate entry." << std::endl;
+            return nullptr;
+        }
+
+        for (const Entry& entry : pack->entries)
+        {
+            if (entry.offset > mapping->size || entry.size > mapping->size - entry.offset)
+            {
+                std::cout << "The pack file \"" << path << "\" has an entry outside of the file." << std::endl;
+                return nullptr;
+            }
+        }
+
+        RecordFileAccess(path, 0, sizeof(header) + tableSize);
+
+        pack->path = path;
+        pack->mapping = std::move(mapping);
+        return pack;
+    }
+
+    bool PackFile::Write(const std::string& path, const std::vector<StringId>& names, const std::vector<std::string>& paths)
+    {
+        if (names.size() != paths.size())
+        {
+            std::cout << "Every pack entry needs a name and a path." << std::endl;
+            return false;
+        }
+
+        std::vector<std::size_t> order(names.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&names](std::size_t a, std::size_t b) { return names[a] < names[b]; });
+
+        for (std::size_t i = 1; i < order.size(); ++i)
+        {
+            if (names[order[i]] == names[order[i - 1]])
+            {
+                std::cout << "Two pack entries have the name hash " << names[order[i]].GetHash() << "." << std::endl;
+                return false;
+            }
+        }
+
+        std::vector<std::vector<char>> contents(names.size());
+        for (std::size_t i = 0; i < paths.size(); ++i)
+        {
+            std::ifstream file(paths[i], std::ios::binary | std::ios::ate);
+            if (!file)
+            {
+                std::cout << "Something went wrong opening \"" << paths[i] << "\"." << std::endl;
+                return false;
+            }
+
+            contents[i].resize(static_cast<std::size_t>(file.tellg()));
+            file.seekg(0);
+            file.read(contents[i].data(), static_cast<std::streamsize>(contents[i].size()));
+        }
+
+        Header header = { Magic, Version, names.size() };
+        std::vector<Entry> table;
+        std::uint64_t offset = sizeof(header) + names.size() * (sizeof(std::uint64_t) + sizeof(Entry));
+        for (std::size_t index : order)
+        {
+            offset = (offset + Alignment - 1) & ~(Alignment - 1);
+            table.push_back({ offset, contents[index].size() });
+            offset += contents[index].size();
+        }
+
+        return WriteFileAtomically(path, [&](std::ostream& file)
+        {
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+            for (std::size_t index : order)
+            {
+                std::uint64_t hash = names[index].GetHash();
+                file.write(reinterpret_cast<const char*>(&hash), sizeof(hash));
+            }
+
+            file.write(reinterpret_cast<const char*>(table.data()), static_cast<std::streamsize>(table.size() * sizeof(Entry)));
+
+            const char padding[Alignment] = {};
+            for (std::size_t i = 0; i < order.size(); ++i)
+            {
+                file.write(padding, static_cast<std::streamsize>(table[i].offset - static_cast<std::uint64_t>(file.tellp())));
+                file.write(contents[order[i]].data(), static_cast<std::streamsize>(contents[order[i]].size()));
+            }
+        });
+    }
+
+    PackFile::~PackFile() = default;
+
+    bool PackFile::Contains(StringId name) const
+    {
+        return Find(name) != nullptr;
+    }
+
+    const void* PackFile::GetData(StringId name, std::size_t& size) const
+    {
+        const Entry* entry = Find(name);
+        if (entry == nullptr)
+            return nullptr;
+
+        RecordFileAccess(path, entry->offset, entry->size);
+
+        size = static_cast<std::size_t>(entry->size);
+        return static_cast<const std::uint8_t*>(mapping->data) + entry->offset;
+    }
+
+    SDL_RWops* PackFile::OpenStream(StringId name) const
+    {
+        std::size_t size = 0;
+        const std::uint8_t* data = static_cast<const std::uint8_t*>(GetData(name, size));
+        if (data == nullptr)
+            return nullptr;
+
+        SDL_RWops* context = SDL_AllocRW();
+        if (context == nullptr)
+            return nullptr;
+
+        context->size = StreamSize;
+        context->seek = StreamSeek;
+        context->read = StreamRead;
+        context->write = StreamWrite;
+        context->close = StreamClose;
+        context->type = SDL_RWOPS_UNKNOWN;
+        context->hidden.unknown.data1 = new Stream { mapping, data, data, data + size };
+        return context;
+    }
+
+    void PackFile::Prefetch(StringId name) const
+    {
+        // Not through `GetData`, a hint isn't a read for the startup prefetch to record.
+        if (const Entry* entry = Find(name))
+            AdviseWillNeed(static_cast<const std::uint8_t*>(mapping->data) + entry->offset, static_cast<std::size_t>(entry->size));
+    }
+
+    void PackFile::PrefetchAll() const
+    {
+        AdviseWillNeed(mapping->data, mapping->size);
+    }
+
+    std::size_t PackFile::GetSize() const
+    {
+        return mapping->size;
+    }
+
+    const PackFile::Entry* PackFile::Find(StringId name) const
+    {
+        auto it = std::lower_bound(hashes.begin(), hashes.end(), name.GetHash());
+        if (it == hashes.end() || *it != name.GetHash())
+            return nullptr;
+
+        return &entries[it - hashes.begin()];
+    }
+}
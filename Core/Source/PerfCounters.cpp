@@ -0,0 +1,319 @@
+#include <Engine/Core/FlightRecorder.hpp>
+#include <Engine/Core/PerfCounters.hpp>
+
+#include <cerrno>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace Engine::Core
+{
+    namespace
+    {
+        std::mutex sitesMutex;
+        PerfScopeSite* firstSite = nullptr;
+        PerfScopeSite* lastSite = nullptr;
+
+#if defined(__linux__)
+        constexpr std::uint64_t EventConfigs[PerfCounterCount] =
+        {
+            PERF_COUNT_HW_CPU_CYCLES,
+            PERF_COUNT_HW_INSTRUCTIONS,
+            PERF_COUNT_HW_CACHE_MISSES,
+            PERF_COUNT_HW_BRANCH_MISSES
+        };
+
+        // One event group per thread, read with a single `read` of the leader.
+        class ThreadCounters
+        {
+        public:
+            ThreadCounters()
+            {
+                for (std::size_t counter = 0; counter < PerfCounterCount; ++counter)
+                {
+                    perf_event_attr attributes;
+                    std::memset(&attributes, 0, sizeof(attributes));
+                    attributes.size = sizeof(attributes);
+                    attributes.type = PERF_TYPE_HARDWARE;
+                    attributes.config = EventConfigs[counter];
+                    // User space only, which `perf_event_paranoid` 2 (the usual default) still allows.
+                    attributes.exclude_kernel = 1;
+                    attributes.exclude_hv = 1;
+                    attributes.disabled = leader < 0 ? 1 : 0;
+                    attributes.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+                    int descriptor = static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, leader, 0));
+                    if (descriptor < 0)
+                    {
+                        if (!error.empty())
+                            error += ", ";
+                        error += std::string(GetPerfCounterName(static_cast<PerfCounter>(counter))) + ": " + GetErrorReason(errno);
+                        continue;
+                    }
+
+                    if (leader < 0)
+                        leader = descriptor;
+                    descriptors[count] = descriptor;
+                    counters[count++] = static_cast<std::uint32_t>(counter);
+                    mask |= 1u << counter;
+                }
+
+                if (leader >= 0)
+                    ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+            }
+
+            ~ThreadCounters()
+            {
+                for (std::size_t i = 0; i < count; ++i)
+                    close(descriptors[i]);
+            }
+
+            ThreadCounters(const ThreadCounters&) = delete;
+            ThreadCounters& operator=(const ThreadCounters&) = delete;
+
+            bool Read(PerfCounterValues& values) const
+            {
+                values = PerfCounterValues();
+                if (leader < 0)
+                    return false;
+
+                // Number of events, time enabled, time running, then a value per event in opening order.
+                std::uint64_t buffer[3 + PerfCounterCount];
+                ssize_t size = read(leader, buffer, sizeof(buffer));
+                if (size < static_cast<ssize_t>(3 * sizeof(std::uint64_t)) || buffer[0] != count)
+                    return false;
+
+                // Not scheduled at all, for example more events than the PMU has counters on this core.
+                std::uint64_t enabled = buffer[1];
+                std::uint64_t running = buffer[2];
+                if (running == 0)
+                    return false;
+
+                double scale = running < enabled ? static_cast<double>(enabled) / static_cast<double>(running) : 1.0;
+                for (std::size_t i = 0; i < count; ++i)
+                    values.values[counters[i]] = static_cast<std::uint64_t>(static_cast<double>(buffer[3 + i]) * scale);
+                values.validMask = mask;
+                return true;
+            }
+
+            std::uint32_t GetMask() const { return mask; }
+            const std::string& GetError() const { return error; }
+
+        private:
+            static const char* GetErrorReason(int code)
+            {
+                switch (code)
+                {
+                    case EACCES:
+                    case EPERM: return "not permitted, see /proc/sys/kernel/perf_event_paranoid";
+                    case ENOENT:
+                    case EOPNOTSUPP: return "not supported by this CPU or VM";
+                    case ENOSYS: return "perf_event_open is not available";
+                    case EMFILE: return "too many open files";
+                    default: return std::strerror(code);
+                }
+            }
+
+            int leader = -1;
+            int descriptors[PerfCounterCount] = {};
+            std::uint32_t counters[PerfCounterCount] = {};
+            std::size_t count = 0;
+            std::uint32_t mask = 0;
+            std::string error;
+        };
+
+        const ThreadCounters& GetThreadCounters()
+        {
+            thread_local ThreadCounters counters;
+            return counters;
+        }
+#endif
+
+        void PrintPerMillion(std::uint64_t value, std::uint64_t calls)
+        {
+            std::cout << std::setw(10) << static_cast<double>(value) / static_cast<double>(calls) / 1e6;
+        }
+    }
+
+    const char* GetPerfCounterName(PerfCounter counter)
+    {
+        switch (counter)
+        {
+            case PerfCounter::Cycles: return "cycles";
+            case PerfCounter::Instructions: return "instructions";
+            case PerfCounter::CacheMisses: return "LLC misses";
+            case PerfCounter::BranchMisses: return "branch misses";
+        }
+
+        return "unknown";
+    }
+
+    double PerfCounterValues::GetInstructionsPerCycle() const
+    {
+        if (!IsValid(PerfCounter::Cycles) || !IsValid(PerfCounter::Instructions) || Get(PerfCounter::Cycles) == 0)
+            return 0.0;
+
+        return static_cast<double>(Get(PerfCounter::Instructions)) / static_cast<double>(Get(PerfCounter::Cycles));
+    }
+
+    PerfCounterValues PerfCounterValues::operator-(const PerfCounterValues& other) const
+    {
+        PerfCounterValues result;
+        result.validMask = validMask & other.validMask;
+        for (std::size_t i = 0; i < PerfCounterCount; ++i)
+        {
+            // Scaled multiplexed values can step back slightly.
+            if ((result.validMask >> i) & 1)
+                result.values[i] = values[i] > other.values[i] ? values[i] - other.values[i] : 0;
+        }
+
+        return result;
+    }
+
+    PerfCounterValues& PerfCounterValues::operator+=(const PerfCounterValues& other)
+    {
+        for (std::size_t i = 0; i < PerfCounterCount; ++i)
+            values[i] += other.values[i];
+        validMask |= other.validMask;
+        return *this;
+    }
+
+    bool ReadThreadPerfCounters(PerfCounterValues& values)
+    {
+#if defined(__linux__)
+        return GetThreadCounters().Read(values);
+#else
+        values = PerfCounterValues();
+        return false;
+#endif
+    }
+
+    std::uint32_t GetThreadPerfCounterMask()
+    {
+#if defined(__linux__)
+        return GetThreadCounters().GetMask();
+#else
+        return 0;
+#endif
+    }
+
+    std::string GetThreadPerfCounterError()
+    {
+#if defined(__linux__)
+        return GetThreadCounters().GetError();
+#else
+        return "hardware counters are only supported on Linux";
+#endif
+    }
+
+    PerfScopeSite::PerfScopeSite(const char* name) : name(name)
+    {
+        std::lock_guard<std::mutex> lock(sitesMutex);
+        (lastSite != nullptr ? lastSite->next : firstSite) = this;
+        lastSite = this;
+    }
+
+    void PerfScopeSite::Add(std::uint64_t elapsed, const PerfCounterValues& delta)
+    {
+        calls.fetch_add(1, std::memory_order_relaxed);
+        nanoseconds.fetch_add(elapsed, std::memory_order_relaxed);
+        for (std::size_t i = 0; i < PerfCounterCount; ++i)
+        {
+            if ((delta.validMask >> i) & 1)
+                values[i].fetch_add(delta.values[i], std::memory_order_relaxed);
+        }
+        validMask.fetch_or(delta.validMask, std::memory_order_relaxed);
+    }
+
+    PerfScope::PerfScope(PerfScopeSite& site) : site(site)
+    {
+        ReadThreadPerfCounters(counters);
+        start = std::chrono::steady_clock::now();
+    }
+
+    PerfScope::~PerfScope()
+    {
+        auto end = std::chrono::steady_clock::now();
+        PerfCounterValues now;
+        ReadThreadPerfCounters(now);
+        site.Add(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()), now - counters);
+
+        // Same clock as `GetFlightTimestamp`.
+        auto toTimestamp = [](std::chrono::steady_clock::time_point time)
+        {
+            return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count());
+        };
+        RecordFlightScope(site.GetName(), toTimestamp(start), toTimestamp(end));
+    }
+
+    std::vector<PerfScopeStats> GetPerfScopeStats()
+    {
+        std::lock_guard<std::mutex> lock(sitesMutex);
+        std::vector<PerfScopeStats> stats;
+        for (PerfScopeSite* site = firstSite; site != nullptr; site = site->next)
+        {
+            std::uint64_t calls = site->calls.load(std::memory_order_relaxed);
+            if (calls == 0)
+                continue;
+
+            PerfScopeStats& entry = stats.emplace_back();
+            entry.name = site->name;
+            entry.calls = calls;
+            entry.milliseconds = static_cast<double>(site->nanoseconds.load(std::memory_order_relaxed)) / 1e6;
+            for (std::size_t i = 0; i < PerfCounterCount; ++i)
+                entry.counters.values[i] = site->values[i].load(std::memory_order_relaxed);
+            entry.counters.validMask = site->validMask.load(std::memory_order_relaxed);
+        }
+
+        return stats;
+    }
+
+    void ResetPerfScopeStats()
+    {
+        std::lock_guard<std::mutex> lock(sitesMutex);
+        for (PerfScopeSite* site = firstSite; site != nullptr; site = site->next)
+        {
+            site->calls.store(0, std::memory_order_relaxed);
+            site->nanoseconds.store(0, std::memory_order_relaxed);
+            for (std::atomic<std::uint64_t>& value : site->values)
+                value.store(0, std::memory_order_relaxed);
+            site->validMask.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    void ReportPerfScopes()
+    {
+        std::vector<PerfScopeStats> stats = GetPerfScopeStats();
+        if (stats.empty())
+            return;
+
+        std::cout << std::left << std::setw(28) << "Scope" << std::right << std::setw(10) << "calls" << std::setw(12) << "ms/call"
+                  << std::setw(8) << "IPC" << std::setw(10) << "Minstr" << std::setw(10) << "MLLC" << std::setw(10) << "Mbranch"
+                  << "  (counters per call)" << std::endl;
+
+        for (const PerfScopeStats& entry : stats)
+        {
+            std::cout << std::left << std::setw(28) << entry.name << std::right << std::setw(10) << entry.calls
+                      << std::fixed << std::setprecision(3) << std::setw(12) << entry.milliseconds / static_cast<double>(entry.calls)
+                      << std::setprecision(2) << std::setw(8) << entry.counters.GetInstructionsPerCycle() << std::setprecision(4);
+
+            for (PerfCounter counter : { PerfCounter::Instructions, PerfCounter::CacheMisses, PerfCounter::BranchMisses })
+            {
+                if (entry.counters.IsValid(counter))
+                    PrintPerMillion(entry.counters.Get(counter), entry.calls);
+                else
+                    std::cout << std::setw(10) << "-";
+            }
+
+            std::cout << std::endl;
+        }
+    }
+}
@@ -0,0 +1,902 @@
+#include <Engine/Core/PixelConversion.hpp>
+#include <Engine/Core/CpuDispatch.hpp>
+
+#include <SDL2/SDL_surface.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+// GCC 12 flags the undefined vectors some AVX-512 intrinsics start from as uninitialized.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#include <immintrin.h>
+#pragma GCC diagnostic pop
+#else
+#include <immintrin.h>
+#endif
+#define ENGINE_CORE_PIXELS_X86
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define ENGINE_CORE_PIXELS_NEON
+#endif
+
+namespace Engine::Core
+{
+    namespace
+    {
+        using Byte = std::uint8_t;
+
+        // Rounded x / 255 for x in [0, 255 * 255].
+        inline std::uint32_t Divide255(std::uint32_t x)
+        {
+            x += 128;
+            return (x + (x >> 8)) >> 8;
+        }
+
+        inline std::uint32_t Load32(const Byte* pixel)
+        {
+            std::uint32_t value;
+            std::memcpy(&value, pixel, sizeof(value));
+            return value;
+        }
+
+        inline void Store32(Byte* pixel, std::uint32_t value)
+        {
+            std::memcpy(pixel, &value, sizeof(value));
+        }
+
+        // Reference implementations, and the tails the vector kernels leave over.
+        namespace Scalar
+        {
+            std::size_t SwapRedBlue(const Byte* source, Byte* destination, std::size_t count)
+            {
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    std::uint32_t pixel = Load32(source + i * 4);
+                    Store32(destination + i * 4, (pixel & 0xFF00FF00u) | ((pixel >> 16) & 0xFFu) | ((pixel & 0xFFu) << 16));
+                }
+
+                return count;
+            }
+
+            template<int Red, int Blue>
+            std::size_t ConvertToRGB565(const Byte* source, Byte* destination, std::size_t count)
+            {
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    const Byte* pixel = source + i * 4;
+                    std::uint16_t value = static_cast<std::uint16_t>(((pixel[Red] >> 3) << 11) | ((pixel[1] >> 2) << 5) | (pixel[Blue] >> 3));
+                    std::memcpy(destination + i * 2, &value, sizeof(value));
+                }
+
+                return count;
+            }
+
+            template<int Red, int Blue>
+            std::size_t ConvertFromRGB565(const Byte* source, Byte* destination, std::size_t count)
+            {
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    std::uint16_t value;
+                    std::memcpy(&value, source + i * 2, sizeof(value));
+
+                    std::uint32_t red = value >> 11;
+                    std::uint32_t green = (value >> 5) & 63;
+                    std::uint32_t blue = value & 31;
+
+                    Byte* pixel = destination + i * 4;
+                    pixel[Red] = static_cast<Byte>((red << 3) | (red >> 2));
+                    pixel[1] = static_cast<Byte>((green << 2) | (green >> 4));
+                    pixel[Blue] = static_cast<Byte>((blue << 3) | (blue >> 2));
+                    pixel[3] = 255;
+                }
+
+                return count;
+            }
+
+            std::size_t PremultiplyAlpha(const Byte* source, Byte* destination, std::size_t count)
+            {
+                for (std::size_t i = 0; i < count * 4; i += 4)
+                {
+                    std::uint32_t alpha = source[i + 3];
+                    destination[i + 0] = static_cast<Byte>(Divide255(source[i + 0] * alpha));
+                    destination[i + 1] = static_cast<Byte>(Divide255(source[i + 1] * alpha));
+                    destination[i + 2] = static_cast<Byte>(Divide255(source[i + 2] * alpha));
+                    destination[i + 3] = static_cast<Byte>(alpha);
+                }
+
+                return count;
+            }
+
+            std::size_t BlendAlpha(const Byte* source, Byte* destination, std::size_t count)
+            {
+                for (std::size_t i = 0; i < count * 4; i += 4)
+                {
+                    std::uint32_t alpha = source[i + 3];
+                    std::uint32_t inverse = 255 - alpha;
+                    for (int channel = 0; channel < 3; ++channel)
+                        destination[i + channel] = static_cast<Byte>(Divide255(source[i + channel] * alpha + destination[i + channel] * inverse));
+                    destination[i + 3] = static_cast<Byte>(Divide255(255 * alpha + destination[i + 3] * inverse));
+                }
+
+                return count;
+            }
+        }
+
+        // Each vector kernel handles a multiple of its width and returns how many pixels it converted.
+#if defined(ENGINE_CORE_PIXELS_X86)
+        namespace Sse2
+        {
+            ENGINE_CORE_TARGET("sse2") inline __m128i Divide255(__m128i x)
+            {
+                x = _mm_add_epi16(x, _mm_set1_epi16(128));
+                return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+            }
+
+            // Each pixel's alpha in all four of its 16-bit lanes.
+            ENGINE_CORE_TARGET("sse2") inline __m128i BroadcastAlpha(__m128i pixels)
+            {
+                return _mm_shufflehi_epi16(_mm_shufflelo_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+            }
+
+            ENGINE_CORE_TARGET("sse2") std::size_t SwapRedBlue(const Byte* source, Byte* destination, std::size_t count)
+            {
+                const __m128i alphaGreen = _mm_set1_epi32(static_cast<int>(0xFF00FF00u));
+                const __m128i low = _mm_set1_epi32(0xFF);
+
+                std::size_t i = 0;
+                for (; i + 4 <= count; i += 4)
+                {
+                    __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * 4));
+                    __m128i red = _mm_and_si128(_mm_srli_epi32(pixels, 16), low);
+                    __m128i blue = _mm_slli_epi32(_mm_and_si128(pixels, low), 16);
+                    pixels = _mm_or_si128(_mm_and_si128(pixels, alphaGreen), _mm_or_si128(red, blue));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i * 4), pixels);
+                }
+
+                return i;
+            }
+
+            // Red in the low byte for RGBA, in the third byte for BGRA.
+            template<bool RedFirst>
+            ENGINE_CORE_TARGET("sse2") inline __m128i PackRGB565(__m128i pixels)
+            {
+                const __m128i green = _mm_srli_epi32(_mm_and_si128(pixels, _mm_set1_epi32(0xFC00)), 5);
+                __m128i red;
+                __m128i blue;
+                if (RedFirst)
+                {
+                    red = _mm_slli_epi32(_mm_and_si128(pixels, _mm_set1_epi32(0xF8)), 8);
+                    blue = _mm_srli_epi32(_mm_and_si128(pixels, _mm_set1_epi32(0xF80000)), 19);
+                }
+                else
+                {
+                    red = _mm_srli_epi32(_mm_and_si128(pixels, _mm_set1_epi32(0xF80000)), 8);
+                    blue = _mm_srli_epi32(_mm_and_si128(pixels, _mm_set1_epi32(0xF8)), 3);
+                }
+
+                // Sign extend the low 16 bits so the saturating pack keeps them as they are.
+                __m128i packed = _mm_or_si128(_mm_or_si128(red, green), blue);
+                return _mm_srai_epi32(_mm_slli_epi32(packed, 16), 16);
+            }
+
+            template<bool RedFirst>
+            ENGINE_CORE_TARGET("sse2") std::size_t ConvertToRGB565(const Byte* source, Byte* destination, std::size_t count)
+            {
+                std::size_t i = 0;
+                for (; i + 8 <= count; i += 8)
+                {
+                    __m128i first = PackRGB565<RedFirst>(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * 4)));
+                    __m128i second = PackRGB565<RedFirst>(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * 4 + 16)));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i * 2), _mm_packs_epi32(first, second));
+                }
+
+                return i;
+            }
+
+            // Four RGB565 values zero extended to 32 bits.
+            template<bool RedFirst>
+            ENGINE_CORE_TARGET("sse2") inline __m128i UnpackRGB565(__m128i values)
+            {
+                __m128i red = _mm_srli_epi32(values, 11);
+                __m128i green = _mm_and_si128(_mm_srli_epi32(values, 5), _mm_set1_epi32(63));
+                __m128i blue = _mm_and_si128(values, _mm_set1_epi32(31));
+
+                red = _mm_or_si128(_mm_slli_epi32(red, 3), _mm_srli_epi32(red, 2));
+                green = _mm_or_si128(_mm_slli_epi32(green, 2), _mm_srli_epi32(green, 4));
+                blue = _mm_or_si128(_mm_slli_epi32(blue, 3), _mm_srli_epi32(blue, 2));
+
+                __m128i first = RedFirst ? red : blue;
+                __m128i third = RedFirst ? blue : red;
+                return _mm_or_si128(_mm_or_si128(first, _mm_slli_epi32(green, 8)),
+                                    _mm_or_si128(_mm_slli_epi32(third, 16), _mm_set1_epi32(static_cast<int>(0xFF000000u))));
+            }
+
+            template<bool RedFirst>
+            ENGINE_CORE_TARGET("sse2") std::size_t ConvertFromRGB565(const Byte* source, Byte* destination, std::size_t count)
+            {
+                const __m128i zero = _mm_setzero_si128();
+
+                std::size_t i = 0;
+                for (; i + 8 <= count; i += 8)
+                {
+                    __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * 2));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i * 4), UnpackRGB565<RedFirst>(_mm_unpacklo_epi16(values, zero)));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i * 4 + 16), UnpackRGB565<RedFirst>(_mm_unpackhi_epi16(values, zero)));
+                }
+
+                return i;
+            }
+
+            // Two pixels widened to 16-bit lanes, times their alpha, with alpha itself times 255.
+            ENGINE_CORE_TARGET("sse2") inline __m128i PremultiplyWide(__m128i wide)
+            {
+                const __m128i colorLanes = _mm_set_epi16(0, -1, -1, -1, 0, -1, -1, -1);
+                const __m128i alphaLanes = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+
+                __m128i alpha = _mm_or_si128(_mm_and_si128(BroadcastAlpha(wide), colorLanes), alphaLanes);
+                return Divide255(_mm_mullo_epi16(wide, alpha));
+            }
+
+            ENGINE_CORE_TARGET("sse2") std::size_t PremultiplyAlpha(const Byte* source, Byte* destination, std::size_t count)
+            {
+                const __m128i zero = _mm_setzero_si128();
+
+                std::size_t i = 0;
+                for (; i + 4 <= count; i += 4)
+                {
+                    __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * 4));
+                    __m128i low = PremultiplyWide(_mm_unpacklo_epi8(pixels, zero));
+                    __m128i high = PremultiplyWide(_mm_unpackhi_epi8(pixels, zero));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i * 4), _mm_packus_epi16(low, high));
+                }
+
+                return i;
+            }
+
+            ENGINE_CORE_TARGET("sse2") inline __m128i BlendWide(__m128i source, __m128i destination)
+            {
+                const __m128i colorLanes = _mm_set_epi16(0, -1, -1, -1, 0, -1, -1, -1);
+                const __m128i alphaLanes = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+
+                __m128i alpha = BroadcastAlpha(source);
+                __m128i inverse = _mm_sub_epi16(_mm_set1_epi16(255), alpha);
+                __m128i sourceFactor = _mm_or_si128(_mm_and_si128(alpha, colorLanes), alphaLanes);
+
+                // At most 255 * 255, which fits the unsigned 16-bit lanes.
+                __m128i sum = _mm_add_epi16(_mm_mullo_epi16(source, sourceFactor), _mm_mullo_epi16(destination, inverse));
+                return Divide255(sum);
+            }
+
+            ENGINE_CORE_TARGET("sse2") std::size_t BlendAlpha(const Byte* source, Byte* destination, std::size_t count)
+            {
+                const __m128i zero = _mm_setzero_si128();
+
+                std::size_t i = 0;
+                for (; i + 4 <= count; i += 4)
+                {
+                    __m128i sourcePixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * 4));
+                    __m128i destinationPixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(destination + i * 4));
+                    __m128i low = BlendWide(_mm_unpacklo_epi8(sourcePixels, zero), _mm_unpacklo_epi8(destinationPixels, zero));
+                    __m128i high = BlendWide(_mm_unpackhi_epi8(sourcePixels, zero), _mm_unpackhi_epi8(destinationPixels, zero));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i * 4), _mm_packus_epi16(low, high));
+                }
+
+                return i;
+            }
+        }
+#endif
+
+#if defined(ENGINE_CORE_PIXELS_X86)
+        // Eight pixels per step. Unpacking, shuffles and packing work within 128-bit lanes, which
+        // keeps pixels in place as long as every step stays within the lanes.
+        namespace Avx2
+        {
+            ENGINE_CORE_TARGET("avx2") inline __m256i Divide255(__m256i x)
+            {
+                x = _mm256_add_epi16(x, _mm256_set1_epi16(128));
+                return _mm256_srli_epi16(_mm256_add_epi16(x, _mm256_srli_epi16(x, 8)), 8);
+            }
+
+            ENGINE_CORE_TARGET("avx2") inline __m256i BroadcastAlpha(__m256i pixels)
+            {
+                return _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+            }
+
+            ENGINE_CORE_TARGET("avx2") std::size_t SwapRedBlue(const Byte* source, Byte* destination, std::size_t count)
+            {
+                const __m256i shuffle = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,
+                                                         2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+
+                std::size_t i = 0;
+                for (; i + 8 <= count; i += 8)
+                {
+                    __m256i pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i * 4));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i * 4), _mm256_shuffle_epi8(pixels, shuffle));
+                }
+
+                return i;
+            }
+
+            template<bool RedFirst>
+            ENGINE_CORE_TARGET("avx2") inline __m256i PackRGB565(__m256i pixels)
+            {
+                const __m256i green = _mm256_srli_epi32(_mm256_and_si256(pixels, _mm256_set1_epi32(0xFC00)), 5);
+                __m256i red;
+                __m256i blue;
+                if (RedFirst)
+                {
+                    red = _mm256_slli_epi32(_mm256_and_si256(pixels, _mm256_set1_epi32(0xF8)), 8);
+                    blue = _mm256_srli_epi32(_mm256_and_si256(pixels, _mm256_set1_epi32(0xF80000)), 19);
+                }
+                else
+                {
+                    red = _mm256_srli_epi32(_mm256_and_si256(pixels, _mm256_set1_epi32(0xF80000)), 8);
+                    blue = _mm256_srli_epi32(_mm256_and_si256(pixels, _mm256_set1_epi32(0xF8)), 3);
+                }
+
+                __m256i packed = _mm256_or_si256(_mm256_or_si256(red, green), blue);
+                return _mm256_srai_epi32(_mm256_slli_epi32(packed, 16), 16);
+            }
+
+            template<bool RedFirst>
+            ENGINE_CORE_TARGET("avx2") std::size_t ConvertToRGB565(const Byte* source, Byte* destination, std::size_t count)
+            {
+                std::size_t i = 0;
+                for (; i + 16 <= count; i += 16)
+                {
+                    __m256i first = PackRGB565<RedFirst>(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i * 4)));
+                    __m256i second = PackRGB565<RedFirst>(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i * 4 + 32)));
+                    // The pack interleaves the 128-bit lanes of both inputs, put them back in order.
+                    __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(first, second), _MM_SHUFFLE(3, 1, 2, 0));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i * 2), packed);
+                }
+
+                return i;
+            }
+
+            template<bool RedFirst>
+            ENGINE_CORE_TARGET("avx2") inline __m256i UnpackRGB565(__m256i values)
+            {
+                __m256i red = _mm256_srli_epi32(values, 11);
+                __m256i green = _mm256_and_si256(_mm256_srli_epi32(values, 5), _mm256_set1_epi32(63));
+                __m256i blue = _mm256_and_si256(values, _mm256_set1_epi32(31));
+
+                red = _mm256_or_si256(_mm256_slli_epi32(red, 3), _mm256_srli_epi32(red, 2));
+                green = _mm256_or_si256(_mm256_slli_epi32(green, 2), _mm256_srli_epi32(green, 4));
+                blue = _mm256_or_si256(_mm256_slli_epi32(blue, 3), _mm256_srli_epi32(blue, 2));
+
+                __m256i first = RedFirst ? red : blue;
+                __m256i third = RedFirst ? blue : red;
+                return _mm256_or_si256(_mm256_or_si256(first, _mm256_slli_epi32(green, 8)),
+                                       _mm256_or_si256(_mm256_slli_epi32(third, 16), _mm256_set1_epi32(static_cast<int>(0xFF000000u))));
+            }
+
+            template<bool RedFirst>
+            ENGINE_CORE_TARGET("avx2") std::size_t ConvertFromRGB565(const Byte* source, Byte* destination, std::size_t count)
+            {
+                std::size_t i = 0;
+                for (; i + 8 <= count; i += 8)
+                {
+                    __m256i values = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * 2)));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i * 4), UnpackRGB565<RedFirst>(values));
+                }
+
+                return i;
+            }
+
+            ENGINE_CORE_TARGET("avx2") inline __m256i PremultiplyWide(__m256i wide)
+            {
+                const __m256i colorLanes = _mm256_set_epi16(0, -1, -1, -1, 0, -1, -1, -1, 0, -1, -1, -1, 0, -1, -1, -1);
+                const __m256i alphaLanes = _mm256_set_epi16(255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0);
+
+                __m256i alpha = _mm256_or_si256(_mm256_and_si256(BroadcastAlpha(wide), colorLanes), alphaLanes);
+                return Divide255(_mm256_mullo_epi16(wide, alpha));
+            }
+
+            ENGINE_CORE_TARGET("avx2") std::size_t PremultiplyAlpha(const Byte* source, Byte* destination, std::size_t count)
+            {
+                const __m256i zero = _mm256_setzero_si256();
+
+                std::size_t i = 0;
+                for (; i + 8 <= count; i += 8)
+                {
+                    __m256i pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i * 4));
+                    __m256i low = PremultiplyWide(_mm256_unpacklo_epi8(pixels, zero));
+                    __m256i high = PremultiplyWide(_mm256_unpackhi_epi8(pixels, zero));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i * 4), _mm256_packus_epi16(low, high));
+                }
+
+                return i;
+            }
+
+            ENGINE_CORE_TARGET("avx2") inline __m256i BlendWide(__m256i source, __m256i destination)
+            {
+                const __m256i colorLanes = _mm256_set_epi16(0, -1, -1, -1, 0, -1, -1, -1, 0, -1, -1, -1, 0, -1, -1, -1);
+                const __m256i alphaLanes = _mm256_set_epi16(255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0);
+
+                __m256i alpha = BroadcastAlpha(source);
+                __m256i inverse = _mm256_sub_epi16(_mm256_set1_epi16(255), alpha);
+                __m256i sourceFactor = _mm256_or_si256(_mm256_and_si256(alpha, colorLanes), alphaLanes);
+
+                __m256i sum = _mm256_add_epi16(_mm256_mullo_epi16(source, sourceFactor), _mm256_mullo_epi16(destination, inverse));
+                return Divide255(sum);
+            }
+
+            ENGINE_CORE_TARGET("avx2") std::size_t BlendAlpha(const Byte* source, Byte* destination, std::size_t count)
+            {
+                const __m256i zero = _mm256_setzero_si256();
+
+                std::size_t i = 0;
+                for (; i + 8 <= count; i += 8)
+                {
+                    __m256i sourcePixels = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i * 4));
+                    __m256i destinationPixels = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(destination + i * 4));
+                    __m256i low = BlendWide(_mm256_unpacklo_epi8(sourcePixels, zero), _mm256_unpacklo_epi8(destinationPixels, zero));
+                    __m256i high = BlendWide(_mm256_unpackhi_epi8(sourcePixels, zero), _mm256_unpackhi_epi8(destinationPixels, zero));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i * 4), _mm256_packus_epi16(low, high));
+                }
+
+                return i;
+            }
+        }
+#endif
+
+#if defined(ENGINE_CORE_PIXELS_NEON)
+        // De-interleaving loads put each channel in its own register, eight pixels per step.
+        namespace Neon
+        {
+            inline uint8x8_t Divide255(uint16x8_t x)
+            {
+                x = vaddq_u16(x, vdupq_n_u16(128));
+                return vshrn_n_u16(vaddq_u16(x, vshrq_n_u16(x, 8)), 8);
+            }
+
+            std::size_t SwapRedBlue(const Byte* source, Byte* destination, std::size_t count)
+            {
+                std::size_t i = 0;
+                for (; i + 16 <= count; i += 16)
+                {
+                    uint8x16x4_t pixels = vld4q_u8(source + i * 4);
+                    uint8x16_t red = pixels.val[0];
+                    pixels.val[0] = pixels.val[2];
+                    pixels.val[2] = red;
+                    vst4q_u8(destination + i * 4, pixels);
+                }
+
+                return i;
+            }
+
+            template<int Red, int Blue>
+            std::size_t ConvertToRGB565(const Byte* source, Byte* destination, std::size_t count)
+            {
+                std::size_t i = 0;
+                for (; i + 8 <= count; i += 8)
+                {
+                    uint8x8x4_t pixels = vld4_u8(source + i * 4);
+                    uint16x8_t red = vshlq_n_u16(vmovl_u8(vshr_n_u8(pixels.val[Red], 3)), 11);
+                    uint16x8_t green = vshlq_n_u16(vmovl_u8(vshr_n_u8(pixels.val[1], 2)), 5);
+                    uint16x8_t blue = vmovl_u8(vshr_n_u8(pixels.val[Blue], 3));
+                    vst1q_u16(reinterpret_cast<std::uint16_t*>(destination + i * 2), vorrq_u16(vorrq_u16(red, green), blue));
+                }
+
+                return i;
+            }
+
+            template<int Red, int Blue>
+            std::size_t ConvertFromRGB565(const Byte* source, Byte* destination, std::size_t count)
+            {
+                std::size_t i = 0;
+                for (; i + 8 <= count; i += 8)
+                {
+                    uint16x8_t values = vld1q_u16(reinterpret_cast<const std::uint16_t*>(source + i * 2));
+                    uint8x8_t red = vshrn_n_u16(values, 11);
+                    uint8x8_t green = vmovn_u16(vandq_u16(vshrq_n_u16(values, 5), vdupq_n_u16(63)));
+                    uint8x8_t blue = vmovn_u16(vandq_u16(values, vdupq_n_u16(31)));
+
+                    uint8x8x4_t pixels;
+                    pixels.val[Red] = vorr_u8(vshl_n_u8(red, 3), vshr_n_u8(red, 2));
+                    pixels.val[1] = vorr_u8(vshl_n_u8(green, 2), vshr_n_u8(green, 4));
+                    pixels.val[Blue] = vorr_u8(vshl_n_u8(blue, 3), vshr_n_u8(blue, 2));
+                    pixels.val[3] = vdup_n_u8(255);
+                    vst4_u8(destination + i * 4, pixels);
+                }
+
+                return i;
+            }
+
+            std::size_t PremultiplyAlpha(const Byte* source, Byte* destination, std::size_t count)
+            {
+                std::size_t i = 0;
+                for (; i + 8 <= count; i += 8)
+                {
+                    uint8x8x4_t pixels = vld4_u8(source + i * 4);
+                    for (int channel = 0; channel < 3; ++channel)
+                        pixels.val[channel] = Divide255(vmull_u8(pixels.val[channel], pixels.val[3]));
+                    vst4_u8(destination + i * 4, pixels);
+                }
+
+                return i;
+            }
+
+            std::size_t BlendAlpha(const Byte* source, Byte* destination, std::size_t count)
+            {
+                std::size_t i = 0;
+                for (; i + 8 <= count; i += 8)
+                {
+                    uint8x8x4_t sourcePixels = vld4_u8(source + i * 4);
+                    uint8x8x4_t destinationPixels = vld4_u8(destination + i * 4);
+                    uint8x8_t alpha = sourcePixels.val[3];
+                    uint8x8_t inverse = vmvn_u8(alpha);
+
+                    for (int channel = 0; channel < 3; ++channel)
+                    {
+                        uint16x8_t sum = vmlal_u8(vmull_u8(sourcePixels.val[channel], alpha), destinationPixels.val[channel], inverse);
+                        destinationPixels.val[channel] = Divide255(sum);
+                    }
+
+                    uint16x8_t alphaSum = vmlal_u8(vmull_u8(alpha, vdup_n_u8(255)), destinationPixels.val[3], inverse);
+                    destinationPixels.val[3] = Divide255(alphaSum);
+                    vst4_u8(destination + i * 4, destinationPixels);
+                }
+
+                return i;
+            }
+        }
+#endif
+
+#if defined(ENGINE_CORE_PIXELS_X86)
+        // Sixteen pixels per step, for the kernels that only need 32-bit lanes. Premultiplying and
+        // blending need 16-bit multiplies from AVX-512BW, which SDL doesn't detect, and stay on AVX2.
+        namespace Avx512
+        {
+            ENGINE_CORE_TARGET("avx512f") std::size_t SwapRedBlue(const Byte* source, Byte* destination, std::size_t count)
+            {
+                const __m512i alphaGreen = _mm512_set1_epi32(static_cast<int>(0xFF00FF00u));
+                const __m512i low = _mm512_set1_epi32(0xFF);
+
+                std::size_t i = 0;
+                for (; i + 16 <= count; i += 16)
+                {
+                    __m512i pixels = _mm512_loadu_si512(source + i * 4);
+                    __m512i red = _mm512_and_si512(_mm512_srli_epi32(pixels, 16), low);
+                    __m512i blue = _mm512_slli_epi32(_mm512_and_si512(pixels, low), 16);
+                    _mm512_storeu_si512(destination + i * 4, _mm512_or_si512(_mm512_and_si512(pixels, alphaGreen), _mm512_or_si512(red, blue)));
+                }
+
+                return i;
+            }
+
+            template<bool RedFirst>
+            ENGINE_CORE_TARGET("avx512f") std::size_t ConvertToRGB565(const Byte* source, Byte* destination, std::size_t count)
+            {
+                const __m512i redMask = _mm512_set1_epi32(RedFirst ? 0xF8 : 0xF80000);
+                const __m512i greenMask = _mm512_set1_epi32(0xFC00);
+                const __m512i blueMask = _mm512_set1_epi32(RedFirst ? 0xF80000 : 0xF8);
+
+                std::size_t i = 0;
+                for (; i + 16 <= count; i += 16)
+                {
+                    __m512i pixels = _mm512_loadu_si512(source + i * 4);
+                    __m512i red = _mm512_and_si512(pixels, redMask);
+                    __m512i blue = _mm512_and_si512(pixels, blueMask);
+                    red = RedFirst ? _mm512_slli_epi32(red, 8) : _mm512_srli_epi32(red, 8);
+                    blue = RedFirst ? _mm512_srli_epi32(blue, 19) : _mm512_srli_epi32(blue, 3);
+                    __m512i green = _mm512_srli_epi32(_mm512_and_si512(pixels, greenMask), 5);
+
+                    // Truncating narrow, no sign tricks needed unlike the saturating packs.
+                    __m256i packed = _mm512_cvtepi32_epi16(_mm512_or_si512(_mm512_or_si512(red, green), blue));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i * 2), packed);
+                }
+
+                return i;
+            }
+
+            template<bool RedFirst>
+            ENGINE_CORE_TARGET("avx512f") std::size_t ConvertFromRGB565(const Byte* source, Byte* destination, std::size_t count)
+            {
+                std::size_t i = 0;
+                for (; i + 16 <= count; i += 16)
+                {
+                    __m512i values = _mm512_cvtepu16_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i * 2)));
+                    __m512i red = _mm512_srli_epi32(values, 11);
+                    __m512i green = _mm512_and_si512(_mm512_srli_epi32(values, 5), _mm512_set1_epi32(63));
+                    __m512i blue = _mm512_and_si512(values, _mm512_set1_epi32(31));
+
+                    red = _mm512_or_si512(_mm512_slli_epi32(red, 3), _mm512_srli_epi32(red, 2));
+                    green = _mm512_or_si512(_mm512_slli_epi32(green, 2), _mm512_srli_epi32(green, 4));
+                    blue = _mm512_or_si512(_mm512_slli_epi32(blue, 3), _mm512_srli_epi32(blue, 2));
+
+                    __m512i first = RedFirst ? red : blue;
+                    __m512i third = RedFirst ? blue : red;
+                    __m512i pixels = _mm512_or_si512(_mm512_or_si512(first, _mm512_slli_epi32(green, 8)),
+                                                     _mm512_or_si512(_mm512_slli_epi32(third, 16), _mm512_set1_epi32(static_cast<int>(0xFF000000u))));
+                    _mm512_storeu_si512(destination + i * 4, pixels);
+                }
+
+                return i;
+            }
+        }
+#endif
+
+        using Kernel = std::size_t (*)(const Byte* source, Byte* destination, std::size_t count);
+
+        struct PixelKernels
+        {
+            Kernel swapRedBlue;
+            Kernel rgbaToRGB565;
+            Kernel bgraToRGB565;
+            Kernel rgb565ToRGBA;
+            Kernel rgb565ToBGRA;
+            Kernel premultiplyAlpha;
+            Kernel blendAlpha;
+        };
+
+        constexpr PixelKernels ScalarKernels = {
+            Scalar::SwapRedBlue, Scalar::ConvertToRGB565<0, 2>, Scalar::ConvertToRGB565<2, 0>, Scalar::ConvertFromRGB565<0, 2>,
+            Scalar::ConvertFromRGB565<2, 0>, Scalar::PremultiplyAlpha, Scalar::BlendAlpha,
+        };
+
+#if defined(ENGINE_CORE_PIXELS_X86)
+        constexpr PixelKernels Sse2Kernels = {
+            Sse2::SwapRedBlue, Sse2::ConvertToRGB565<true>, Sse2::ConvertToRGB565<false>, Sse2::ConvertFromRGB565<true>,
+            Sse2::ConvertFromRGB565<false>, Sse2::PremultiplyAlpha, Sse2::BlendAlpha,
+        };
+
+        constexpr PixelKernels Avx2Kernels = {
+            Avx2::SwapRedBlue, Avx2::ConvertToRGB565<true>, Avx2::ConvertToRGB565<false>, Avx2::ConvertFromRGB565<true>,
+            Avx2::ConvertFromRGB565<false>, Avx2::PremultiplyAlpha, Avx2::BlendAlpha,
+        };
+
+        constexpr PixelKernels Avx512Kernels = {
+            Avx512::SwapRedBlue, Avx512::ConvertToRGB565<true>, Avx512::ConvertToRGB565<false>, Avx512::ConvertFromRGB565<true>,
+            Avx512::ConvertFromRGB565<false>, Avx2::PremultiplyAlpha, Avx2::BlendAlpha,
+        };
+#elif defined(ENGINE_CORE_PIXELS_NEON)
+        constexpr PixelKernels NeonKernels = {
+            Neon::SwapRedBlue, Neon::ConvertToRGB565<0, 2>, Neon::ConvertToRGB565<2, 0>, Neon::ConvertFromRGB565<0, 2>,
+            Neon::ConvertFromRGB565<2, 0>, Neon::PremultiplyAlpha, Neon::BlendAlpha,
+        };
+#endif
+
+        CpuDispatch<PixelKernels> kernels("Pixel conversion", {
+#if defined(ENGINE_CORE_PIXELS_X86)
+            { CpuLevel::AVX512F, &Avx512Kernels },
+            { CpuLevel::AVX2, &Avx2Kernels },
+            { CpuLevel::SSE2, &Sse2Kernels },
+#elif defined(ENGINE_CORE_PIXELS_NEON)
+            { CpuLevel::NEON, &NeonKernels },
+#endif
+            { CpuLevel::Scalar, &ScalarKernels },
+        });
+
+        // The selected kernel over as much of the row as it handles, the scalar one over the rest.
+        void Run(Kernel kernel, Kernel tail, const void* source, void* destination, std::size_t pixelCount,
+                 std::size_t sourceSize, std::size_t destinationSize)
+        {
+            const Byte* from = static_cast<const Byte*>(source);
+            Byte* to = static_cast<Byte*>(destination);
+            std::size_t done = kernel(from, to, pixelCount);
+            if (done < pixelCount)
+                tail(from + done * sourceSize, to + done * destinationSize, pixelCount - done);
+        }
+
+        // sRGB decoding is a 256 entry table. Encoding indexes a table with the linear value quantized
+        // to 14 bits, fine enough to be within rounding of the exact curve everywhere.
+        constexpr int EncodeBits = 14;
+        constexpr int EncodeSize = 1 << EncodeBits;
+
+        struct SRGBTables
+        {
+            float decode[256];
+            Byte encode[EncodeSize];
+
+            SRGBTables()
+            {
+                for (int i = 0; i < 256; ++i)
+                {
+                    double value = i / 255.0;
+                    decode[i] = static_cast<float>(value <= 0.04045 ? value / 12.92 : std::pow((value + 0.055) / 1.055, 2.4));
+                }
+
+                for (int i = 0; i < EncodeSize; ++i)
+                {
+                    double value = static_cast<double>(i) / (EncodeSize - 1);
+                    double encoded = value <= 0.0031308 ? value * 12.92 : 1.055 * std::pow(value, 1.0 / 2.4) - 0.055;
+                    encode[i] = static_cast<Byte>(std::lround(encoded * 255.0));
+                }
+            }
+        };
+
+        const SRGBTables& GetSRGBTables()
+        {
+            static const SRGBTables tables;
+            return tables;
+        }
+
+        // To [0, 1], NaN to 0. `std::clamp` lets NaN through, which would index past the table.
+        float ClampUnit(float value)
+        {
+            return !(value > 0.0f) ? 0.0f : (value < 1.0f ? value : 1.0f);
+        }
+
+        bool IsAlphaLast(std::uint32_t format)
+        {
+            return format == SDL_PIXELFORMAT_RGBA32 || format == SDL_PIXELFORMAT_BGRA32;
+        }
+
+        // Locks surfaces that need it for the duration of a kernel.
+        class SurfaceLock
+        {
+        public:
+            explicit SurfaceLock(const SDL_Surface* surface) : surface(const_cast<SDL_Surface*>(surface))
+            {
+                locked = SDL_MUSTLOCK(this->surface) && SDL_LockSurface(this->surface) == 0;
+            }
+
+            ~SurfaceLock()
+            {
+                if (locked)
+                    SDL_UnlockSurface(surface);
+            }
+
+        private:
+            SDL_Surface* surface;
+            bool locked = false;
+        };
+    }
+
+    void SwapRedBlue(const void* source, void* destination, std::size_t pixelCount)
+    {
+        Run(kernels->swapRedBlue, Scalar::SwapRedBlue, source, destination, pixelCount, 4, 4);
+    }
+
+    void ConvertRGBAToRGB565(const void* source, void* destination, std::size_t pixelCount)
+    {
+        Run(kernels->rgbaToRGB565, Scalar::ConvertToRGB565<0, 2>, source, destination, pixelCount, 4, 2);
+    }
+
+    void ConvertBGRAToRGB565(const void* source, void* destination, std::size_t pixelCount)
+    {
+        Run(kernels->bgraToRGB565, Scalar::ConvertToRGB565<2, 0>, source, destination, pixelCount, 4, 2);
+    }
+
+    void ConvertRGB565ToRGBA(const void* source, void* destination, std::size_t pixelCount)
+    {
+        Run(kernels->rgb565ToRGBA, Scalar::ConvertFromRGB565<0, 2>, source, destination, pixelCount, 2, 4);
+    }
+
+    void ConvertRGB565ToBGRA(const void* source, void* destination, std::size_t pixelCount)
+    {
+        Run(kernels->rgb565ToBGRA, Scalar::ConvertFromRGB565<2, 0>, source, destination, pixelCount, 2, 4);
+    }
+
+    void ConvertSRGBToLinear(const void* source, float* destination, std::size_t pixelCount)
+    {
+        const SRGBTables& tables = GetSRGBTables();
+        const Byte* from = static_cast<const Byte*>(source);
+        for (std::size_t i = 0; i < pixelCount * 4; i += 4)
+        {
+            destination[i + 0] = tables.decode[from[i + 0]];
+            destination[i + 1] = tables.decode[from[i + 1]];
+            destination[i + 2] = tables.decode[from[i + 2]];
+            destination[i + 3] = from[i + 3] * (1.0f / 255.0f);
+        }
+    }
+
+    void ConvertLinearToSRGB(const float* source, void* destination, std::size_t pixelCount)
+    {
+        const SRGBTables& tables = GetSRGBTables();
+        Byte* to = static_cast<Byte*>(destination);
+        for (std::size_t i = 0; i < pixelCount * 4; i += 4)
+        {
+            for (int channel = 0; channel < 3; ++channel)
+            {
+                float value = ClampUnit(source[i + channel]);
+                to[i + channel] = tables.encode[static_cast<int>(value * (EncodeSize - 1) + 0.5f)];
+            }
+
+            to[i + 3] = static_cast<Byte>(ClampUnit(source[i + 3]) * 255.0f + 0.5f);
+        }
+    }
+
+    void PremultiplyAlpha(const void* source, void* destination, std::size_t pixelCount)
+    {
+        Run(kernels->premultiplyAlpha, Scalar::PremultiplyAlpha, source, destination, pixelCount, 4, 4);
+    }
+
+    void BlendAlpha(const void* source, void* destination, std::size_t pixelCount)
+    {
+        Run(kernels->blendAlpha, Scalar::BlendAlpha, source, destination, pixelCount, 4, 4);
+    }
+
+    CpuLevel GetPixelKernelLevel()
+    {
+        return kernels.GetLevel();
+    }
+
+    bool ConvertSurfacePixels(const SDL_Surface* source, SDL_Surface* destination)
+    {
+        if (source->w != destination->w || source->h != destination->h)
+            return false;
+
+        std::uint32_t from = source->format->format;
+        std::uint32_t to = destination->format->format;
+
+        void (*convert)(const void*, void*, std::size_t) = nullptr;
+        if (from == to && (IsAlphaLast(from) || from == SDL_PIXELFORMAT_RGB565))
+            convert = nullptr;
+        else if (IsAlphaLast(from) && IsAlphaLast(to))
+            convert = SwapRedBlue;
+        else if (from == SDL_PIXELFORMAT_RGBA32 && to == SDL_PIXELFORMAT_RGB565)
+            convert = ConvertRGBAToRGB565;
+        else if (from == SDL_PIXELFORMAT_BGRA32 && to == SDL_PIXELFORMAT_RGB565)
+            convert = ConvertBGRAToRGB565;
+        else if (from == SDL_PIXELFORMAT_RGB565 && to == SDL_PIXELFORMAT_RGBA32)
+            convert = ConvertRGB565ToRGBA;
+        else if (from == SDL_PIXELFORMAT_RGB565 && to == SDL_PIXELFORMAT_BGRA32)
+            convert = ConvertRGB565ToBGRA;
+        else
+            return false;
+
+        SurfaceLock sourceLock(source);
+        SurfaceLock destinationLock(destination);
+
+        std::size_t rowBytes = static_cast<std::size_t>(source->w) * source->format->BytesPerPixel;
+        for (int y = 0; y < source->h; ++y)
+        {
+            const Byte* sourceRow = static_cast<const Byte*>(source->pixels) + y * source->pitch;
+            Byte* destinationRow = static_cast<Byte*>(destination->pixels) + y * destination->pitch;
+
+            if (convert != nullptr)
+                convert(sourceRow, destinationRow, source->w);
+            else if (sourceRow != destinationRow)
+                std::memcpy(destinationRow, sourceRow, rowBytes);
+        }
+
+        return true;
+    }
+
+    bool PremultiplySurfaceAlpha(SDL_Surface* surface)
+    {
+        if (!IsAlphaLast(surface->format->format))
+            return false;
+
+        SurfaceLock lock(surface);
+        for (int y = 0; y < surface->h; ++y)
+        {
+            Byte* row = static_cast<Byte*>(surface->pixels) + y * surface->pitch;
+            PremultiplyAlpha(row, row, surface->w);
+        }
+
+        return true;
+    }
+
+    bool BlendSurface(const SDL_Surface* source, SDL_Surface* destination, int x, int y)
+    {
+        if (!IsAlphaLast(source->format->format) || source->format->format != destination->format->format)
+            return false;
+
+        const SDL_Rect& clip = destination->clip_rect;
+        int left = std::max(x, clip.x);
+        int top = std::max(y, clip.y);
+        int right = std::min(x + source->w, clip.x + clip.w);
+        int bottom = std::min(y + source->h, clip.y + clip.h);
+        if (left >= right || top >= bottom)
+            return true;
+
+        SurfaceLock sourceLock(source);
+        SurfaceLock destinationLock(destination);
+
+        for (int row = top; row < bottom; ++row)
+        {
+            const Byte* sourceRow = static_cast<const Byte*>(source->pixels) + (row - y) * source->pitch + (left - x) * 4;
+            Byte* destinationRow = static_cast<Byte*>(destination->pixels) + row * destination->pitch + left * 4;
+            BlendAlpha(sourceRow, destinationRow, right - left);
+        }
+
+        return true;
+    }
+}
@@ -0,0 +1,191 @@
+#include <Engine/Core/ResourceManager.hpp>
+#include <Engine/Core/MemoryTracking.hpp>
+#include <Engine/Core/StartupPrefetch.hpp>
+
+#include <algorithm>
+#include <iostream>
+
+namespace Engine::Core
+{
+    namespace Detail
+    {
+        ResourceTypeIndex NextResourceTypeIndex()
+        {
+            static std::atomic<ResourceTypeIndex> nextIndex { 0 };
+            return nextIndex.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    ResourceManager::ResourceManager(std::size_t memoryBudget, std::size_t workerCount)
+        : memoryBudget(memoryBudget), workers(workerCount)
+    {
+    }
+
+    ResourceManager::~ResourceManager()
+    {
+        workers.Wait();
+    }
+
+    void ResourceManager::RegisterType(ResourceTypeIndex type, const std::string& name, ErasedLoader loader)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        TypeInfo& info = types[type];
+        info.loader = std::move(loader);
+        info.stats.name = name;
+    }
+
+    Detail::ResourceEntry* ResourceManager::Acquire(ResourceTypeIndex type, const std::string& path)
+    {
+        MemoryTagScope memoryTag(MemoryTag::Core);
+        StringId id = StringId::Intern(path);
+
+        std::lock_guard<std::mutex> lock(mutex);
+
+        auto typeIterator = types.find(type);
+        if (typeIterator == types.end())
+        {
+            std::cout << "Cannot load resource \"" << path << "\": resource type is not registered." << std::endl;
+            return nullptr;
+        }
+
+        auto entryIterator = entries.find(id);
+        if (entryIterator != entries.end())
+        {
+            Detail::ResourceEntry* entry = entryIterator->second.get();
+            if (entry->type != type)
+            {
+                std::cout << "Cannot load resource \"" << path << "\": already loaded as a different type." << std::endl;
+                return nullptr;
+            }
+
+            if (entry->inLru)
+                lru.splice(lru.begin(), lru, entry->lruPosition);
+
+            entry->referenceCount.fetch_add(1, std::memory_order_relaxed);
+            return entry;
+        }
+
+        auto entry = std::make_unique<Detail::ResourceEntry>();
+        entry->id = id;
+        entry->type = type;
+        entry->path = path;
+        entry->referenceCount.store(1, std::memory_order_relaxed);
+
+        Detail::ResourceEntry* result = entry.get();
+        entries.emplace(id, std::move(entry));
+
+        // The loader is copied so that re-registering a type does not race with pending loads.
+        workers.Submit([this, result, loader = typeIterator->second.loader]
+        {
+            LoadEntry(result, loader);
+        });
+
+        return result;
+    }
+
+    void ResourceManager::LoadEntry(Detail::ResourceEntry* entry, const ErasedLoader& loader)
+    {
+        RecordFileAccess(entry->path, 0, 0);
+
+        std::size_t size = 0;
+        std::shared_ptr<void> data = loader(entry->path, size);
+
+        std::lock_guard<std::mutex> lock(mutex);
+
+        ResourceTypeStats& stats = types[entry->type].stats;
+        if (data == nullptr)
+        {
+            std::cout << "Failed to load resource \"" << entry->path << "\"." << std::endl;
+            ++stats.failedLoadCount;
+            entry->state.store(ResourceState::Failed, std::memory_order_release);
+            return;
+        }
+
+        entry->data = std::move(data);
+        entry->size = size;
+        entry->lruPosition = lru.insert(lru.begin(), entry);
+        entry->inLru = true;
+
+        residentBytes += size;
+        stats.residentBytes += size;
+        stats.peakResidentBytes = std::max(stats.peakResidentBytes, stats.residentBytes);
+        ++stats.residentCount;
+        ++stats.loadCount;
+
+        entry->state.store(ResourceState::Ready, std::memory_order_release);
+
+        EvictToBudget();
+    }
+
+    void ResourceManager::EvictToBudget()
+    {
+        auto iterator = lru.end();
+        while (residentBytes > memoryBudget && iterator != lru.begin())
+        {
+            --iterator;
+
+            Detail::ResourceEntry* entry = *iterator;
+            if (entry->referenceCount.load(std::memory_order_acquire) != 0)
+                continue;
+
+            ResourceTypeStats& stats = types[entry->type].stats;
+            stats.residentBytes -= entry->size;
+            --stats.residentCount;
+            ++stats.evictionCount;
+            residentBytes -= entry->size;
+
+            iterator = lru.erase(iterator);
+            entries.erase(entry->id);
+        }
+    }
+
+    ResourceTypeStats ResourceManager::GetStats(ResourceTypeIndex type) const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        auto iterator = types.find(type);
+        return iterator != types.end() ? iterator->second.stats : ResourceTypeStats();
+    }
+
+    std::vector<ResourceTypeStats> ResourceManager::GetAllStats() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        std::vector<ResourceTypeStats> result;
+        result.reserve(types.size());
+        for (const auto& [type, info] : types)
+            result.push_back(info.stats);
+        return result;
+    }
+
+    std::size_t ResourceManager::GetMemoryBudget() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return memoryBudget;
+    }
+
+    std::size_t ResourceManager::GetResidentBytes() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return residentBytes;
+    }
+
+    void ResourceManager::SetMemoryBudget(std::size_t bytes)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        memoryBudget = bytes;
+        EvictToBudget();
+    }
+
+    void ResourceManager::Trim()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        EvictToBudget();
+    }
+
+    void ResourceManager::Wait()
+    {
+        workers.Wait();
+    }
+}
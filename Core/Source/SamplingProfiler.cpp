@@ -0,0 +1,389 @@
+#include <Engine/Core/SamplingProfiler.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <signal.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <ucontext.h>
+#include <unistd.h>
+#endif
+
+namespace Engine::Core
+{
+    namespace
+    {
+        static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "The signal handler needs lock-free atomics.");
+
+        std::mutex registryMutex;
+        // Names by thread index, kept after the threads exit for `Save`.
+        std::vector<std::string> threadNames;
+
+#if defined(__linux__)
+        struct RegisteredThread
+        {
+            pthread_t handle;
+            pid_t id = 0;
+            timer_t timer;
+            bool hasTimer = false;
+        };
+
+        std::vector<RegisteredThread*> registeredThreads;
+        std::atomic<SamplingProfiler*> signalProfiler { nullptr };
+        std::atomic<int> runningHandlers { 0 };
+        std::uint64_t timerNanoseconds = 0;
+        bool handlerInstalled = false;
+
+        // Read by the signal handler, trivial so that it needs no initialization on access.
+        struct SignalThreadInfo
+        {
+            std::uintptr_t stackLow;
+            std::uintptr_t stackHigh;
+            std::uint32_t index;
+            bool registered;
+        };
+
+        thread_local SignalThreadInfo signalThread;
+
+        // Call with `registryMutex` held.
+        bool StartTimer(RegisteredThread& thread)
+        {
+            clockid_t clock;
+            if (pthread_getcpuclockid(thread.handle, &clock) != 0)
+                return false;
+
+            sigevent event;
+            std::memset(&event, 0, sizeof(event));
+            event.sigev_notify = SIGEV_THREAD_ID;
+            event.sigev_signo = SIGPROF;
+#if defined(sigev_notify_thread_id)
+            event.sigev_notify_thread_id = thread.id;
+#else
+            event._sigev_un._tid = thread.id;
+#endif
+            if (timer_create(clock, &event, &thread.timer) != 0)
+                return false;
+
+            itimerspec interval;
+            std::memset(&interval, 0, sizeof(interval));
+            interval.it_interval.tv_sec = static_cast<time_t>(timerNanoseconds / 1000000000);
+            interval.it_interval.tv_nsec = static_cast<long>(timerNanoseconds % 1000000000);
+            interval.it_value = interval.it_interval;
+            if (timer_settime(thread.timer, 0, &interval, nullptr) != 0)
+            {
+                timer_delete(thread.timer);
+                return false;
+            }
+
+            thread.hasTimer = true;
+            return true;
+        }
+
+        // Frame pointer chain: every frame starts with the caller's frame pointer and the return address.
+        // Pointers outside the thread's stack or not growing towards its base end the walk, code built
+        // without frame pointers gives short stacks but never a crash.
+        std::size_t Unwind(const ucontext_t& context, std::uintptr_t* frames)
+        {
+#if defined(__x86_64__)
+            std::uintptr_t pc = static_cast<std::uintptr_t>(context.uc_mcontext.gregs[REG_RIP]);
+            std::uintptr_t framePointer = static_cast<std::uintptr_t>(context.uc_mcontext.gregs[REG_RBP]);
+            std::uintptr_t stackPointer = static_cast<std::uintptr_t>(context.uc_mcontext.gregs[REG_RSP]);
+#elif defined(__aarch64__)
+            std::uintptr_t pc = static_cast<std::uintptr_t>(context.uc_mcontext.pc);
+            std::uintptr_t framePointer = static_cast<std::uintptr_t>(context.uc_mcontext.regs[29]);
+            std::uintptr_t stackPointer = static_cast<std::uintptr_t>(context.uc_mcontext.sp);
+#else
+            (void)context;
+            (void)frames;
+            return 0;
+#endif
+
+#if defined(__x86_64__) || defined(__aarch64__)
+            std::size_t depth = 0;
+            frames[depth++] = pc;
+
+            std::uintptr_t low = std::max(stackPointer, signalThread.stackLow);
+            while (depth < SamplingProfiler::MaxDepth && framePointer >= low && framePointer + 2 * sizeof(std::uintptr_t) <= signalThread.stackHigh &&
+                   framePointer % sizeof(std::uintptr_t) == 0)
+            {
+                const std::uintptr_t* frame = reinterpret_cast<const std::uintptr_t*>(framePointer);
+                if (frame[1] == 0)
+                    break;
+
+                frames[depth++] = frame[1];
+                if (frame[0] <= framePointer)
+                    break;
+                framePointer = frame[0];
+            }
+
+            return depth;
+#endif
+        }
+
+        void HandleSignal(int, siginfo_t*, void* context)
+        {
+            int savedErrno = errno;
+            runningHandlers.fetch_add(1);
+
+            SamplingProfiler* profiler = signalProfiler.load();
+            if (profiler != nullptr && signalThread.registered)
+            {
+                std::uintptr_t frames[SamplingProfiler::MaxDepth];
+                std::size_t depth = Unwind(*static_cast<const ucontext_t*>(context), frames);
+                profiler->RecordSample(signalThread.index, frames, depth);
+            }
+
+            runningHandlers.fetch_sub(1);
+            errno = savedErrno;
+        }
+
+        class ThreadRegistration
+        {
+        public:
+            explicit ThreadRegistration(const std::string& name)
+            {
+                thread.handle = pthread_self();
+                thread.id = static_cast<pid_t>(syscall(SYS_gettid));
+
+                std::uintptr_t low = 0;
+                std::uintptr_t high = 0;
+                pthread_attr_t attributes;
+                if (pthread_getattr_np(thread.handle, &attributes) == 0)
+                {
+                    void* address = nullptr;
+                    std::size_t size = 0;
+                    if (pthread_attr_getstack(&attributes, &address, &size) == 0)
+                    {
+                        low = reinterpret_cast<std::uintptr_t>(address);
+                        high = low + size;
+                    }
+                    pthread_attr_destroy(&attributes);
+                }
+
+                std::lock_guard<std::mutex> lock(registryMutex);
+                signalThread.stackLow = low;
+                signalThread.stackHigh = high;
+                signalThread.index = static_cast<std::uint32_t>(threadNames.size());
+                signalThread.registered = true;
+                threadNames.push_back(name);
+                registeredThreads.push_back(&thread);
+
+                if (signalProfiler.load() != nullptr)
+                    StartTimer(thread);
+            }
+
+            ~ThreadRegistration()
+            {
+                std::lock_guard<std::mutex> lock(registryMutex);
+                if (thread.hasTimer)
+                    timer_delete(thread.timer);
+                signalThread.registered = false;
+                registeredThreads.erase(std::find(registeredThreads.begin(), registeredThreads.end(), &thread));
+            }
+
+            ThreadRegistration(const ThreadRegistration&) = delete;
+            ThreadRegistration& operator=(const ThreadRegistration&) = delete;
+
+        private:
+            RegisteredThread thread;
+        };
+#endif
+    }
+
+    SamplingProfiler::SamplingProfiler(SamplingProfilerOptions options)
+        : options(options), samples(std::make_unique<Sample[]>(options.maxSamples))
+    {
+    }
+
+    SamplingProfiler::~SamplingProfiler()
+    {
+        Stop();
+    }
+
+    bool SamplingProfiler::Start()
+    {
+#if defined(__linux__)
+        std::lock_guard<std::mutex> lock(registryMutex);
+        if (signalProfiler.load() != nullptr || options.frequency == 0)
+            return false;
+
+        // Stays installed: a SIGPROF still pending after `Stop` would terminate the process otherwise.
+        if (!handlerInstalled)
+        {
+            struct sigaction action;
+            std::memset(&action, 0, sizeof(action));
+            action.sa_sigaction = HandleSignal;
+            action.sa_flags = SA_SIGINFO | SA_RESTART;
+            sigemptyset(&action.sa_mask);
+            if (sigaction(SIGPROF, &action, nullptr) != 0)
+            {
+                std::cout << "Something went wrong installing the sampling profiler's signal handler: " << std::strerror(errno) << std::endl;
+                return false;
+            }
+            handlerInstalled = true;
+        }
+
+        timerNanoseconds = std::max<std::uint64_t>(1000000000 / options.frequency, 1);
+        signalProfiler.store(this);
+        running = true;
+
+        for (RegisteredThread* thread : registeredThreads)
+        {
+            if (!StartTimer(*thread))
+                std::cout << "Something went wrong starting a sampling timer: " << std::strerror(errno) << std::endl;
+        }
+
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    void SamplingProfiler::Stop()
+    {
+#if defined(__linux__)
+        {
+            std::lock_guard<std::mutex> lock(registryMutex);
+            if (!running)
+                return;
+
+            for (RegisteredThread* thread : registeredThreads)
+            {
+                if (thread->hasTimer)
+                    timer_delete(thread->timer);
+                thread->hasTimer = false;
+            }
+
+            signalProfiler.store(nullptr);
+            running = false;
+        }
+
+        // Handlers that saw this profiler finish writing before it can be read or destroyed.
+        while (runningHandlers.load() != 0)
+            std::this_thread::yield();
+#endif
+    }
+
+    bool SamplingProfiler::Save(const std::string& path) const
+    {
+        std::vector<std::string> names;
+        {
+            std::lock_guard<std::mutex> lock(registryMutex);
+            names = threadNames;
+        }
+
+        // Thread index first, then the frames.
+        std::map<std::vector<std::uintptr_t>, std::uint64_t> stacks;
+        std::uint64_t count = std::min<std::uint64_t>(nextSample.load(std::memory_order_relaxed), options.maxSamples);
+        for (std::uint64_t i = 0; i < count; ++i)
+        {
+            const Sample& sample = samples[i];
+            if (!sample.ready.load(std::memory_order_acquire) || sample.depth == 0)
+                continue;
+
+            std::vector<std::uintptr_t> stack(1, sample.thread);
+            stack.insert(stack.end(), sample.frames, sample.frames + sample.depth);
+            ++stacks[stack];
+        }
+
+        std::ofstream file(path, std::ios::trunc);
+        if (!file)
+        {
+            std::cout << "Something went wrong opening \"" << path << "\" for the sampling profile" << std::endl;
+            return false;
+        }
+
+        file << "# Engine sampling profile, symbolize with Scripts/CollapseProfile.py\n";
+        file << "frequency " << options.frequency << "\n";
+        for (std::size_t i = 0; i < names.size(); ++i)
+            file << "thread " << i << " " << names[i] << "\n";
+
+        // Executable mappings, so the addresses can be mapped back to files and offsets.
+        std::ifstream maps("/proc/self/maps");
+        std::string line;
+        while (std::getline(maps, line))
+        {
+            char range[64];
+            char permissions[8];
+            unsigned long long offset = 0;
+            char device[16];
+            unsigned long long inode = 0;
+            int pathStart = 0;
+            if (std::sscanf(line.c_str(), "%63s %7s %llx %15s %llu %n", range, permissions, &offset, device, &inode, &pathStart) < 5 ||
+                permissions[2] != 'x' || pathStart <= 0 || line[static_cast<std::size_t>(pathStart)] != '/')
+                continue;
+
+            std::string bounds = range;
+            std::size_t dash = bounds.find('-');
+            file << "module " << bounds.substr(0, dash) << " " << bounds.substr(dash + 1) << " " << std::hex << offset << std::dec << " "
+                 << line.substr(static_cast<std::size_t>(pathStart)) << "\n";
+        }
+
+        for (const auto& [stack, samplesOfStack] : stacks)
+        {
+            file << "stack " << samplesOfStack << " " << stack[0] << std::hex;
+            for (std::size_t i = 1; i < stack.size(); ++i)
+                file << " " << stack[i];
+            file << std::dec << "\n";
+        }
+
+        return static_cast<bool>(file);
+    }
+
+    SamplingProfilerStats SamplingProfiler::GetStats() const
+    {
+        SamplingProfilerStats stats;
+        stats.samples = std::min<std::uint64_t>(nextSample.load(std::memory_order_relaxed), options.maxSamples);
+        stats.dropped = dropped.load(std::memory_order_relaxed);
+
+        std::lock_guard<std::mutex> lock(registryMutex);
+        stats.threads = threadNames.size();
+
+        return stats;
+    }
+
+    void SamplingProfiler::Report() const
+    {
+        SamplingProfilerStats stats = GetStats();
+        std::cout << "Sampling profiler: " << stats.samples << " samples at " << options.frequency << " Hz, " << stats.dropped
+                  << " dropped, " << stats.threads << " threads registered" << std::endl;
+    }
+
+    void SamplingProfiler::RecordSample(std::uint32_t thread, const std::uintptr_t* frames, std::size_t depth)
+    {
+        std::uint64_t index = nextSample.fetch_add(1, std::memory_order_relaxed);
+        if (index >= options.maxSamples)
+        {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        Sample& sample = samples[index];
+        sample.thread = thread;
+        sample.depth = static_cast<std::uint32_t>(std::min(depth, MaxDepth));
+        for (std::size_t i = 0; i < sample.depth; ++i)
+            sample.frames[i] = frames[i];
+        sample.ready.store(true, std::memory_order_release);
+    }
+
+    void RegisterSamplingThread(const std::string& name)
+    {
+#if defined(__linux__)
+        thread_local ThreadRegistration registration(name);
+#else
+        (void)name;
+#endif
+    }
+}
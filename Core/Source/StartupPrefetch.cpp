@@ -0,0 +1,310 @@
+#include <Engine/Core/StartupPrefetch.hpp>
+
+#include <Engine/Core/AtomicFile.hpp>
+
+#include <SDL2/SDL_filesystem.h>
+#include <SDL2/SDL_stdinc.h>
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace Engine::Core
+{
+    namespace
+    {
+        constexpr std::uint32_t Magic = 0x48434650; // "PFCH"
+        constexpr std::uint32_t Version = 1;
+
+        struct Header
+        {
+            std::uint32_t magic;
+            std::uint32_t version;
+            std::uint64_t rangeCount;
+        };
+
+        std::atomic<StartupPrefetch*> active { nullptr };
+        // Calls of `RecordFileAccess` in progress, which may still use the previous `active`.
+        std::atomic<std::uint32_t> recordingCalls { 0 };
+
+        // After changing `active`. Both are sequentially consistent, so a call that loaded the previous
+        // pointer is counted by the time `active` changed.
+        void WaitForRecordingCalls()
+        {
+            while (recordingCalls.load() != 0)
+                std::this_thread::yield();
+        }
+
+        // Ask the OS to read `ranges` of one file into the page cache. Returns the bytes requested.
+        std::uint64_t ReadAhead(const std::vector<PrefetchRange>& ranges)
+        {
+            std::error_code error;
+            std::uint64_t fileSize = std::filesystem::file_size(ranges.front().path, error);
+            if (error)
+                return 0;
+
+            std::uint64_t requested = 0;
+
+#if defined(__linux__) || defined(__APPLE__)
+            int file = open(ranges.front().path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (file < 0)
+                return 0;
+
+            for (const PrefetchRange& range : ranges)
+            {
+                if (range.offset >= fileSize)
+                    continue;
+
+                std::uint64_t size = range.size == 0 ? fileSize - range.offset : std::min(range.size, fileSize - range.offset);
+                requested += size;
+
+#if defined(__linux__)
+                posix_fadvise(file, static_cast<off_t>(range.offset), static_cast<off_t>(size), POSIX_FADV_WILLNEED);
+#else
+                radvisory advice = { static_cast<off_t>(range.offset), static_cast<int>(std::min<std::uint64_t>(size, INT32_MAX)) };
+                fcntl(file, F_RDADVISE, &advice);
+#endif
+            }
+
+            close(file);
+#else
+            // No asynchronous hint worth the trouble here, reading the ranges fills the cache as well.
+            std::ifstream file(ranges.front().path, std::ios::binary);
+            std::vector<char> buffer(1 << 20);
+            for (const PrefetchRange& range : ranges)
+            {
+                if (range.offset >= fileSize)
+                    continue;
+
+                std::uint64_t size = range.size == 0 ? fileSize - range.offset : std::min(range.size, fileSize - range.offset);
+                requested += size;
+
+                file.clear();
+                file.seekg(static_cast<std::streamoff>(range.offset));
+                for (std::uint64_t left = size; left > 0 && file;)
+                {
+                    std::uint64_t chunk = std::min<std::uint64_t>(left, buffer.size());
+                    file.read(buffer.data(), static_cast<std::streamsize>(chunk));
+                    left -= chunk;
+                }
+            }
+#endif
+
+            return requested;
+        }
+
+        bool ReadManifest(const std::string& path, std::vector<PrefetchRange>& ranges)
+        {
+            std::ifstream file(path, std::ios::binary);
+            if (!file)
+                return false;
+
+            Header header;
+            if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) || header.magic != Magic || header.version != Version)
+            {
+                std::cout << "\"" << path << "\" is not a prefetch manifest of version " << Version << "." << std::endl;
+                return false;
+            }
+
+            for (std::uint64_t i = 0; i < header.rangeCount; ++i)
+            {
+                PrefetchRange range;
+                std::uint32_t length = 0;
+                file.read(reinterpret_cast<char*>(&range.offset), sizeof(range.offset));
+                file.read(reinterpret_cast<char*>(&range.size), sizeof(range.size));
+                file.read(reinterpret_cast<char*>(&length), sizeof(length));
+                if (!file || length > 4096)
+                {
+                    std::cout << "The prefetch manifest \"" << path << "\" is malformed." << std::endl;
+                    return false;
+                }
+
+                range.path.resize(length);
+                file.read(range.path.data(), length);
+                ranges.push_back(std::move(range));
+            }
+
+            if (!file)
+            {
+                std::cout << "The prefetch manifest \"" << path << "\" is truncated." << std::endl;
+                return false;
+            }
+
+            return true;
+        }
+    }
+
+    StartupPrefetch::StartupPrefetch(std::string manifestPath, double recordSeconds)
+        : manifestPath(std::move(manifestPath)),
+          recordEnd(std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(recordSeconds)))
+    {
+    }
+
+    StartupPrefetch::~StartupPrefetch()
+    {
+        StartupPrefetch* self = this;
+        if (active.compare_exchange_strong(self, nullptr))
+            WaitForRecordingCalls();
+
+        std::unique_lock<std::mutex> lock(mutex);
+        filesDone.wait(lock, [this] { return pendingFiles == 0; });
+    }
+
+    std::string StartupPrefetch::GetDefaultManifestPath()
+    {
+        std::string path = "Startup.prefetch";
+        if (char* basePath = SDL_GetBasePath())
+        {
+            path = basePath + path;
+            SDL_free(basePath);
+        }
+
+        return path;
+    }
+
+    bool StartupPrefetch::Prefetch(ThreadPool& workers)
+    {
+        auto start = std::chrono::steady_clock::now();
+
+        std::vector<PrefetchRange> manifest;
+        if (!ReadManifest(manifestPath, manifest) || manifest.empty())
+            return false;
+
+        // Ranges of a file are stored together, one job per file keeps each file's hints sequential.
+        std::vector<std::vector<PrefetchRange>> perFile;
+        for (PrefetchRange& range : manifest)
+        {
+            if (perFile.empty() || perFile.back().front().path != range.path)
+                perFile.emplace_back();
+            perFile.back().push_back(std::move(range));
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stats.prefetchedRanges = manifest.size();
+            pendingFiles += perFile.size();
+        }
+
+        for (std::vector<PrefetchRange>& ranges : perFile)
+        {
+            workers.Submit([this, start, ranges = std::move(ranges)]
+            {
+                std::uint64_t requested = ReadAhead(ranges);
+
+                std::lock_guard<std::mutex> lock(mutex);
+                stats.prefetchedBytes += requested;
+                if (--pendingFiles == 0)
+                {
+                    stats.prefetchMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+                    filesDone.notify_all();
+                }
+            });
+        }
+
+        return true;
+    }
+
+    void StartupPrefetch::Record(const std::string& path, std::uint64_t offset, std::uint64_t size)
+    {
+        if (std::chrono::steady_clock::now() > recordEnd)
+            return;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        auto [it, inserted] = ranges.try_emplace(path);
+        if (inserted)
+            files.push_back(path);
+
+        it->second.push_back({ path, offset, size });
+        ++stats.recordedRanges;
+    }
+
+    bool StartupPrefetch::Save() const
+    {
+        std::vector<PrefetchRange> merged;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (const std::string& path : files)
+            {
+                std::vector<PrefetchRange> fileRanges = ranges.at(path);
+                bool wholeFile = std::any_of(fileRanges.begin(), fileRanges.end(), [](const PrefetchRange& range) { return range.size == 0; });
+                if (wholeFile)
+                {
+                    merged.push_back({ path, 0, 0 });
+                    continue;
+                }
+
+                // Overlapping and adjacent ranges become one, in file order for sequential reads.
+                std::sort(fileRanges.begin(), fileRanges.end(), [](const PrefetchRange& a, const PrefetchRange& b) { return a.offset < b.offset; });
+                std::size_t first = merged.size();
+                for (const PrefetchRange& range : fileRanges)
+                {
+                    if (merged.size() > first && range.offset <= merged.back().offset + merged.back().size)
+                    {
+                        PrefetchRange& last = merged.back();
+                        last.size = std::max(last.size, range.offset + range.size - last.offset);
+                    }
+                    else
+                        merged.push_back(range);
+                }
+            }
+        }
+
+        return WriteFileAtomically(manifestPath, [&](std::ostream& file)
+        {
+            Header header = { Magic, Version, merged.size() };
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+            for (const PrefetchRange& range : merged)
+            {
+                std::uint32_t length = static_cast<std::uint32_t>(range.path.size());
+                file.write(reinterpret_cast<const char*>(&range.offset), sizeof(range.offset));
+                file.write(reinterpret_cast<const char*>(&range.size), sizeof(range.size));
+                file.write(reinterpret_cast<const char*>(&length), sizeof(length));
+                file.write(range.path.data(), length);
+            }
+        });
+    }
+
+    StartupPrefetchStats StartupPrefetch::GetStats() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return stats;
+    }
+
+    void StartupPrefetch::Report() const
+    {
+        StartupPrefetchStats current = GetStats();
+
+        std::cout << std::fixed << std::setprecision(1);
+        if (current.prefetchedRanges == 0)
+            std::cout << "Startup prefetch: no manifest";
+        else
+            std::cout << "Startup prefetch: " << current.prefetchedRanges << " ranges, " << current.prefetchedBytes / (1024.0 * 1024.0)
+                      << " MB hinted in " << current.prefetchMilliseconds << " ms";
+
+        std::cout << ", " << current.recordedRanges << " ranges recorded" << std::endl;
+    }
+
+    void SetStartupPrefetch(StartupPrefetch* prefetch)
+    {
+        active.store(prefetch);
+        WaitForRecordingCalls();
+    }
+
+    void RecordFileAccess(const std::string& path, std::uint64_t offset, std::uint64_t size)
+    {
+        recordingCalls.fetch_add(1);
+        if (StartupPrefetch* prefetch = active.load())
+            prefetch->Record(path, offset, size);
+        recordingCalls.fetch_sub(1, std::memory_order_release);
+    }
+}
@@ -0,0 +1,122 @@
+#include <Engine/Core/StringId.hpp>
+
+#include <Engine/Core/MemoryTracking.hpp>
+
+#include <atomic>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+namespace Engine::Core
+{
+    namespace
+    {
+        // Open addressing with linear probing. Slots are claimed by CAS on the hash,
+        // then the owner publishes the string; readers that find the same hash wait for it.
+        constexpr std::size_t InternTableCapacity = 1 << 16;
+        constexpr std::size_t InternTableMask = InternTableCapacity - 1;
+
+        struct InternSlot
+        {
+            std::atomic<std::uint64_t> hash;
+            std::atomic<const char*> string;
+        };
+
+        InternSlot internTable[InternTableCapacity];
+        std::atomic<std::size_t> internedCount { 0 };
+
+        const char* WaitForString(InternSlot& slot)
+        {
+            const char* string = slot.string.load(std::memory_order_acquire);
+            while (string == nullptr)
+            {
+                std::this_thread::yield();
+                string = slot.string.load(std::memory_order_acquire);
+            }
+            return string;
+        }
+    }
+
+    StringId StringId::Intern(std::string_view string)
+    {
+        std::uint64_t hash = HashString(string);
+
+        // Hash 0 marks empty slots.
+        if (hash == 0)
+        {
+            std::cout << "Cannot intern string \"" << string << "\": hash is reserved." << std::endl;
+            return StringId(hash);
+        }
+
+        std::size_t index = hash & InternTableMask;
+        for (std::size_t probe = 0; probe < InternTableCapacity; ++probe)
+        {
+            InternSlot& slot = internTable[index];
+            std::uint64_t slotHash = slot.hash.load(std::memory_order_acquire);
+
+            if (slotHash == 0)
+            {
+                if (slot.hash.compare_exchange_strong(slotHash, hash, std::memory_order_acq_rel))
+                {
+                    // Never freed on purpose. Untagged, so that Debug builds don't report it as a Core leak.
+                    MemoryTagScope memoryTag(MemoryTag::Untagged);
+                    char* copy = new char[string.size() + 1];
+                    std::memcpy(copy, string.data(), string.size());
+                    copy[string.size()] = '\0';
+
+                    slot.string.store(copy, std::memory_order_release);
+                    internedCount.fetch_add(1, std::memory_order_relaxed);
+                    return StringId(hash);
+                }
+                // Lost the race, `slotHash` now holds the winner's hash.
+            }
+
+            if (slotHash == hash)
+            {
+                const char* existing = WaitForString(slot);
+                if (string != existing)
+                {
+                    std::cout << "String id collision: \"" << string << "\" and \"" << existing
+                              << "\" both hash to " << hash << "." << std::endl;
+                }
+                return StringId(hash);
+            }
+
+            index = (index + 1) & InternTableMask;
+        }
+
+        std::cout << "Cannot intern string \"" << string << "\": intern table is full." << std::endl;
+        return StringId(hash);
+    }
+
+    std::size_t StringId::GetInternedCount()
+    {
+        return internedCount.load(std::memory_order_relaxed);
+    }
+
+    const char* StringId::GetDebugString() const
+    {
+#ifdef ENGINE_CORE_DEBUG
+        if (hash == 0)
+            return nullptr;
+
+        std::size_t index = hash & InternTableMask;
+        for (std::size_t probe = 0; probe < InternTableCapacity; ++probe)
+        {
+            InternSlot& slot = internTable[index];
+            std::uint64_t slotHash = slot.hash.load(std::memory_order_acquire);
+
+            if (slotHash == 0)
+                return nullptr;
+
+            if (slotHash == hash)
+                return WaitForString(slot);
+
+            index = (index + 1) & InternTableMask;
+        }
+        return nullptr;
+#else
+        return nullptr;
+#endif
+    }
+}
@@ -0,0 +1,77 @@
+#include <Engine/Core/MemoryTracking.hpp>
+#include <Engine/Core/SamplingProfiler.hpp>
+#include <Engine/Core/ThreadPool.hpp>
+
+namespace Engine::Core
+{
+    ThreadPool::ThreadPool(std::size_t threadCount)
+    {
+        if (threadCount == 0)
+        {
+            unsigned int hardwareThreads = std::thread::hardware_concurrency();
+            threadCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+        }
+
+        threads.reserve(threadCount);
+        for (std::size_t i = 0; i < threadCount; ++i)
+            threads.emplace_back(&ThreadPool::WorkerMain, this);
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        jobAvailable.notify_all();
+
+        for (std::thread& thread : threads)
+            thread.join();
+    }
+
+    void ThreadPool::Submit(std::function<void()> job)
+    {
+        {
+            // The job's allocations are charged to the submitter's tag.
+            std::lock_guard<std::mutex> lock(mutex);
+            jobs.push_back({ std::move(job), GetMemoryTag() });
+        }
+        jobAvailable.notify_one();
+    }
+
+    void ThreadPool::Wait()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        jobsFinished.wait(lock, [this] { return jobs.empty() && runningJobs == 0; });
+    }
+
+    void ThreadPool::WorkerMain()
+    {
+        RegisterSamplingThread("Worker");
+
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true)
+        {
+            jobAvailable.wait(lock, [this] { return stopping || !jobs.empty(); });
+
+            // Finish queued jobs before stopping.
+            if (jobs.empty())
+                return;
+
+            Job job = std::move(jobs.front());
+            jobs.pop_front();
+            ++runningJobs;
+
+            lock.unlock();
+            {
+                MemoryTagScope memoryTag(job.tag);
+                job.function();
+            }
+            lock.lock();
+
+            --runningJobs;
+            if (jobs.empty() && runningJobs == 0)
+                jobsFinished.notify_all();
+        }
+    }
+}
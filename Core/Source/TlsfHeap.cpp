@@ -0,0 +1,621 @@
+#include <Engine/Core/TlsfHeap.hpp>
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace Engine::Core
+{
+    namespace Detail
+    {
+        // In front of every block's payload. Blocks of a pool are contiguous, ending in a used block of
+        // size 0, so every block's physical successor is right after its payload.
+        struct alignas(TlsfHeap::Alignment) TlsfBlock
+        {
+            // Block right before this one in its pool, `nullptr` for the first.
+            TlsfBlock* previous;
+            // Payload bytes, a multiple of `TlsfHeap::Alignment`. Bit 0 is set while the block is free.
+            std::size_t size;
+        };
+
+        // At the start of the payload of free blocks, and of blocks in thread caches.
+        struct TlsfLinks
+        {
+            TlsfBlock* next;
+            TlsfBlock* previous;
+        };
+    }
+
+    namespace
+    {
+        using Block = Detail::TlsfBlock;
+
+        constexpr std::size_t FreeBit = 1;
+        constexpr std::size_t HeaderSize = sizeof(Block);
+        // A free block's payload holds its links.
+        constexpr std::size_t MinimumBlockSize = TlsfHeap::Alignment;
+        // Lists per first level. Sizes below `SmallBlockSize` map linearly to the lists of first level 0,
+        // one per `Alignment`, larger ones to a first level per power of 2.
+        constexpr std::size_t SecondLevelLog2 = 5;
+        constexpr std::size_t SmallBlockLog2 = 9;
+        constexpr std::size_t SmallBlockSize = std::size_t(1) << SmallBlockLog2;
+        constexpr std::size_t HugePageSize = std::size_t(2) << 20;
+        constexpr std::size_t PageSize = 4096;
+
+        // Per-thread caches hold up to `CacheLimit` blocks per size class. Refilling takes
+        // `CacheRefill` blocks at once, trimming gives back `CacheTrim`.
+        constexpr std::uint32_t CacheLimit = 64;
+        constexpr std::uint32_t CacheRefill = 16;
+        constexpr std::uint32_t CacheTrim = 32;
+
+        static_assert(SmallBlockSize == TlsfHeap::Alignment << SecondLevelLog2, "First level 0 has a list per alignment step.");
+        static_assert(HeaderSize == TlsfHeap::Alignment, "Payloads have to stay aligned.");
+        static_assert(sizeof(Detail::TlsfLinks) <= MinimumBlockSize, "Free blocks have to hold their links.");
+
+        std::size_t GetBlockSize(const Block* block)
+        {
+            return block->size & ~FreeBit;
+        }
+
+        bool IsFree(const Block* block)
+        {
+            return (block->size & FreeBit) != 0;
+        }
+
+        void* GetPayload(Block* block)
+        {
+            return reinterpret_cast<char*>(block) + HeaderSize;
+        }
+
+        Block* GetBlock(const void* memory)
+        {
+            return reinterpret_cast<Block*>(const_cast<char*>(static_cast<const char*>(memory)) - HeaderSize);
+        }
+
+        Block* GetNext(Block* block)
+        {
+            return reinterpret_cast<Block*>(static_cast<char*>(GetPayload(block)) + GetBlockSize(block));
+        }
+
+        Detail::TlsfLinks& GetLinks(Block* block)
+        {
+            return *static_cast<Detail::TlsfLinks*>(GetPayload(block));
+        }
+
+        std::size_t AlignUp(std::size_t value, std::size_t alignment)
+        {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+
+        // Index of the highest and lowest set bit, `value` isn't 0.
+        std::size_t FindLastSet(std::uint64_t value)
+        {
+#if defined(_MSC_VER)
+            unsigned long index;
+            _BitScanReverse64(&index, value);
+            return index;
+#else
+            return 63 - static_cast<std::size_t>(__builtin_clzll(value));
+#endif
+        }
+
+        std::size_t FindFirstSet(std::uint32_t value)
+        {
+#if defined(_MSC_VER)
+            unsigned long index;
+            _BitScanForward(&index, value);
+            return index;
+#else
+            return static_cast<std::size_t>(__builtin_ctz(value));
+#endif
+        }
+
+        // Smallest size whose list holds only blocks of at least `size` bytes.
+        std::size_t RoundUpToList(std::size_t size)
+        {
+            if (size < SmallBlockSize)
+                return size;
+            return size + (std::size_t(1) << (FindLastSet(size) - SecondLevelLog2)) - 1;
+        }
+
+        void* MapPages(std::size_t size, bool hugePages, bool& gotHugePages)
+        {
+            gotHugePages = false;
+#if defined(_WIN32)
+            // Needs the "Lock pages in memory" privilege.
+            std::size_t largePageSize = GetLargePageMinimum();
+            if (hugePages && largePageSize != 0 && size % largePageSize == 0)
+            {
+                if (void* memory = VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE))
+                {
+                    gotHugePages = true;
+                    return memory;
+                }
+            }
+
+            return VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#else
+            if (hugePages)
+            {
+#if defined(MAP_HUGETLB)
+                // Pages reserved by the administrator, usually none.
+                void* reserved = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+                if (reserved != MAP_FAILED)
+                {
+                    gotHugePages = true;
+                    return reserved;
+                }
+#endif
+
+                // Transparent huge pages need 2 MB aligned ranges: map more than needed, trim both ends.
+                void* memory = mmap(nullptr, size + HugePageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if (memory == MAP_FAILED)
+                    return nullptr;
+
+                char* start = static_cast<char*>(memory);
+                char* aligned = reinterpret_cast<char*>(AlignUp(reinterpret_cast<std::size_t>(start), HugePageSize));
+                if (aligned != start)
+                    munmap(start, static_cast<std::size_t>(aligned - start));
+                munmap(aligned + size, static_cast<std::size_t>(start + HugePageSize - aligned));
+
+#if defined(MADV_HUGEPAGE)
+                gotHugePages = madvise(aligned, size, MADV_HUGEPAGE) == 0;
+#endif
+                return aligned;
+            }
+
+            void* memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            return memory != MAP_FAILED ? memory : nullptr;
+#endif
+        }
+
+        void UnmapPages(void* memory, std::size_t size)
+        {
+#if defined(_WIN32)
+            (void)size;
+            VirtualFree(memory, 0, MEM_RELEASE);
+#else
+            munmap(memory, size);
+#endif
+        }
+
+        // Every thread gets an index into the caches of every heap, for as long as it runs. None of this
+        // allocates, the heap can be the one behind `operator new`.
+        constexpr int NoThreadCache = -1;
+        constexpr int UnassignedThreadCache = -2;
+
+        std::mutex threadCachesMutex;
+        std::uint64_t takenThreadCaches = 0;
+        thread_local int threadCacheIndex = UnassignedThreadCache;
+
+        static_assert(TlsfHeap::MaxCacheThreads <= 64, "Taken caches are a 64 bit mask.");
+
+        class ThreadCacheIndex
+        {
+        public:
+            ThreadCacheIndex()
+            {
+                std::lock_guard<std::mutex> lock(threadCachesMutex);
+                threadCacheIndex = NoThreadCache;
+                for (std::size_t index = 0; index < TlsfHeap::MaxCacheThreads; ++index)
+                {
+                    if ((takenThreadCaches & (std::uint64_t(1) << index)) == 0)
+                    {
+                        takenThreadCaches |= std::uint64_t(1) << index;
+                        threadCacheIndex = static_cast<int>(index);
+                        break;
+                    }
+                }
+            }
+
+            // Allocations after this, while the thread exits, bypass the caches.
+            ~ThreadCacheIndex()
+            {
+                std::lock_guard<std::mutex> lock(threadCachesMutex);
+                if (threadCacheIndex >= 0)
+                    takenThreadCaches &= ~(std::uint64_t(1) << threadCacheIndex);
+                threadCacheIndex = NoThreadCache;
+            }
+
+            ThreadCacheIndex(const ThreadCacheIndex&) = delete;
+            ThreadCacheIndex& operator=(const ThreadCacheIndex&) = delete;
+        };
+
+        int GetThreadCacheIndex()
+        {
+            if (threadCacheIndex == UnassignedThreadCache)
+            {
+                thread_local ThreadCacheIndex index;
+                (void)index;
+            }
+
+            return threadCacheIndex;
+        }
+
+        void AddRelaxed(std::atomic<std::size_t>& counter, std::size_t value)
+        {
+            counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        }
+    }
+
+    TlsfHeap::TlsfHeap(TlsfHeapOptions options) : options(options)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        AddPool(0);
+    }
+
+    TlsfHeap::~TlsfHeap()
+    {
+        for (std::size_t i = 0; i < poolCount; ++i)
+            UnmapPages(pools[i].memory, pools[i].size);
+    }
+
+    void* TlsfHeap::Allocate(std::size_t size, std::size_t alignment)
+    {
+        if (size > MaxAllocationSize)
+            return nullptr;
+
+        size = std::max(AlignUp(size, Alignment), MinimumBlockSize);
+        if (options.threadCaches && size <= MaxCachedSize && alignment <= Alignment)
+        {
+            int index = GetThreadCacheIndex();
+            if (index >= 0)
+                return AllocateCached(caches[index], size / Alignment - 1);
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        return AllocateLocked(size, alignment);
+    }
+
+    void TlsfHeap::Free(void* memory)
+    {
+        if (memory == nullptr)
+            return;
+
+        Block* block = GetBlock(memory);
+        std::size_t size = GetBlockSize(block);
+        if (options.threadCaches && size <= MaxCachedSize)
+        {
+            int index = GetThreadCacheIndex();
+            if (index >= 0)
+            {
+                FreeCached(caches[index], block, size / Alignment - 1);
+                return;
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        FreeLocked(block);
+    }
+
+    std::size_t TlsfHeap::GetSize(const void* memory)
+    {
+        return GetBlockSize(GetBlock(memory));
+    }
+
+    TlsfHeapStats TlsfHeap::GetStats() const
+    {
+        TlsfHeapStats stats;
+        for (const ThreadCache& cache : caches)
+            stats.cachedBytes += cache.bytes.load(std::memory_order_relaxed);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        stats.pools = poolCount;
+        for (std::size_t i = 0; i < poolCount; ++i)
+        {
+            stats.poolBytes += pools[i].size;
+            if (pools[i].hugePages)
+                stats.hugePageBytes += pools[i].size;
+        }
+
+        stats.usedBytes = usedBytes;
+        stats.peakUsedBytes = peakUsedBytes;
+        stats.freeBytes = freeBytes;
+        stats.freeBlocks = freeBlockCount;
+
+        // Per pool, free memory can't be in one piece across pools. Walks every block, fine for reports.
+        std::size_t largestPerPool = 0;
+        for (std::size_t i = 0; i < poolCount; ++i)
+        {
+            std::size_t largest = 0;
+            for (Block* block = static_cast<Block*>(pools[i].memory); GetBlockSize(block) != 0; block = GetNext(block))
+            {
+                if (IsFree(block))
+                    largest = std::max(largest, GetBlockSize(block));
+            }
+
+            largestPerPool += largest;
+            stats.largestFreeBlock = std::max(stats.largestFreeBlock, largest);
+        }
+
+        if (freeBytes > 0)
+            stats.fragmentation = 1.0 - static_cast<double>(largestPerPool) / static_cast<double>(freeBytes);
+
+        return stats;
+    }
+
+    void TlsfHeap::Report() const
+    {
+        TlsfHeapStats stats = GetStats();
+        auto megabytes = [](std::size_t bytes) { return static_cast<double>(bytes) / (1024.0 * 1024.0); };
+
+        std::cout << std::fixed << std::setprecision(2) << "TLSF heap: " << megabytes(stats.poolBytes) << " MB in " << stats.pools << " pools ("
+                  << megabytes(stats.hugePageBytes) << " MB huge pages), used " << megabytes(stats.usedBytes) << " MB (peak "
+                  << megabytes(stats.peakUsedBytes) << " MB, " << megabytes(stats.cachedBytes) << " MB in thread caches), free "
+                  << megabytes(stats.freeBytes) << " MB in " << stats.freeBlocks << " blocks, largest " << megabytes(stats.largestFreeBlock)
+                  << " MB, fragmentation " << std::setprecision(1) << stats.fragmentation * 100.0 << "%" << std::endl;
+    }
+
+    void TlsfHeap::MapSize(std::size_t size, std::size_t& firstLevel, std::size_t& secondLevel)
+    {
+        if (size < SmallBlockSize)
+        {
+            firstLevel = 0;
+            secondLevel = size / (SmallBlockSize / SecondLevelCount);
+            return;
+        }
+
+        // The highest bit picks the first level, the next `SecondLevelLog2` bits the list.
+        std::size_t last = FindLastSet(size);
+        secondLevel = (size >> (last - SecondLevelLog2)) ^ SecondLevelCount;
+        firstLevel = last - SmallBlockLog2 + 1;
+    }
+
+    bool TlsfHeap::AddPool(std::size_t minimumSize)
+    {
+        if (poolCount == MaxPools)
+            return false;
+
+        // Each pool twice the size of the one before, so that the heap runs out of address space long
+        // before it runs out of `MaxPools`.
+        std::size_t grownSize = options.poolSize;
+        for (std::size_t i = 0; i < poolCount && grownSize <= MaxAllocationSize / 2; ++i)
+            grownSize *= 2;
+
+        // The first block's header, and the header of the block of size 0 that ends the pool.
+        std::size_t pageSize = options.hugePages ? HugePageSize : PageSize;
+        std::size_t size = AlignUp(std::max(grownSize, minimumSize + 2 * HeaderSize), pageSize);
+        std::size_t neededSize = AlignUp(std::max(options.poolSize, minimumSize + 2 * HeaderSize), pageSize);
+
+        // Where memory is committed on mapping, a grown pool may not fit when a smaller one does.
+        bool hugePages = false;
+        void* memory = MapPages(size, options.hugePages, hugePages);
+        if (memory == nullptr && size > neededSize)
+        {
+            size = neededSize;
+            memory = MapPages(size, options.hugePages, hugePages);
+        }
+
+        if (memory == nullptr)
+            return false;
+
+        if (options.prefault)
+        {
+            for (std::size_t offset = 0; offset < size; offset += PageSize)
+                static_cast<volatile char*>(memory)[offset] = 0;
+        }
+
+        pools[poolCount++] = { memory, size, hugePages };
+
+        Block* block = static_cast<Block*>(memory);
+        block->previous = nullptr;
+        block->size = size - 2 * HeaderSize;
+        Block* end = GetNext(block);
+        end->previous = block;
+        end->size = 0;
+        InsertFree(block);
+        return true;
+    }
+
+    Block* TlsfHeap::TakeFree(std::size_t size)
+    {
+        std::size_t firstLevel;
+        std::size_t secondLevel;
+        MapSize(RoundUpToList(size), firstLevel, secondLevel);
+        if (firstLevel >= FirstLevelCount)
+            return nullptr;
+
+        std::uint32_t secondLevelMap = secondLevelMaps[firstLevel] & (~0u << secondLevel);
+        if (secondLevelMap == 0)
+        {
+            std::uint32_t firstLevelMapAbove = firstLevel + 1 < FirstLevelCount ? firstLevelMap & (~0u << (firstLevel + 1)) : 0;
+            if (firstLevelMapAbove == 0)
+                return nullptr;
+
+            firstLevel = FindFirstSet(firstLevelMapAbove);
+            secondLevelMap = secondLevelMaps[firstLevel];
+        }
+
+        Block* block = freeLists[firstLevel][FindFirstSet(secondLevelMap)];
+        RemoveFree(block);
+        return block;
+    }
+
+    void TlsfHeap::InsertFree(Block* block)
+    {
+        std::size_t size = GetBlockSize(block);
+        std::size_t firstLevel;
+        std::size_t secondLevel;
+        MapSize(size, firstLevel, secondLevel);
+
+        Block*& head = freeLists[firstLevel][secondLevel];
+        GetLinks(block) = { head, nullptr };
+        if (head != nullptr)
+            GetLinks(head).previous = block;
+        head = block;
+        block->size = size | FreeBit;
+
+        firstLevelMap |= 1u << firstLevel;
+        secondLevelMaps[firstLevel] |= 1u << secondLevel;
+        freeBytes += size;
+        ++freeBlockCount;
+    }
+
+    void TlsfHeap::RemoveFree(Block* block)
+    {
+        std::size_t size = GetBlockSize(block);
+        std::size_t firstLevel;
+        std::size_t secondLevel;
+        MapSize(size, firstLevel, secondLevel);
+
+        Detail::TlsfLinks& links = GetLinks(block);
+        if (links.next != nullptr)
+            GetLinks(links.next).previous = links.previous;
+        if (links.previous != nullptr)
+            GetLinks(links.previous).next = links.next;
+        else
+            freeLists[firstLevel][secondLevel] = links.next;
+
+        if (freeLists[firstLevel][secondLevel] == nullptr)
+        {
+            secondLevelMaps[firstLevel] &= ~(1u << secondLevel);
+            if (secondLevelMaps[firstLevel] == 0)
+                firstLevelMap &= ~(1u << firstLevel);
+        }
+
+        block->size = size;
+        freeBytes -= size;
+        --freeBlockCount;
+    }
+
+    void* TlsfHeap::AllocateLocked(std::size_t size, std::size_t alignment)
+    {
+        // Over-aligned requests need room to move the start, with a free block in front of it.
+        std::size_t searchSize = alignment > Alignment ? size + alignment + HeaderSize + MinimumBlockSize : size;
+        Block* block = TakeFree(searchSize);
+        if (block == nullptr)
+        {
+            // Sized for the list `TakeFree` searches, the unrounded size may land in the list below.
+            if (!AddPool(RoundUpToList(searchSize)))
+                return nullptr;
+            block = TakeFree(searchSize);
+            if (block == nullptr)
+                return nullptr;
+        }
+
+        if (alignment > Alignment)
+        {
+            std::size_t payload = reinterpret_cast<std::size_t>(GetPayload(block));
+            std::size_t aligned = AlignUp(payload, alignment);
+            if (aligned != payload)
+            {
+                if (aligned - payload < HeaderSize + MinimumBlockSize)
+                    aligned = AlignUp(payload + HeaderSize + MinimumBlockSize, alignment);
+
+                // The gap in front becomes a free block. Its predecessor is used, free ones merge.
+                std::size_t gap = aligned - payload;
+                Block* moved = reinterpret_cast<Block*>(aligned - HeaderSize);
+                moved->previous = block;
+                moved->size = GetBlockSize(block) - gap;
+                GetNext(moved)->previous = moved;
+                block->size = gap - HeaderSize;
+                InsertFree(block);
+                block = moved;
+            }
+        }
+
+        // Give back what's left if it makes a block of its own. The successor is used, free ones merge.
+        std::size_t remaining = GetBlockSize(block) - size;
+        if (remaining >= HeaderSize + MinimumBlockSize)
+        {
+            Block* rest = reinterpret_cast<Block*>(static_cast<char*>(GetPayload(block)) + size);
+            rest->previous = block;
+            rest->size = remaining - HeaderSize;
+            GetNext(rest)->previous = rest;
+            block->size = size;
+            InsertFree(rest);
+        }
+
+        usedBytes += GetBlockSize(block);
+        peakUsedBytes = std::max(peakUsedBytes, usedBytes);
+        return GetPayload(block);
+    }
+
+    void TlsfHeap::FreeLocked(Block* block)
+    {
+        usedBytes -= GetBlockSize(block);
+
+        Block* previous = block->previous;
+        if (previous != nullptr && IsFree(previous))
+        {
+            RemoveFree(previous);
+            previous->size += HeaderSize + GetBlockSize(block);
+            block = previous;
+            GetNext(block)->previous = block;
+        }
+
+        Block* next = GetNext(block);
+        if (IsFree(next))
+        {
+            RemoveFree(next);
+            block->size += HeaderSize + GetBlockSize(next);
+            GetNext(block)->previous = block;
+        }
+
+        InsertFree(block);
+    }
+
+    void* TlsfHeap::AllocateCached(ThreadCache& cache, std::size_t sizeClass)
+    {
+        Block*& head = cache.blocks[sizeClass];
+        if (head == nullptr)
+        {
+            // Splitting may leave a block larger than the class, it's freed to the heap by its size later.
+            std::lock_guard<std::mutex> lock(mutex);
+            for (std::uint32_t i = 0; i < CacheRefill; ++i)
+            {
+                void* memory = AllocateLocked((sizeClass + 1) * Alignment, Alignment);
+                if (memory == nullptr)
+                    break;
+
+                Block* block = GetBlock(memory);
+                GetLinks(block).next = head;
+                head = block;
+                ++cache.counts[sizeClass];
+                AddRelaxed(cache.bytes, GetBlockSize(block));
+            }
+
+            if (head == nullptr)
+                return nullptr;
+        }
+
+        Block* block = head;
+        head = GetLinks(block).next;
+        --cache.counts[sizeClass];
+        AddRelaxed(cache.bytes, 0 - GetBlockSize(block));
+        return GetPayload(block);
+    }
+
+    void TlsfHeap::FreeCached(ThreadCache& cache, Block* block, std::size_t sizeClass)
+    {
+        Block*& head = cache.blocks[sizeClass];
+        GetLinks(block).next = head;
+        head = block;
+        AddRelaxed(cache.bytes, GetBlockSize(block));
+        if (++cache.counts[sizeClass] <= CacheLimit)
+            return;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        for (std::uint32_t i = 0; i < CacheTrim; ++i)
+        {
+            Block* trimmed = head;
+            head = GetLinks(trimmed).next;
+            AddRelaxed(cache.bytes, 0 - GetBlockSize(trimmed));
+            FreeLocked(trimmed);
+        }
+
+        cache.counts[sizeClass] -= CacheTrim;
+    }
+}
@@ -0,0 +1,64 @@
+#ifndef ENGINE_GRAPHICS_ATLAS_PACKER_INCLUDED
+#define ENGINE_GRAPHICS_ATLAS_PACKER_INCLUDED
+
+#include <cstdint>
+#include <vector>
+
+namespace Engine::Graphics
+{
+    struct AtlasImageSize
+    {
+        std::uint32_t width = 0;
+        std::uint32_t height = 0;
+    };
+
+    struct AtlasPackOptions
+    {
+        std::uint32_t maxPageWidth = 2048;
+        std::uint32_t maxPageHeight = 2048;
+        // Empty pixels between neighboring images, so filtering never bleeds across them.
+        std::uint32_t padding = 2;
+        // Border pixels repeated around each image, for clamped sampling at its edges.
+        std::uint32_t extrude = 1;
+        bool allowRotation = true;
+        // Shrink each page to the power of two that holds its images.
+        bool trimPages = true;
+    };
+
+    struct AtlasPlacement
+    {
+        std::uint32_t page = 0;
+        // Top left of the image itself, the extruded border lies around it.
+        std::uint32_t x = 0;
+        std::uint32_t y = 0;
+        // Size in the page, swapped when rotated.
+        std::uint32_t width = 0;
+        std::uint32_t height = 0;
+        // Stored rotated by 90 degrees clockwise.
+        bool rotated = false;
+    };
+
+    struct AtlasPage
+    {
+        std::uint32_t width = 0;
+        std::uint32_t height = 0;
+        // Pixels covered by images, without padding and extrusion.
+        std::uint64_t usedPixels = 0;
+    };
+
+    struct AtlasPackResult
+    {
+        // In the order of the input images.
+        std::vector<AtlasPlacement> placements;
+        std::vector<AtlasPage> pages;
+
+        // Image pixels over page pixels.
+        float GetEfficiency() const;
+    };
+
+    // Pack images of the given sizes into as few pages as possible with MaxRects (best short side fit),
+    // largest images first. Returns false and reports which image if one can't fit on an empty page.
+    bool PackAtlas(const std::vector<AtlasImageSize>& images, const AtlasPackOptions& options, AtlasPackResult& result);
+}
+
+#endif
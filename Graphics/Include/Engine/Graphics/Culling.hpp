@@ -0,0 +1,67 @@
+#ifndef ENGINE_GRAPHICS_CULLING_INCLUDED
+#define ENGINE_GRAPHICS_CULLING_INCLUDED
+
+#include <Engine/Core/Math.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Engine::Graphics
+{
+    // Six normalized planes pointing inwards: left, right, bottom, top, near, far.
+    struct Frustum
+    {
+        Core::Vector4 planes[6];
+
+        // Extracts the planes in the space that `viewProjection` transforms from.
+        static Frustum FromViewProjection(const Core::Matrix4& viewProjection);
+
+        bool IsSphereVisible(const Core::Vector3& center, float radius) const;
+    };
+
+    // CPU depth buffer with a hierarchical max-depth pyramid for conservative occlusion tests.
+    // Depth is in [0, 1], larger is farther away. Occluders are either rasterized on the CPU
+    // or the depth buffer of the previous frame is copied in with `SetDepth`.
+    class OcclusionBuffer
+    {
+    public:
+        OcclusionBuffer(std::uint32_t width, std::uint32_t height);
+
+        std::uint32_t GetWidth() const { return width; }
+        std::uint32_t GetHeight() const { return height; }
+
+        void Clear();
+
+        // Copy a full resolution depth buffer, rows from bottom to top.
+        void SetDepth(const float* depth);
+
+        // Rasterize triangles, nearest depth wins. `positions` points at the first vertex position,
+        // consecutive positions are `positionStride` bytes apart. Triangles crossing the near plane
+        // are skipped, which can only make occlusion tests pass less often.
+        void RasterizeTriangles(const Core::Matrix4& viewProjection, const float* positions, std::size_t positionStride,
+                                const std::uint32_t* indices, std::size_t indexCount);
+
+        // Must be called after changing the depth and before testing.
+        void BuildPyramid();
+
+        // True if the sphere is entirely behind the depth buffer contents.
+        bool IsSphereOccluded(const Core::Matrix4& viewProjection, const Core::Vector3& center, float radius) const;
+
+        std::uint32_t GetTrianglesRasterized() const { return trianglesRasterized; }
+
+    private:
+        float SampleMaxDepth(std::uint32_t level, int minimumX, int minimumY, int maximumX, int maximumY) const;
+
+        std::uint32_t width;
+        std::uint32_t height;
+        std::uint32_t trianglesRasterized = 0;
+
+        // Level 0 is full resolution, every level halves both dimensions.
+        std::vector<std::vector<float>> levels;
+        std::vector<std::uint32_t> levelWidths;
+        std::vector<std::uint32_t> levelHeights;
+    };
+}
+
+#endif
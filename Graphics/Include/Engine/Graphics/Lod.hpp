@@ -0,0 +1,92 @@
+#ifndef ENGINE_GRAPHICS_LOD_INCLUDED
+#define ENGINE_GRAPHICS_LOD_INCLUDED
+
+#include <Engine/Graphics/Mesh.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Engine::Graphics
+{
+    struct LodLevel
+    {
+        // Indices into the shared vertex buffer of the source mesh.
+        std::vector<std::uint32_t> indices;
+        // Object space error relative to the full detail mesh.
+        float error = 0.0f;
+    };
+
+    struct LodChain
+    {
+        // Level 0 is the source mesh, every next level is coarser.
+        std::vector<LodLevel> levels;
+    };
+
+    // Simplify repeatedly by `reduction` until `maxLevels` are generated or simplification stalls.
+    LodChain GenerateLodChain(const Mesh& mesh, std::size_t maxLevels = 6, float reduction = 0.5f);
+
+    // Pixels per unit of object space length at distance 1, multiply by error / distance
+    // to get the projected error in pixels.
+    float ComputeProjectionScale(float verticalFov, float screenHeight);
+
+    struct LodSelection
+    {
+        std::uint32_t level = 0;
+        // Level being faded out and how far the fade has progressed, 1 if no fade is running.
+        std::uint32_t previousLevel = 0;
+        float fade = 1.0f;
+    };
+
+    struct LodStats
+    {
+        std::size_t instances = 0;
+        std::size_t fadingInstances = 0;
+        // Triangles submitted, counting both levels of fading instances.
+        std::size_t triangles = 0;
+        // Triangles that always drawing level 0 would have submitted.
+        std::size_t fullDetailTriangles = 0;
+    };
+
+    using LodInstanceId = std::uint32_t;
+
+    // Picks the coarsest level whose projected error stays below a pixel threshold.
+    // Switching to a coarser level needs the error to be `hysteresis` below the threshold,
+    // so that instances near a switching distance don't pop back and forth. Level changes
+    // cross-fade over `fadeDuration` seconds.
+    class LodSelector
+    {
+    public:
+        LodSelector(float pixelErrorThreshold, float hysteresis = 0.25f, float fadeDuration = 0.25f);
+
+        LodInstanceId AddInstance();
+        void RemoveInstance(LodInstanceId id);
+
+        // Call once per frame and visible instance.
+        LodSelection Select(LodInstanceId id, const LodChain& chain, float distance, float projectionScale, float deltaTime);
+
+        void SetPixelErrorThreshold(float pixels) { pixelErrorThreshold = pixels; }
+        float GetPixelErrorThreshold() const { return pixelErrorThreshold; }
+
+        // Statistics accumulated by `Select` since the last call.
+        LodStats ResetStats();
+
+    private:
+        struct Instance
+        {
+            LodSelection selection;
+            bool selected = false;
+            bool alive = false;
+        };
+
+        float pixelErrorThreshold;
+        float hysteresis;
+        float fadeDuration;
+
+        std::vector<Instance> instances;
+        std::vector<LodInstanceId> freeIds;
+        LodStats stats;
+    };
+}
+
+#endif
@@ -0,0 +1,92 @@
+#ifndef ENGINE_GRAPHICS_MESH_INCLUDED
+#define ENGINE_GRAPHICS_MESH_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Engine::Graphics
+{
+    struct Vertex
+    {
+        float position[3];
+        float normal[3];
+        float uv[2];
+    };
+
+    // 16 bytes instead of 32. Positions are normalized to the mesh bounds,
+    // normals are octahedral encoded and UVs are half floats.
+    struct QuantizedVertex
+    {
+        std::uint16_t position[4];
+        std::int16_t normal[2];
+        std::uint16_t uv[2];
+    };
+
+    struct Mesh
+    {
+        std::vector<Vertex> vertices;
+        std::vector<std::uint32_t> indices;
+    };
+
+    struct QuantizedMesh
+    {
+        std::vector<QuantizedVertex> vertices;
+        std::vector<std::uint32_t> indices;
+
+        // position = quantized position / 65535 * positionScale + positionOffset
+        float positionOffset[3];
+        float positionScale[3];
+    };
+
+    enum class VertexAttributeFormat : std::uint8_t
+    {
+        Float32,
+        Float16,
+        UInt16Normalized,
+        Int16Normalized
+    };
+
+    struct VertexAttribute
+    {
+        std::uint32_t location;
+        VertexAttributeFormat format;
+        std::uint32_t componentCount;
+        std::uint32_t offset;
+    };
+
+    // Describes a vertex struct so that backends can set up their input layouts from it.
+    struct VertexLayout
+    {
+        static constexpr std::size_t MaxAttributes = 8;
+
+        VertexAttribute attributes[MaxAttributes];
+        std::uint32_t attributeCount;
+        std::uint32_t stride;
+    };
+
+    // Attribute locations: 0 = position, 1 = normal, 2 = UV.
+    constexpr VertexLayout StandardVertexLayout =
+    {
+        {
+            { 0, VertexAttributeFormat::Float32, 3, offsetof(Vertex, position) },
+            { 1, VertexAttributeFormat::Float32, 3, offsetof(Vertex, normal) },
+            { 2, VertexAttributeFormat::Float32, 2, offsetof(Vertex, uv) }
+        },
+        3, sizeof(Vertex)
+    };
+
+    // The normal has to be decoded from octahedral in the vertex shader,
+    // the position has to be rescaled with the mesh's offset and scale.
+    constexpr VertexLayout QuantizedVertexLayout =
+    {
+        {
+            { 0, VertexAttributeFormat::UInt16Normalized, 3, offsetof(QuantizedVertex, position) },
+            { 1, VertexAttributeFormat::Int16Normalized, 2, offsetof(QuantizedVertex, normal) },
+            { 2, VertexAttributeFormat::Float16, 2, offsetof(QuantizedVertex, uv) }
+        },
+        3, sizeof(QuantizedVertex)
+    };
+}
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef ENGINE_GRAPHICS_MESH_OPTIMIZER_INCLUDED
+#define ENGINE_GRAPHICS_MESH_OPTIMIZER_INCLUDED
+
+#include <Engine/Graphics/Mesh.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Engine::Graphics
+{
+    struct VertexCacheStats
+    {
+        // Average cache miss ratio, vertex shader invocations per triangle (0.5 to 3).
+        float acmr = 0.0f;
+        // Average transform to vertex ratio, vertex shader invocations per vertex (1 and up).
+        float atvr = 0.0f;
+    };
+
+    // Simulates a FIFO post-transform cache of `cacheSize` entries.
+    VertexCacheStats AnalyzeVertexCache(const std::uint32_t* indices, std::size_t indexCount,
+                                        std::size_t vertexCount, std::size_t cacheSize = 16);
+
+    // Reorder triangles for post-transform vertex cache hits (Forsyth's linear-speed algorithm).
+    void OptimizeVertexCache(std::uint32_t* indices, std::size_t indexCount, std::size_t vertexCount);
+
+    // Reorder clusters of a vertex cache optimized index buffer so that triangles facing outwards
+    // are drawn first, which reduces overdraw. Clusters are split where the vertex cache is
+    // cold anyway, or where the ACMR stays within `threshold` times the overall ACMR.
+    void OptimizeOverdraw(std::uint32_t* indices, std::size_t indexCount,
+                          const Vertex* vertices, std::size_t vertexCount, float threshold = 1.05f);
+
+    // Reorder vertices in order of first use and remap indices, for linear vertex fetches.
+    // Unused vertices are removed, returns the new vertex count.
+    std::size_t OptimizeVertexFetch(Vertex* vertices, std::size_t vertexCount,
+                                    std::uint32_t* indices, std::size_t indexCount);
+
+    // Vertex cache, overdraw and vertex fetch optimization in that order.
+    void OptimizeMesh(Mesh& mesh, float overdrawThreshold = 1.05f);
+
+    QuantizedMesh QuantizeMesh(const Mesh& mesh);
+
+    // Optimize and quantize, as done when cooking assets offline or when loading raw meshes.
+    QuantizedMesh CookMesh(Mesh mesh);
+
+    std::uint16_t FloatToHalf(float value);
+    float HalfToFloat(std::uint16_t value);
+
+    // Octahedral normal encoding into two snorm16 values.
+    void EncodeOctahedral(const float normal[3], std::int16_t encoded[2]);
+    void DecodeOctahedral(const std::int16_t encoded[2], float normal[3]);
+}
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef ENGINE_GRAPHICS_MESH_SIMPLIFIER_INCLUDED
+#define ENGINE_GRAPHICS_MESH_SIMPLIFIER_INCLUDED
+
+#include <Engine/Graphics/Mesh.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Engine::Graphics
+{
+    struct SimplifyOptions
+    {
+        // Stop once the index count is at or below this.
+        std::size_t targetIndexCount = 0;
+        // Stop before collapses with a larger object space error than this.
+        float maximumError = 1e30f;
+        // Weight of normal and UV differences relative to positional error.
+        float attributeWeight = 1.0f;
+    };
+
+    // Quadric error metric edge collapse simplification (Garland and Heckbert).
+    // Vertices only ever collapse onto existing vertices, so the vertex buffer is reused.
+    // Attribute seams (vertices sharing a position) are kept fixed and open borders only
+    // collapse along themselves, so UVs and normals are preserved across seams.
+    // Writes the simplified triangle list to `result` and returns the object space error,
+    // the largest RMS distance of a collapsed vertex to its original surface.
+    float SimplifyMesh(const std::vector<Vertex>& vertices, const std::vector<std::uint32_t>& indices,
+                       const SimplifyOptions& options, std::vector<std::uint32_t>& result);
+}
+
+#endif
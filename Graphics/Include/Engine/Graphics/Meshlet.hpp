@@ -0,0 +1,83 @@
+#ifndef ENGINE_GRAPHICS_MESHLET_INCLUDED
+#define ENGINE_GRAPHICS_MESHLET_INCLUDED
+
+#include <Engine/Core/Math.hpp>
+#include <Engine/Graphics/Culling.hpp>
+#include <Engine/Graphics/Mesh.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Engine::Graphics
+{
+    constexpr std::size_t MaxMeshletVertices = 64;
+    constexpr std::size_t MaxMeshletTriangles = 124;
+
+    struct Meshlet
+    {
+        // Into `MeshletMesh::vertices` and `MeshletMesh::triangles` (three bytes per triangle).
+        std::uint32_t vertexOffset;
+        std::uint32_t triangleOffset;
+        std::uint32_t vertexCount;
+        std::uint32_t triangleCount;
+
+        Core::Vector3 center;
+        float radius;
+
+        // All triangles face away from a camera at `position` if
+        // dot(normalize(coneApex - position), coneAxis) >= coneCutoff.
+        // A cutoff of 1 or more means the cone is too wide to ever cull.
+        Core::Vector3 coneApex;
+        Core::Vector3 coneAxis;
+        float coneCutoff;
+    };
+
+    struct MeshletMesh
+    {
+        std::vector<Meshlet> meshlets;
+        // Indices into the source mesh's vertices.
+        std::vector<std::uint32_t> vertices;
+        // Indices into the meshlet's range of `vertices`.
+        std::vector<std::uint8_t> triangles;
+    };
+
+    struct MeshletCullStats
+    {
+        std::size_t meshlets = 0;
+        std::size_t frustumCulled = 0;
+        std::size_t backfaceCulled = 0;
+        std::size_t occlusionCulled = 0;
+        std::size_t visible = 0;
+
+        std::size_t triangles = 0;
+        std::size_t visibleTriangles = 0;
+
+        MeshletCullStats& operator+=(const MeshletCullStats& other);
+    };
+
+    // Camera data for culling, in the space of the mesh.
+    struct MeshletCullView
+    {
+        Core::Matrix4 viewProjection;
+        Frustum frustum;
+        Core::Vector3 cameraPosition;
+        // Optional, skips the occlusion stage if null. Must have its pyramid built.
+        const OcclusionBuffer* occlusion = nullptr;
+    };
+
+    // Split a mesh, ideally vertex cache optimized, into meshlets in index order.
+    MeshletMesh BuildMeshlets(const Mesh& mesh, std::size_t maxVertices = MaxMeshletVertices,
+                              std::size_t maxTriangles = MaxMeshletTriangles);
+
+    // Appends the indices of meshlets that pass frustum, backface cone and occlusion culling.
+    void CullMeshlets(const MeshletMesh& meshletMesh, const MeshletCullView& view,
+                      std::vector<std::uint32_t>& visibleMeshlets, MeshletCullStats& stats);
+
+    // Expands visible meshlets into a regular triangle list of source mesh indices,
+    // for renderers without mesh shaders.
+    void AppendMeshletIndices(const MeshletMesh& meshletMesh, const std::vector<std::uint32_t>& visibleMeshlets,
+                              std::vector<std::uint32_t>& indices);
+}
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef ENGINE_GRAPHICS_OPENGL_GL_DEVICE_INCLUDED
+#define ENGINE_GRAPHICS_OPENGL_GL_DEVICE_INCLUDED
+
+#include <Engine/Graphics/OpenGL/GLFunctions.hpp>
+
+#include <SDL2/SDL_video.h>
+#include <memory>
+#include <string>
+
+namespace Engine::Graphics
+{
+    // Set the context attributes for an OpenGL 4.5 core context. Must be called before creating
+    // the window. With `debug`, the context is created with the debug flag.
+    void SetGLContextAttributes(bool debug);
+
+    // Creates a window suitable for `GLDevice`. For headless use (for example Mesa llvmpipe in CI),
+    // set `SDL_VIDEODRIVER=offscreen` and pass `hidden`.
+    SDL_Window* CreateGLWindow(const char* title, int width, int height, bool hidden, bool debug = false);
+
+    // OpenGL 4.5 context on an SDL window with its loaded functions.
+    class GLDevice
+    {
+    public:
+        // Returns `nullptr` and reports why if the context can't be created or lacks OpenGL 4.5.
+        static std::unique_ptr<GLDevice> Create(SDL_Window* window, bool debug = false);
+        ~GLDevice();
+
+        GLDevice(const GLDevice&) = delete;
+        GLDevice& operator=(const GLDevice&) = delete;
+
+        const GLFunctions& GetFunctions() const { return functions; }
+        SDL_Window* GetWindow() const { return window; }
+        SDL_GLContext GetContext() const { return context; }
+
+        const std::string& GetVendor() const { return vendor; }
+        const std::string& GetRenderer() const { return renderer; }
+        const std::string& GetVersion() const { return version; }
+
+        // Create a context sharing objects with this one, for loading on another thread.
+        // Make it current on that thread with `MakeCurrent`. This context stays current on the caller.
+        std::unique_ptr<GLDevice> CreateSharedContext();
+
+        void MakeCurrent();
+        void SetSwapInterval(int interval);
+        void Present();
+
+    private:
+        GLDevice(SDL_Window* window, SDL_GLContext context);
+
+        SDL_Window* window;
+        SDL_GLContext context;
+        GLFunctions functions;
+
+        std::string vendor;
+        std::string renderer;
+        std::string version;
+    };
+}
+
+#endif
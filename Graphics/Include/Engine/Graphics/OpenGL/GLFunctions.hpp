@@ -0,0 +1,128 @@
+#ifndef ENGINE_GRAPHICS_OPENGL_GL_FUNCTIONS_INCLUDED
+#define ENGINE_GRAPHICS_OPENGL_GL_FUNCTIONS_INCLUDED
+
+#include <SDL2/SDL_opengl.h>
+
+// The SDL headers stop at OpenGL 4.4, declare what is needed from 4.5 (direct state access).
+#ifndef GL_VERSION_4_5
+#define GL_VERSION_4_5 1
+typedef void (APIENTRYP PFNGLCREATEBUFFERSPROC) (GLsizei n, GLuint *buffers);
+typedef void (APIENTRYP PFNGLNAMEDBUFFERSTORAGEPROC) (GLuint buffer, GLsizeiptr size, const void *data, GLbitfield flags);
+typedef void (APIENTRYP PFNGLNAMEDBUFFERSUBDATAPROC) (GLuint buffer, GLintptr offset, GLsizeiptr size, const void *data);
+typedef void *(APIENTRYP PFNGLMAPNAMEDBUFFERRANGEPROC) (GLuint buffer, GLintptr offset, GLsizeiptr length, GLbitfield access);
+typedef GLboolean (APIENTRYP PFNGLUNMAPNAMEDBUFFERPROC) (GLuint buffer);
+typedef void (APIENTRYP PFNGLCREATEVERTEXARRAYSPROC) (GLsizei n, GLuint *arrays);
+typedef void (APIENTRYP PFNGLVERTEXARRAYVERTEXBUFFERPROC) (GLuint vaobj, GLuint bindingindex, GLuint buffer, GLintptr offset, GLsizei stride);
+typedef void (APIENTRYP PFNGLVERTEXARRAYELEMENTBUFFERPROC) (GLuint vaobj, GLuint buffer);
+typedef void (APIENTRYP PFNGLENABLEVERTEXARRAYATTRIBPROC) (GLuint vaobj, GLuint index);
+typedef void (APIENTRYP PFNGLVERTEXARRAYATTRIBFORMATPROC) (GLuint vaobj, GLuint attribindex, GLint size, GLenum type, GLboolean normalized, GLuint relativeoffset);
+typedef void (APIENTRYP PFNGLVERTEXARRAYATTRIBIFORMATPROC) (GLuint vaobj, GLuint attribindex, GLint size, GLenum type, GLuint relativeoffset);
+typedef void (APIENTRYP PFNGLVERTEXARRAYATTRIBBINDINGPROC) (GLuint vaobj, GLuint attribindex, GLuint bindingindex);
+typedef void (APIENTRYP PFNGLVERTEXARRAYBINDINGDIVISORPROC) (GLuint vaobj, GLuint bindingindex, GLuint divisor);
+typedef void (APIENTRYP PFNGLCREATETEXTURESPROC) (GLenum target, GLsizei n, GLuint *textures);
+typedef void (APIENTRYP PFNGLTEXTURESTORAGE3DPROC) (GLuint texture, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth);
+typedef void (APIENTRYP PFNGLTEXTURESUBIMAGE3DPROC) (GLuint texture, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void *pixels);
+typedef void (APIENTRYP PFNGLTEXTUREPARAMETERIPROC) (GLuint texture, GLenum pname, GLint param);
+typedef void (APIENTRYP PFNGLGENERATETEXTUREMIPMAPPROC) (GLuint texture);
+typedef void (APIENTRYP PFNGLBINDTEXTUREUNITPROC) (GLuint unit, GLuint texture);
+#endif
+
+// Core 1.x functions have prototypes but no pointer typedefs, their type is taken from the prototype.
+#define ENGINE_GL_LEGACY_FUNCTIONS(X) \
+    X(Clear) \
+    X(ClearColor) \
+    X(ClearDepth) \
+    X(Viewport) \
+    X(Scissor) \
+    X(Enable) \
+    X(Disable) \
+    X(IsEnabled) \
+    X(GetString) \
+    X(GetError) \
+    X(GetIntegerv) \
+    X(GetBooleanv) \
+    X(DepthFunc) \
+    X(DepthMask) \
+    X(BlendFunc) \
+    X(CullFace) \
+    X(FrontFace) \
+    X(ColorMask) \
+    X(PolygonOffset) \
+    X(PixelStorei) \
+    X(DeleteTextures) \
+    X(Finish) \
+    X(Flush)
+
+#define ENGINE_GL_FUNCTIONS(X) \
+    X(PFNGLGETSTRINGIPROC, GetStringi) \
+    X(PFNGLDEBUGMESSAGECALLBACKPROC, DebugMessageCallback) \
+    X(PFNGLCREATEBUFFERSPROC, CreateBuffers) \
+    X(PFNGLDELETEBUFFERSPROC, DeleteBuffers) \
+    X(PFNGLNAMEDBUFFERSTORAGEPROC, NamedBufferStorage) \
+    X(PFNGLNAMEDBUFFERSUBDATAPROC, NamedBufferSubData) \
+    X(PFNGLMAPNAMEDBUFFERRANGEPROC, MapNamedBufferRange) \
+    X(PFNGLUNMAPNAMEDBUFFERPROC, UnmapNamedBuffer) \
+    X(PFNGLBINDBUFFERPROC, BindBuffer) \
+    X(PFNGLBINDBUFFERBASEPROC, BindBufferBase) \
+    X(PFNGLBINDBUFFERRANGEPROC, BindBufferRange) \
+    X(PFNGLCREATEVERTEXARRAYSPROC, CreateVertexArrays) \
+    X(PFNGLDELETEVERTEXARRAYSPROC, DeleteVertexArrays) \
+    X(PFNGLBINDVERTEXARRAYPROC, BindVertexArray) \
+    X(PFNGLVERTEXARRAYVERTEXBUFFERPROC, VertexArrayVertexBuffer) \
+    X(PFNGLVERTEXARRAYELEMENTBUFFERPROC, VertexArrayElementBuffer) \
+    X(PFNGLENABLEVERTEXARRAYATTRIBPROC, EnableVertexArrayAttrib) \
+    X(PFNGLVERTEXARRAYATTRIBFORMATPROC, VertexArrayAttribFormat) \
+    X(PFNGLVERTEXARRAYATTRIBIFORMATPROC, VertexArrayAttribIFormat) \
+    X(PFNGLVERTEXARRAYATTRIBBINDINGPROC, VertexArrayAttribBinding) \
+    X(PFNGLVERTEXARRAYBINDINGDIVISORPROC, VertexArrayBindingDivisor) \
+    X(PFNGLCREATETEXTURESPROC, CreateTextures) \
+    X(PFNGLTEXTURESTORAGE3DPROC, TextureStorage3D) \
+    X(PFNGLTEXTURESUBIMAGE3DPROC, TextureSubImage3D) \
+    X(PFNGLTEXTUREPARAMETERIPROC, TextureParameteri) \
+    X(PFNGLGENERATETEXTUREMIPMAPPROC, GenerateTextureMipmap) \
+    X(PFNGLBINDTEXTUREUNITPROC, BindTextureUnit) \
+    X(PFNGLFENCESYNCPROC, FenceSync) \
+    X(PFNGLCLIENTWAITSYNCPROC, ClientWaitSync) \
+    X(PFNGLDELETESYNCPROC, DeleteSync) \
+    X(PFNGLMULTIDRAWELEMENTSINDIRECTPROC, MultiDrawElementsIndirect) \
+    X(PFNGLCREATESHADERPROC, CreateShader) \
+    X(PFNGLSHADERSOURCEPROC, ShaderSource) \
+    X(PFNGLCOMPILESHADERPROC, CompileShader) \
+    X(PFNGLGETSHADERIVPROC, GetShaderiv) \
+    X(PFNGLGETSHADERINFOLOGPROC, GetShaderInfoLog) \
+    X(PFNGLDELETESHADERPROC, DeleteShader) \
+    X(PFNGLCREATEPROGRAMPROC, CreateProgram) \
+    X(PFNGLATTACHSHADERPROC, AttachShader) \
+    X(PFNGLDETACHSHADERPROC, DetachShader) \
+    X(PFNGLLINKPROGRAMPROC, LinkProgram) \
+    X(PFNGLGETPROGRAMIVPROC, GetProgramiv) \
+    X(PFNGLGETPROGRAMINFOLOGPROC, GetProgramInfoLog) \
+    X(PFNGLDELETEPROGRAMPROC, DeleteProgram) \
+    X(PFNGLPROGRAMPARAMETERIPROC, ProgramParameteri) \
+    X(PFNGLGETPROGRAMBINARYPROC, GetProgramBinary) \
+    X(PFNGLPROGRAMBINARYPROC, ProgramBinary) \
+    X(PFNGLUSEPROGRAMPROC, UseProgram) \
+    X(PFNGLGETUNIFORMLOCATIONPROC, GetUniformLocation) \
+    X(PFNGLPROGRAMUNIFORM1IPROC, ProgramUniform1i) \
+    X(PFNGLPROGRAMUNIFORMMATRIX4FVPROC, ProgramUniformMatrix4fv)
+
+namespace Engine::Graphics
+{
+    // OpenGL entry points of one context, called as `gl.Clear(...)`.
+    // Function pointers are only guaranteed to be valid for the context they were loaded with.
+    struct GLFunctions
+    {
+#define ENGINE_GL_DECLARE_LEGACY(Name) decltype(&::gl##Name) Name = nullptr;
+#define ENGINE_GL_DECLARE(Type, Name) Type Name = nullptr;
+        ENGINE_GL_LEGACY_FUNCTIONS(ENGINE_GL_DECLARE_LEGACY)
+        ENGINE_GL_FUNCTIONS(ENGINE_GL_DECLARE)
+#undef ENGINE_GL_DECLARE_LEGACY
+#undef ENGINE_GL_DECLARE
+
+        // Load every function through `SDL_GL_GetProcAddress` for the current context.
+        // Reports missing functions and returns false if any is missing.
+        bool Load();
+    };
+}
+
+#endif
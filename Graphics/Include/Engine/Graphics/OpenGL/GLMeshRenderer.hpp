@@ -0,0 +1,126 @@
+#ifndef ENGINE_GRAPHICS_OPENGL_GL_MESH_RENDERER_INCLUDED
+#define ENGINE_GRAPHICS_OPENGL_GL_MESH_RENDERER_INCLUDED
+
+#include <Engine/Core/Math.hpp>
+#include <Engine/Graphics/Mesh.hpp>
+#include <Engine/Graphics/OpenGL/GLFunctions.hpp>
+#include <Engine/Graphics/OpenGL/GLProgram.hpp>
+#include <Engine/Graphics/OpenGL/GLRingBuffer.hpp>
+#include <Engine/Graphics/OpenGL/GLStateTracker.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Engine::Graphics
+{
+    class GLProgramCache;
+    class GLTextureArray;
+    struct GLProgramSource;
+
+    struct GLMeshRendererStats
+    {
+        std::uint32_t draws = 0;
+        std::uint64_t triangles = 0;
+        // Actual driver draw calls, one per pass with draws in it.
+        std::uint32_t multiDrawCalls = 0;
+    };
+
+    // Draws quantized meshes out of one shared vertex and index arena. Every draw of a frame is
+    // written straight into a persistently mapped ring buffer as an indirect command plus its
+    // per-draw data, and the whole pass goes to the driver as a single `glMultiDrawElementsIndirect`.
+    class GLMeshRenderer
+    {
+    public:
+        static constexpr std::uint32_t InvalidMesh = UINT32_MAX;
+
+        // With a `programCache`, the shader is loaded through it instead of compiled.
+        GLMeshRenderer(GLStateTracker& state, std::size_t maxVertices, std::size_t maxIndices,
+                       std::uint32_t maxDrawsPerFrame, std::uint32_t framesInFlight = 3,
+                       GLProgramCache* programCache = nullptr);
+        ~GLMeshRenderer();
+
+        GLMeshRenderer(const GLMeshRenderer&) = delete;
+        GLMeshRenderer& operator=(const GLMeshRenderer&) = delete;
+
+        // The shader of the renderer, for precompiling.
+        static GLProgramSource GetProgramSource();
+
+        bool IsValid() const { return program.IsValid() && ring.IsValid(); }
+
+        // Copy a mesh into the arena. Returns `InvalidMesh` if it doesn't fit.
+        std::uint32_t AddMesh(const QuantizedMesh& mesh);
+
+        // `textures` may be `nullptr`, meshes are then drawn untextured.
+        void BeginFrame(const Core::Matrix4& viewProjection, const GLTextureArray* textures = nullptr);
+
+        // Returns false and drops the draw once `maxDrawsPerFrame` is reached.
+        bool Draw(std::uint32_t mesh, const Core::Matrix4& model, std::uint32_t textureLayer = 0);
+
+        // Issue everything drawn since `BeginFrame`.
+        void EndFrame();
+
+        const GLMeshRendererStats& GetStats() const { return stats; }
+        const GLRingBufferStats& GetRingBufferStats() const { return ring.GetStats(); }
+
+    private:
+        struct MeshRange
+        {
+            std::uint32_t firstIndex;
+            std::uint32_t indexCount;
+            std::int32_t baseVertex;
+            float positionOffset[3];
+            float positionScale[3];
+        };
+
+        // Matches `DrawData` in the shader, std430.
+        struct DrawData
+        {
+            float model[16];
+            float positionOffset[3];
+            std::uint32_t textureLayer;
+            float positionScale[3];
+            std::uint32_t padding;
+        };
+
+        struct DrawCommand
+        {
+            std::uint32_t count;
+            std::uint32_t instanceCount;
+            std::uint32_t firstIndex;
+            std::int32_t baseVertex;
+            std::uint32_t baseInstance;
+        };
+
+        GLStateTracker& state;
+        const GLFunctions& gl;
+        GLProgram program;
+        GLRingBuffer ring;
+
+        GLuint vertexBuffer = 0;
+        GLuint indexBuffer = 0;
+        GLuint drawIndexBuffer = 0;
+        GLuint vertexArray = 0;
+        const GLPipeline* pipeline = nullptr;
+
+        std::size_t maxVertices;
+        std::size_t maxIndices;
+        std::size_t vertexCount = 0;
+        std::size_t indexCount = 0;
+        std::vector<MeshRange> meshes;
+
+        std::uint32_t maxDrawsPerFrame;
+        std::size_t storageAlignment = 256;
+        GLint viewProjectionLocation = -1;
+        GLint texturedLocation = -1;
+
+        const GLTextureArray* textures = nullptr;
+        GLRingAllocation commands;
+        GLRingAllocation drawData;
+        std::uint32_t drawCount = 0;
+
+        GLMeshRendererStats stats;
+    };
+}
+
+#endif
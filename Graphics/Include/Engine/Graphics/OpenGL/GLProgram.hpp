@@ -0,0 +1,35 @@
+#ifndef ENGINE_GRAPHICS_OPENGL_GL_PROGRAM_INCLUDED
+#define ENGINE_GRAPHICS_OPENGL_GL_PROGRAM_INCLUDED
+
+#include <Engine/Graphics/OpenGL/GLFunctions.hpp>
+
+namespace Engine::Graphics
+{
+    // Compile and link a vertex and fragment shader. Errors are reported with the driver's info log
+    // and return 0. With `retrievable`, the driver is asked to keep the binary for `glGetProgramBinary`.
+    GLuint CompileProgram(const GLFunctions& gl, const char* vertexSource, const char* fragmentSource, bool retrievable = false);
+
+    // Owns a linked program, invalid if compiling or linking failed.
+    class GLProgram
+    {
+    public:
+        GLProgram(const GLFunctions& gl, const char* vertexSource, const char* fragmentSource);
+        // Takes ownership of `program`, for example one from `GLProgramCache`.
+        GLProgram(const GLFunctions& gl, GLuint program);
+        ~GLProgram();
+
+        GLProgram(const GLProgram&) = delete;
+        GLProgram& operator=(const GLProgram&) = delete;
+
+        bool IsValid() const { return program != 0; }
+        GLuint GetHandle() const { return program; }
+
+        GLint GetUniformLocation(const char* name) const;
+
+    private:
+        const GLFunctions& gl;
+        GLuint program = 0;
+    };
+}
+
+#endif
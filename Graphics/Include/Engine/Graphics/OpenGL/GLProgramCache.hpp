@@ -0,0 +1,88 @@
+#ifndef ENGINE_GRAPHICS_OPENGL_GL_PROGRAM_CACHE_INCLUDED
+#define ENGINE_GRAPHICS_OPENGL_GL_PROGRAM_CACHE_INCLUDED
+
+#include <Engine/Graphics/OpenGL/GLDevice.hpp>
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace Engine::Graphics
+{
+    struct GLProgramSource
+    {
+        std::string vertex;
+        std::string fragment;
+    };
+
+    struct GLProgramCacheStats
+    {
+        // Programs compiled from source on the calling thread, the cache misses.
+        std::uint32_t compiled = 0;
+        // Programs created from a binary on disk.
+        std::uint32_t loaded = 0;
+        // Programs handed over from the background precompilation.
+        std::uint32_t precompiled = 0;
+        // Binaries on disk that didn't match the driver or were refused by it, and were replaced.
+        std::uint32_t rejected = 0;
+
+        // Time spent in `Load` on the calling thread and on the background context.
+        std::uint64_t loadNanoseconds = 0;
+        std::uint64_t backgroundNanoseconds = 0;
+    };
+
+    // Stores `glGetProgramBinary` output on disk so that programs are only compiled from source once
+    // per driver. Files are keyed by a hash of the sources, and carry a hash of the vendor, renderer
+    // and version strings so that binaries from another driver are recompiled instead of loaded.
+    class GLProgramCache
+    {
+    public:
+        // `directory` must exist.
+        GLProgramCache(const GLDevice& device, std::string directory);
+        ~GLProgramCache();
+
+        GLProgramCache(const GLProgramCache&) = delete;
+        GLProgramCache& operator=(const GLProgramCache&) = delete;
+
+        // Returns a linked program owned by the caller, or 0 if compiling failed. If the program is
+        // still being precompiled in the background, waits for it instead of compiling it twice.
+        GLuint Load(const char* vertexSource, const char* fragmentSource);
+
+        // Compile (or load) `sources` on `context`, which must share objects with the device of the
+        // cache (see `GLDevice::CreateSharedContext`), on a background thread. Results are kept
+        // in memory for `Load` and written to disk.
+        void Precompile(std::unique_ptr<GLDevice> context, std::vector<GLProgramSource> sources);
+        void WaitForPrecompile();
+
+        GLProgramCacheStats GetStats() const;
+
+    private:
+        std::uint64_t GetKey(const char* vertexSource, const char* fragmentSource) const;
+        std::string GetPath(std::uint64_t key) const;
+
+        // Returns 0 if there is no usable binary, sets `rejected` if there was one but it was stale.
+        GLuint LoadBinary(const GLFunctions& functions, std::uint64_t key, bool& rejected) const;
+        void StoreBinary(const GLFunctions& functions, GLuint program, std::uint64_t key) const;
+
+        const GLFunctions& gl;
+        std::string directory;
+        std::uint64_t driverHash;
+        bool binariesSupported;
+
+        mutable std::mutex mutex;
+        std::condition_variable precompiled;
+        std::unordered_set<std::uint64_t> pending;
+        std::unordered_map<std::uint64_t, GLuint> ready;
+        GLProgramCacheStats stats;
+
+        std::thread worker;
+    };
+}
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef ENGINE_GRAPHICS_OPENGL_GL_RING_BUFFER_INCLUDED
+#define ENGINE_GRAPHICS_OPENGL_GL_RING_BUFFER_INCLUDED
+
+#include <Engine/Graphics/OpenGL/GLFunctions.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Engine::Graphics
+{
+    struct GLRingAllocation
+    {
+        // Write-only, `nullptr` if the frame's section is full.
+        void* data = nullptr;
+        GLuint buffer = 0;
+        std::size_t offset = 0;
+    };
+
+    struct GLRingBufferStats
+    {
+        // Frames where the CPU caught up with the GPU and had to wait for a fence.
+        std::uint64_t waits = 0;
+        std::uint64_t waitNanoseconds = 0;
+    };
+
+    // Persistently and coherently mapped buffer split into one section per frame in flight.
+    // The CPU writes a frame's data directly into the mapping, a fence per section makes sure
+    // the GPU is done reading a section before it is reused.
+    class GLRingBuffer
+    {
+    public:
+        GLRingBuffer(const GLFunctions& gl, std::size_t frameSize, std::uint32_t frameCount = 3);
+        ~GLRingBuffer();
+
+        GLRingBuffer(const GLRingBuffer&) = delete;
+        GLRingBuffer& operator=(const GLRingBuffer&) = delete;
+
+        bool IsValid() const { return mapping != nullptr; }
+
+        // Wait until the GPU is done with the section of this frame, then start allocating from it. Gives
+        // up after a few seconds, for a lost context.
+        void BeginFrame();
+
+        // `alignment` must be a power of two, the offset into the buffer is aligned to it.
+        GLRingAllocation Allocate(std::size_t size, std::size_t alignment = 16);
+
+        // Fence the section of this frame and move on to the next one.
+        void EndFrame();
+
+        GLuint GetBuffer() const { return buffer; }
+        std::size_t GetFrameSize() const { return frameSize; }
+        const GLRingBufferStats& GetStats() const { return stats; }
+
+    private:
+        const GLFunctions& gl;
+        GLuint buffer = 0;
+        unsigned char* mapping = nullptr;
+
+        std::size_t frameSize;
+        std::uint32_t frameCount;
+        std::uint32_t frameIndex = 0;
+        std::size_t frameOffset = 0;
+        std::vector<GLsync> fences;
+
+        GLRingBufferStats stats;
+    };
+}
+
+#endif
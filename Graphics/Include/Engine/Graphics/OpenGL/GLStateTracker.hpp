@@ -0,0 +1,147 @@
+#ifndef ENGINE_GRAPHICS_OPENGL_GL_STATE_TRACKER_INCLUDED
+#define ENGINE_GRAPHICS_OPENGL_GL_STATE_TRACKER_INCLUDED
+
+#include <Engine/Graphics/OpenGL/GLFunctions.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+
+namespace Engine::Graphics
+{
+    enum class GLBlendMode : std::uint8_t
+    {
+        Opaque,
+        Alpha,
+        Premultiplied,
+        Additive
+    };
+
+    enum class GLCullMode : std::uint8_t
+    {
+        None,
+        Back,
+        Front
+    };
+
+    // Everything a draw needs besides resource bindings.
+    struct GLPipelineDesc
+    {
+        GLuint program = 0;
+        GLuint vertexArray = 0;
+        GLBlendMode blendMode = GLBlendMode::Opaque;
+        GLCullMode cullMode = GLCullMode::Back;
+        bool depthTest = true;
+        bool depthWrite = true;
+        bool colorWrite = true;
+        GLenum depthFunc = GL_LESS;
+
+        bool operator==(const GLPipelineDesc& other) const;
+        bool operator!=(const GLPipelineDesc& other) const { return !(*this == other); }
+    };
+
+    struct GLPipelineDescHash
+    {
+        std::size_t operator()(const GLPipelineDesc& desc) const;
+    };
+
+    // Immutable, created once per unique description by `GLStateTracker::GetPipeline`.
+    // Binding the same pipeline again costs a pointer compare.
+    struct GLPipeline
+    {
+        GLPipelineDesc desc;
+        std::uint32_t id;
+    };
+
+    struct GLStateCounters
+    {
+        // Driver calls made and driver calls skipped because the state was already set.
+        std::uint64_t issued = 0;
+        std::uint64_t elided = 0;
+        std::uint64_t pipelineChanges = 0;
+    };
+
+    // Shadow copy of the bound OpenGL state. Calls only reach the driver when they change something.
+    // All state changes have to go through the tracker, call `Invalidate` after code that doesn't
+    // and after deleting bound objects, since their names can be reused.
+    class GLStateTracker
+    {
+    public:
+        static constexpr std::uint32_t MaxTextureUnits = 32;
+        static constexpr std::uint32_t MaxBufferBindings = 16;
+
+        explicit GLStateTracker(const GLFunctions& gl);
+
+        const GLFunctions& GetFunctions() const { return gl; }
+
+        // Returns the cached pipeline for `desc`, creating it on first use.
+        const GLPipeline* GetPipeline(const GLPipelineDesc& desc);
+        std::size_t GetPipelineCount() const { return pipelines.size(); }
+
+        // Only the states that differ from the current pipeline are sent.
+        // Setting the current pipeline again counts as a single elided call.
+        void SetPipeline(const GLPipeline* pipeline);
+
+        void BindTexture(GLuint unit, GLuint texture);
+        void BindBuffer(GLenum target, GLuint buffer);
+        // `target` is `GL_UNIFORM_BUFFER` or `GL_SHADER_STORAGE_BUFFER`.
+        void BindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size);
+        void SetViewport(GLint x, GLint y, GLsizei width, GLsizei height);
+
+        // Forget the shadow state, the next call of each kind is always sent.
+        void Invalidate();
+
+        // Compare the shadow state with the driver's. Reports and returns false on a mismatch.
+        // Queries stall the pipeline, meant for debugging and tests only.
+        bool Validate() const;
+
+        const GLStateCounters& GetCounters() const { return counters; }
+        void ResetCounters() { counters = GLStateCounters(); }
+
+    private:
+        // Sentinel for unknown shadow values, never a valid name or enum.
+        static constexpr GLuint Unknown = UINT32_MAX;
+
+        struct BufferRange
+        {
+            GLuint buffer;
+            GLintptr offset;
+            GLsizeiptr size;
+        };
+
+        template<typename Value, typename Issue>
+        void Apply(Value& shadow, Value value, Issue&& issue);
+
+        void SetEnabled(GLenum capability, std::int8_t& shadow, bool enabled);
+
+        const GLFunctions& gl;
+        std::unordered_map<GLPipelineDesc, std::unique_ptr<GLPipeline>, GLPipelineDescHash> pipelines;
+
+        const GLPipeline* pipeline;
+        GLuint program;
+        GLuint vertexArray;
+        // -1 unknown, 0 disabled, 1 enabled.
+        std::int8_t blend;
+        std::int8_t cullFace;
+        std::int8_t depthTest;
+        std::int8_t depthWrite;
+        std::int8_t colorWrite;
+        GLenum blendSource;
+        GLenum blendDestination;
+        GLenum cullFaceMode;
+        GLenum depthFunc;
+
+        GLuint textures[MaxTextureUnits];
+        GLuint arrayBuffer;
+        GLuint drawIndirectBuffer;
+        GLuint pixelUnpackBuffer;
+        BufferRange uniformBuffers[MaxBufferBindings];
+        BufferRange storageBuffers[MaxBufferBindings];
+        GLint viewport[4];
+
+        GLStateCounters counters;
+    };
+}
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef ENGINE_GRAPHICS_OPENGL_GL_TEXTURE_ARRAY_INCLUDED
+#define ENGINE_GRAPHICS_OPENGL_GL_TEXTURE_ARRAY_INCLUDED
+
+#include <Engine/Graphics/OpenGL/GLFunctions.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace Engine::Graphics
+{
+    // 2D texture array with immutable storage. Textures of the same size share one array
+    // and are selected by layer in the shader, so switching textures doesn't break a batch.
+    class GLTextureArray
+    {
+    public:
+        // `mipLevels` of 0 means a full mip chain.
+        GLTextureArray(const GLFunctions& gl, std::uint32_t width, std::uint32_t height,
+                       std::uint32_t layerCount, std::uint32_t mipLevels = 0, GLenum internalFormat = GL_RGBA8);
+        ~GLTextureArray();
+
+        GLTextureArray(const GLTextureArray&) = delete;
+        GLTextureArray& operator=(const GLTextureArray&) = delete;
+
+        // Returns -1 if every layer is in use.
+        std::int32_t AllocateLayer();
+        void FreeLayer(std::int32_t layer);
+
+        // Upload mip 0 of `layer` from tightly packed RGBA8 pixels.
+        void Upload(std::int32_t layer, const void* pixels);
+
+        // Generate the mip chain of every layer after uploading.
+        void GenerateMipmaps();
+
+        void Bind(GLuint unit) const;
+
+        GLuint GetHandle() const { return texture; }
+        std::uint32_t GetWidth() const { return width; }
+        std::uint32_t GetHeight() const { return height; }
+        std::uint32_t GetLayerCount() const { return layerCount; }
+
+    private:
+        const GLFunctions& gl;
+        GLuint texture = 0;
+
+        std::uint32_t width;
+        std::uint32_t height;
+        std::uint32_t layerCount;
+
+        std::vector<std::int32_t> freeLayers;
+    };
+}
+
+#endif
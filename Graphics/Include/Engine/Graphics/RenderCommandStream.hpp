@@ -0,0 +1,83 @@
+#ifndef ENGINE_GRAPHICS_RENDER_COMMAND_STREAM_INCLUDED
+#define ENGINE_GRAPHICS_RENDER_COMMAND_STREAM_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Engine::Graphics
+{
+    // Commands serialized back to back into reusable memory blocks. A command is any callable,
+    // stored by value together with a pointer to a function that runs and destroys it. Commands
+    // never move once pushed, so captures don't need to be relocatable.
+    class RenderCommandStream
+    {
+    public:
+        explicit RenderCommandStream(std::size_t blockSize = 64 * 1024);
+        ~RenderCommandStream();
+
+        RenderCommandStream(const RenderCommandStream&) = delete;
+        RenderCommandStream& operator=(const RenderCommandStream&) = delete;
+
+        template<typename Function>
+        void Push(Function&& function)
+        {
+            using Command = std::decay_t<Function>;
+            static_assert(alignof(Command) <= alignof(std::max_align_t), "Over-aligned render commands are not supported.");
+
+            void* memory = Allocate(sizeof(Command));
+            new (memory) Command(std::forward<Function>(function));
+            Commit([](void* command, bool run)
+            {
+                Command& typed = *static_cast<Command*>(command);
+                if (run)
+                    typed();
+                typed.~Command();
+            });
+        }
+
+        // Run the commands in push order, destroy them and reset the stream, keeping its memory.
+        void Execute();
+        // Destroy the commands without running them.
+        void Clear();
+
+        bool IsEmpty() const { return commandCount == 0; }
+        std::uint32_t GetCommandCount() const { return commandCount; }
+        std::size_t GetUsedBytes() const { return usedBytes; }
+
+    private:
+        using CommandFunction = void (*)(void* command, bool run);
+
+        struct Header
+        {
+            CommandFunction function;
+            // Offset from this header to the next one in the block.
+            std::size_t next;
+        };
+
+        struct Block
+        {
+            std::unique_ptr<unsigned char[]> data;
+            std::size_t size = 0;
+            std::size_t used = 0;
+        };
+
+        void* Allocate(std::size_t size);
+        void Commit(CommandFunction function);
+        void Consume(bool run);
+
+        std::size_t blockSize;
+        std::vector<Block> blocks;
+        std::size_t currentBlock = 0;
+        Header* pendingHeader = nullptr;
+
+        std::uint32_t commandCount = 0;
+        std::size_t usedBytes = 0;
+    };
+}
+
+#endif
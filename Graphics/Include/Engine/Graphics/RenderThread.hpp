@@ -0,0 +1,91 @@
+#ifndef ENGINE_GRAPHICS_RENDER_THREAD_INCLUDED
+#define ENGINE_GRAPHICS_RENDER_THREAD_INCLUDED
+
+#include <Engine/Graphics/RenderCommandStream.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace Engine::Graphics
+{
+    // Frame number returned by `RenderThread::EndFrame`, complete once the render thread executed that frame.
+    using RenderFence = std::uint64_t;
+
+    struct RenderThreadStats
+    {
+        // Main thread: time between the last two `EndFrame` calls, and how much of it was spent
+        // blocked on the render thread.
+        std::uint64_t mainFrameNanoseconds = 0;
+        std::uint64_t mainWaitNanoseconds = 0;
+        // Render thread, for the last executed frame: time executing commands, and time idle
+        // waiting for the frame before it. Both threads being busy at once is the overlap gained.
+        std::uint64_t renderExecuteNanoseconds = 0;
+        std::uint64_t renderIdleNanoseconds = 0;
+        std::uint32_t commands = 0;
+        std::size_t commandBytes = 0;
+    };
+
+    // Runs graphics API calls on a dedicated thread. The main thread enqueues commands for frame N+1
+    // into one stream while the render thread executes frame N from the other. `EndFrame` blocks
+    // until frame N is done, so the main thread is never more than one frame ahead.
+    //
+    // Graphics contexts are bound to a thread: release the context on the main thread and make it
+    // current with the first enqueued command, e.g. `Enqueue([&] { device.MakeCurrent(); })`.
+    class RenderThread
+    {
+    public:
+        // Without `threaded` commands run on the calling thread in `EndFrame`, in the same order,
+        // which keeps call stacks intact for debugging.
+        explicit RenderThread(bool threaded = true);
+        // Executes everything enqueued so far before stopping.
+        ~RenderThread();
+
+        RenderThread(const RenderThread&) = delete;
+        RenderThread& operator=(const RenderThread&) = delete;
+
+        // Captures are copied or moved into the command stream, anything captured by reference must
+        // stay alive until the frame completes.
+        template<typename Function>
+        void Enqueue(Function&& function)
+        {
+            streams[writeIndex].Push(std::forward<Function>(function));
+        }
+
+        // Hand the enqueued commands over to the render thread and start the next frame.
+        RenderFence EndFrame();
+
+        bool IsComplete(RenderFence fence) const;
+        void Wait(RenderFence fence);
+        // End the frame and wait for it, for shutdown or reading back results.
+        void Flush();
+
+        bool IsThreaded() const { return thread.joinable(); }
+        bool IsRenderThread() const;
+
+        RenderThreadStats GetStats() const;
+
+    private:
+        void RenderMain();
+
+        RenderCommandStream streams[2];
+        int writeIndex = 0;
+
+        std::thread thread;
+        std::thread::id renderThreadId;
+        mutable std::mutex mutex;
+        std::condition_variable frameSubmitted;
+        std::condition_variable frameCompleted;
+        RenderFence submittedFrame = 0;
+        RenderFence completedFrame = 0;
+        bool stopping = false;
+
+        std::chrono::steady_clock::time_point lastEndFrame;
+        RenderThreadStats stats;
+    };
+}
+
+#endif
@@ -0,0 +1,79 @@
+#ifndef ENGINE_GRAPHICS_SPRITE_BATCHER_INCLUDED
+#define ENGINE_GRAPHICS_SPRITE_BATCHER_INCLUDED
+
+#include <SDL2/SDL_render.h>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace Engine::Graphics
+{
+    struct Sprite
+    {
+        // `nullptr` draws an untextured, colored quad.
+        SDL_Texture* texture = nullptr;
+        // Destination in render coordinates.
+        SDL_FRect destination = { 0.0f, 0.0f, 0.0f, 0.0f };
+        // Normalized texture coordinates, an atlas region or the whole texture.
+        SDL_FRect uv = { 0.0f, 0.0f, 1.0f, 1.0f };
+        // The `uv` region holds the image rotated by 90 degrees clockwise, as atlas regions may.
+        bool rotatedUv = false;
+        SDL_Color color = { 255, 255, 255, 255 };
+        // Clockwise, in radians, around the center of `destination`.
+        float rotation = 0.0f;
+        // Lower layers are drawn first. Within a layer sprites are grouped by texture, so overlapping
+        // sprites that must keep their order belong to different layers.
+        std::int32_t layer = 0;
+    };
+
+    struct SpriteBatchStats
+    {
+        std::uint32_t sprites = 0;
+        std::uint32_t batches = 0;
+        std::uint32_t textures = 0;
+    };
+
+    // Collects a frame of sprites, sorts them by layer and texture, and draws each run of sprites
+    // sharing a texture with a single `SDL_RenderGeometry` call. Works with every SDL renderer,
+    // including the software renderer.
+    class SpriteBatcher
+    {
+    public:
+        explicit SpriteBatcher(SDL_Renderer* renderer);
+
+        SpriteBatcher(const SpriteBatcher&) = delete;
+        SpriteBatcher& operator=(const SpriteBatcher&) = delete;
+
+        void Begin();
+        void Draw(const Sprite& sprite);
+        // Sort, build the vertices and issue the draw calls. Returns false if SDL reported an error.
+        bool End();
+
+        // Statistics of the last `End`.
+        const SpriteBatchStats& GetStats() const { return stats; }
+
+    private:
+        struct SortEntry
+        {
+            std::uint64_t key;
+            std::uint32_t sprite;
+        };
+
+        void WriteVertices(const Sprite& sprite, SDL_Vertex* vertices) const;
+
+        SDL_Renderer* renderer;
+
+        std::vector<Sprite> sprites;
+        std::vector<SortEntry> order;
+        // Textures in first use order this frame, which keeps the sort deterministic.
+        std::unordered_map<SDL_Texture*, std::uint32_t> textureIndices;
+
+        std::vector<SDL_Vertex> vertices;
+        // Two triangles per quad, shared by every batch since vertices are passed per batch.
+        std::vector<int> indices;
+
+        SpriteBatchStats stats;
+    };
+}
+
+#endif
@@ -0,0 +1,61 @@
+#ifndef ENGINE_GRAPHICS_TEXTURE_ATLAS_INCLUDED
+#define ENGINE_GRAPHICS_TEXTURE_ATLAS_INCLUDED
+
+#include <Engine/Core/StringId.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Engine::Graphics
+{
+    struct AtlasRegion
+    {
+        // Normalized texture coordinates of the region in its page.
+        float u0 = 0.0f;
+        float v0 = 0.0f;
+        float u1 = 0.0f;
+        float v1 = 0.0f;
+        std::uint16_t page = 0;
+        // Size of the original image, before rotation.
+        std::uint16_t width = 0;
+        std::uint16_t height = 0;
+        // The image is stored rotated by 90 degrees clockwise, see `Sprite::rotatedUv`.
+        std::uint8_t rotated = 0;
+        std::uint8_t padding = 0;
+    };
+
+    // Lookup table of an atlas written by the atlas packer. Regions are sorted by the hash of their
+    // name, so a lookup is a binary search over a packed array of hashes.
+    class TextureAtlas
+    {
+    public:
+        // Returns `nullptr` and reports why if the file is missing or malformed.
+        static std::unique_ptr<TextureAtlas> Load(const std::string& path);
+
+        TextureAtlas(const TextureAtlas&) = delete;
+        TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+        // Returns `nullptr` if there is no region named `name`.
+        const AtlasRegion* Find(Core::StringId name) const;
+
+        // Page image file names, relative to the directory of the atlas file.
+        std::size_t GetPageCount() const { return pages.size(); }
+        const std::string& GetPage(std::size_t page) const { return pages[page]; }
+        std::size_t GetRegionCount() const { return regions.size(); }
+
+        // Writes `regions` named by `names` (any order) in the format `Load` reads.
+        static bool Write(const std::string& path, const std::vector<std::string>& pages,
+                          const std::vector<Core::StringId>& names, const std::vector<AtlasRegion>& regions);
+
+    private:
+        TextureAtlas() = default;
+
+        std::vector<std::string> pages;
+        std::vector<std::uint64_t> hashes;
+        std::vector<AtlasRegion> regions;
+    };
+}
+
+#endif
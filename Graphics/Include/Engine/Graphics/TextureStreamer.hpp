@@ -0,0 +1,116 @@
+#ifndef ENGINE_GRAPHICS_TEXTURE_STREAMER_INCLUDED
+#define ENGINE_GRAPHICS_TEXTURE_STREAMER_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace Engine::Graphics
+{
+    using StreamedTextureId = std::uint32_t;
+
+    struct StreamedTextureDesc
+    {
+        std::uint32_t width = 0;
+        std::uint32_t height = 0;
+        std::uint32_t mipCount = 1;
+        std::uint32_t bytesPerPixel = 4;
+    };
+
+    struct TextureStreamingStats
+    {
+        std::size_t residentBytes = 0;
+        // Bytes needed to have every texture at its requested mip.
+        std::size_t requestedBytes = 0;
+        // Bytes needed to have every mip of every texture resident.
+        std::size_t fullyResidentBytes = 0;
+        std::size_t streamedInBytes = 0;
+        std::size_t streamedInMips = 0;
+        std::size_t droppedMips = 0;
+        // Textures whose resident mip is coarser than requested this frame.
+        std::size_t texturesBelowRequest = 0;
+    };
+
+    // Size in bytes of a single mip level.
+    std::size_t GetMipSize(const StreamedTextureDesc& desc, std::uint32_t mip);
+
+    // Most detailed mip worth sampling when the texture covers `screenSize` pixels on screen.
+    std::uint32_t ComputeRequiredMip(const StreamedTextureDesc& desc, float screenSize);
+
+    // Approximate height in pixels of a sphere with `radius` at `distance` from the camera.
+    float ComputeProjectedSize(float radius, float distance, float verticalFov, float screenHeight);
+
+    // Keeps a contiguous range of mips [resident mip, mip count - 1] per texture resident.
+    // Every frame, `Request` the on-screen size of visible textures, then `Update` streams
+    // finer mips in, most under-resolved textures first, and drops mips finer than
+    // requested when the memory budget is exceeded. The coarsest mip is always resident
+    // so sampling can fall back to it.
+    class TextureStreamer
+    {
+    public:
+        // Loads mip `mip` of texture `id`, returns false if it is not available yet.
+        using StreamInCallback = std::function<bool(StreamedTextureId id, std::uint32_t mip)>;
+        // Frees mip `mip` of texture `id`.
+        using StreamOutCallback = std::function<void(StreamedTextureId id, std::uint32_t mip)>;
+
+        TextureStreamer(std::size_t memoryBudget, std::size_t uploadBudgetPerFrame,
+                        StreamInCallback streamIn, StreamOutCallback streamOut);
+
+        StreamedTextureId AddTexture(const StreamedTextureDesc& desc);
+        void RemoveTexture(StreamedTextureId id);
+
+        // Report that `id` covers `screenSize` pixels this frame. The largest request wins.
+        void Request(StreamedTextureId id, float screenSize);
+
+        // Stream mips in and out, then reset requests for the next frame.
+        void Update();
+
+        // Most detailed mip that is resident and safe to sample.
+        std::uint32_t GetResidentMip(StreamedTextureId id) const;
+        std::uint32_t GetRequestedMip(StreamedTextureId id) const;
+
+        void SetMemoryBudget(std::size_t bytes) { memoryBudget = bytes; }
+        std::size_t GetMemoryBudget() const { return memoryBudget; }
+
+        // Statistics of the last `Update`.
+        const TextureStreamingStats& GetStats() const { return stats; }
+
+    private:
+        struct Texture
+        {
+            StreamedTextureDesc desc;
+            std::uint32_t residentMip = 0;
+            std::uint32_t requestedMip = 0;
+            float requestedSize = 0.0f;
+            std::uint64_t lastRequestFrame = 0;
+            bool alive = false;
+        };
+
+        bool DropMip(StreamedTextureId id);
+        // Drop mips finer than requested, least recently requested textures first,
+        // until `bytes` more fit into the budget. Never drops from `keep`.
+        void DropExcessMips(std::size_t bytes, StreamedTextureId keep);
+        bool MakeRoom(std::size_t bytes, StreamedTextureId keep);
+
+        std::vector<Texture> textures;
+        std::vector<StreamedTextureId> freeIds;
+
+        std::size_t memoryBudget;
+        std::size_t uploadBudgetPerFrame;
+        std::size_t residentBytes = 0;
+        std::uint64_t frame = 1;
+
+        // Textures resident finer than requested during `Update`, and the bytes they could give up.
+        std::vector<StreamedTextureId> victims;
+        std::size_t victimCursor = 0;
+        std::size_t reclaimableBytes = 0;
+
+        StreamInCallback streamIn;
+        StreamOutCallback streamOut;
+
+        TextureStreamingStats stats;
+    };
+}
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef ENGINE_GRAPHICS_VULKAN_VK_DEVICE_INCLUDED
+#define ENGINE_GRAPHICS_VULKAN_VK_DEVICE_INCLUDED
+
+#include <Engine/Graphics/Vulkan/VKFunctions.hpp>
+
+#include <SDL2/SDL_video.h>
+#include <cstdint>
+#include <memory>
+
+namespace Engine::Graphics
+{
+    // Vulkan 1.2 instance and device with a single graphics queue. Timeline semaphores are required.
+    class VKDevice
+    {
+    public:
+        // `window` must be created with `SDL_WINDOW_VULKAN`. Without a window, the device is headless:
+        // the loader is opened directly and no surface or swapchain support is set up, which is how
+        // it runs on CPU implementations like Mesa lavapipe in CI.
+        // Returns `nullptr` and reports why if no suitable device is found.
+        static std::unique_ptr<VKDevice> Create(SDL_Window* window, bool validation = false);
+        ~VKDevice();
+
+        VKDevice(const VKDevice&) = delete;
+        VKDevice& operator=(const VKDevice&) = delete;
+
+        const VKFunctions& GetFunctions() const { return functions; }
+        SDL_Window* GetWindow() const { return window; }
+        VkInstance GetInstance() const { return instance; }
+        VkSurfaceKHR GetSurface() const { return surface; }
+        VkPhysicalDevice GetPhysicalDevice() const { return physicalDevice; }
+        VkDevice GetDevice() const { return device; }
+        VkQueue GetQueue() const { return queue; }
+        std::uint32_t GetQueueFamily() const { return queueFamily; }
+        const VkPhysicalDeviceProperties& GetProperties() const { return properties; }
+
+        // Returns `UINT32_MAX` if no memory type in `typeBits` has all `flags`.
+        std::uint32_t FindMemoryType(std::uint32_t typeBits, VkMemoryPropertyFlags flags) const;
+
+    private:
+        VKDevice(SDL_Window* window);
+
+        bool CreateInstance(bool validation);
+        bool SelectPhysicalDevice();
+        bool CreateDevice();
+
+        SDL_Window* window;
+        // Loader opened with `SDL_LoadObject` for headless devices.
+        void* loader = nullptr;
+        bool sdlLoader = false;
+
+        VKFunctions functions;
+        VkInstance instance = VK_NULL_HANDLE;
+        VkSurfaceKHR surface = VK_NULL_HANDLE;
+        VkPhysicalDevice physicalDevice = VK_NULL_HANDLE;
+        VkPhysicalDeviceProperties properties = {};
+        VkPhysicalDeviceMemoryProperties memoryProperties = {};
+        VkDevice device = VK_NULL_HANDLE;
+        VkQueue queue = VK_NULL_HANDLE;
+        std::uint32_t queueFamily = 0;
+    };
+}
+
+#endif
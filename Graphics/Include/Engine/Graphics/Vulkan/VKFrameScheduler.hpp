@@ -0,0 +1,127 @@
+#ifndef ENGINE_GRAPHICS_VULKAN_VK_FRAME_SCHEDULER_INCLUDED
+#define ENGINE_GRAPHICS_VULKAN_VK_FRAME_SCHEDULER_INCLUDED
+
+#include <Engine/Core/ThreadPool.hpp>
+#include <Engine/Graphics/Vulkan/VKDevice.hpp>
+#include <Engine/Graphics/Vulkan/VKUniformRing.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace Engine::Graphics
+{
+    struct VKFrameStats
+    {
+        // CPU time waiting for the GPU to release a frame, recording, and in `vkQueueSubmit`.
+        std::uint64_t waitNanoseconds = 0;
+        std::uint64_t recordNanoseconds = 0;
+        std::uint64_t submitNanoseconds = 0;
+        std::uint32_t commandBuffers = 0;
+        std::uint32_t descriptorSets = 0;
+    };
+
+    class VKFrameScheduler;
+
+    // Handed to record callbacks. Everything allocated through it lives until the frame is reused.
+    class VKRecordContext
+    {
+    public:
+        VkCommandBuffer GetCommandBuffer() const { return commandBuffer; }
+        std::uint32_t GetWorker() const { return worker; }
+
+        // Returns `VK_NULL_HANDLE` if the set can't be allocated at all.
+        VkDescriptorSet AllocateDescriptorSet(VkDescriptorSetLayout layout);
+        VKUniformAllocation AllocateUniforms(std::size_t size);
+
+    private:
+        friend class VKFrameScheduler;
+
+        VKRecordContext(VKFrameScheduler& scheduler, std::uint32_t worker, VkCommandBuffer commandBuffer)
+            : scheduler(scheduler), worker(worker), commandBuffer(commandBuffer) {}
+
+        VKFrameScheduler& scheduler;
+        std::uint32_t worker;
+        VkCommandBuffer commandBuffer;
+    };
+
+    // Paces frames with a timeline semaphore and records command buffers on worker threads.
+    // Frame N signals value N when the GPU is done with it, and `BeginFrame` waits for N - framesInFlight
+    // before reusing its command pools, descriptor pools and uniform ring section. Each worker has
+    // its own command and descriptor pools per frame, so recording needs no locks.
+    class VKFrameScheduler
+    {
+    public:
+        using RecordFunction = std::function<void(VKRecordContext& context, std::uint32_t task)>;
+
+        // A `workerCount` of 0 uses one thread less than the hardware concurrency (at least one).
+        VKFrameScheduler(VKDevice& device, std::uint32_t workerCount = 0, std::uint32_t framesInFlight = 2,
+                         std::size_t uniformBytesPerFrame = 4 * 1024 * 1024);
+        ~VKFrameScheduler();
+
+        VKFrameScheduler(const VKFrameScheduler&) = delete;
+        VKFrameScheduler& operator=(const VKFrameScheduler&) = delete;
+
+        void BeginFrame();
+
+        // Record one primary command buffer per task, spread over the workers. Tasks are submitted
+        // in order, across calls as well. Blocks until all tasks are recorded.
+        void Record(std::uint32_t taskCount, const RecordFunction& record);
+
+        // Submit the frame's command buffers and signal the timeline with the frame number. The binary
+        // semaphores are for swapchain acquire and present, and are optional.
+        void Submit(VkSemaphore waitSemaphore = VK_NULL_HANDLE,
+                    VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                    VkSemaphore signalSemaphore = VK_NULL_HANDLE);
+
+        // Block until the GPU is done with every submitted frame.
+        void WaitIdle();
+
+        std::uint64_t GetFrameNumber() const { return frameNumber; }
+        std::uint32_t GetFrameIndex() const { return static_cast<std::uint32_t>(frameNumber % framesInFlight); }
+        std::uint32_t GetWorkerCount() const { return workerCount; }
+        VkSemaphore GetTimeline() const { return timeline; }
+        VKUniformRing& GetUniformRing() { return uniformRing; }
+        // Of the frame being recorded, or the last one after `Submit`.
+        const VKFrameStats& GetStats() const { return stats; }
+
+    private:
+        friend class VKRecordContext;
+
+        struct WorkerFrame
+        {
+            VkCommandPool commandPool = VK_NULL_HANDLE;
+            std::vector<VkCommandBuffer> commandBuffers;
+            std::uint32_t usedCommandBuffers = 0;
+
+            std::vector<VkDescriptorPool> descriptorPools;
+            std::uint32_t currentDescriptorPool = 0;
+            std::uint32_t descriptorSets = 0;
+        };
+
+        WorkerFrame& GetWorkerFrame(std::uint32_t worker);
+        VkCommandBuffer AcquireCommandBuffer(WorkerFrame& workerFrame);
+        VkDescriptorPool CreateDescriptorPool();
+        void WaitForTimeline(std::uint64_t value);
+
+        VKDevice& device;
+        const VKFunctions& vk;
+        std::uint32_t workerCount;
+        std::uint32_t framesInFlight;
+
+        VkSemaphore timeline = VK_NULL_HANDLE;
+        std::uint64_t frameNumber = 0;
+        std::uint64_t submittedFrame = 0;
+
+        // `framesInFlight` times `workerCount`, indexed by frame first.
+        std::vector<WorkerFrame> workerFrames;
+        std::vector<VkCommandBuffer> submitList;
+        VKUniformRing uniformRing;
+        VKFrameStats stats;
+
+        Core::ThreadPool workers;
+    };
+}
+
+#endif
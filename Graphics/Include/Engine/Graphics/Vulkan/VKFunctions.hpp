@@ -0,0 +1,106 @@
+#ifndef ENGINE_GRAPHICS_VULKAN_VK_FUNCTIONS_INCLUDED
+#define ENGINE_GRAPHICS_VULKAN_VK_FUNCTIONS_INCLUDED
+
+// Only the headers are needed, the loader is opened at runtime and every function is loaded
+// through `vkGetInstanceProcAddr` and `vkGetDeviceProcAddr`.
+#define VK_NO_PROTOTYPES
+#include <vulkan/vulkan.h>
+
+#define ENGINE_VK_GLOBAL_FUNCTIONS(X) \
+    X(vkCreateInstance) \
+    X(vkEnumerateInstanceExtensionProperties)
+
+#define ENGINE_VK_INSTANCE_FUNCTIONS(X) \
+    X(vkDestroyInstance) \
+    X(vkEnumeratePhysicalDevices) \
+    X(vkGetPhysicalDeviceProperties) \
+    X(vkGetPhysicalDeviceFeatures2) \
+    X(vkGetPhysicalDeviceQueueFamilyProperties) \
+    X(vkGetPhysicalDeviceMemoryProperties) \
+    X(vkCreateDevice) \
+    X(vkGetDeviceProcAddr)
+
+// Only loaded when the instance was created for a window.
+#define ENGINE_VK_SURFACE_FUNCTIONS(X) \
+    X(vkDestroySurfaceKHR) \
+    X(vkGetPhysicalDeviceSurfaceSupportKHR) \
+    X(vkGetPhysicalDeviceSurfaceCapabilitiesKHR) \
+    X(vkGetPhysicalDeviceSurfaceFormatsKHR) \
+    X(vkGetPhysicalDeviceSurfacePresentModesKHR)
+
+#define ENGINE_VK_DEVICE_FUNCTIONS(X) \
+    X(vkDestroyDevice) \
+    X(vkGetDeviceQueue) \
+    X(vkDeviceWaitIdle) \
+    X(vkQueueSubmit) \
+    X(vkCreateCommandPool) \
+    X(vkDestroyCommandPool) \
+    X(vkResetCommandPool) \
+    X(vkAllocateCommandBuffers) \
+    X(vkBeginCommandBuffer) \
+    X(vkEndCommandBuffer) \
+    X(vkCreateSemaphore) \
+    X(vkDestroySemaphore) \
+    X(vkWaitSemaphores) \
+    X(vkGetSemaphoreCounterValue) \
+    X(vkCreateBuffer) \
+    X(vkDestroyBuffer) \
+    X(vkGetBufferMemoryRequirements) \
+    X(vkAllocateMemory) \
+    X(vkFreeMemory) \
+    X(vkBindBufferMemory) \
+    X(vkMapMemory) \
+    X(vkUnmapMemory) \
+    X(vkCreateImageView) \
+    X(vkDestroyImageView) \
+    X(vkCreateDescriptorPool) \
+    X(vkDestroyDescriptorPool) \
+    X(vkResetDescriptorPool) \
+    X(vkAllocateDescriptorSets) \
+    X(vkUpdateDescriptorSets) \
+    X(vkCreatePipelineCache) \
+    X(vkDestroyPipelineCache) \
+    X(vkGetPipelineCacheData) \
+    X(vkCmdPipelineBarrier) \
+    X(vkCmdFillBuffer) \
+    X(vkCmdBindPipeline) \
+    X(vkCmdBindDescriptorSets) \
+    X(vkCmdBindVertexBuffers) \
+    X(vkCmdBindIndexBuffer) \
+    X(vkCmdPushConstants) \
+    X(vkCmdSetViewport) \
+    X(vkCmdSetScissor) \
+    X(vkCmdDraw) \
+    X(vkCmdDrawIndexed)
+
+// Only loaded when the device was created for a window.
+#define ENGINE_VK_SWAPCHAIN_FUNCTIONS(X) \
+    X(vkCreateSwapchainKHR) \
+    X(vkDestroySwapchainKHR) \
+    X(vkGetSwapchainImagesKHR) \
+    X(vkAcquireNextImageKHR) \
+    X(vkQueuePresentKHR)
+
+namespace Engine::Graphics
+{
+    // Vulkan entry points of one instance and device, called as `vk.vkQueueSubmit(...)`.
+    // Device functions are loaded for the device directly, which skips the loader's dispatch.
+    struct VKFunctions
+    {
+#define ENGINE_VK_DECLARE(Name) PFN_##Name Name = nullptr;
+        PFN_vkGetInstanceProcAddr vkGetInstanceProcAddr = nullptr;
+        ENGINE_VK_GLOBAL_FUNCTIONS(ENGINE_VK_DECLARE)
+        ENGINE_VK_INSTANCE_FUNCTIONS(ENGINE_VK_DECLARE)
+        ENGINE_VK_SURFACE_FUNCTIONS(ENGINE_VK_DECLARE)
+        ENGINE_VK_DEVICE_FUNCTIONS(ENGINE_VK_DECLARE)
+        ENGINE_VK_SWAPCHAIN_FUNCTIONS(ENGINE_VK_DECLARE)
+#undef ENGINE_VK_DECLARE
+
+        // Each step reports missing functions and returns false if any is missing.
+        bool LoadGlobal(PFN_vkGetInstanceProcAddr getInstanceProcAddr);
+        bool LoadInstance(VkInstance instance, bool surface);
+        bool LoadDevice(VkDevice device, bool swapchain);
+    };
+}
+
+#endif
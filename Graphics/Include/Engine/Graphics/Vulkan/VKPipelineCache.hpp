@@ -0,0 +1,41 @@
+#ifndef ENGINE_GRAPHICS_VULKAN_VK_PIPELINE_CACHE_INCLUDED
+#define ENGINE_GRAPHICS_VULKAN_VK_PIPELINE_CACHE_INCLUDED
+
+#include <Engine/Graphics/Vulkan/VKDevice.hpp>
+
+#include <cstddef>
+#include <string>
+
+namespace Engine::Graphics
+{
+    // `VkPipelineCache` serialized to a file between runs. The data is only handed to the driver if its
+    // header matches the device (vendor, device and pipeline cache UUID), otherwise the cache starts empty.
+    class VKPipelineCache
+    {
+    public:
+        VKPipelineCache(const VKDevice& device, std::string path);
+        ~VKPipelineCache();
+
+        VKPipelineCache(const VKPipelineCache&) = delete;
+        VKPipelineCache& operator=(const VKPipelineCache&) = delete;
+
+        // Pass to `vkCreateGraphicsPipelines` and `vkCreateComputePipelines`.
+        VkPipelineCache GetHandle() const { return cache; }
+
+        // Write the cache to its file, returns false on failure.
+        bool Save() const;
+
+        std::size_t GetLoadedBytes() const { return loadedBytes; }
+        bool WasRejected() const { return rejected; }
+
+    private:
+        const VKDevice& device;
+        std::string path;
+        VkPipelineCache cache = VK_NULL_HANDLE;
+
+        std::size_t loadedBytes = 0;
+        bool rejected = false;
+    };
+}
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef ENGINE_GRAPHICS_VULKAN_VK_SWAPCHAIN_INCLUDED
+#define ENGINE_GRAPHICS_VULKAN_VK_SWAPCHAIN_INCLUDED
+
+#include <Engine/Graphics/Vulkan/VKDevice.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace Engine::Graphics
+{
+    // Swapchain of the window of a `VKDevice`. Pass `GetAcquireSemaphore` and `GetPresentSemaphore`
+    // to `VKFrameScheduler::Submit` between `Acquire` and `Present`.
+    class VKSwapchain
+    {
+    public:
+        // With `vsync` FIFO presentation is used, otherwise mailbox or immediate if available.
+        VKSwapchain(const VKDevice& device, std::uint32_t framesInFlight, bool vsync = true);
+        ~VKSwapchain();
+
+        VKSwapchain(const VKSwapchain&) = delete;
+        VKSwapchain& operator=(const VKSwapchain&) = delete;
+
+        bool IsValid() const { return swapchain != VK_NULL_HANDLE; }
+
+        // Returns false if the swapchain was out of date and got recreated, the frame should be skipped.
+        bool Acquire(std::uint32_t frameIndex);
+        // Returns false if the swapchain was out of date and got recreated.
+        bool Present();
+
+        // Recreate after a resize, waits for the device to be idle.
+        void Recreate();
+
+        VkSemaphore GetAcquireSemaphore() const { return acquireSemaphores[frameIndex]; }
+        VkSemaphore GetPresentSemaphore() const { return presentSemaphores[imageIndex]; }
+
+        std::uint32_t GetImageIndex() const { return imageIndex; }
+        std::uint32_t GetImageCount() const { return static_cast<std::uint32_t>(images.size()); }
+        VkImage GetImage(std::uint32_t index) const { return images[index]; }
+        VkImageView GetImageView(std::uint32_t index) const { return imageViews[index]; }
+        VkFormat GetFormat() const { return format; }
+        VkExtent2D GetExtent() const { return extent; }
+
+    private:
+        void Create();
+        void DestroyImages();
+
+        const VKDevice& device;
+        bool vsync;
+
+        VkSwapchainKHR swapchain = VK_NULL_HANDLE;
+        VkFormat format = VK_FORMAT_UNDEFINED;
+        VkExtent2D extent = {};
+        std::vector<VkImage> images;
+        std::vector<VkImageView> imageViews;
+
+        // Acquire semaphores are per frame in flight, the timeline wait of a frame makes them reusable.
+        // Present semaphores are per image, as only reacquiring an image proves its present is done.
+        std::vector<VkSemaphore> acquireSemaphores;
+        std::vector<VkSemaphore> presentSemaphores;
+        std::uint32_t frameIndex = 0;
+        std::uint32_t imageIndex = 0;
+    };
+}
+
+#endif
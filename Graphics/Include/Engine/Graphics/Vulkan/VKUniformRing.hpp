@@ -0,0 +1,58 @@
+#ifndef ENGINE_GRAPHICS_VULKAN_VK_UNIFORM_RING_INCLUDED
+#define ENGINE_GRAPHICS_VULKAN_VK_UNIFORM_RING_INCLUDED
+
+#include <Engine/Graphics/Vulkan/VKDevice.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace Engine::Graphics
+{
+    struct VKUniformAllocation
+    {
+        // Write-only, `nullptr` if the frame's section is full.
+        void* data = nullptr;
+        VkBuffer buffer = VK_NULL_HANDLE;
+        // Use as the dynamic offset of a `VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC` binding.
+        std::uint32_t offset = 0;
+    };
+
+    // Host visible, coherent buffer mapped once and split into one section per frame in flight.
+    // Allocation is a single atomic add, so workers recording in parallel can share it. One dynamic
+    // uniform buffer descriptor covering `GetDescriptorRange` bytes serves every allocation.
+    // The caller makes sure the GPU is done with a section before starting it again.
+    class VKUniformRing
+    {
+    public:
+        VKUniformRing(const VKDevice& device, std::size_t frameSize, std::uint32_t frameCount);
+        ~VKUniformRing();
+
+        VKUniformRing(const VKUniformRing&) = delete;
+        VKUniformRing& operator=(const VKUniformRing&) = delete;
+
+        bool IsValid() const { return mapping != nullptr; }
+
+        void BeginFrame(std::uint32_t frameIndex);
+        VKUniformAllocation Allocate(std::size_t size);
+
+        VkBuffer GetBuffer() const { return buffer; }
+        // Largest allocation a dynamic uniform buffer descriptor of the ring has to cover.
+        std::size_t GetDescriptorRange() const { return descriptorRange; }
+        std::size_t GetUsedBytes() const { return frameOffset.load(std::memory_order_relaxed); }
+
+    private:
+        const VKDevice& device;
+        VkBuffer buffer = VK_NULL_HANDLE;
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        unsigned char* mapping = nullptr;
+
+        std::size_t frameSize;
+        std::size_t alignment;
+        std::size_t descriptorRange;
+        std::size_t frameStart = 0;
+        std::atomic<std::size_t> frameOffset { 0 };
+    };
+}
+
+#endif
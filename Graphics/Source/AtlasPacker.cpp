@@ -0,0 +1,256 @@
+#include <Engine/Graphics/AtlasPacker.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <numeric>
+
+namespace Engine::Graphics
+{
+    namespace
+    {
+        struct Rect
+        {
+            std::uint32_t x;
+            std::uint32_t y;
+            std::uint32_t width;
+            std::uint32_t height;
+
+            std::uint32_t GetRight() const { return x + width; }
+            std::uint32_t GetBottom() const { return y + height; }
+
+            bool Contains(const Rect& other) const
+            {
+                return other.x >= x && other.y >= y && other.GetRight() <= GetRight() && other.GetBottom() <= GetBottom();
+            }
+
+            bool Intersects(const Rect& other) const
+            {
+                return other.x < GetRight() && other.GetRight() > x && other.y < GetBottom() && other.GetBottom() > y;
+            }
+        };
+
+        struct Score
+        {
+            std::uint32_t shortSide = std::numeric_limits<std::uint32_t>::max();
+            std::uint32_t longSide = std::numeric_limits<std::uint32_t>::max();
+
+            bool operator<(const Score& other) const
+            {
+                return shortSide != other.shortSide ? shortSide < other.shortSide : longSide < other.longSide;
+            }
+        };
+
+        // Free space as the list of maximal free rectangles, which may overlap each other.
+        class MaxRectsBin
+        {
+        public:
+            MaxRectsBin(std::uint32_t width, std::uint32_t height)
+            {
+                freeRects.push_back({ 0, 0, width, height });
+            }
+
+            // Best short side fit: the free rectangle leaving the smallest leftover on its shorter side.
+            Score FindPosition(std::uint32_t width, std::uint32_t height, bool allowRotation, Rect& position, bool& rotated) const
+            {
+                Score best;
+                for (const Rect& free : freeRects)
+                {
+                    for (int rotation = 0; rotation < (allowRotation ? 2 : 1); ++rotation)
+                    {
+                        std::uint32_t w = rotation == 0 ? width : height;
+                        std::uint32_t h = rotation == 0 ? height : width;
+                        if (w > free.width || h > free.height)
+                            continue;
+
+                        std::uint32_t leftoverX = free.width - w;
+                        std::uint32_t leftoverY = free.height - h;
+                        Score score = { std::min(leftoverX, leftoverY), std::max(leftoverX, leftoverY) };
+                        if (score < best)
+                        {
+                            best = score;
+                            position = { free.x, free.y, w, h };
+                            rotated = rotation != 0;
+                        }
+                    }
+                }
+
+                return best;
+            }
+
+            void Place(const Rect& used)
+            {
+                // Every free rectangle overlapping the new one is replaced by its up to four maximal remainders.
+                splitRects.clear();
+                for (const Rect& free : freeRects)
+                {
+                    if (!free.Intersects(used))
+                    {
+                        splitRects.push_back(free);
+                        continue;
+                    }
+
+                    if (used.x > free.x)
+                        splitRects.push_back({ free.x, free.y, used.x - free.x, free.height });
+                    if (used.GetRight() < free.GetRight())
+                        splitRects.push_back({ used.GetRight(), free.y, free.GetRight() - used.GetRight(), free.height });
+                    if (used.y > free.y)
+                        splitRects.push_back({ free.x, free.y, free.width, used.y - free.y });
+                    if (used.GetBottom() < free.GetBottom())
+                        splitRects.push_back({ free.x, used.GetBottom(), free.width, free.GetBottom() - used.GetBottom() });
+                }
+
+                freeRects.swap(splitRects);
+                Prune();
+            }
+
+        private:
+            // Drop free rectangles contained in another one.
+            void Prune()
+            {
+                for (std::size_t i = 0; i < freeRects.size(); ++i)
+                {
+                    for (std::size_t j = i + 1; j < freeRects.size();)
+                    {
+                        if (freeRects[i].Contains(freeRects[j]))
+                        {
+                            freeRects[j] = freeRects.back();
+                            freeRects.pop_back();
+                        }
+                        else if (freeRects[j].Contains(freeRects[i]))
+                        {
+                            freeRects[i] = freeRects[j];
+                            freeRects[j] = freeRects.back();
+                            freeRects.pop_back();
+                            j = i + 1;
+                        }
+                        else
+                        {
+                            ++j;
+                        }
+                    }
+                }
+            }
+
+            std::vector<Rect> freeRects;
+            std::vector<Rect> splitRects;
+        };
+
+        std::uint32_t RoundUpToPowerOfTwo(std::uint32_t value)
+        {
+            std::uint32_t result = 1;
+            while (result < value)
+                result <<= 1;
+            return result;
+        }
+    }
+
+    float AtlasPackResult::GetEfficiency() const
+    {
+        std::uint64_t usedPixels = 0;
+        std::uint64_t pagePixels = 0;
+        for (const AtlasPage& page : pages)
+        {
+            usedPixels += page.usedPixels;
+            pagePixels += std::uint64_t(page.width) * page.height;
+        }
+
+        return pagePixels > 0 ? static_cast<float>(static_cast<double>(usedPixels) / pagePixels) : 0.0f;
+    }
+
+    bool PackAtlas(const std::vector<AtlasImageSize>& images, const AtlasPackOptions& options, AtlasPackResult& result)
+    {
+        result.placements.assign(images.size(), AtlasPlacement());
+        result.pages.clear();
+
+        // Trailing padding may hang over the page edge, so bins are larger by the padding.
+        std::uint32_t border = options.extrude * 2 + options.padding;
+        std::uint32_t binWidth = options.maxPageWidth + options.padding;
+        std::uint32_t binHeight = options.maxPageHeight + options.padding;
+
+        // Largest first, by longer side then area, the order MaxRects packs tightest with.
+        std::vector<std::uint32_t> order(images.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&images](std::uint32_t a, std::uint32_t b)
+        {
+            std::uint32_t sideA = std::max(images[a].width, images[a].height);
+            std::uint32_t sideB = std::max(images[b].width, images[b].height);
+            if (sideA != sideB)
+                return sideA > sideB;
+
+            return std::uint64_t(images[a].width) * images[a].height > std::uint64_t(images[b].width) * images[b].height;
+        });
+
+        std::vector<MaxRectsBin> bins;
+        for (std::uint32_t index : order)
+        {
+            std::uint32_t width = images[index].width + border;
+            std::uint32_t height = images[index].height + border;
+
+            // The tightest fit over every open page, a new page if none has room.
+            Score best;
+            Rect position = {};
+            bool rotated = false;
+            std::size_t page = bins.size();
+            for (std::size_t i = 0; i < bins.size(); ++i)
+            {
+                Rect candidate = {};
+                bool candidateRotated = false;
+                Score score = bins[i].FindPosition(width, height, options.allowRotation, candidate, candidateRotated);
+                if (score < best)
+                {
+                    best = score;
+                    position = candidate;
+                    rotated = candidateRotated;
+                    page = i;
+                }
+            }
+
+            if (page == bins.size())
+            {
+                MaxRectsBin bin(binWidth, binHeight);
+                if (bin.FindPosition(width, height, options.allowRotation, position, rotated).shortSide ==
+                    std::numeric_limits<std::uint32_t>::max())
+                {
+                    std::cout << "Image " << index << " (" << images[index].width << "x" << images[index].height
+                              << ") does not fit on an atlas page." << std::endl;
+                    return false;
+                }
+
+                bins.push_back(std::move(bin));
+                result.pages.emplace_back();
+            }
+
+            bins[page].Place(position);
+
+            AtlasPlacement& placement = result.placements[index];
+            placement.page = static_cast<std::uint32_t>(page);
+            placement.x = position.x + options.extrude;
+            placement.y = position.y + options.extrude;
+            placement.width = rotated ? images[index].height : images[index].width;
+            placement.height = rotated ? images[index].width : images[index].height;
+            placement.rotated = rotated;
+
+            AtlasPage& atlasPage = result.pages[page];
+            atlasPage.usedPixels += std::uint64_t(placement.width) * placement.height;
+            atlasPage.width = std::max(atlasPage.width, placement.x + placement.width + options.extrude);
+            atlasPage.height = std::max(atlasPage.height, placement.y + placement.height + options.extrude);
+        }
+
+        for (AtlasPage& page : result.pages)
+        {
+            if (options.trimPages)
+            {
+                page.width = std::min(RoundUpToPowerOfTwo(page.width), options.maxPageWidth);
+                page.height = std::min(RoundUpToPowerOfTwo(page.height), options.maxPageHeight);
+            }
+            else
+            {
+                page.width = options.maxPageWidth;
+                page.height = options.maxPageHeight;
+            }
+        }
+
+        return true;
+    }
+}
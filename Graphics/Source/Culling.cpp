@@ -0,0 +1,262 @@
+#include <Engine/Graphics/Culling.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace Engine::Graphics
+{
+    using Core::Matrix4;
+    using Core::Vector3;
+    using Core::Vector4;
+
+    namespace
+    {
+        // Clip space `w` below which a point counts as behind the camera.
+        constexpr float MinimumW = 1e-5f;
+
+        Vector4 GetRow(const Matrix4& matrix, int row)
+        {
+            return Vector4(matrix(row, 0), matrix(row, 1), matrix(row, 2), matrix(row, 3));
+        }
+
+        Vector4 AddRows(const Vector4& a, const Vector4& b, float sign)
+        {
+            return Vector4(a.x + sign * b.x, a.y + sign * b.y, a.z + sign * b.z, a.w + sign * b.w);
+        }
+
+        Vector4 NormalizePlane(const Vector4& plane)
+        {
+            float length = std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+            return length > 0.0f ? Vector4(plane.x / length, plane.y / length, plane.z / length, plane.w / length) : plane;
+        }
+
+        float EdgeFunction(float ax, float ay, float bx, float by, float px, float py)
+        {
+            return (bx - ax) * (py - ay) - (by - ay) * (px - ax);
+        }
+    }
+
+    Frustum Frustum::FromViewProjection(const Matrix4& viewProjection)
+    {
+        // Gribb and Hartmann.
+        Vector4 row0 = GetRow(viewProjection, 0);
+        Vector4 row1 = GetRow(viewProjection, 1);
+        Vector4 row2 = GetRow(viewProjection, 2);
+        Vector4 row3 = GetRow(viewProjection, 3);
+
+        Frustum frustum;
+        frustum.planes[0] = NormalizePlane(AddRows(row3, row0, 1.0f));
+        frustum.planes[1] = NormalizePlane(AddRows(row3, row0, -1.0f));
+        frustum.planes[2] = NormalizePlane(AddRows(row3, row1, 1.0f));
+        frustum.planes[3] = NormalizePlane(AddRows(row3, row1, -1.0f));
+        frustum.planes[4] = NormalizePlane(AddRows(row3, row2, 1.0f));
+        frustum.planes[5] = NormalizePlane(AddRows(row3, row2, -1.0f));
+        return frustum;
+    }
+
+    bool Frustum::IsSphereVisible(const Vector3& center, float radius) const
+    {
+        for (const Vector4& plane : planes)
+        {
+            if (plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w < -radius)
+                return false;
+        }
+        return true;
+    }
+
+    OcclusionBuffer::OcclusionBuffer(std::uint32_t width, std::uint32_t height)
+        : width(std::max<std::uint32_t>(width, 1)), height(std::max<std::uint32_t>(height, 1))
+    {
+        std::uint32_t levelWidth = this->width;
+        std::uint32_t levelHeight = this->height;
+        while (true)
+        {
+            levels.emplace_back(static_cast<std::size_t>(levelWidth) * levelHeight, 1.0f);
+            levelWidths.push_back(levelWidth);
+            levelHeights.push_back(levelHeight);
+
+            if (levelWidth == 1 && levelHeight == 1)
+                break;
+
+            levelWidth = (levelWidth + 1) / 2;
+            levelHeight = (levelHeight + 1) / 2;
+        }
+    }
+
+    void OcclusionBuffer::Clear()
+    {
+        for (std::vector<float>& level : levels)
+            std::fill(level.begin(), level.end(), 1.0f);
+
+        trianglesRasterized = 0;
+    }
+
+    void OcclusionBuffer::SetDepth(const float* depth)
+    {
+        std::memcpy(levels[0].data(), depth, levels[0].size() * sizeof(float));
+    }
+
+    void OcclusionBuffer::RasterizeTriangles(const Matrix4& viewProjection, const float* positions, std::size_t positionStride,
+                                             const std::uint32_t* indices, std::size_t indexCount)
+    {
+        const auto* bytes = reinterpret_cast<const unsigned char*>(positions);
+        std::vector<float>& depth = levels[0];
+
+        for (std::size_t i = 0; i + 2 < indexCount; i += 3)
+        {
+            float screenX[3];
+            float screenY[3];
+            float screenDepth[3];
+            bool behindCamera = false;
+
+            for (int corner = 0; corner < 3; ++corner)
+            {
+                const auto* position = reinterpret_cast<const float*>(bytes + indices[i + corner] * positionStride);
+                Vector4 clip = viewProjection * Vector4(position[0], position[1], position[2], 1.0f);
+                if (clip.w < MinimumW)
+                {
+                    behindCamera = true;
+                    break;
+                }
+
+                screenX[corner] = (clip.x / clip.w * 0.5f + 0.5f) * width;
+                screenY[corner] = (clip.y / clip.w * 0.5f + 0.5f) * height;
+                screenDepth[corner] = clip.z / clip.w * 0.5f + 0.5f;
+            }
+
+            if (behindCamera)
+                continue;
+
+            float area = EdgeFunction(screenX[0], screenY[0], screenX[1], screenY[1], screenX[2], screenY[2]);
+            if (std::fabs(area) < 1e-8f)
+                continue;
+
+            // Occluders are rasterized regardless of winding.
+            if (area < 0.0f)
+            {
+                std::swap(screenX[1], screenX[2]);
+                std::swap(screenY[1], screenY[2]);
+                std::swap(screenDepth[1], screenDepth[2]);
+                area = -area;
+            }
+
+            int minimumX = std::max(static_cast<int>(std::floor(std::min({ screenX[0], screenX[1], screenX[2] }))), 0);
+            int minimumY = std::max(static_cast<int>(std::floor(std::min({ screenY[0], screenY[1], screenY[2] }))), 0);
+            int maximumX = std::min(static_cast<int>(std::ceil(std::max({ screenX[0], screenX[1], screenX[2] }))), static_cast<int>(width) - 1);
+            int maximumY = std::min(static_cast<int>(std::ceil(std::max({ screenY[0], screenY[1], screenY[2] }))), static_cast<int>(height) - 1);
+            if (minimumX > maximumX || minimumY > maximumY)
+                continue;
+
+            ++trianglesRasterized;
+
+            float inverseArea = 1.0f / area;
+            for (int y = minimumY; y <= maximumY; ++y)
+            {
+                float pixelY = y + 0.5f;
+                for (int x = minimumX; x <= maximumX; ++x)
+                {
+                    float pixelX = x + 0.5f;
+                    float weight0 = EdgeFunction(screenX[1], screenY[1], screenX[2], screenY[2], pixelX, pixelY);
+                    float weight1 = EdgeFunction(screenX[2], screenY[2], screenX[0], screenY[0], pixelX, pixelY);
+                    float weight2 = EdgeFunction(screenX[0], screenY[0], screenX[1], screenY[1], pixelX, pixelY);
+                    if (weight0 < 0.0f || weight1 < 0.0f || weight2 < 0.0f)
+                        continue;
+
+                    // Depth after the perspective divide is affine in screen space.
+                    float pixelDepth = (weight0 * screenDepth[0] + weight1 * screenDepth[1] + weight2 * screenDepth[2]) * inverseArea;
+                    if (pixelDepth < 0.0f)
+                        continue;
+
+                    float& stored = depth[static_cast<std::size_t>(y) * width + x];
+                    stored = std::min(stored, pixelDepth);
+                }
+            }
+        }
+    }
+
+    void OcclusionBuffer::BuildPyramid()
+    {
+        for (std::size_t level = 1; level < levels.size(); ++level)
+        {
+            const std::vector<float>& source = levels[level - 1];
+            std::vector<float>& destination = levels[level];
+            std::uint32_t sourceWidth = levelWidths[level - 1];
+            std::uint32_t sourceHeight = levelHeights[level - 1];
+
+            for (std::uint32_t y = 0; y < levelHeights[level]; ++y)
+            {
+                std::uint32_t y0 = y * 2;
+                std::uint32_t y1 = std::min(y0 + 1, sourceHeight - 1);
+                for (std::uint32_t x = 0; x < levelWidths[level]; ++x)
+                {
+                    std::uint32_t x0 = x * 2;
+                    std::uint32_t x1 = std::min(x0 + 1, sourceWidth - 1);
+                    destination[y * levelWidths[level] + x] = std::max(
+                        std::max(source[y0 * sourceWidth + x0], source[y0 * sourceWidth + x1]),
+                        std::max(source[y1 * sourceWidth + x0], source[y1 * sourceWidth + x1]));
+                }
+            }
+        }
+    }
+
+    float OcclusionBuffer::SampleMaxDepth(std::uint32_t level, int minimumX, int minimumY, int maximumX, int maximumY) const
+    {
+        const std::vector<float>& depth = levels[level];
+        std::uint32_t levelWidth = levelWidths[level];
+
+        float result = 0.0f;
+        for (int y = minimumY >> level; y <= (maximumY >> level); ++y)
+        {
+            for (int x = minimumX >> level; x <= (maximumX >> level); ++x)
+                result = std::max(result, depth[static_cast<std::size_t>(y) * levelWidth + x]);
+        }
+        return result;
+    }
+
+    bool OcclusionBuffer::IsSphereOccluded(const Matrix4& viewProjection, const Vector3& center, float radius) const
+    {
+        // Project the corners of the sphere's bounding box.
+        float minimumX = 1.0f;
+        float minimumY = 1.0f;
+        float maximumX = -1.0f;
+        float maximumY = -1.0f;
+        float nearestDepth = 1.0f;
+
+        for (int corner = 0; corner < 8; ++corner)
+        {
+            Vector3 point(center.x + ((corner & 1) != 0 ? radius : -radius),
+                          center.y + ((corner & 2) != 0 ? radius : -radius),
+                          center.z + ((corner & 4) != 0 ? radius : -radius));
+
+            Vector4 clip = viewProjection * Vector4(point, 1.0f);
+            if (clip.w < MinimumW)
+                return false;
+
+            float x = clip.x / clip.w;
+            float y = clip.y / clip.w;
+            minimumX = std::min(minimumX, x);
+            minimumY = std::min(minimumY, y);
+            maximumX = std::max(maximumX, x);
+            maximumY = std::max(maximumY, y);
+            nearestDepth = std::min(nearestDepth, clip.z / clip.w * 0.5f + 0.5f);
+        }
+
+        int pixelMinimumX = std::max(static_cast<int>(std::floor((minimumX * 0.5f + 0.5f) * width)), 0);
+        int pixelMinimumY = std::max(static_cast<int>(std::floor((minimumY * 0.5f + 0.5f) * height)), 0);
+        int pixelMaximumX = std::min(static_cast<int>(std::floor((maximumX * 0.5f + 0.5f) * width)), static_cast<int>(width) - 1);
+        int pixelMaximumY = std::min(static_cast<int>(std::floor((maximumY * 0.5f + 0.5f) * height)), static_cast<int>(height) - 1);
+
+        // Off screen, that's up to frustum culling.
+        if (pixelMinimumX > pixelMaximumX || pixelMinimumY > pixelMaximumY)
+            return false;
+
+        // Pick the level at which the rectangle covers at most 3x3 texels.
+        int size = std::max(pixelMaximumX - pixelMinimumX, pixelMaximumY - pixelMinimumY) + 1;
+        std::uint32_t level = 0;
+        while ((size >> level) > 2 && level + 1 < levels.size())
+            ++level;
+
+        return nearestDepth > SampleMaxDepth(level, pixelMinimumX, pixelMinimumY, pixelMaximumX, pixelMaximumY);
+    }
+}
@@ -0,0 +1,153 @@
+#include <Engine/Graphics/Lod.hpp>
+
+#include <Engine/Core/MemoryTracking.hpp>
+#include <Engine/Graphics/MeshOptimizer.hpp>
+#include <Engine/Graphics/MeshSimplifier.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace Engine::Graphics
+{
+    namespace
+    {
+        // A level that doesn't get at least this much smaller than the previous one is discarded.
+        constexpr float MinimumReduction = 0.9f;
+    }
+
+    LodChain GenerateLodChain(const Mesh& mesh, std::size_t maxLevels, float reduction)
+    {
+        Core::MemoryTagScope memoryTag(Core::MemoryTag::Graphics);
+        LodChain chain;
+        if (maxLevels == 0)
+            return chain;
+
+        LodLevel& base = chain.levels.emplace_back();
+        base.indices = mesh.indices;
+        base.error = 0.0f;
+
+        while (chain.levels.size() < maxLevels)
+        {
+            const LodLevel& previous = chain.levels.back();
+
+            SimplifyOptions options;
+            options.targetIndexCount = static_cast<std::size_t>(previous.indices.size() / 3 * reduction) * 3;
+
+            LodLevel level;
+            float error = SimplifyMesh(mesh.vertices, previous.indices, options, level.indices);
+            if (level.indices.empty() || level.indices.size() > previous.indices.size() * MinimumReduction)
+                break;
+
+            // Each level is simplified from the previous one, so errors add up.
+            level.error = previous.error + error;
+            OptimizeVertexCache(level.indices.data(), level.indices.size(), mesh.vertices.size());
+            chain.levels.push_back(std::move(level));
+        }
+
+        return chain;
+    }
+
+    float ComputeProjectionScale(float verticalFov, float screenHeight)
+    {
+        return screenHeight / (2.0f * std::tan(verticalFov * 0.5f));
+    }
+
+    LodSelector::LodSelector(float pixelErrorThreshold, float hysteresis, float fadeDuration)
+        : pixelErrorThreshold(pixelErrorThreshold), hysteresis(hysteresis), fadeDuration(fadeDuration)
+    {
+    }
+
+    LodInstanceId LodSelector::AddInstance()
+    {
+        LodInstanceId id;
+        if (!freeIds.empty())
+        {
+            id = freeIds.back();
+            freeIds.pop_back();
+        }
+        else
+        {
+            id = static_cast<LodInstanceId>(instances.size());
+            instances.emplace_back();
+        }
+
+        instances[id] = Instance();
+        instances[id].alive = true;
+        return id;
+    }
+
+    void LodSelector::RemoveInstance(LodInstanceId id)
+    {
+        instances[id].alive = false;
+        freeIds.push_back(id);
+    }
+
+    LodSelection LodSelector::Select(LodInstanceId id, const LodChain& chain, float distance, float projectionScale, float deltaTime)
+    {
+        Instance& instance = instances[id];
+        LodSelection& selection = instance.selection;
+        if (chain.levels.empty())
+            return selection;
+
+        std::uint32_t levelCount = static_cast<std::uint32_t>(chain.levels.size());
+        std::uint32_t current = std::min(selection.level, levelCount - 1);
+        float pixelsPerUnit = projectionScale / std::max(distance, 1e-4f);
+
+        auto coarsestWithin = [&](float threshold)
+        {
+            std::uint32_t level = 0;
+            while (level + 1 < levelCount && chain.levels[level + 1].error * pixelsPerUnit <= threshold)
+                ++level;
+            return level;
+        };
+
+        std::uint32_t desired = coarsestWithin(pixelErrorThreshold);
+        std::uint32_t next = current;
+        if (desired < current)
+        {
+            // Quality first, refine as soon as the current level is too coarse.
+            next = desired;
+        }
+        else if (desired > current)
+        {
+            next = std::max(current, coarsestWithin(pixelErrorThreshold * (1.0f - hysteresis)));
+        }
+
+        if (!instance.selected)
+        {
+            // New instances start at their level without fading in.
+            instance.selected = true;
+            selection.level = desired;
+            selection.previousLevel = desired;
+            selection.fade = 1.0f;
+        }
+        else if (next != current)
+        {
+            selection.previousLevel = current;
+            selection.level = next;
+            selection.fade = fadeDuration > 0.0f ? 0.0f : 1.0f;
+        }
+        else if (selection.fade < 1.0f)
+        {
+            selection.fade = std::min(selection.fade + deltaTime / fadeDuration, 1.0f);
+        }
+
+        ++stats.instances;
+        stats.triangles += chain.levels[selection.level].indices.size() / 3;
+        stats.fullDetailTriangles += chain.levels[0].indices.size() / 3;
+        if (selection.fade < 1.0f)
+        {
+            ++stats.fadingInstances;
+            stats.triangles += chain.levels[selection.previousLevel].indices.size() / 3;
+        }
+
+        return selection;
+    }
+
+    LodStats LodSelector::ResetStats()
+    {
+        LodStats result = stats;
+        stats = LodStats();
+        return result;
+    }
+}
@@ -0,0 +1,595 @@
+#include <Engine/Graphics/MeshOptimizer.hpp>
+
+#include <Engine/Core/MemoryTracking.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace Engine::Graphics
+{
+    namespace
+    {
+        // Forsyth's scoring parameters, as published.
+        constexpr int ForsythCacheSize = 32;
+        constexpr float CacheDecayPower = 1.5f;
+        constexpr float LastTriangleScore = 0.75f;
+        constexpr float ValenceBoostScale = 2.0f;
+        constexpr float ValenceBoostPower = 0.5f;
+
+        // Cache size used to find cluster boundaries for overdraw optimization.
+        constexpr std::size_t OverdrawCacheSize = 16;
+
+        float ComputeVertexScore(int cachePosition, std::uint32_t remainingTriangles)
+        {
+            if (remainingTriangles == 0)
+                return -1.0f;
+
+            float score = 0.0f;
+            if (cachePosition >= 0)
+            {
+                // The last triangle's vertices get a fixed score so that it isn't repeated.
+                if (cachePosition < 3)
+                {
+                    score = LastTriangleScore;
+                }
+                else
+                {
+                    float scale = 1.0f / (ForsythCacheSize - 3);
+                    score = std::pow(1.0f - (cachePosition - 3) * scale, CacheDecayPower);
+                }
+            }
+
+            // Prefer vertices with few remaining triangles, to get rid of lone triangles early.
+            score += ValenceBoostScale * std::pow(static_cast<float>(remainingTriangles), -ValenceBoostPower);
+            return score;
+        }
+
+        void Subtract(const float a[3], const float b[3], float result[3])
+        {
+            result[0] = a[0] - b[0];
+            result[1] = a[1] - b[1];
+            result[2] = a[2] - b[2];
+        }
+
+        void Cross(const float a[3], const float b[3], float result[3])
+        {
+            result[0] = a[1] * b[2] - a[2] * b[1];
+            result[1] = a[2] * b[0] - a[0] * b[2];
+            result[2] = a[0] * b[1] - a[1] * b[0];
+        }
+    }
+
+    VertexCacheStats AnalyzeVertexCache(const std::uint32_t* indices, std::size_t indexCount,
+                                        std::size_t vertexCount, std::size_t cacheSize)
+    {
+        VertexCacheStats stats;
+        if (indexCount == 0 || vertexCount == 0)
+            return stats;
+
+        // A vertex is in the FIFO if fewer than `cacheSize` misses happened since it was added.
+        std::vector<std::size_t> timestamps(vertexCount, 0);
+        std::size_t time = cacheSize + 1;
+        std::size_t misses = 0;
+
+        for (std::size_t i = 0; i < indexCount; ++i)
+        {
+            std::uint32_t vertex = indices[i];
+            if (time - timestamps[vertex] > cacheSize)
+            {
+                timestamps[vertex] = time++;
+                ++misses;
+            }
+        }
+
+        stats.acmr = static_cast<float>(misses) / static_cast<float>(indexCount / 3);
+        stats.atvr = static_cast<float>(misses) / static_cast<float>(vertexCount);
+        return stats;
+    }
+
+    void OptimizeVertexCache(std::uint32_t* indices, std::size_t indexCount, std::size_t vertexCount)
+    {
+        std::size_t triangleCount = indexCount / 3;
+        if (triangleCount == 0)
+            return;
+
+        // Triangles adjacent to each vertex. The first `remaining[vertex]` are not emitted yet.
+        std::vector<std::uint32_t> remaining(vertexCount, 0);
+        for (std::size_t i = 0; i < indexCount; ++i)
+            ++remaining[indices[i]];
+
+        std::vector<std::uint32_t> offsets(vertexCount + 1, 0);
+        for (std::size_t vertex = 0; vertex < vertexCount; ++vertex)
+            offsets[vertex + 1] = offsets[vertex] + remaining[vertex];
+
+        std::vector<std::uint32_t> adjacency(indexCount);
+        {
+            std::vector<std::uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+            for (std::size_t i = 0; i < indexCount; ++i)
+                adjacency[cursor[indices[i]]++] = static_cast<std::uint32_t>(i / 3);
+        }
+
+        std::vector<float> vertexScores(vertexCount);
+        for (std::size_t vertex = 0; vertex < vertexCount; ++vertex)
+            vertexScores[vertex] = ComputeVertexScore(-1, remaining[vertex]);
+
+        std::vector<float> triangleScores(triangleCount);
+        for (std::size_t triangle = 0; triangle < triangleCount; ++triangle)
+        {
+            const std::uint32_t* corners = indices + triangle * 3;
+            triangleScores[triangle] = vertexScores[corners[0]] + vertexScores[corners[1]] + vertexScores[corners[2]];
+        }
+
+        std::vector<bool> emitted(triangleCount, false);
+        std::vector<std::uint32_t> output(triangleCount * 3);
+
+        std::uint32_t cache[ForsythCacheSize + 3];
+        std::uint32_t newCache[ForsythCacheSize + 3];
+        int cacheCount = 0;
+
+        std::size_t scanCursor = 0;
+        std::size_t bestTriangle = std::numeric_limits<std::size_t>::max();
+
+        for (std::size_t outputTriangle = 0; outputTriangle < triangleCount; ++outputTriangle)
+        {
+            // Nothing adjacent to the cache, continue with the next triangle in input order.
+            if (bestTriangle == std::numeric_limits<std::size_t>::max())
+            {
+                while (emitted[scanCursor])
+                    ++scanCursor;
+                bestTriangle = scanCursor;
+            }
+
+            const std::uint32_t* corners = indices + bestTriangle * 3;
+            std::memcpy(&output[outputTriangle * 3], corners, 3 * sizeof(std::uint32_t));
+            emitted[bestTriangle] = true;
+
+            int newCacheCount = 0;
+            for (int corner = 0; corner < 3; ++corner)
+            {
+                std::uint32_t vertex = corners[corner];
+
+                // Move the triangle out of the vertex's remaining range.
+                std::uint32_t* triangles = adjacency.data() + offsets[vertex];
+                std::uint32_t count = remaining[vertex];
+                for (std::uint32_t i = 0; i < count; ++i)
+                {
+                    if (triangles[i] == bestTriangle)
+                    {
+                        std::swap(triangles[i], triangles[count - 1]);
+                        --remaining[vertex];
+                        break;
+                    }
+                }
+
+                if (std::find(newCache, newCache + newCacheCount, vertex) == newCache + newCacheCount)
+                    newCache[newCacheCount++] = vertex;
+            }
+
+            for (int i = 0; i < cacheCount; ++i)
+            {
+                std::uint32_t vertex = cache[i];
+                if (vertex != corners[0] && vertex != corners[1] && vertex != corners[2])
+                    newCache[newCacheCount++] = vertex;
+            }
+
+            // Rescore everything that was or is in the cache, including vertices that fell out.
+            for (int i = 0; i < newCacheCount; ++i)
+            {
+                std::uint32_t vertex = newCache[i];
+                int position = i < ForsythCacheSize ? i : -1;
+
+                float score = ComputeVertexScore(position, remaining[vertex]);
+                float delta = score - vertexScores[vertex];
+                vertexScores[vertex] = score;
+
+                const std::uint32_t* triangles = adjacency.data() + offsets[vertex];
+                for (std::uint32_t j = 0; j < remaining[vertex]; ++j)
+                    triangleScores[triangles[j]] += delta;
+            }
+
+            cacheCount = std::min(newCacheCount, ForsythCacheSize);
+            std::memcpy(cache, newCache, cacheCount * sizeof(std::uint32_t));
+
+            bestTriangle = std::numeric_limits<std::size_t>::max();
+            float bestScore = -std::numeric_limits<float>::max();
+            for (int i = 0; i < cacheCount; ++i)
+            {
+                std::uint32_t vertex = cache[i];
+                const std::uint32_t* triangles = adjacency.data() + offsets[vertex];
+                for (std::uint32_t j = 0; j < remaining[vertex]; ++j)
+                {
+                    if (triangleScores[triangles[j]] > bestScore)
+                    {
+                        bestScore = triangleScores[triangles[j]];
+                        bestTriangle = triangles[j];
+                    }
+                }
+            }
+        }
+
+        std::memcpy(indices, output.data(), output.size() * sizeof(std::uint32_t));
+    }
+
+    void OptimizeOverdraw(std::uint32_t* indices, std::size_t indexCount,
+                          const Vertex* vertices, std::size_t vertexCount, float threshold)
+    {
+        std::size_t triangleCount = indexCount / 3;
+        if (triangleCount == 0)
+            return;
+
+        // A triangle that misses with all three vertices marks a hard boundary, the cache is cold
+        // there so reordering at it costs nothing.
+        std::vector<std::size_t> hardStarts;
+        {
+            std::vector<std::size_t> timestamps(vertexCount, 0);
+            std::size_t time = OverdrawCacheSize + 1;
+
+            for (std::size_t triangle = 0; triangle < triangleCount; ++triangle)
+            {
+                std::size_t misses = 0;
+                for (int corner = 0; corner < 3; ++corner)
+                {
+                    std::uint32_t vertex = indices[triangle * 3 + corner];
+                    if (time - timestamps[vertex] > OverdrawCacheSize)
+                    {
+                        timestamps[vertex] = time++;
+                        ++misses;
+                    }
+                }
+
+                if (triangle == 0 || misses == 3)
+                    hardStarts.push_back(triangle);
+            }
+            hardStarts.push_back(triangleCount);
+        }
+
+        // Split hard clusters further wherever the part so far, simulated from a cold cache,
+        // is within `threshold` of the whole hard cluster's ACMR.
+        std::vector<std::size_t> clusterStarts;
+        {
+            std::vector<std::size_t> timestamps(vertexCount, 0);
+            std::size_t time = OverdrawCacheSize + 1;
+
+            auto countMisses = [&](std::size_t triangle)
+            {
+                std::size_t misses = 0;
+                for (int corner = 0; corner < 3; ++corner)
+                {
+                    std::uint32_t vertex = indices[triangle * 3 + corner];
+                    if (time - timestamps[vertex] > OverdrawCacheSize)
+                    {
+                        timestamps[vertex] = time++;
+                        ++misses;
+                    }
+                }
+                return misses;
+            };
+
+            for (std::size_t hard = 0; hard + 1 < hardStarts.size(); ++hard)
+            {
+                std::size_t begin = hardStarts[hard];
+                std::size_t end = hardStarts[hard + 1];
+
+                time += OverdrawCacheSize + 1;
+                std::size_t hardMisses = 0;
+                for (std::size_t triangle = begin; triangle < end; ++triangle)
+                    hardMisses += countMisses(triangle);
+
+                float targetAcmr = threshold * static_cast<float>(hardMisses) / static_cast<float>(end - begin);
+
+                time += OverdrawCacheSize + 1;
+                std::size_t clusterMisses = 0;
+                std::size_t clusterTriangles = 0;
+                for (std::size_t triangle = begin; triangle < end; ++triangle)
+                {
+                    if (clusterTriangles == 0)
+                        clusterStarts.push_back(triangle);
+
+                    clusterMisses += countMisses(triangle);
+                    ++clusterTriangles;
+
+                    if (static_cast<float>(clusterMisses) <= targetAcmr * static_cast<float>(clusterTriangles))
+                    {
+                        time += OverdrawCacheSize + 1;
+                        clusterMisses = 0;
+                        clusterTriangles = 0;
+                    }
+                }
+            }
+        }
+
+        std::size_t clusterCount = clusterStarts.size();
+        clusterStarts.push_back(triangleCount);
+
+        // Area weighted centroids and normals.
+        std::vector<float> clusterData(clusterCount * 6, 0.0f);
+        float meshCentroid[3] = { 0.0f, 0.0f, 0.0f };
+        float meshArea = 0.0f;
+
+        for (std::size_t cluster = 0; cluster < clusterCount; ++cluster)
+        {
+            float* centroid = &clusterData[cluster * 6];
+            float* normal = &clusterData[cluster * 6 + 3];
+            float clusterArea = 0.0f;
+
+            for (std::size_t triangle = clusterStarts[cluster]; triangle < clusterStarts[cluster + 1]; ++triangle)
+            {
+                const float* p0 = vertices[indices[triangle * 3 + 0]].position;
+                const float* p1 = vertices[indices[triangle * 3 + 1]].position;
+                const float* p2 = vertices[indices[triangle * 3 + 2]].position;
+
+                float edge1[3];
+                float edge2[3];
+                float cross[3];
+                Subtract(p1, p0, edge1);
+                Subtract(p2, p0, edge2);
+                Cross(edge1, edge2, cross);
+
+                float area = std::sqrt(cross[0] * cross[0] + cross[1] * cross[1] + cross[2] * cross[2]);
+                for (int axis = 0; axis < 3; ++axis)
+                {
+                    float triangleCentroid = (p0[axis] + p1[axis] + p2[axis]) / 3.0f;
+                    centroid[axis] += triangleCentroid * area;
+                    meshCentroid[axis] += triangleCentroid * area;
+                    normal[axis] += cross[axis];
+                }
+                clusterArea += area;
+            }
+
+            if (clusterArea > 0.0f)
+            {
+                for (int axis = 0; axis < 3; ++axis)
+                    centroid[axis] /= clusterArea;
+            }
+            meshArea += clusterArea;
+        }
+
+        if (meshArea > 0.0f)
+        {
+            for (int axis = 0; axis < 3; ++axis)
+                meshCentroid[axis] /= meshArea;
+        }
+
+        // Clusters facing away from the center are likely occluders, draw them first.
+        std::vector<float> sortKeys(clusterCount);
+        for (std::size_t cluster = 0; cluster < clusterCount; ++cluster)
+        {
+            const float* centroid = &clusterData[cluster * 6];
+            const float* normal = &clusterData[cluster * 6 + 3];
+
+            float length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+            float direction[3];
+            Subtract(centroid, meshCentroid, direction);
+
+            float dot = direction[0] * normal[0] + direction[1] * normal[1] + direction[2] * normal[2];
+            sortKeys[cluster] = length > 0.0f ? dot / length : 0.0f;
+        }
+
+        std::vector<std::size_t> order(clusterCount);
+        for (std::size_t cluster = 0; cluster < clusterCount; ++cluster)
+            order[cluster] = cluster;
+
+        std::stable_sort(order.begin(), order.end(), [&sortKeys](std::size_t a, std::size_t b)
+        {
+            return sortKeys[a] > sortKeys[b];
+        });
+
+        std::vector<std::uint32_t> output;
+        output.reserve(triangleCount * 3);
+        for (std::size_t cluster : order)
+        {
+            output.insert(output.end(), indices + clusterStarts[cluster] * 3,
+                                        indices + clusterStarts[cluster + 1] * 3);
+        }
+
+        std::memcpy(indices, output.data(), output.size() * sizeof(std::uint32_t));
+    }
+
+    std::size_t OptimizeVertexFetch(Vertex* vertices, std::size_t vertexCount,
+                                    std::uint32_t* indices, std::size_t indexCount)
+    {
+        constexpr std::uint32_t Unused = std::numeric_limits<std::uint32_t>::max();
+
+        std::vector<std::uint32_t> remap(vertexCount, Unused);
+        std::uint32_t nextVertex = 0;
+
+        for (std::size_t i = 0; i < indexCount; ++i)
+        {
+            std::uint32_t& newIndex = remap[indices[i]];
+            if (newIndex == Unused)
+                newIndex = nextVertex++;
+
+            indices[i] = newIndex;
+        }
+
+        std::vector<Vertex> original(vertices, vertices + vertexCount);
+        for (std::size_t vertex = 0; vertex < vertexCount; ++vertex)
+        {
+            if (remap[vertex] != Unused)
+                vertices[remap[vertex]] = original[vertex];
+        }
+
+        return nextVertex;
+    }
+
+    void OptimizeMesh(Mesh& mesh, float overdrawThreshold)
+    {
+        Core::MemoryTagScope memoryTag(Core::MemoryTag::Graphics);
+        OptimizeVertexCache(mesh.indices.data(), mesh.indices.size(), mesh.vertices.size());
+        OptimizeOverdraw(mesh.indices.data(), mesh.indices.size(), mesh.vertices.data(), mesh.vertices.size(), overdrawThreshold);
+
+        std::size_t vertexCount = OptimizeVertexFetch(mesh.vertices.data(), mesh.vertices.size(),
+                                                      mesh.indices.data(), mesh.indices.size());
+        mesh.vertices.resize(vertexCount);
+    }
+
+    QuantizedMesh QuantizeMesh(const Mesh& mesh)
+    {
+        Core::MemoryTagScope memoryTag(Core::MemoryTag::Graphics);
+        QuantizedMesh result;
+        result.indices = mesh.indices;
+        result.vertices.resize(mesh.vertices.size());
+
+        float minimum[3] = { 0.0f, 0.0f, 0.0f };
+        float maximum[3] = { 0.0f, 0.0f, 0.0f };
+        if (!mesh.vertices.empty())
+        {
+            std::memcpy(minimum, mesh.vertices[0].position, sizeof(minimum));
+            std::memcpy(maximum, mesh.vertices[0].position, sizeof(maximum));
+        }
+
+        for (const Vertex& vertex : mesh.vertices)
+        {
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                minimum[axis] = std::min(minimum[axis], vertex.position[axis]);
+                maximum[axis] = std::max(maximum[axis], vertex.position[axis]);
+            }
+        }
+
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            float extent = maximum[axis] - minimum[axis];
+            result.positionOffset[axis] = minimum[axis];
+            result.positionScale[axis] = extent > 0.0f ? extent : 1.0f;
+        }
+
+        for (std::size_t i = 0; i < mesh.vertices.size(); ++i)
+        {
+            const Vertex& vertex = mesh.vertices[i];
+            QuantizedVertex& quantized = result.vertices[i];
+
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                float normalized = (vertex.position[axis] - result.positionOffset[axis]) / result.positionScale[axis];
+                normalized = std::clamp(normalized, 0.0f, 1.0f);
+                quantized.position[axis] = static_cast<std::uint16_t>(std::lround(normalized * 65535.0f));
+            }
+            quantized.position[3] = 0;
+
+            EncodeOctahedral(vertex.normal, quantized.normal);
+            quantized.uv[0] = FloatToHalf(vertex.uv[0]);
+            quantized.uv[1] = FloatToHalf(vertex.uv[1]);
+        }
+
+        return result;
+    }
+
+    QuantizedMesh CookMesh(Mesh mesh)
+    {
+        OptimizeMesh(mesh);
+        return QuantizeMesh(mesh);
+    }
+
+    std::uint16_t FloatToHalf(float value)
+    {
+        std::uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+
+        std::uint32_t sign = (bits >> 16) & 0x8000;
+        std::int32_t exponent = static_cast<std::int32_t>((bits >> 23) & 0xff) - 127 + 15;
+        std::uint32_t mantissa = bits & 0x7fffff;
+
+        // Infinity and NaN.
+        if ((bits & 0x7fffffff) >= 0x7f800000)
+            return static_cast<std::uint16_t>(sign | 0x7c00 | (mantissa != 0 ? 0x200 : 0));
+
+        // Overflow to infinity.
+        if (exponent >= 31)
+            return static_cast<std::uint16_t>(sign | 0x7c00);
+
+        // Subnormal or zero, rounded to nearest even.
+        if (exponent <= 0)
+        {
+            if (exponent < -10)
+                return static_cast<std::uint16_t>(sign);
+
+            mantissa |= 0x800000;
+            std::uint32_t shift = static_cast<std::uint32_t>(14 - exponent);
+            std::uint32_t half = mantissa >> shift;
+            std::uint32_t remainder = mantissa & ((1u << shift) - 1);
+            std::uint32_t halfway = 1u << (shift - 1);
+            if (remainder > halfway || (remainder == halfway && (half & 1) != 0))
+                ++half;
+            return static_cast<std::uint16_t>(sign | half);
+        }
+
+        // Rounding may carry into the exponent, which is the correct result.
+        std::uint32_t half = sign | (static_cast<std::uint32_t>(exponent) << 10) | (mantissa >> 13);
+        std::uint32_t remainder = mantissa & 0x1fff;
+        if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1) != 0))
+            ++half;
+        return static_cast<std::uint16_t>(half);
+    }
+
+    float HalfToFloat(std::uint16_t value)
+    {
+        std::uint32_t sign = static_cast<std::uint32_t>(value & 0x8000) << 16;
+        std::uint32_t exponent = (value >> 10) & 0x1f;
+        std::uint32_t mantissa = value & 0x3ff;
+
+        std::uint32_t bits;
+        if (exponent == 0)
+        {
+            float magnitude = static_cast<float>(mantissa) * (1.0f / 16777216.0f);
+            return sign != 0 ? -magnitude : magnitude;
+        }
+        else if (exponent == 31)
+        {
+            bits = sign | 0x7f800000 | (mantissa << 13);
+        }
+        else
+        {
+            bits = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+        }
+
+        float result;
+        std::memcpy(&result, &bits, sizeof(result));
+        return result;
+    }
+
+    void EncodeOctahedral(const float normal[3], std::int16_t encoded[2])
+    {
+        float length = std::fabs(normal[0]) + std::fabs(normal[1]) + std::fabs(normal[2]);
+        if (length == 0.0f)
+        {
+            encoded[0] = 0;
+            encoded[1] = 0;
+            return;
+        }
+
+        float x = normal[0] / length;
+        float y = normal[1] / length;
+
+        // Fold the lower hemisphere over the diagonals.
+        if (normal[2] < 0.0f)
+        {
+            float foldedX = (1.0f - std::fabs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+            float foldedY = (1.0f - std::fabs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+            x = foldedX;
+            y = foldedY;
+        }
+
+        encoded[0] = static_cast<std::int16_t>(std::lround(std::clamp(x, -1.0f, 1.0f) * 32767.0f));
+        encoded[1] = static_cast<std::int16_t>(std::lround(std::clamp(y, -1.0f, 1.0f) * 32767.0f));
+    }
+
+    void DecodeOctahedral(const std::int16_t encoded[2], float normal[3])
+    {
+        float x = std::max(encoded[0] / 32767.0f, -1.0f);
+        float y = std::max(encoded[1] / 32767.0f, -1.0f);
+        float z = 1.0f - std::fabs(x) - std::fabs(y);
+
+        float fold = std::max(-z, 0.0f);
+        x += x >= 0.0f ? -fold : fold;
+        y += y >= 0.0f ? -fold : fold;
+
+        float length = std::sqrt(x * x + y * y + z * z);
+        normal[0] = x / length;
+        normal[1] = y / length;
+        normal[2] = z / length;
+    }
+}
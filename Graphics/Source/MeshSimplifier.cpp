@@ -0,0 +1,368 @@
+#include <Engine/Graphics/MeshSimplifier.hpp>
+
+#include <Engine/Core/Math.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_set>
+
+namespace Engine::Graphics
+{
+    using Core::Vector3;
+
+    namespace
+    {
+        // Border edges resist collapses perpendicular to them by this much.
+        constexpr double BorderWeight = 10.0;
+
+        struct Quadric
+        {
+            double a2 = 0.0, ab = 0.0, ac = 0.0, ad = 0.0;
+            double b2 = 0.0, bc = 0.0, bd = 0.0;
+            double c2 = 0.0, cd = 0.0;
+            double d2 = 0.0;
+            double weight = 0.0;
+
+            void AddPlane(const Vector3& normal, float distance, double planeWeight)
+            {
+                double a = normal.x;
+                double b = normal.y;
+                double c = normal.z;
+                double d = distance;
+
+                a2 += planeWeight * a * a; ab += planeWeight * a * b; ac += planeWeight * a * c; ad += planeWeight * a * d;
+                b2 += planeWeight * b * b; bc += planeWeight * b * c; bd += planeWeight * b * d;
+                c2 += planeWeight * c * c; cd += planeWeight * c * d;
+                d2 += planeWeight * d * d;
+                weight += planeWeight;
+            }
+
+            Quadric& operator+=(const Quadric& other)
+            {
+                a2 += other.a2; ab += other.ab; ac += other.ac; ad += other.ad;
+                b2 += other.b2; bc += other.bc; bd += other.bd;
+                c2 += other.c2; cd += other.cd;
+                d2 += other.d2;
+                weight += other.weight;
+                return *this;
+            }
+
+            // Weighted mean squared distance of `point` to the accumulated planes.
+            double Evaluate(const Vector3& point) const
+            {
+                double x = point.x;
+                double y = point.y;
+                double z = point.z;
+
+                double error = a2 * x * x + 2.0 * ab * x * y + 2.0 * ac * x * z + 2.0 * ad * x
+                             + b2 * y * y + 2.0 * bc * y * z + 2.0 * bd * y
+                             + c2 * z * z + 2.0 * cd * z
+                             + d2;
+
+                return weight > 0.0 ? std::max(error, 0.0) / weight : 0.0;
+            }
+        };
+
+        struct Collapse
+        {
+            std::uint32_t from;
+            std::uint32_t to;
+            double cost;
+        };
+
+        std::uint64_t EdgeKey(std::uint32_t a, std::uint32_t b)
+        {
+            return (static_cast<std::uint64_t>(a) << 32) | b;
+        }
+
+        Vector3 PositionOf(const std::vector<Vertex>& vertices, std::uint32_t vertex)
+        {
+            return Vector3(vertices[vertex].position);
+        }
+
+        // Maps every vertex to the first vertex with a bitwise identical position.
+        std::vector<std::uint32_t> BuildPositionRemap(const std::vector<Vertex>& vertices)
+        {
+            std::vector<std::uint32_t> order(vertices.size());
+            for (std::uint32_t i = 0; i < order.size(); ++i)
+                order[i] = i;
+
+            auto compare = [&vertices](std::uint32_t a, std::uint32_t b)
+            {
+                int result = std::memcmp(vertices[a].position, vertices[b].position, sizeof(Vertex::position));
+                return result != 0 ? result < 0 : a < b;
+            };
+            std::sort(order.begin(), order.end(), compare);
+
+            std::vector<std::uint32_t> remap(vertices.size());
+            for (std::size_t i = 0; i < order.size(); ++i)
+            {
+                bool samePosition = i > 0 && std::memcmp(vertices[order[i]].position, vertices[order[i - 1]].position,
+                                                         sizeof(Vertex::position)) == 0;
+                remap[order[i]] = samePosition ? remap[order[i - 1]] : order[i];
+            }
+            return remap;
+        }
+    }
+
+    float SimplifyMesh(const std::vector<Vertex>& vertices, const std::vector<std::uint32_t>& indices,
+                       const SimplifyOptions& options, std::vector<std::uint32_t>& result)
+    {
+        result = indices;
+        std::size_t vertexCount = vertices.size();
+
+        std::vector<std::uint32_t> positionRemap = BuildPositionRemap(vertices);
+        std::vector<std::uint32_t> wedgeCounts(vertexCount, 0);
+        for (std::uint32_t canonical : positionRemap)
+            ++wedgeCounts[canonical];
+
+        // Vertices on attribute seams never move and are never collapsed onto.
+        auto isSeam = [&](std::uint32_t vertex) { return wedgeCounts[positionRemap[vertex]] > 1; };
+
+        std::vector<Quadric> quadrics(vertexCount);
+        for (std::size_t i = 0; i + 2 < result.size(); i += 3)
+        {
+            Vector3 p0 = PositionOf(vertices, result[i + 0]);
+            Vector3 p1 = PositionOf(vertices, result[i + 1]);
+            Vector3 p2 = PositionOf(vertices, result[i + 2]);
+
+            Vector3 cross = Core::Cross(p1 - p0, p2 - p0);
+            float doubleArea = Core::Length(cross);
+            if (doubleArea <= 0.0f)
+                continue;
+
+            Vector3 normal = cross / doubleArea;
+            float distance = -Core::Dot(normal, p0);
+            for (int corner = 0; corner < 3; ++corner)
+                quadrics[result[i + corner]].AddPlane(normal, distance, doubleArea * 0.5);
+        }
+
+        // Border edges get an extra plane perpendicular to their triangle.
+        {
+            std::unordered_set<std::uint64_t> edges;
+            for (std::size_t i = 0; i + 2 < result.size(); i += 3)
+            {
+                for (int corner = 0; corner < 3; ++corner)
+                    edges.insert(EdgeKey(positionRemap[result[i + corner]], positionRemap[result[i + (corner + 1) % 3]]));
+            }
+
+            for (std::size_t i = 0; i + 2 < result.size(); i += 3)
+            {
+                Vector3 p0 = PositionOf(vertices, result[i + 0]);
+                Vector3 p1 = PositionOf(vertices, result[i + 1]);
+                Vector3 p2 = PositionOf(vertices, result[i + 2]);
+                Vector3 triangleNormal = Core::Normalize(Core::Cross(p1 - p0, p2 - p0));
+
+                for (int corner = 0; corner < 3; ++corner)
+                {
+                    std::uint32_t a = result[i + corner];
+                    std::uint32_t b = result[i + (corner + 1) % 3];
+                    if (edges.count(EdgeKey(positionRemap[b], positionRemap[a])) != 0)
+                        continue;
+
+                    Vector3 edge = PositionOf(vertices, b) - PositionOf(vertices, a);
+                    Vector3 normal = Core::Normalize(Core::Cross(edge, triangleNormal));
+                    float distance = -Core::Dot(normal, PositionOf(vertices, a));
+                    double weight = Core::Dot(edge, edge) * BorderWeight;
+
+                    quadrics[a].AddPlane(normal, distance, weight);
+                    quadrics[b].AddPlane(normal, distance, weight);
+                }
+            }
+        }
+
+        double maximumCost = static_cast<double>(options.maximumError) * options.maximumError;
+        double resultCost = 0.0;
+
+        std::vector<std::uint32_t> remap(vertexCount);
+        std::vector<bool> touched(vertexCount);
+        std::vector<bool> isBorder(vertexCount);
+        std::vector<std::uint32_t> triangleOffsets(vertexCount + 1);
+        std::vector<std::uint32_t> adjacency;
+        std::vector<Collapse> collapses;
+        std::unordered_set<std::uint64_t> edges;
+
+        while (result.size() > options.targetIndexCount)
+        {
+            std::size_t triangleCount = result.size() / 3;
+
+            // Vertex to triangle adjacency.
+            std::fill(triangleOffsets.begin(), triangleOffsets.end(), 0);
+            for (std::uint32_t vertex : result)
+                ++triangleOffsets[vertex + 1];
+            for (std::size_t vertex = 0; vertex < vertexCount; ++vertex)
+                triangleOffsets[vertex + 1] += triangleOffsets[vertex];
+
+            adjacency.resize(result.size());
+            {
+                std::vector<std::uint32_t> cursor(triangleOffsets.begin(), triangleOffsets.end() - 1);
+                for (std::size_t i = 0; i < result.size(); ++i)
+                    adjacency[cursor[result[i]]++] = static_cast<std::uint32_t>(i / 3);
+            }
+
+            // Border classification of the current topology.
+            edges.clear();
+            for (std::size_t i = 0; i < result.size(); i += 3)
+            {
+                for (int corner = 0; corner < 3; ++corner)
+                    edges.insert(EdgeKey(positionRemap[result[i + corner]], positionRemap[result[i + (corner + 1) % 3]]));
+            }
+
+            std::fill(isBorder.begin(), isBorder.end(), false);
+            auto isBorderEdge = [&](std::uint32_t a, std::uint32_t b)
+            {
+                return edges.count(EdgeKey(positionRemap[a], positionRemap[b])) == 0 ||
+                       edges.count(EdgeKey(positionRemap[b], positionRemap[a])) == 0;
+            };
+
+            for (std::size_t i = 0; i < result.size(); i += 3)
+            {
+                for (int corner = 0; corner < 3; ++corner)
+                {
+                    std::uint32_t a = result[i + corner];
+                    std::uint32_t b = result[i + (corner + 1) % 3];
+                    if (isBorderEdge(a, b))
+                    {
+                        isBorder[a] = true;
+                        isBorder[b] = true;
+                    }
+                }
+            }
+
+            auto isAllowed = [&](std::uint32_t from, std::uint32_t to)
+            {
+                if (isSeam(from) || isSeam(to))
+                    return false;
+
+                if (isBorder[from])
+                    return isBorder[to] && isBorderEdge(from, to);
+
+                return true;
+            };
+
+            auto computeCost = [&](std::uint32_t from, std::uint32_t to)
+            {
+                Quadric quadric = quadrics[from];
+                quadric += quadrics[to];
+
+                const Vertex& source = vertices[from];
+                const Vertex& target = vertices[to];
+                Vector3 edge = Vector3(target.position) - Vector3(source.position);
+                Vector3 normalDelta = Vector3(target.normal) - Vector3(source.normal);
+                float uvDeltaX = target.uv[0] - source.uv[0];
+                float uvDeltaY = target.uv[1] - source.uv[1];
+
+                // Attribute change, scaled by how far the vertex moves to stay in units of length.
+                double attributeError = (Core::Dot(normalDelta, normalDelta) + uvDeltaX * uvDeltaX + uvDeltaY * uvDeltaY) *
+                                        Core::Dot(edge, edge) * options.attributeWeight;
+
+                return quadric.Evaluate(Vector3(target.position)) + attributeError;
+            };
+
+            collapses.clear();
+            for (std::size_t i = 0; i < result.size(); i += 3)
+            {
+                for (int corner = 0; corner < 3; ++corner)
+                {
+                    std::uint32_t a = result[i + corner];
+                    std::uint32_t b = result[i + (corner + 1) % 3];
+
+                    // Each edge is seen from both of its triangles, only consider it once.
+                    if (a > b && !isBorderEdge(a, b))
+                        continue;
+
+                    bool forward = isAllowed(a, b);
+                    bool backward = isAllowed(b, a);
+                    double forwardCost = forward ? computeCost(a, b) : 0.0;
+                    double backwardCost = backward ? computeCost(b, a) : 0.0;
+
+                    if (forward && (!backward || forwardCost <= backwardCost))
+                        collapses.push_back({ a, b, forwardCost });
+                    else if (backward)
+                        collapses.push_back({ b, a, backwardCost });
+                }
+            }
+
+            std::sort(collapses.begin(), collapses.end(), [](const Collapse& a, const Collapse& b)
+            {
+                return a.cost < b.cost;
+            });
+
+            for (std::uint32_t vertex = 0; vertex < vertexCount; ++vertex)
+                remap[vertex] = vertex;
+            std::fill(touched.begin(), touched.end(), false);
+
+            // Every collapse removes about two triangles.
+            std::size_t collapseLimit = (result.size() - options.targetIndexCount) / 6 + 1;
+            std::size_t collapseCount = 0;
+
+            for (const Collapse& collapse : collapses)
+            {
+                if (collapseCount >= collapseLimit || collapse.cost > maximumCost)
+                    break;
+
+                if (touched[collapse.from] || touched[collapse.to])
+                    continue;
+
+                // Reject collapses that flip a remaining triangle.
+                Vector3 target = PositionOf(vertices, collapse.to);
+                bool flips = false;
+                for (std::uint32_t j = triangleOffsets[collapse.from]; j < triangleOffsets[collapse.from + 1] && !flips; ++j)
+                {
+                    std::uint32_t triangle = adjacency[j];
+                    std::uint32_t corners[3] = { remap[result[triangle * 3 + 0]],
+                                                 remap[result[triangle * 3 + 1]],
+                                                 remap[result[triangle * 3 + 2]] };
+
+                    if (corners[0] == collapse.to || corners[1] == collapse.to || corners[2] == collapse.to)
+                        continue;
+
+                    Vector3 positions[3];
+                    for (int corner = 0; corner < 3; ++corner)
+                        positions[corner] = PositionOf(vertices, corners[corner]);
+
+                    Vector3 before = Core::Cross(positions[1] - positions[0], positions[2] - positions[0]);
+                    for (int corner = 0; corner < 3; ++corner)
+                    {
+                        if (corners[corner] == collapse.from)
+                            positions[corner] = target;
+                    }
+                    Vector3 after = Core::Cross(positions[1] - positions[0], positions[2] - positions[0]);
+
+                    flips = Core::Dot(before, after) <= 0.0f;
+                }
+
+                if (flips)
+                    continue;
+
+                remap[collapse.from] = collapse.to;
+                quadrics[collapse.to] += quadrics[collapse.from];
+                touched[collapse.from] = true;
+                touched[collapse.to] = true;
+                resultCost = std::max(resultCost, collapse.cost);
+                ++collapseCount;
+            }
+
+            if (collapseCount == 0)
+                break;
+
+            std::size_t writeIndex = 0;
+            for (std::size_t triangle = 0; triangle < triangleCount; ++triangle)
+            {
+                std::uint32_t a = remap[result[triangle * 3 + 0]];
+                std::uint32_t b = remap[result[triangle * 3 + 1]];
+                std::uint32_t c = remap[result[triangle * 3 + 2]];
+                if (positionRemap[a] == positionRemap[b] || positionRemap[b] == positionRemap[c] || positionRemap[a] == positionRemap[c])
+                    continue;
+
+                result[writeIndex++] = a;
+                result[writeIndex++] = b;
+                result[writeIndex++] = c;
+            }
+            result.resize(writeIndex);
+        }
+
+        return static_cast<float>(std::sqrt(resultCost));
+    }
+}
@@ -0,0 +1,211 @@
+#include <Engine/Graphics/Meshlet.hpp>
+
+#include <Engine/Core/MemoryTracking.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Engine::Graphics
+{
+    using Core::Vector3;
+
+    namespace
+    {
+        constexpr std::uint8_t NotInMeshlet = 0xff;
+
+        void ComputeBounds(const Mesh& mesh, const MeshletMesh& meshletMesh, Meshlet& meshlet)
+        {
+            const std::uint32_t* vertices = &meshletMesh.vertices[meshlet.vertexOffset];
+            const std::uint8_t* triangles = &meshletMesh.triangles[meshlet.triangleOffset * 3];
+
+            Vector3 minimum(mesh.vertices[vertices[0]].position);
+            Vector3 maximum = minimum;
+            for (std::uint32_t i = 1; i < meshlet.vertexCount; ++i)
+            {
+                Vector3 position(mesh.vertices[vertices[i]].position);
+                minimum = Vector3(std::min(minimum.x, position.x), std::min(minimum.y, position.y), std::min(minimum.z, position.z));
+                maximum = Vector3(std::max(maximum.x, position.x), std::max(maximum.y, position.y), std::max(maximum.z, position.z));
+            }
+
+            meshlet.center = (minimum + maximum) * 0.5f;
+            meshlet.radius = 0.0f;
+            for (std::uint32_t i = 0; i < meshlet.vertexCount; ++i)
+            {
+                Vector3 position(mesh.vertices[vertices[i]].position);
+                meshlet.radius = std::max(meshlet.radius, Core::Length(position - meshlet.center));
+            }
+
+            // The cone axis is the average triangle normal, the cutoff comes from the widest deviation.
+            Vector3 normals[MaxMeshletTriangles];
+            Vector3 corners[MaxMeshletTriangles];
+            std::uint32_t normalCount = 0;
+            Vector3 axis;
+
+            for (std::uint32_t triangle = 0; triangle < meshlet.triangleCount && normalCount < MaxMeshletTriangles; ++triangle)
+            {
+                Vector3 p0(mesh.vertices[vertices[triangles[triangle * 3 + 0]]].position);
+                Vector3 p1(mesh.vertices[vertices[triangles[triangle * 3 + 1]]].position);
+                Vector3 p2(mesh.vertices[vertices[triangles[triangle * 3 + 2]]].position);
+
+                Vector3 normal = Core::Normalize(Core::Cross(p1 - p0, p2 - p0));
+                if (normal.x == 0.0f && normal.y == 0.0f && normal.z == 0.0f)
+                    continue;
+
+                normals[normalCount] = normal;
+                corners[normalCount] = p0;
+                ++normalCount;
+                axis += normal;
+            }
+
+            axis = Core::Normalize(axis);
+            meshlet.coneAxis = axis;
+            meshlet.coneApex = meshlet.center;
+            meshlet.coneCutoff = 1.0f;
+
+            if (normalCount == 0)
+                return;
+
+            float minimumDot = 1.0f;
+            for (std::uint32_t i = 0; i < normalCount; ++i)
+                minimumDot = std::min(minimumDot, Core::Dot(normals[i], axis));
+
+            // Wider than a hemisphere, some triangle always faces the camera.
+            if (minimumDot <= 0.0f)
+                return;
+
+            // Move the apex back along the axis until it is behind every triangle's plane.
+            float maximumDistance = 0.0f;
+            for (std::uint32_t i = 0; i < normalCount; ++i)
+            {
+                float distance = Core::Dot(meshlet.center - corners[i], normals[i]) / Core::Dot(axis, normals[i]);
+                maximumDistance = std::max(maximumDistance, distance);
+            }
+
+            meshlet.coneApex = meshlet.center - axis * maximumDistance;
+            meshlet.coneCutoff = std::sqrt(1.0f - minimumDot * minimumDot);
+        }
+    }
+
+    MeshletCullStats& MeshletCullStats::operator+=(const MeshletCullStats& other)
+    {
+        meshlets += other.meshlets;
+        frustumCulled += other.frustumCulled;
+        backfaceCulled += other.backfaceCulled;
+        occlusionCulled += other.occlusionCulled;
+        visible += other.visible;
+        triangles += other.triangles;
+        visibleTriangles += other.visibleTriangles;
+        return *this;
+    }
+
+    MeshletMesh BuildMeshlets(const Mesh& mesh, std::size_t maxVertices, std::size_t maxTriangles)
+    {
+        Core::MemoryTagScope memoryTag(Core::MemoryTag::Graphics);
+        maxVertices = std::clamp<std::size_t>(maxVertices, 3, MaxMeshletVertices);
+        maxTriangles = std::clamp<std::size_t>(maxTriangles, 1, MaxMeshletTriangles);
+
+        MeshletMesh result;
+        std::vector<std::uint8_t> localIndices(mesh.vertices.size(), NotInMeshlet);
+
+        Meshlet current = {};
+
+        auto flush = [&]()
+        {
+            if (current.triangleCount == 0)
+                return;
+
+            ComputeBounds(mesh, result, current);
+            result.meshlets.push_back(current);
+
+            for (std::uint32_t i = 0; i < current.vertexCount; ++i)
+                localIndices[result.vertices[current.vertexOffset + i]] = NotInMeshlet;
+
+            current = {};
+            current.vertexOffset = static_cast<std::uint32_t>(result.vertices.size());
+            current.triangleOffset = static_cast<std::uint32_t>(result.triangles.size() / 3);
+        };
+
+        for (std::size_t i = 0; i + 2 < mesh.indices.size(); i += 3)
+        {
+            const std::uint32_t* corners = &mesh.indices[i];
+
+            std::uint32_t newVertices = 0;
+            for (int corner = 0; corner < 3; ++corner)
+            {
+                bool duplicate = (corner > 0 && corners[corner] == corners[0]) || (corner > 1 && corners[corner] == corners[1]);
+                if (!duplicate && localIndices[corners[corner]] == NotInMeshlet)
+                    ++newVertices;
+            }
+
+            if (current.vertexCount + newVertices > maxVertices || current.triangleCount + 1 > maxTriangles)
+                flush();
+
+            for (int corner = 0; corner < 3; ++corner)
+            {
+                std::uint8_t& local = localIndices[corners[corner]];
+                if (local == NotInMeshlet)
+                {
+                    local = static_cast<std::uint8_t>(current.vertexCount++);
+                    result.vertices.push_back(corners[corner]);
+                }
+                result.triangles.push_back(local);
+            }
+            ++current.triangleCount;
+        }
+
+        flush();
+        return result;
+    }
+
+    void CullMeshlets(const MeshletMesh& meshletMesh, const MeshletCullView& view,
+                      std::vector<std::uint32_t>& visibleMeshlets, MeshletCullStats& stats)
+    {
+        for (std::size_t i = 0; i < meshletMesh.meshlets.size(); ++i)
+        {
+            const Meshlet& meshlet = meshletMesh.meshlets[i];
+            ++stats.meshlets;
+            stats.triangles += meshlet.triangleCount;
+
+            if (!view.frustum.IsSphereVisible(meshlet.center, meshlet.radius))
+            {
+                ++stats.frustumCulled;
+                continue;
+            }
+
+            if (meshlet.coneCutoff < 1.0f)
+            {
+                Vector3 direction = Core::Normalize(meshlet.coneApex - view.cameraPosition);
+                if (Core::Dot(direction, meshlet.coneAxis) >= meshlet.coneCutoff)
+                {
+                    ++stats.backfaceCulled;
+                    continue;
+                }
+            }
+
+            if (view.occlusion != nullptr && view.occlusion->IsSphereOccluded(view.viewProjection, meshlet.center, meshlet.radius))
+            {
+                ++stats.occlusionCulled;
+                continue;
+            }
+
+            ++stats.visible;
+            stats.visibleTriangles += meshlet.triangleCount;
+            visibleMeshlets.push_back(static_cast<std::uint32_t>(i));
+        }
+    }
+
+    void AppendMeshletIndices(const MeshletMesh& meshletMesh, const std::vector<std::uint32_t>& visibleMeshlets,
+                              std::vector<std::uint32_t>& indices)
+    {
+        for (std::uint32_t index : visibleMeshlets)
+        {
+            const Meshlet& meshlet = meshletMesh.meshlets[index];
+            const std::uint32_t* vertices = &meshletMesh.vertices[meshlet.vertexOffset];
+            const std::uint8_t* triangles = &meshletMesh.triangles[meshlet.triangleOffset * 3];
+
+            for (std::uint32_t i = 0; i < meshlet.triangleCount * 3; ++i)
+                indices.push_back(vertices[triangles[i]]);
+        }
+    }
+}
@@ -0,0 +1,127 @@
+#include <Engine/Graphics/OpenGL/GLDevice.hpp>
+
+#include <iostream>
+
+namespace Engine::Graphics
+{
+    namespace
+    {
+        const char* GetString(const GLFunctions& gl, GLenum name)
+        {
+            const GLubyte* string = gl.GetString(name);
+            return string != nullptr ? reinterpret_cast<const char*>(string) : "";
+        }
+
+        void APIENTRY DebugCallback(GLenum, GLenum type, GLuint, GLenum severity, GLsizei, const GLchar* message, const void*)
+        {
+            if (severity == GL_DEBUG_SEVERITY_NOTIFICATION)
+                return;
+
+            std::cout << "OpenGL" << (type == GL_DEBUG_TYPE_ERROR ? " error" : "") << ": " << message << std::endl;
+        }
+    }
+
+    void SetGLContextAttributes(bool debug)
+    {
+        SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 4);
+        SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 5);
+        SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_CORE);
+        SDL_GL_SetAttribute(SDL_GL_CONTEXT_FLAGS, debug ? SDL_GL_CONTEXT_DEBUG_FLAG : 0);
+        SDL_GL_SetAttribute(SDL_GL_DOUBLEBUFFER, 1);
+        SDL_GL_SetAttribute(SDL_GL_DEPTH_SIZE, 24);
+    }
+
+    SDL_Window* CreateGLWindow(const char* title, int width, int height, bool hidden, bool debug)
+    {
+        SetGLContextAttributes(debug);
+
+        Uint32 flags = SDL_WINDOW_OPENGL | (hidden ? SDL_WINDOW_HIDDEN : SDL_WINDOW_SHOWN);
+        SDL_Window* window = SDL_CreateWindow(title, SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, width, height, flags);
+        if (window == nullptr)
+            std::cout << "Something went wrong creating an OpenGL window: " << SDL_GetError() << std::endl;
+
+        return window;
+    }
+
+    std::unique_ptr<GLDevice> GLDevice::Create(SDL_Window* window, bool debug)
+    {
+        SetGLContextAttributes(debug);
+
+        SDL_GLContext context = SDL_GL_CreateContext(window);
+        if (context == nullptr)
+        {
+            std::cout << "Something went wrong creating an OpenGL 4.5 context: " << SDL_GetError() << std::endl;
+            return nullptr;
+        }
+
+        std::unique_ptr<GLDevice> device(new GLDevice(window, context));
+        if (!device->functions.Load())
+        {
+            std::cout << "OpenGL 4.5 is not fully supported by the driver." << std::endl;
+            return nullptr;
+        }
+
+        const GLFunctions& gl = device->functions;
+        device->vendor = GetString(gl, GL_VENDOR);
+        device->renderer = GetString(gl, GL_RENDERER);
+        device->version = GetString(gl, GL_VERSION);
+
+        if (debug)
+        {
+            gl.Enable(GL_DEBUG_OUTPUT);
+            gl.Enable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+            gl.DebugMessageCallback(DebugCallback, nullptr);
+        }
+
+        return device;
+    }
+
+    GLDevice::GLDevice(SDL_Window* window, SDL_GLContext context) : window(window), context(context)
+    {
+    }
+
+    GLDevice::~GLDevice()
+    {
+        SDL_GL_DeleteContext(context);
+    }
+
+    std::unique_ptr<GLDevice> GLDevice::CreateSharedContext()
+    {
+        MakeCurrent();
+
+        SDL_GL_SetAttribute(SDL_GL_SHARE_WITH_CURRENT_CONTEXT, 1);
+        SDL_GLContext sharedContext = SDL_GL_CreateContext(window);
+        SDL_GL_SetAttribute(SDL_GL_SHARE_WITH_CURRENT_CONTEXT, 0);
+
+        if (sharedContext == nullptr)
+        {
+            std::cout << "Something went wrong creating a shared OpenGL context: " << SDL_GetError() << std::endl;
+            return nullptr;
+        }
+
+        // Creating a context makes it current, load its functions before switching back.
+        std::unique_ptr<GLDevice> device(new GLDevice(window, sharedContext));
+        device->functions.Load();
+        device->vendor = vendor;
+        device->renderer = renderer;
+        device->version = version;
+
+        MakeCurrent();
+        return device;
+    }
+
+    void GLDevice::MakeCurrent()
+    {
+        SDL_GL_MakeCurrent(window, context);
+    }
+
+    void GLDevice::SetSwapInterval(int interval)
+    {
+        SDL_GL_SetSwapInterval(interval);
+    }
+
+    void GLDevice::Present()
+    {
+        SDL_GL_SwapWindow(window);
+    }
+}
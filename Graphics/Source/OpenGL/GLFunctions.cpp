@@ -0,0 +1,32 @@
+#include <Engine/Graphics/OpenGL/GLFunctions.hpp>
+
+#include <SDL2/SDL_video.h>
+#include <iostream>
+#include <type_traits>
+
+namespace Engine::Graphics
+{
+    bool GLFunctions::Load()
+    {
+        bool complete = true;
+
+        auto load = [&complete](auto& function, const char* name)
+        {
+            function = reinterpret_cast<std::remove_reference_t<decltype(function)>>(SDL_GL_GetProcAddress(name));
+            if (function == nullptr)
+            {
+                std::cout << "Missing OpenGL function \"" << name << "\"." << std::endl;
+                complete = false;
+            }
+        };
+
+#define ENGINE_GL_LOAD_LEGACY(Name) load(Name, "gl" #Name);
+#define ENGINE_GL_LOAD(Type, Name) load(Name, "gl" #Name);
+        ENGINE_GL_LEGACY_FUNCTIONS(ENGINE_GL_LOAD_LEGACY)
+        ENGINE_GL_FUNCTIONS(ENGINE_GL_LOAD)
+#undef ENGINE_GL_LOAD_LEGACY
+#undef ENGINE_GL_LOAD
+
+        return complete;
+    }
+}
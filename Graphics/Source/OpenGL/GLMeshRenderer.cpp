@@ -0,0 +1,255 @@
+#include <Engine/Graphics/OpenGL/GLMeshRenderer.hpp>
+
+#include <Engine/Graphics/OpenGL/GLProgramCache.hpp>
+#include <Engine/Graphics/OpenGL/GLTextureArray.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
+namespace Engine::Graphics
+{
+    namespace
+    {
+        constexpr GLuint VertexBinding = 0;
+        constexpr GLuint DrawIndexBinding = 1;
+        constexpr GLuint DrawIndexLocation = 3;
+        constexpr GLuint DrawDataBinding = 0;
+
+        // The largest `GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT` the specification allows.
+        constexpr std::size_t MaxStorageAlignment = 256;
+
+        // The draw index comes in as an instanced attribute, with one instance per command it reads
+        // element `baseInstance`, which doesn't need `gl_BaseInstance` from OpenGL 4.6.
+        const char* VertexShaderSource = R"(#version 450 core
+layout(location = 0) in vec3 quantizedPosition;
+layout(location = 1) in vec2 octahedralNormal;
+layout(location = 2) in vec2 uv;
+layout(location = 3) in uint drawIndex;
+
+struct DrawData
+{
+    mat4 model;
+    vec3 positionOffset;
+    uint textureLayer;
+    vec3 positionScale;
+    uint padding;
+};
+
+layout(std430, binding = 0) readonly buffer DrawBuffer
+{
+    DrawData draws[];
+};
+
+uniform mat4 viewProjection;
+
+out vec3 vertexNormal;
+out vec2 vertexUv;
+flat out uint vertexLayer;
+
+vec3 DecodeOctahedral(vec2 encoded)
+{
+    vec3 normal = vec3(encoded, 1.0 - abs(encoded.x) - abs(encoded.y));
+    float fold = max(-normal.z, 0.0);
+    normal.x += normal.x >= 0.0 ? -fold : fold;
+    normal.y += normal.y >= 0.0 ? -fold : fold;
+    return normalize(normal);
+}
+
+void main()
+{
+    DrawData draw = draws[drawIndex];
+    vec3 position = quantizedPosition * draw.positionScale + draw.positionOffset;
+
+    gl_Position = viewProjection * draw.model * vec4(position, 1.0);
+    vertexNormal = mat3(draw.model) * DecodeOctahedral(octahedralNormal);
+    vertexUv = uv;
+    vertexLayer = draw.textureLayer;
+}
+)";
+
+        const char* FragmentShaderSource = R"(#version 450 core
+in vec3 vertexNormal;
+in vec2 vertexUv;
+flat in uint vertexLayer;
+
+layout(binding = 0) uniform sampler2DArray textures;
+uniform bool textured;
+
+out vec4 color;
+
+void main()
+{
+    vec3 albedo = textured ? texture(textures, vec3(vertexUv, float(vertexLayer))).rgb : vec3(1.0);
+    float light = 0.2 + 0.8 * max(dot(normalize(vertexNormal), normalize(vec3(0.4, 0.8, 0.4))), 0.0);
+    color = vec4(albedo * light, 1.0);
+}
+)";
+
+        void GetAttributeFormat(VertexAttributeFormat format, GLenum& type, GLboolean& normalized)
+        {
+            switch (format)
+            {
+                case VertexAttributeFormat::Float32: type = GL_FLOAT; normalized = GL_FALSE; break;
+                case VertexAttributeFormat::Float16: type = GL_HALF_FLOAT; normalized = GL_FALSE; break;
+                case VertexAttributeFormat::UInt16Normalized: type = GL_UNSIGNED_SHORT; normalized = GL_TRUE; break;
+                case VertexAttributeFormat::Int16Normalized: type = GL_SHORT; normalized = GL_TRUE; break;
+            }
+        }
+    }
+
+    GLMeshRenderer::GLMeshRenderer(GLStateTracker& state, std::size_t maxVertices, std::size_t maxIndices,
+                                   std::uint32_t maxDrawsPerFrame, std::uint32_t framesInFlight,
+                                   GLProgramCache* programCache)
+        : state(state), gl(state.GetFunctions()),
+          program(gl, programCache != nullptr ? programCache->Load(VertexShaderSource, FragmentShaderSource)
+                                              : CompileProgram(gl, VertexShaderSource, FragmentShaderSource)),
+          ring(gl, maxDrawsPerFrame * (sizeof(DrawCommand) + sizeof(DrawData)) + MaxStorageAlignment, framesInFlight),
+          maxVertices(maxVertices), maxIndices(maxIndices), maxDrawsPerFrame(maxDrawsPerFrame)
+    {
+        GLint alignment = 0;
+        gl.GetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+        storageAlignment = std::max<std::size_t>(alignment, alignof(DrawData));
+
+        viewProjectionLocation = program.GetUniformLocation("viewProjection");
+        texturedLocation = program.GetUniformLocation("textured");
+
+        // Immutable arenas, meshes are copied in with `glNamedBufferSubData`.
+        gl.CreateBuffers(1, &vertexBuffer);
+        gl.NamedBufferStorage(vertexBuffer, maxVertices * sizeof(QuantizedVertex), nullptr, GL_DYNAMIC_STORAGE_BIT);
+        gl.CreateBuffers(1, &indexBuffer);
+        gl.NamedBufferStorage(indexBuffer, maxIndices * sizeof(std::uint32_t), nullptr, GL_DYNAMIC_STORAGE_BIT);
+
+        std::vector<std::uint32_t> drawIndices(maxDrawsPerFrame);
+        std::iota(drawIndices.begin(), drawIndices.end(), 0u);
+        gl.CreateBuffers(1, &drawIndexBuffer);
+        gl.NamedBufferStorage(drawIndexBuffer, drawIndices.size() * sizeof(std::uint32_t), drawIndices.data(), 0);
+
+        gl.CreateVertexArrays(1, &vertexArray);
+        gl.VertexArrayVertexBuffer(vertexArray, VertexBinding, vertexBuffer, 0, QuantizedVertexLayout.stride);
+        gl.VertexArrayElementBuffer(vertexArray, indexBuffer);
+
+        for (std::uint32_t i = 0; i < QuantizedVertexLayout.attributeCount; ++i)
+        {
+            const VertexAttribute& attribute = QuantizedVertexLayout.attributes[i];
+
+            GLenum type = GL_FLOAT;
+            GLboolean normalized = GL_FALSE;
+            GetAttributeFormat(attribute.format, type, normalized);
+
+            gl.EnableVertexArrayAttrib(vertexArray, attribute.location);
+            gl.VertexArrayAttribFormat(vertexArray, attribute.location, attribute.componentCount, type, normalized, attribute.offset);
+            gl.VertexArrayAttribBinding(vertexArray, attribute.location, VertexBinding);
+        }
+
+        gl.VertexArrayVertexBuffer(vertexArray, DrawIndexBinding, drawIndexBuffer, 0, sizeof(std::uint32_t));
+        gl.VertexArrayBindingDivisor(vertexArray, DrawIndexBinding, 1);
+        gl.EnableVertexArrayAttrib(vertexArray, DrawIndexLocation);
+        gl.VertexArrayAttribIFormat(vertexArray, DrawIndexLocation, 1, GL_UNSIGNED_INT, 0);
+        gl.VertexArrayAttribBinding(vertexArray, DrawIndexLocation, DrawIndexBinding);
+
+        GLPipelineDesc desc;
+        desc.program = program.GetHandle();
+        desc.vertexArray = vertexArray;
+        pipeline = state.GetPipeline(desc);
+    }
+
+    GLMeshRenderer::~GLMeshRenderer()
+    {
+        gl.DeleteVertexArrays(1, &vertexArray);
+        gl.DeleteBuffers(1, &drawIndexBuffer);
+        gl.DeleteBuffers(1, &indexBuffer);
+        gl.DeleteBuffers(1, &vertexBuffer);
+
+        // Deleted objects get unbound, and so will the program and ring buffer after this.
+        state.Invalidate();
+    }
+
+    GLProgramSource GLMeshRenderer::GetProgramSource()
+    {
+        return { VertexShaderSource, FragmentShaderSource };
+    }
+
+    std::uint32_t GLMeshRenderer::AddMesh(const QuantizedMesh& mesh)
+    {
+        if (vertexCount + mesh.vertices.size() > maxVertices || indexCount + mesh.indices.size() > maxIndices)
+            return InvalidMesh;
+
+        gl.NamedBufferSubData(vertexBuffer, vertexCount * sizeof(QuantizedVertex),
+                              mesh.vertices.size() * sizeof(QuantizedVertex), mesh.vertices.data());
+        gl.NamedBufferSubData(indexBuffer, indexCount * sizeof(std::uint32_t),
+                              mesh.indices.size() * sizeof(std::uint32_t), mesh.indices.data());
+
+        MeshRange range;
+        range.firstIndex = static_cast<std::uint32_t>(indexCount);
+        range.indexCount = static_cast<std::uint32_t>(mesh.indices.size());
+        range.baseVertex = static_cast<std::int32_t>(vertexCount);
+        std::copy(mesh.positionOffset, mesh.positionOffset + 3, range.positionOffset);
+        std::copy(mesh.positionScale, mesh.positionScale + 3, range.positionScale);
+        meshes.push_back(range);
+
+        vertexCount += mesh.vertices.size();
+        indexCount += mesh.indices.size();
+        return static_cast<std::uint32_t>(meshes.size() - 1);
+    }
+
+    void GLMeshRenderer::BeginFrame(const Core::Matrix4& viewProjection, const GLTextureArray* frameTextures)
+    {
+        ring.BeginFrame();
+        commands = ring.Allocate(maxDrawsPerFrame * sizeof(DrawCommand), alignof(DrawCommand));
+        drawData = ring.Allocate(maxDrawsPerFrame * sizeof(DrawData), storageAlignment);
+        drawCount = 0;
+        textures = frameTextures;
+        stats = GLMeshRendererStats();
+
+        gl.ProgramUniformMatrix4fv(program.GetHandle(), viewProjectionLocation, 1, GL_FALSE, viewProjection.elements);
+        gl.ProgramUniform1i(program.GetHandle(), texturedLocation, textures != nullptr);
+    }
+
+    bool GLMeshRenderer::Draw(std::uint32_t mesh, const Core::Matrix4& model, std::uint32_t textureLayer)
+    {
+        if (drawCount == maxDrawsPerFrame || commands.data == nullptr || drawData.data == nullptr)
+            return false;
+
+        const MeshRange& range = meshes[mesh];
+
+        // Written field by field, the mapping is write-combined and never read back.
+        DrawCommand* command = static_cast<DrawCommand*>(commands.data) + drawCount;
+        command->count = range.indexCount;
+        command->instanceCount = 1;
+        command->firstIndex = range.firstIndex;
+        command->baseVertex = range.baseVertex;
+        command->baseInstance = drawCount;
+
+        DrawData* data = static_cast<DrawData*>(drawData.data) + drawCount;
+        std::memcpy(data->model, model.elements, sizeof(data->model));
+        std::memcpy(data->positionOffset, range.positionOffset, sizeof(data->positionOffset));
+        data->textureLayer = textureLayer;
+        std::memcpy(data->positionScale, range.positionScale, sizeof(data->positionScale));
+
+        ++drawCount;
+        ++stats.draws;
+        stats.triangles += range.indexCount / 3;
+        return true;
+    }
+
+    void GLMeshRenderer::EndFrame()
+    {
+        if (drawCount > 0)
+        {
+            state.SetPipeline(pipeline);
+            if (textures != nullptr)
+                state.BindTexture(0, textures->GetHandle());
+
+            state.BindBufferRange(GL_SHADER_STORAGE_BUFFER, DrawDataBinding, drawData.buffer,
+                                  drawData.offset, drawCount * sizeof(DrawData));
+            state.BindBuffer(GL_DRAW_INDIRECT_BUFFER, commands.buffer);
+
+            gl.MultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT,
+                                         reinterpret_cast<const void*>(commands.offset), drawCount, 0);
+            ++stats.multiDrawCalls;
+        }
+
+        ring.EndFrame();
+    }
+}
@@ -0,0 +1,93 @@
+#include <Engine/Graphics/OpenGL/GLProgram.hpp>
+
+#include <iostream>
+#include <string>
+
+namespace Engine::Graphics
+{
+    namespace
+    {
+        GLuint CompileShader(const GLFunctions& gl, GLenum type, const char* source)
+        {
+            GLuint shader = gl.CreateShader(type);
+            gl.ShaderSource(shader, 1, &source, nullptr);
+            gl.CompileShader(shader);
+
+            GLint compiled = GL_FALSE;
+            gl.GetShaderiv(shader, GL_COMPILE_STATUS, &compiled);
+            if (compiled == GL_TRUE)
+                return shader;
+
+            GLint length = 0;
+            gl.GetShaderiv(shader, GL_INFO_LOG_LENGTH, &length);
+            std::string log(length > 0 ? length : 1, '\0');
+            gl.GetShaderInfoLog(shader, static_cast<GLsizei>(log.size()), nullptr, log.data());
+
+            std::cout << "Something went wrong compiling a " << (type == GL_VERTEX_SHADER ? "vertex" : "fragment")
+                      << " shader: " << log.c_str() << std::endl;
+
+            gl.DeleteShader(shader);
+            return 0;
+        }
+    }
+
+    GLuint CompileProgram(const GLFunctions& gl, const char* vertexSource, const char* fragmentSource, bool retrievable)
+    {
+        GLuint vertexShader = CompileShader(gl, GL_VERTEX_SHADER, vertexSource);
+        GLuint fragmentShader = CompileShader(gl, GL_FRAGMENT_SHADER, fragmentSource);
+        GLuint program = 0;
+
+        if (vertexShader != 0 && fragmentShader != 0)
+        {
+            program = gl.CreateProgram();
+            if (retrievable)
+                gl.ProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
+            gl.AttachShader(program, vertexShader);
+            gl.AttachShader(program, fragmentShader);
+            gl.LinkProgram(program);
+            gl.DetachShader(program, vertexShader);
+            gl.DetachShader(program, fragmentShader);
+
+            GLint linked = GL_FALSE;
+            gl.GetProgramiv(program, GL_LINK_STATUS, &linked);
+            if (linked != GL_TRUE)
+            {
+                GLint length = 0;
+                gl.GetProgramiv(program, GL_INFO_LOG_LENGTH, &length);
+                std::string log(length > 0 ? length : 1, '\0');
+                gl.GetProgramInfoLog(program, static_cast<GLsizei>(log.size()), nullptr, log.data());
+
+                std::cout << "Something went wrong linking a program: " << log.c_str() << std::endl;
+
+                gl.DeleteProgram(program);
+                program = 0;
+            }
+        }
+
+        // Deleting 0 is silently ignored.
+        gl.DeleteShader(vertexShader);
+        gl.DeleteShader(fragmentShader);
+
+        return program;
+    }
+
+    GLProgram::GLProgram(const GLFunctions& gl, const char* vertexSource, const char* fragmentSource)
+        : gl(gl), program(CompileProgram(gl, vertexSource, fragmentSource))
+    {
+    }
+
+    GLProgram::GLProgram(const GLFunctions& gl, GLuint program) : gl(gl), program(program)
+    {
+    }
+
+    GLProgram::~GLProgram()
+    {
+        gl.DeleteProgram(program);
+    }
+
+    GLint GLProgram::GetUniformLocation(const char* name) const
+    {
+        return gl.GetUniformLocation(program, name);
+    }
+}
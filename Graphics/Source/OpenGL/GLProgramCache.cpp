@@ -0,0 +1,250 @@
+#include <Engine/Graphics/OpenGL/GLProgramCache.hpp>
+
+#include <Engine/Core/AtomicFile.hpp>
+#include <Engine/Core/StringId.hpp>
+#include <Engine/Graphics/OpenGL/GLProgram.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace Engine::Graphics
+{
+    namespace
+    {
+        constexpr std::uint32_t BinaryMagic = 0x43504745; // "EGPC"
+        constexpr std::uint32_t BinaryVersion = 1;
+
+        // Continues the FNV-1a `hash` of `HashString` over `size` more bytes.
+        std::uint64_t HashBytes(std::uint64_t hash, const void* data, std::size_t size)
+        {
+            const std::uint8_t* bytes = static_cast<const std::uint8_t*>(data);
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                hash ^= bytes[i];
+                hash *= 1099511628211ull;
+            }
+            return hash;
+        }
+
+        struct BinaryHeader
+        {
+            std::uint32_t magic;
+            std::uint32_t version;
+            std::uint64_t key;
+            std::uint64_t driverHash;
+            std::uint32_t format;
+            std::uint32_t size;
+        };
+
+        std::uint64_t GetNanosecondsSince(std::chrono::steady_clock::time_point start)
+        {
+            auto duration = std::chrono::steady_clock::now() - start;
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+        }
+    }
+
+    GLProgramCache::GLProgramCache(const GLDevice& device, std::string directory)
+        : gl(device.GetFunctions()), directory(std::move(directory))
+    {
+        driverHash = Core::HashString(device.GetVendor() + '\n' + device.GetRenderer() + '\n' + device.GetVersion());
+
+        GLint formatCount = 0;
+        gl.GetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+        binariesSupported = formatCount > 0;
+
+        if (!binariesSupported)
+            std::cout << "The OpenGL driver doesn't support program binaries, programs will always be compiled." << std::endl;
+    }
+
+    GLProgramCache::~GLProgramCache()
+    {
+        WaitForPrecompile();
+
+        for (const auto& [key, program] : ready)
+            gl.DeleteProgram(program);
+    }
+
+    GLuint GLProgramCache::Load(const char* vertexSource, const char* fragmentSource)
+    {
+        auto start = std::chrono::steady_clock::now();
+        std::uint64_t key = GetKey(vertexSource, fragmentSource);
+
+        GLuint program = 0;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            precompiled.wait(lock, [&] { return pending.count(key) == 0; });
+
+            auto iterator = ready.find(key);
+            if (iterator != ready.end())
+            {
+                program = iterator->second;
+                ready.erase(iterator);
+                ++stats.precompiled;
+            }
+        }
+
+        bool rejected = false;
+        bool loaded = false;
+        if (program == 0 && binariesSupported)
+        {
+            program = LoadBinary(gl, key, rejected);
+            loaded = program != 0;
+        }
+
+        bool compiled = false;
+        if (program == 0)
+        {
+            program = CompileProgram(gl, vertexSource, fragmentSource, binariesSupported);
+            compiled = true;
+
+            if (program != 0 && binariesSupported)
+                StoreBinary(gl, program, key);
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        stats.compiled += compiled;
+        stats.loaded += loaded;
+        stats.rejected += rejected;
+        stats.loadNanoseconds += GetNanosecondsSince(start);
+
+        return program;
+    }
+
+    void GLProgramCache::Precompile(std::unique_ptr<GLDevice> context, std::vector<GLProgramSource> sources)
+    {
+        WaitForPrecompile();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (const GLProgramSource& source : sources)
+                pending.insert(GetKey(source.vertex.c_str(), source.fragment.c_str()));
+        }
+
+        worker = std::thread([this, context = std::move(context), sources = std::move(sources)]
+        {
+            context->MakeCurrent();
+            const GLFunctions& functions = context->GetFunctions();
+
+            for (const GLProgramSource& source : sources)
+            {
+                auto start = std::chrono::steady_clock::now();
+                std::uint64_t key = GetKey(source.vertex.c_str(), source.fragment.c_str());
+
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (pending.count(key) == 0)
+                        continue;
+                }
+
+                bool rejected = false;
+                GLuint program = binariesSupported ? LoadBinary(functions, key, rejected) : 0;
+                if (program == 0)
+                {
+                    program = CompileProgram(functions, source.vertex.c_str(), source.fragment.c_str(), binariesSupported);
+                    if (program != 0 && binariesSupported)
+                        StoreBinary(functions, program, key);
+                }
+
+                // Objects created on one context may only be used on another once they are complete.
+                functions.Finish();
+
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    pending.erase(key);
+                    if (program != 0)
+                        ready.emplace(key, program);
+
+                    stats.rejected += rejected;
+                    stats.backgroundNanoseconds += GetNanosecondsSince(start);
+                }
+
+                precompiled.notify_all();
+            }
+        });
+    }
+
+    void GLProgramCache::WaitForPrecompile()
+    {
+        if (worker.joinable())
+            worker.join();
+    }
+
+    GLProgramCacheStats GLProgramCache::GetStats() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return stats;
+    }
+
+    std::uint64_t GLProgramCache::GetKey(const char* vertexSource, const char* fragmentSource) const
+    {
+        // One hash over the stages in order, each with its terminator, then the driver: swapped or
+        // identical stages don't cancel out.
+        std::uint64_t hash = Core::HashString({ vertexSource, std::strlen(vertexSource) + 1 });
+        hash = HashBytes(hash, fragmentSource, std::strlen(fragmentSource) + 1);
+        return HashBytes(hash, &driverHash, sizeof(driverHash));
+    }
+
+    std::string GLProgramCache::GetPath(std::uint64_t key) const
+    {
+        char name[32];
+        std::snprintf(name, sizeof(name), "%016llx.glbin", static_cast<unsigned long long>(key));
+        return directory + '/' + name;
+    }
+
+    GLuint GLProgramCache::LoadBinary(const GLFunctions& functions, std::uint64_t key, bool& rejected) const
+    {
+        std::ifstream file(GetPath(key), std::ios::binary);
+        if (!file)
+            return 0;
+
+        rejected = true;
+
+        BinaryHeader header;
+        if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+            header.magic != BinaryMagic || header.version != BinaryVersion ||
+            header.key != key || header.driverHash != driverHash)
+            return 0;
+
+        std::vector<char> binary(header.size);
+        if (!file.read(binary.data(), binary.size()))
+            return 0;
+
+        // The driver may still refuse a binary it wrote itself, for example after a settings change.
+        GLuint program = functions.CreateProgram();
+        functions.ProgramBinary(program, header.format, binary.data(), static_cast<GLsizei>(binary.size()));
+
+        GLint linked = GL_FALSE;
+        functions.GetProgramiv(program, GL_LINK_STATUS, &linked);
+        if (linked != GL_TRUE)
+        {
+            functions.DeleteProgram(program);
+            return 0;
+        }
+
+        rejected = false;
+        return program;
+    }
+
+    void GLProgramCache::StoreBinary(const GLFunctions& functions, GLuint program, std::uint64_t key) const
+    {
+        GLint length = 0;
+        functions.GetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+        if (length <= 0)
+            return;
+
+        std::vector<char> binary(length);
+        GLenum format = 0;
+        functions.GetProgramBinary(program, length, &length, &format, binary.data());
+
+        BinaryHeader header = { BinaryMagic, BinaryVersion, key, driverHash, format, static_cast<std::uint32_t>(length) };
+
+        Core::WriteFileAtomically(GetPath(key), [&](std::ostream& file)
+        {
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(binary.data(), length);
+        });
+    }
+}
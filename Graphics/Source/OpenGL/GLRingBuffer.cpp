@@ -0,0 +1,100 @@
+#include <Engine/Graphics/OpenGL/GLRingBuffer.hpp>
+
+#include <chrono>
+#include <iostream>
+
+namespace Engine::Graphics
+{
+    namespace
+    {
+        constexpr GLbitfield MappingFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+        // Wait in slices of a second, and give up after a few so that a lost context can't block forever.
+        constexpr GLuint64 FenceTimeoutNanoseconds = 1000000000;
+        constexpr int MaxFenceTimeouts = 5;
+    }
+
+    GLRingBuffer::GLRingBuffer(const GLFunctions& gl, std::size_t frameSize, std::uint32_t frameCount)
+        : gl(gl), frameSize(frameSize), frameCount(frameCount), fences(frameCount, nullptr)
+    {
+        GLsizeiptr totalSize = static_cast<GLsizeiptr>(frameSize * frameCount);
+
+        gl.CreateBuffers(1, &buffer);
+        gl.NamedBufferStorage(buffer, totalSize, nullptr, MappingFlags);
+        mapping = static_cast<unsigned char*>(gl.MapNamedBufferRange(buffer, 0, totalSize, MappingFlags));
+
+        if (mapping == nullptr)
+            std::cout << "Something went wrong mapping a persistent OpenGL buffer of " << totalSize << " bytes." << std::endl;
+    }
+
+    GLRingBuffer::~GLRingBuffer()
+    {
+        for (GLsync fence : fences)
+        {
+            if (fence != nullptr)
+                gl.DeleteSync(fence);
+        }
+
+        if (mapping != nullptr)
+            gl.UnmapNamedBuffer(buffer);
+
+        gl.DeleteBuffers(1, &buffer);
+    }
+
+    void GLRingBuffer::BeginFrame()
+    {
+        frameOffset = 0;
+
+        GLsync& fence = fences[frameIndex];
+        if (fence == nullptr)
+            return;
+
+        // Fast path, the GPU is already done with this section.
+        GLenum status = gl.ClientWaitSync(fence, 0, 0);
+        if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+        {
+            auto start = std::chrono::steady_clock::now();
+            int timeouts = 0;
+            do
+            {
+                status = gl.ClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, FenceTimeoutNanoseconds);
+            }
+            while (status == GL_TIMEOUT_EXPIRED && ++timeouts < MaxFenceTimeouts);
+
+            if (status == GL_TIMEOUT_EXPIRED || status == GL_WAIT_FAILED)
+                std::cout << "Something went wrong waiting for the GPU to finish with a ring buffer section, reusing it anyway." << std::endl;
+
+            auto duration = std::chrono::steady_clock::now() - start;
+            ++stats.waits;
+            stats.waitNanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+        }
+
+        gl.DeleteSync(fence);
+        fence = nullptr;
+    }
+
+    GLRingAllocation GLRingBuffer::Allocate(std::size_t size, std::size_t alignment)
+    {
+        GLRingAllocation allocation;
+
+        // Align the offset into the whole buffer, bindings like `glBindBufferRange` check that one and the
+        // sections don't start aligned unless `frameSize` happens to be.
+        std::size_t frameStart = frameIndex * frameSize;
+        std::size_t offset = ((frameStart + frameOffset + alignment - 1) & ~(alignment - 1)) - frameStart;
+        if (mapping == nullptr || offset + size > frameSize)
+            return allocation;
+
+        frameOffset = offset + size;
+
+        allocation.offset = frameStart + offset;
+        allocation.data = mapping + allocation.offset;
+        allocation.buffer = buffer;
+        return allocation;
+    }
+
+    void GLRingBuffer::EndFrame()
+    {
+        fences[frameIndex] = gl.FenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        frameIndex = (frameIndex + 1) % frameCount;
+    }
+}
@@ -0,0 +1,316 @@
+#include <Engine/Graphics/OpenGL/GLStateTracker.hpp>
+
+#include <iostream>
+
+namespace Engine::Graphics
+{
+    namespace
+    {
+        void GetBlendFactors(GLBlendMode mode, GLenum& source, GLenum& destination)
+        {
+            switch (mode)
+            {
+                case GLBlendMode::Opaque: source = GL_ONE; destination = GL_ZERO; break;
+                case GLBlendMode::Alpha: source = GL_SRC_ALPHA; destination = GL_ONE_MINUS_SRC_ALPHA; break;
+                case GLBlendMode::Premultiplied: source = GL_ONE; destination = GL_ONE_MINUS_SRC_ALPHA; break;
+                case GLBlendMode::Additive: source = GL_SRC_ALPHA; destination = GL_ONE; break;
+            }
+        }
+
+        void Report(const char* state, GLint expected, GLint actual)
+        {
+            std::cout << "OpenGL state \"" << state << "\" is " << actual << " but was tracked as " << expected << "." << std::endl;
+        }
+    }
+
+    bool GLPipelineDesc::operator==(const GLPipelineDesc& other) const
+    {
+        return program == other.program && vertexArray == other.vertexArray &&
+               blendMode == other.blendMode && cullMode == other.cullMode &&
+               depthTest == other.depthTest && depthWrite == other.depthWrite &&
+               colorWrite == other.colorWrite && depthFunc == other.depthFunc;
+    }
+
+    std::size_t GLPipelineDescHash::operator()(const GLPipelineDesc& desc) const
+    {
+        std::uint64_t state = static_cast<std::uint64_t>(desc.blendMode) |
+                              static_cast<std::uint64_t>(desc.cullMode) << 8 |
+                              static_cast<std::uint64_t>(desc.depthTest) << 16 |
+                              static_cast<std::uint64_t>(desc.depthWrite) << 17 |
+                              static_cast<std::uint64_t>(desc.colorWrite) << 18 |
+                              static_cast<std::uint64_t>(desc.depthFunc) << 32;
+
+        std::uint64_t hash = 14695981039346656037ull;
+        for (std::uint64_t value : { static_cast<std::uint64_t>(desc.program), static_cast<std::uint64_t>(desc.vertexArray), state })
+            hash = (hash ^ value) * 1099511628211ull;
+
+        return static_cast<std::size_t>(hash);
+    }
+
+    GLStateTracker::GLStateTracker(const GLFunctions& gl) : gl(gl)
+    {
+        Invalidate();
+    }
+
+    const GLPipeline* GLStateTracker::GetPipeline(const GLPipelineDesc& desc)
+    {
+        std::unique_ptr<GLPipeline>& pipeline = pipelines[desc];
+        if (pipeline == nullptr)
+            pipeline.reset(new GLPipeline { desc, static_cast<std::uint32_t>(pipelines.size() - 1) });
+
+        return pipeline.get();
+    }
+
+    template<typename Value, typename Issue>
+    void GLStateTracker::Apply(Value& shadow, Value value, Issue&& issue)
+    {
+        if (shadow == value)
+        {
+            ++counters.elided;
+            return;
+        }
+
+        shadow = value;
+        issue();
+        ++counters.issued;
+    }
+
+    void GLStateTracker::SetEnabled(GLenum capability, std::int8_t& shadow, bool enabled)
+    {
+        Apply(shadow, static_cast<std::int8_t>(enabled), [&]
+        {
+            if (enabled)
+                gl.Enable(capability);
+            else
+                gl.Disable(capability);
+        });
+    }
+
+    void GLStateTracker::SetPipeline(const GLPipeline* newPipeline)
+    {
+        if (newPipeline == pipeline)
+        {
+            ++counters.elided;
+            return;
+        }
+
+        pipeline = newPipeline;
+        ++counters.pipelineChanges;
+
+        const GLPipelineDesc& desc = newPipeline->desc;
+
+        Apply(program, desc.program, [&] { gl.UseProgram(desc.program); });
+        Apply(vertexArray, desc.vertexArray, [&] { gl.BindVertexArray(desc.vertexArray); });
+
+        bool blended = desc.blendMode != GLBlendMode::Opaque;
+        SetEnabled(GL_BLEND, blend, blended);
+        if (blended)
+        {
+            GLenum source = GL_ONE;
+            GLenum destination = GL_ZERO;
+            GetBlendFactors(desc.blendMode, source, destination);
+
+            // Both factors go in one call, track them as a pair.
+            if (blendSource != source || blendDestination != destination)
+            {
+                blendSource = source;
+                blendDestination = destination;
+                gl.BlendFunc(source, destination);
+                ++counters.issued;
+            }
+            else
+            {
+                ++counters.elided;
+            }
+        }
+
+        bool culled = desc.cullMode != GLCullMode::None;
+        SetEnabled(GL_CULL_FACE, cullFace, culled);
+        if (culled)
+        {
+            GLenum mode = desc.cullMode == GLCullMode::Back ? GL_BACK : GL_FRONT;
+            Apply(cullFaceMode, mode, [&] { gl.CullFace(mode); });
+        }
+
+        SetEnabled(GL_DEPTH_TEST, depthTest, desc.depthTest);
+        if (desc.depthTest)
+            Apply(depthFunc, desc.depthFunc, [&] { gl.DepthFunc(desc.depthFunc); });
+
+        Apply(depthWrite, static_cast<std::int8_t>(desc.depthWrite), [&] { gl.DepthMask(desc.depthWrite); });
+
+        Apply(colorWrite, static_cast<std::int8_t>(desc.colorWrite), [&]
+        {
+            gl.ColorMask(desc.colorWrite, desc.colorWrite, desc.colorWrite, desc.colorWrite);
+        });
+    }
+
+    void GLStateTracker::BindTexture(GLuint unit, GLuint texture)
+    {
+        if (unit >= MaxTextureUnits)
+        {
+            gl.BindTextureUnit(unit, texture);
+            ++counters.issued;
+            return;
+        }
+
+        Apply(textures[unit], texture, [&] { gl.BindTextureUnit(unit, texture); });
+    }
+
+    void GLStateTracker::BindBuffer(GLenum target, GLuint buffer)
+    {
+        GLuint* shadow = nullptr;
+        switch (target)
+        {
+            case GL_ARRAY_BUFFER: shadow = &arrayBuffer; break;
+            case GL_DRAW_INDIRECT_BUFFER: shadow = &drawIndirectBuffer; break;
+            case GL_PIXEL_UNPACK_BUFFER: shadow = &pixelUnpackBuffer; break;
+        }
+
+        if (shadow == nullptr)
+        {
+            gl.BindBuffer(target, buffer);
+            ++counters.issued;
+            return;
+        }
+
+        Apply(*shadow, buffer, [&] { gl.BindBuffer(target, buffer); });
+    }
+
+    void GLStateTracker::BindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size)
+    {
+        BufferRange* ranges = target == GL_UNIFORM_BUFFER ? uniformBuffers : target == GL_SHADER_STORAGE_BUFFER ? storageBuffers : nullptr;
+        if (ranges != nullptr && index < MaxBufferBindings)
+        {
+            BufferRange& range = ranges[index];
+            if (range.buffer == buffer && range.offset == offset && range.size == size)
+            {
+                ++counters.elided;
+                return;
+            }
+
+            range = { buffer, offset, size };
+        }
+
+        gl.BindBufferRange(target, index, buffer, offset, size);
+        ++counters.issued;
+    }
+
+    void GLStateTracker::SetViewport(GLint x, GLint y, GLsizei width, GLsizei height)
+    {
+        if (viewport[0] == x && viewport[1] == y && viewport[2] == width && viewport[3] == height)
+        {
+            ++counters.elided;
+            return;
+        }
+
+        viewport[0] = x;
+        viewport[1] = y;
+        viewport[2] = width;
+        viewport[3] = height;
+        gl.Viewport(x, y, width, height);
+        ++counters.issued;
+    }
+
+    void GLStateTracker::Invalidate()
+    {
+        pipeline = nullptr;
+        program = Unknown;
+        vertexArray = Unknown;
+        blend = -1;
+        cullFace = -1;
+        depthTest = -1;
+        depthWrite = -1;
+        colorWrite = -1;
+        blendSource = Unknown;
+        blendDestination = Unknown;
+        cullFaceMode = Unknown;
+        depthFunc = Unknown;
+
+        for (GLuint& texture : textures)
+            texture = Unknown;
+
+        arrayBuffer = Unknown;
+        drawIndirectBuffer = Unknown;
+        pixelUnpackBuffer = Unknown;
+
+        for (std::uint32_t i = 0; i < MaxBufferBindings; ++i)
+        {
+            uniformBuffers[i] = { Unknown, 0, 0 };
+            storageBuffers[i] = { Unknown, 0, 0 };
+        }
+
+        viewport[0] = viewport[1] = viewport[2] = viewport[3] = -1;
+    }
+
+    bool GLStateTracker::Validate() const
+    {
+        bool valid = true;
+
+        auto checkInteger = [&](const char* name, GLenum state, GLuint expected)
+        {
+            if (expected == Unknown)
+                return;
+
+            GLint actual = 0;
+            gl.GetIntegerv(state, &actual);
+            if (static_cast<GLuint>(actual) != expected)
+            {
+                Report(name, static_cast<GLint>(expected), actual);
+                valid = false;
+            }
+        };
+
+        auto checkEnabled = [&](const char* name, GLenum capability, std::int8_t expected)
+        {
+            if (expected < 0)
+                return;
+
+            GLint actual = gl.IsEnabled(capability);
+            if (actual != expected)
+            {
+                Report(name, expected, actual);
+                valid = false;
+            }
+        };
+
+        checkInteger("program", GL_CURRENT_PROGRAM, program);
+        checkInteger("vertex array", GL_VERTEX_ARRAY_BINDING, vertexArray);
+        checkInteger("draw indirect buffer", GL_DRAW_INDIRECT_BUFFER_BINDING, drawIndirectBuffer);
+        checkInteger("array buffer", GL_ARRAY_BUFFER_BINDING, arrayBuffer);
+        checkInteger("pixel unpack buffer", GL_PIXEL_UNPACK_BUFFER_BINDING, pixelUnpackBuffer);
+        checkEnabled("blend", GL_BLEND, blend);
+        checkEnabled("cull face", GL_CULL_FACE, cullFace);
+        checkEnabled("depth test", GL_DEPTH_TEST, depthTest);
+        checkInteger("blend source", GL_BLEND_SRC_RGB, blendSource);
+        checkInteger("blend destination", GL_BLEND_DST_RGB, blendDestination);
+        checkInteger("cull face mode", GL_CULL_FACE_MODE, cullFaceMode);
+        checkInteger("depth function", GL_DEPTH_FUNC, depthFunc);
+
+        if (depthWrite >= 0)
+        {
+            GLboolean actual = GL_FALSE;
+            gl.GetBooleanv(GL_DEPTH_WRITEMASK, &actual);
+            if (actual != depthWrite)
+            {
+                Report("depth write", depthWrite, actual);
+                valid = false;
+            }
+        }
+
+        if (viewport[2] >= 0)
+        {
+            GLint actual[4] = {};
+            gl.GetIntegerv(GL_VIEWPORT, actual);
+            for (int i = 0; i < 4; ++i)
+            {
+                if (actual[i] != viewport[i])
+                {
+                    Report("viewport", viewport[i], actual[i]);
+                    valid = false;
+                }
+            }
+        }
+
+        return valid;
+    }
+}
@@ -0,0 +1,67 @@
+#include <Engine/Graphics/OpenGL/GLTextureArray.hpp>
+
+#include <algorithm>
+
+namespace Engine::Graphics
+{
+    GLTextureArray::GLTextureArray(const GLFunctions& gl, std::uint32_t width, std::uint32_t height,
+                                   std::uint32_t layerCount, std::uint32_t mipLevels, GLenum internalFormat)
+        : gl(gl), width(width), height(height), layerCount(layerCount)
+    {
+        if (mipLevels == 0)
+        {
+            for (std::uint32_t size = std::max(width, height); size > 0; size >>= 1)
+                ++mipLevels;
+        }
+
+        gl.CreateTextures(GL_TEXTURE_2D_ARRAY, 1, &texture);
+        gl.TextureStorage3D(texture, static_cast<GLsizei>(mipLevels), internalFormat,
+                            static_cast<GLsizei>(width), static_cast<GLsizei>(height), static_cast<GLsizei>(layerCount));
+
+        gl.TextureParameteri(texture, GL_TEXTURE_MIN_FILTER, mipLevels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+        gl.TextureParameteri(texture, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        gl.TextureParameteri(texture, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        gl.TextureParameteri(texture, GL_TEXTURE_WRAP_T, GL_REPEAT);
+
+        // Hand out low layers first.
+        freeLayers.reserve(layerCount);
+        for (std::uint32_t layer = layerCount; layer > 0; --layer)
+            freeLayers.push_back(static_cast<std::int32_t>(layer - 1));
+    }
+
+    GLTextureArray::~GLTextureArray()
+    {
+        gl.DeleteTextures(1, &texture);
+    }
+
+    std::int32_t GLTextureArray::AllocateLayer()
+    {
+        if (freeLayers.empty())
+            return -1;
+
+        std::int32_t layer = freeLayers.back();
+        freeLayers.pop_back();
+        return layer;
+    }
+
+    void GLTextureArray::FreeLayer(std::int32_t layer)
+    {
+        freeLayers.push_back(layer);
+    }
+
+    void GLTextureArray::Upload(std::int32_t layer, const void* pixels)
+    {
+        gl.TextureSubImage3D(texture, 0, 0, 0, layer, static_cast<GLsizei>(width), static_cast<GLsizei>(height), 1,
+                             GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    }
+
+    void GLTextureArray::GenerateMipmaps()
+    {
+        gl.GenerateTextureMipmap(texture);
+    }
+
+    void GLTextureArray::Bind(GLuint unit) const
+    {
+        gl.BindTextureUnit(unit, texture);
+    }
+}
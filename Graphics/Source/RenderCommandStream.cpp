@@ -0,0 +1,96 @@
+#include <Engine/Graphics/RenderCommandStream.hpp>
+
+#include <algorithm>
+
+namespace Engine::Graphics
+{
+    namespace
+    {
+        constexpr std::size_t Alignment = alignof(std::max_align_t);
+
+        constexpr std::size_t AlignUp(std::size_t size)
+        {
+            return (size + Alignment - 1) & ~(Alignment - 1);
+        }
+    }
+
+    RenderCommandStream::RenderCommandStream(std::size_t blockSize) : blockSize(blockSize)
+    {
+    }
+
+    RenderCommandStream::~RenderCommandStream()
+    {
+        Clear();
+    }
+
+    void RenderCommandStream::Execute()
+    {
+        Consume(true);
+    }
+
+    void RenderCommandStream::Clear()
+    {
+        Consume(false);
+    }
+
+    void* RenderCommandStream::Allocate(std::size_t size)
+    {
+        constexpr std::size_t HeaderSize = AlignUp(sizeof(Header));
+        std::size_t needed = HeaderSize + AlignUp(size);
+
+        // Blocks are filled in order, a command that doesn't fit moves on to the next one for good.
+        while (currentBlock < blocks.size() && blocks[currentBlock].used + needed > blocks[currentBlock].size)
+            ++currentBlock;
+
+        if (currentBlock == blocks.size())
+        {
+            Block block;
+            block.size = std::max(blockSize, needed);
+            block.data.reset(new unsigned char[block.size]);
+            blocks.push_back(std::move(block));
+        }
+
+        Block& block = blocks[currentBlock];
+        unsigned char* memory = block.data.get() + block.used;
+        block.used += needed;
+
+        // The function is only set once the command is constructed.
+        pendingHeader = reinterpret_cast<Header*>(memory);
+        pendingHeader->function = nullptr;
+        pendingHeader->next = needed;
+
+        return memory + HeaderSize;
+    }
+
+    void RenderCommandStream::Commit(CommandFunction function)
+    {
+        pendingHeader->function = function;
+        usedBytes += pendingHeader->next;
+        ++commandCount;
+    }
+
+    void RenderCommandStream::Consume(bool run)
+    {
+        constexpr std::size_t HeaderSize = AlignUp(sizeof(Header));
+
+        for (std::size_t i = 0; i < blocks.size() && i <= currentBlock; ++i)
+        {
+            Block& block = blocks[i];
+            for (std::size_t offset = 0; offset < block.used;)
+            {
+                Header* header = reinterpret_cast<Header*>(block.data.get() + offset);
+                if (header->function != nullptr)
+                    header->function(block.data.get() + offset + HeaderSize, run);
+
+                offset += header->next;
+            }
+
+            block.used = 0;
+        }
+
+        currentBlock = 0;
+        pendingHeader = nullptr;
+        commandCount = 0;
+        usedBytes = 0;
+    }
+}
@@ -0,0 +1,147 @@
+#include <Engine/Graphics/RenderThread.hpp>
+
+namespace Engine::Graphics
+{
+    namespace
+    {
+        std::uint64_t GetNanosecondsBetween(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end)
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+        }
+    }
+
+    RenderThread::RenderThread(bool threaded) : lastEndFrame(std::chrono::steady_clock::now())
+    {
+        if (threaded)
+        {
+            thread = std::thread(&RenderThread::RenderMain, this);
+            renderThreadId = thread.get_id();
+        }
+        else
+        {
+            renderThreadId = std::this_thread::get_id();
+        }
+    }
+
+    RenderThread::~RenderThread()
+    {
+        Flush();
+
+        if (thread.joinable())
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+
+            frameSubmitted.notify_one();
+            thread.join();
+        }
+    }
+
+    RenderFence RenderThread::EndFrame()
+    {
+        auto start = std::chrono::steady_clock::now();
+        RenderFence fence;
+
+        if (!thread.joinable())
+        {
+            RenderCommandStream& stream = streams[writeIndex];
+            stats.commands = stream.GetCommandCount();
+            stats.commandBytes = stream.GetUsedBytes();
+
+            stream.Execute();
+            fence = ++submittedFrame;
+            completedFrame = fence;
+
+            auto end = std::chrono::steady_clock::now();
+            stats.renderExecuteNanoseconds = GetNanosecondsBetween(start, end);
+            stats.renderIdleNanoseconds = 0;
+            stats.mainWaitNanoseconds = 0;
+            stats.mainFrameNanoseconds = GetNanosecondsBetween(lastEndFrame, end);
+            lastEndFrame = end;
+            return fence;
+        }
+
+        {
+            // Back-pressure: the other stream is free once the render thread finished the previous frame.
+            std::unique_lock<std::mutex> lock(mutex);
+            frameCompleted.wait(lock, [this] { return completedFrame == submittedFrame; });
+
+            fence = ++submittedFrame;
+            writeIndex ^= 1;
+        }
+
+        frameSubmitted.notify_one();
+
+        auto end = std::chrono::steady_clock::now();
+        std::lock_guard<std::mutex> lock(mutex);
+        stats.mainWaitNanoseconds = GetNanosecondsBetween(start, end);
+        stats.mainFrameNanoseconds = GetNanosecondsBetween(lastEndFrame, end);
+        lastEndFrame = end;
+        return fence;
+    }
+
+    bool RenderThread::IsComplete(RenderFence fence) const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return completedFrame >= fence;
+    }
+
+    void RenderThread::Wait(RenderFence fence)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        frameCompleted.wait(lock, [this, fence] { return completedFrame >= fence; });
+    }
+
+    void RenderThread::Flush()
+    {
+        Wait(EndFrame());
+    }
+
+    bool RenderThread::IsRenderThread() const
+    {
+        return std::this_thread::get_id() == renderThreadId;
+    }
+
+    RenderThreadStats RenderThread::GetStats() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return stats;
+    }
+
+    void RenderThread::RenderMain()
+    {
+        while (true)
+        {
+            auto idleStart = std::chrono::steady_clock::now();
+            RenderCommandStream* stream;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                frameSubmitted.wait(lock, [this] { return stopping || submittedFrame != completedFrame; });
+                if (submittedFrame == completedFrame)
+                    return;
+
+                // The main thread switched to the other stream when submitting.
+                stream = &streams[writeIndex ^ 1];
+            }
+
+            auto start = std::chrono::steady_clock::now();
+            std::uint32_t commands = stream->GetCommandCount();
+            std::size_t commandBytes = stream->GetUsedBytes();
+            stream->Execute();
+            auto end = std::chrono::steady_clock::now();
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                ++completedFrame;
+                stats.renderIdleNanoseconds = GetNanosecondsBetween(idleStart, start);
+                stats.renderExecuteNanoseconds = GetNanosecondsBetween(start, end);
+                stats.commands = commands;
+                stats.commandBytes = commandBytes;
+            }
+
+            frameCompleted.notify_all();
+        }
+    }
+}
@@ -0,0 +1,118 @@
+#include <Engine/Graphics/SpriteBatcher.hpp>
+
+#include <Engine/Core/MemoryTracking.hpp>
+
+#include <SDL2/SDL_error.h>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace Engine::Graphics
+{
+    SpriteBatcher::SpriteBatcher(SDL_Renderer* renderer) : renderer(renderer)
+    {
+    }
+
+    void SpriteBatcher::Begin()
+    {
+        sprites.clear();
+        textureIndices.clear();
+    }
+
+    void SpriteBatcher::Draw(const Sprite& sprite)
+    {
+        sprites.push_back(sprite);
+    }
+
+    bool SpriteBatcher::End()
+    {
+        Core::MemoryTagScope memoryTag(Core::MemoryTag::Graphics);
+        stats = SpriteBatchStats();
+        stats.sprites = static_cast<std::uint32_t>(sprites.size());
+        if (sprites.empty())
+            return true;
+
+        // Layer in the high bits, biased so negative layers sort first, then the texture.
+        order.resize(sprites.size());
+        for (std::uint32_t i = 0; i < sprites.size(); ++i)
+        {
+            auto texture = textureIndices.emplace(sprites[i].texture, static_cast<std::uint32_t>(textureIndices.size()));
+            std::uint32_t layer = static_cast<std::uint32_t>(sprites[i].layer) ^ 0x80000000u;
+            order[i] = { (std::uint64_t(layer) << 32) | texture.first->second, i };
+        }
+
+        // The sprite index breaks ties, keeping submission order within a batch.
+        std::sort(order.begin(), order.end(), [](const SortEntry& a, const SortEntry& b)
+        {
+            return a.key != b.key ? a.key < b.key : a.sprite < b.sprite;
+        });
+
+        vertices.resize(sprites.size() * 4);
+        for (std::size_t i = 0; i < order.size(); ++i)
+            WriteVertices(sprites[order[i].sprite], &vertices[i * 4]);
+
+        for (std::size_t quad = indices.size() / 6; quad < sprites.size(); ++quad)
+        {
+            int base = static_cast<int>(quad * 4);
+            indices.insert(indices.end(), { base, base + 1, base + 2, base + 2, base + 3, base });
+        }
+
+        bool success = true;
+        for (std::size_t begin = 0; begin < order.size();)
+        {
+            std::size_t end = begin + 1;
+            while (end < order.size() && order[end].key == order[begin].key)
+                ++end;
+
+            int vertexCount = static_cast<int>((end - begin) * 4);
+            int indexCount = static_cast<int>((end - begin) * 6);
+            if (SDL_RenderGeometry(renderer, sprites[order[begin].sprite].texture, &vertices[begin * 4], vertexCount,
+                                   indices.data(), indexCount) != 0)
+            {
+                std::cout << "Something went wrong drawing a sprite batch: " << SDL_GetError() << std::endl;
+                success = false;
+            }
+
+            ++stats.batches;
+            begin = end;
+        }
+
+        stats.textures = static_cast<std::uint32_t>(textureIndices.size());
+        return success;
+    }
+
+    void SpriteBatcher::WriteVertices(const Sprite& sprite, SDL_Vertex* quad) const
+    {
+        const SDL_FRect& rect = sprite.destination;
+        const SDL_FRect& uv = sprite.uv;
+
+        // Corners clockwise from the top left, as offsets from the center.
+        float halfWidth = rect.w * 0.5f;
+        float halfHeight = rect.h * 0.5f;
+        const float corners[4][2] = { { -halfWidth, -halfHeight }, { halfWidth, -halfHeight },
+                                      { halfWidth, halfHeight }, { -halfWidth, halfHeight } };
+        const float texCoords[4][2] = { { uv.x, uv.y }, { uv.x + uv.w, uv.y },
+                                        { uv.x + uv.w, uv.y + uv.h }, { uv.x, uv.y + uv.h } };
+        // A clockwise rotated image has its top left corner at the top right of the region.
+        int texCoordOffset = sprite.rotatedUv ? 1 : 0;
+
+        float centerX = rect.x + halfWidth;
+        float centerY = rect.y + halfHeight;
+        float cosine = 1.0f;
+        float sine = 0.0f;
+        if (sprite.rotation != 0.0f)
+        {
+            cosine = std::cos(sprite.rotation);
+            sine = std::sin(sprite.rotation);
+        }
+
+        for (int i = 0; i < 4; ++i)
+        {
+            quad[i].position.x = centerX + corners[i][0] * cosine - corners[i][1] * sine;
+            quad[i].position.y = centerY + corners[i][0] * sine + corners[i][1] * cosine;
+            quad[i].color = sprite.color;
+            quad[i].tex_coord.x = texCoords[(i + texCoordOffset) % 4][0];
+            quad[i].tex_coord.y = texCoords[(i + texCoordOffset) % 4][1];
+        }
+    }
+}
@@ -0,0 +1,160 @@
+#include <Engine/Graphics/TextureAtlas.hpp>
+
+#include <Engine/Core/MemoryTracking.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <numeric>
+
+namespace Engine::Graphics
+{
+    namespace
+    {
+        constexpr std::uint32_t Magic = 0x534C5441; // "ATLS"
+        constexpr std::uint32_t Version = 1;
+
+        struct Header
+        {
+            std::uint32_t magic;
+            std::uint32_t version;
+            std::uint32_t pageCount;
+            std::uint32_t regionCount;
+        };
+
+        // Regions are read and written as a block.
+        static_assert(sizeof(AtlasRegion) == 24, "Atlas regions must stay packed.");
+    }
+
+    std::unique_ptr<TextureAtlas> TextureAtlas::Load(const std::string& path)
+    {
+        Core::MemoryTagScope memoryTag(Core::MemoryTag::Graphics);
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file)
+        {
+            std::cout << "Something went wrong opening the texture atlas \"" << path << "\"." << std::endl;
+            return nullptr;
+        }
+
+        std::uint64_t fileSize = static_cast<std::uint64_t>(file.tellg());
+        file.seekg(0);
+
+        Header header;
+        if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) || header.magic != Magic || header.version != Version)
+        {
+            std::cout << "\"" << path << "\" is not a texture atlas of version " << Version << "." << std::endl;
+            return nullptr;
+        }
+
+        // Before allocating anything: every page takes at least its name's length, every region its
+        // hash and itself.
+        std::uint64_t minimumSize = sizeof(header) + std::uint64_t(header.pageCount) * sizeof(std::uint32_t) +
+                                    std::uint64_t(header.regionCount) * (sizeof(std::uint64_t) + sizeof(AtlasRegion));
+        if (minimumSize > fileSize)
+        {
+            std::cout << "The texture atlas \"" << path << "\" is truncated." << std::endl;
+            return nullptr;
+        }
+
+        std::unique_ptr<TextureAtlas> atlas(new TextureAtlas());
+        atlas->pages.resize(header.pageCount);
+        for (std::string& page : atlas->pages)
+        {
+            std::uint32_t length = 0;
+            file.read(reinterpret_cast<char*>(&length), sizeof(length));
+            if (!file || length > 4096)
+            {
+                std::cout << "The texture atlas \"" << path << "\" has a malformed page name." << std::endl;
+                return nullptr;
+            }
+
+            page.resize(length);
+            file.read(page.data(), length);
+        }
+
+        atlas->hashes.resize(header.regionCount);
+        atlas->regions.resize(header.regionCount);
+        file.read(reinterpret_cast<char*>(atlas->hashes.data()), atlas->hashes.size() * sizeof(std::uint64_t));
+        file.read(reinterpret_cast<char*>(atlas->regions.data()), atlas->regions.size() * sizeof(AtlasRegion));
+
+        if (!file)
+        {
+            std::cout << "The texture atlas \"" << path << "\" is truncated." << std::endl;
+            return nullptr;
+        }
+
+        // `Find` binary searches the hashes, which `Write` stores sorted and unique.
+        if (std::adjacent_find(atlas->hashes.begin(), atlas->hashes.end(), std::greater_equal<std::uint64_t>()) != atlas->hashes.end())
+        {
+            std::cout << "The texture atlas \"" << path << "\" has an unsorted or duplicate region." << std::endl;
+            return nullptr;
+        }
+
+        for (const AtlasRegion& region : atlas->regions)
+        {
+            if (region.page >= atlas->pages.size())
+            {
+                std::cout << "The texture atlas \"" << path << "\" has a region on a page it doesn't have." << std::endl;
+                return nullptr;
+            }
+        }
+
+        return atlas;
+    }
+
+    const AtlasRegion* TextureAtlas::Find(Core::StringId name) const
+    {
+        auto it = std::lower_bound(hashes.begin(), hashes.end(), name.GetHash());
+        if (it == hashes.end() || *it != name.GetHash())
+            return nullptr;
+
+        return &regions[it - hashes.begin()];
+    }
+
+    bool TextureAtlas::Write(const std::string& path, const std::vector<std::string>& pages,
+                             const std::vector<Core::StringId>& names, const std::vector<AtlasRegion>& regions)
+    {
+        std::vector<std::size_t> order(names.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&names](std::size_t a, std::size_t b) { return names[a] < names[b]; });
+
+        for (std::size_t i = 1; i < order.size(); ++i)
+        {
+            if (names[order[i]] == names[order[i - 1]])
+            {
+                std::cout << "Two atlas regions have the name hash " << names[order[i]].GetHash() << "." << std::endl;
+                return false;
+            }
+        }
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+        Header header = { Magic, Version, static_cast<std::uint32_t>(pages.size()), static_cast<std::uint32_t>(names.size()) };
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        for (const std::string& page : pages)
+        {
+            std::uint32_t length = static_cast<std::uint32_t>(page.size());
+            file.write(reinterpret_cast<const char*>(&length), sizeof(length));
+            file.write(page.data(), length);
+        }
+
+        for (std::size_t index : order)
+        {
+            std::uint64_t hash = names[index].GetHash();
+            file.write(reinterpret_cast<const char*>(&hash), sizeof(hash));
+        }
+
+        for (std::size_t index : order)
+            file.write(reinterpret_cast<const char*>(&regions[index]), sizeof(AtlasRegion));
+
+        if (!file)
+        {
+            std::cout << "Something went wrong writing the texture atlas \"" << path << "\"." << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+}
@@ -0,0 +1,260 @@
+#include <Engine/Graphics/TextureStreamer.hpp>
+
+#include <Engine/Core/MemoryTracking.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace Engine::Graphics
+{
+    std::size_t GetMipSize(const StreamedTextureDesc& desc, std::uint32_t mip)
+    {
+        std::size_t width = std::max<std::size_t>(desc.width >> mip, 1);
+        std::size_t height = std::max<std::size_t>(desc.height >> mip, 1);
+        return width * height * desc.bytesPerPixel;
+    }
+
+    std::uint32_t ComputeRequiredMip(const StreamedTextureDesc& desc, float screenSize)
+    {
+        std::uint32_t lowestMip = desc.mipCount - 1;
+        if (screenSize <= 1.0f)
+            return lowestMip;
+
+        float textureSize = static_cast<float>(std::max(desc.width, desc.height));
+        float mip = std::floor(std::log2(textureSize / screenSize));
+        if (mip <= 0.0f)
+            return 0;
+
+        return std::min(static_cast<std::uint32_t>(mip), lowestMip);
+    }
+
+    float ComputeProjectedSize(float radius, float distance, float verticalFov, float screenHeight)
+    {
+        if (distance <= radius)
+            return screenHeight;
+
+        return (radius / (distance * std::tan(verticalFov * 0.5f))) * screenHeight;
+    }
+
+    TextureStreamer::TextureStreamer(std::size_t memoryBudget, std::size_t uploadBudgetPerFrame,
+                                     StreamInCallback streamIn, StreamOutCallback streamOut)
+        : memoryBudget(memoryBudget), uploadBudgetPerFrame(uploadBudgetPerFrame),
+          streamIn(std::move(streamIn)), streamOut(std::move(streamOut))
+    {
+    }
+
+    StreamedTextureId TextureStreamer::AddTexture(const StreamedTextureDesc& desc)
+    {
+        Core::MemoryTagScope memoryTag(Core::MemoryTag::Graphics);
+        StreamedTextureId id;
+        if (!freeIds.empty())
+        {
+            id = freeIds.back();
+            freeIds.pop_back();
+        }
+        else
+        {
+            id = static_cast<StreamedTextureId>(textures.size());
+            textures.emplace_back();
+        }
+
+        // The coarsest mip is uploaded by the caller together with the texture.
+        Texture& texture = textures[id];
+        texture = Texture();
+        texture.desc = desc;
+        texture.desc.mipCount = std::max<std::uint32_t>(desc.mipCount, 1);
+        texture.residentMip = texture.desc.mipCount - 1;
+        texture.requestedMip = texture.residentMip;
+        texture.alive = true;
+
+        residentBytes += GetMipSize(texture.desc, texture.residentMip);
+        return id;
+    }
+
+    void TextureStreamer::RemoveTexture(StreamedTextureId id)
+    {
+        Texture& texture = textures[id];
+        for (std::uint32_t mip = texture.residentMip; mip < texture.desc.mipCount; ++mip)
+        {
+            // The coarsest mip belongs to the caller.
+            if (mip + 1 < texture.desc.mipCount)
+                streamOut(id, mip);
+
+            residentBytes -= GetMipSize(texture.desc, mip);
+        }
+
+        texture.alive = false;
+        freeIds.push_back(id);
+    }
+
+    void TextureStreamer::Request(StreamedTextureId id, float screenSize)
+    {
+        Texture& texture = textures[id];
+        if (texture.lastRequestFrame != frame || screenSize > texture.requestedSize)
+        {
+            texture.requestedSize = screenSize;
+            texture.requestedMip = ComputeRequiredMip(texture.desc, screenSize);
+            texture.lastRequestFrame = frame;
+        }
+    }
+
+    std::uint32_t TextureStreamer::GetResidentMip(StreamedTextureId id) const
+    {
+        return textures[id].residentMip;
+    }
+
+    std::uint32_t TextureStreamer::GetRequestedMip(StreamedTextureId id) const
+    {
+        return textures[id].requestedMip;
+    }
+
+    bool TextureStreamer::DropMip(StreamedTextureId id)
+    {
+        Texture& texture = textures[id];
+        if (texture.residentMip + 1 >= texture.desc.mipCount)
+            return false;
+
+        streamOut(id, texture.residentMip);
+        residentBytes -= GetMipSize(texture.desc, texture.residentMip);
+        ++texture.residentMip;
+        ++stats.droppedMips;
+        return true;
+    }
+
+    void TextureStreamer::DropExcessMips(std::size_t bytes, StreamedTextureId keep)
+    {
+        while (victimCursor < victims.size() && residentBytes + bytes > memoryBudget)
+        {
+            StreamedTextureId id = victims[victimCursor];
+            Texture& texture = textures[id];
+            if (id == keep || texture.residentMip >= texture.requestedMip)
+            {
+                ++victimCursor;
+                continue;
+            }
+
+            reclaimableBytes -= GetMipSize(texture.desc, texture.residentMip);
+            DropMip(id);
+        }
+    }
+
+    bool TextureStreamer::MakeRoom(std::size_t bytes, StreamedTextureId keep)
+    {
+        if (residentBytes + bytes <= memoryBudget)
+            return true;
+
+        // Don't drop anything unless it actually makes enough room.
+        if (residentBytes + bytes - memoryBudget > reclaimableBytes)
+            return false;
+
+        DropExcessMips(bytes, keep);
+        return residentBytes + bytes <= memoryBudget;
+    }
+
+    void TextureStreamer::Update()
+    {
+        stats = TextureStreamingStats();
+
+        // Textures not requested this frame only need their coarsest mip.
+        for (Texture& texture : textures)
+        {
+            if (texture.alive && texture.lastRequestFrame != frame)
+            {
+                texture.requestedMip = texture.desc.mipCount - 1;
+                texture.requestedSize = 0.0f;
+            }
+        }
+
+        std::vector<StreamedTextureId> candidates;
+        victims.clear();
+        victimCursor = 0;
+        reclaimableBytes = 0;
+
+        for (StreamedTextureId id = 0; id < textures.size(); ++id)
+        {
+            const Texture& texture = textures[id];
+            if (!texture.alive)
+                continue;
+
+            if (texture.residentMip > texture.requestedMip)
+                candidates.push_back(id);
+
+            for (std::uint32_t mip = texture.residentMip; mip < texture.requestedMip; ++mip)
+                reclaimableBytes += GetMipSize(texture.desc, mip);
+
+            if (texture.residentMip < texture.requestedMip)
+                victims.push_back(id);
+        }
+
+        // Most under-resolved and largest on screen first.
+        std::sort(candidates.begin(), candidates.end(), [this](StreamedTextureId a, StreamedTextureId b)
+        {
+            const Texture& textureA = textures[a];
+            const Texture& textureB = textures[b];
+            std::uint32_t deficitA = textureA.residentMip - textureA.requestedMip;
+            std::uint32_t deficitB = textureB.residentMip - textureB.requestedMip;
+            if (deficitA != deficitB)
+                return deficitA > deficitB;
+            return textureA.requestedSize > textureB.requestedSize;
+        });
+
+        // Least recently requested first.
+        std::sort(victims.begin(), victims.end(), [this](StreamedTextureId a, StreamedTextureId b)
+        {
+            return textures[a].lastRequestFrame < textures[b].lastRequestFrame;
+        });
+
+        // Stream one mip level per texture per pass so that budget is shared fairly.
+        bool progress = true;
+        while (progress)
+        {
+            progress = false;
+            for (StreamedTextureId id : candidates)
+            {
+                Texture& texture = textures[id];
+                if (texture.residentMip <= texture.requestedMip)
+                    continue;
+
+                std::uint32_t mip = texture.residentMip - 1;
+                std::size_t size = GetMipSize(texture.desc, mip);
+                if (stats.streamedInBytes + size > uploadBudgetPerFrame)
+                    continue;
+
+                if (!MakeRoom(size, id))
+                    continue;
+
+                if (!streamIn(id, mip))
+                    continue;
+
+                texture.residentMip = mip;
+                residentBytes += size;
+                stats.streamedInBytes += size;
+                ++stats.streamedInMips;
+                progress = true;
+            }
+        }
+
+        // The budget may have been lowered.
+        DropExcessMips(0, static_cast<StreamedTextureId>(textures.size()));
+
+        for (const Texture& texture : textures)
+        {
+            if (!texture.alive)
+                continue;
+
+            for (std::uint32_t mip = 0; mip < texture.desc.mipCount; ++mip)
+            {
+                std::size_t size = GetMipSize(texture.desc, mip);
+                stats.fullyResidentBytes += size;
+                if (mip >= texture.requestedMip)
+                    stats.requestedBytes += size;
+            }
+
+            if (texture.residentMip > texture.requestedMip)
+                ++stats.texturesBelowRequest;
+        }
+        stats.residentBytes = residentBytes;
+
+        ++frame;
+    }
+}
@@ -0,0 +1,270 @@
+#include <Engine/Graphics/Vulkan/VKDevice.hpp>
+
+#include <SDL2/SDL_error.h>
+#include <SDL2/SDL_loadso.h>
+#include <SDL2/SDL_vulkan.h>
+#include <iostream>
+#include <vector>
+
+namespace Engine::Graphics
+{
+    namespace
+    {
+#if defined(_WIN32)
+        constexpr const char* LoaderName = "vulkan-1.dll";
+#elif defined(__APPLE__)
+        constexpr const char* LoaderName = "libvulkan.1.dylib";
+#else
+        constexpr const char* LoaderName = "libvulkan.so.1";
+#endif
+
+        constexpr const char* ValidationLayer = "VK_LAYER_KHRONOS_validation";
+
+        int GetDeviceTypeScore(VkPhysicalDeviceType type)
+        {
+            switch (type)
+            {
+                case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU: return 4;
+                case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU: return 3;
+                case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU: return 2;
+                case VK_PHYSICAL_DEVICE_TYPE_CPU: return 1;
+                default: return 0;
+            }
+        }
+    }
+
+    std::unique_ptr<VKDevice> VKDevice::Create(SDL_Window* window, bool validation)
+    {
+        std::unique_ptr<VKDevice> device(new VKDevice(window));
+
+        PFN_vkGetInstanceProcAddr getInstanceProcAddr = nullptr;
+        if (window != nullptr)
+        {
+            if (SDL_Vulkan_LoadLibrary(nullptr) != 0)
+            {
+                std::cout << "Something went wrong loading the Vulkan library: " << SDL_GetError() << std::endl;
+                return nullptr;
+            }
+
+            device->sdlLoader = true;
+            getInstanceProcAddr = reinterpret_cast<PFN_vkGetInstanceProcAddr>(SDL_Vulkan_GetVkGetInstanceProcAddr());
+        }
+        else
+        {
+            device->loader = SDL_LoadObject(LoaderName);
+            if (device->loader == nullptr)
+            {
+                std::cout << "Something went wrong loading the Vulkan library: " << SDL_GetError() << std::endl;
+                return nullptr;
+            }
+
+            getInstanceProcAddr = reinterpret_cast<PFN_vkGetInstanceProcAddr>(SDL_LoadFunction(device->loader, "vkGetInstanceProcAddr"));
+        }
+
+        if (getInstanceProcAddr == nullptr || !device->functions.LoadGlobal(getInstanceProcAddr))
+            return nullptr;
+
+        if (!device->CreateInstance(validation) || !device->SelectPhysicalDevice() || !device->CreateDevice())
+            return nullptr;
+
+        return device;
+    }
+
+    VKDevice::VKDevice(SDL_Window* window) : window(window)
+    {
+    }
+
+    VKDevice::~VKDevice()
+    {
+        // Creation may have failed halfway through loading functions.
+        if (device != VK_NULL_HANDLE && functions.vkDestroyDevice != nullptr)
+        {
+            if (functions.vkDeviceWaitIdle != nullptr)
+                functions.vkDeviceWaitIdle(device);
+
+            functions.vkDestroyDevice(device, nullptr);
+        }
+
+        if (surface != VK_NULL_HANDLE && functions.vkDestroySurfaceKHR != nullptr)
+            functions.vkDestroySurfaceKHR(instance, surface, nullptr);
+
+        if (instance != VK_NULL_HANDLE && functions.vkDestroyInstance != nullptr)
+            functions.vkDestroyInstance(instance, nullptr);
+
+        if (loader != nullptr)
+            SDL_UnloadObject(loader);
+
+        if (sdlLoader)
+            SDL_Vulkan_UnloadLibrary();
+    }
+
+    std::uint32_t VKDevice::FindMemoryType(std::uint32_t typeBits, VkMemoryPropertyFlags flags) const
+    {
+        for (std::uint32_t i = 0; i < memoryProperties.memoryTypeCount; ++i)
+        {
+            if ((typeBits & (1u << i)) != 0 && (memoryProperties.memoryTypes[i].propertyFlags & flags) == flags)
+                return i;
+        }
+
+        return UINT32_MAX;
+    }
+
+    bool VKDevice::CreateInstance(bool validation)
+    {
+        std::vector<const char*> extensions;
+        if (window != nullptr)
+        {
+            unsigned int extensionCount = 0;
+            SDL_Vulkan_GetInstanceExtensions(window, &extensionCount, nullptr);
+            extensions.resize(extensionCount);
+            if (!SDL_Vulkan_GetInstanceExtensions(window, &extensionCount, extensions.data()))
+            {
+                std::cout << "Something went wrong getting the Vulkan instance extensions: " << SDL_GetError() << std::endl;
+                return false;
+            }
+        }
+
+        VkApplicationInfo applicationInfo = {};
+        applicationInfo.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+        applicationInfo.pApplicationName = "Engine";
+        applicationInfo.pEngineName = "Engine";
+        applicationInfo.apiVersion = VK_API_VERSION_1_2;
+
+        VkInstanceCreateInfo createInfo = {};
+        createInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+        createInfo.pApplicationInfo = &applicationInfo;
+        createInfo.enabledExtensionCount = static_cast<std::uint32_t>(extensions.size());
+        createInfo.ppEnabledExtensionNames = extensions.data();
+        createInfo.enabledLayerCount = validation ? 1 : 0;
+        createInfo.ppEnabledLayerNames = &ValidationLayer;
+
+        VkResult result = functions.vkCreateInstance(&createInfo, nullptr, &instance);
+        if (result == VK_ERROR_LAYER_NOT_PRESENT)
+        {
+            std::cout << "The Vulkan validation layer is not installed, continuing without it." << std::endl;
+            createInfo.enabledLayerCount = 0;
+            result = functions.vkCreateInstance(&createInfo, nullptr, &instance);
+        }
+
+        if (result != VK_SUCCESS)
+        {
+            std::cout << "Something went wrong creating a Vulkan instance (" << result << ")." << std::endl;
+            instance = VK_NULL_HANDLE;
+            return false;
+        }
+
+        if (!functions.LoadInstance(instance, window != nullptr))
+            return false;
+
+        if (window != nullptr && !SDL_Vulkan_CreateSurface(window, instance, &surface))
+        {
+            std::cout << "Something went wrong creating a Vulkan surface: " << SDL_GetError() << std::endl;
+            surface = VK_NULL_HANDLE;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool VKDevice::SelectPhysicalDevice()
+    {
+        std::uint32_t deviceCount = 0;
+        functions.vkEnumeratePhysicalDevices(instance, &deviceCount, nullptr);
+        std::vector<VkPhysicalDevice> devices(deviceCount);
+        functions.vkEnumeratePhysicalDevices(instance, &deviceCount, devices.data());
+
+        int bestScore = 0;
+        for (VkPhysicalDevice candidate : devices)
+        {
+            VkPhysicalDeviceProperties candidateProperties;
+            functions.vkGetPhysicalDeviceProperties(candidate, &candidateProperties);
+            if (candidateProperties.apiVersion < VK_API_VERSION_1_2)
+                continue;
+
+            VkPhysicalDeviceVulkan12Features features12 = {};
+            features12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+            VkPhysicalDeviceFeatures2 features = {};
+            features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+            features.pNext = &features12;
+            functions.vkGetPhysicalDeviceFeatures2(candidate, &features);
+            if (features12.timelineSemaphore != VK_TRUE)
+                continue;
+
+            std::uint32_t familyCount = 0;
+            functions.vkGetPhysicalDeviceQueueFamilyProperties(candidate, &familyCount, nullptr);
+            std::vector<VkQueueFamilyProperties> families(familyCount);
+            functions.vkGetPhysicalDeviceQueueFamilyProperties(candidate, &familyCount, families.data());
+
+            for (std::uint32_t family = 0; family < familyCount; ++family)
+            {
+                if ((families[family].queueFlags & VK_QUEUE_GRAPHICS_BIT) == 0)
+                    continue;
+
+                VkBool32 presentable = VK_TRUE;
+                if (surface != VK_NULL_HANDLE)
+                    functions.vkGetPhysicalDeviceSurfaceSupportKHR(candidate, family, surface, &presentable);
+
+                if (presentable != VK_TRUE)
+                    continue;
+
+                int score = GetDeviceTypeScore(candidateProperties.deviceType) + 1;
+                if (score > bestScore)
+                {
+                    bestScore = score;
+                    physicalDevice = candidate;
+                    properties = candidateProperties;
+                    queueFamily = family;
+                }
+
+                break;
+            }
+        }
+
+        if (physicalDevice == VK_NULL_HANDLE)
+        {
+            std::cout << "No Vulkan 1.2 device with timeline semaphores and a graphics queue was found." << std::endl;
+            return false;
+        }
+
+        functions.vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memoryProperties);
+        return true;
+    }
+
+    bool VKDevice::CreateDevice()
+    {
+        float priority = 1.0f;
+        VkDeviceQueueCreateInfo queueInfo = {};
+        queueInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+        queueInfo.queueFamilyIndex = queueFamily;
+        queueInfo.queueCount = 1;
+        queueInfo.pQueuePriorities = &priority;
+
+        VkPhysicalDeviceVulkan12Features features12 = {};
+        features12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+        features12.timelineSemaphore = VK_TRUE;
+
+        const char* swapchainExtension = VK_KHR_SWAPCHAIN_EXTENSION_NAME;
+
+        VkDeviceCreateInfo createInfo = {};
+        createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+        createInfo.pNext = &features12;
+        createInfo.queueCreateInfoCount = 1;
+        createInfo.pQueueCreateInfos = &queueInfo;
+        createInfo.enabledExtensionCount = surface != VK_NULL_HANDLE ? 1 : 0;
+        createInfo.ppEnabledExtensionNames = &swapchainExtension;
+
+        VkResult result = functions.vkCreateDevice(physicalDevice, &createInfo, nullptr, &device);
+        if (result != VK_SUCCESS)
+        {
+            std::cout << "Something went wrong creating a Vulkan device (" << result << ")." << std::endl;
+            device = VK_NULL_HANDLE;
+            return false;
+        }
+
+        if (!functions.LoadDevice(device, surface != VK_NULL_HANDLE))
+            return false;
+
+        functions.vkGetDeviceQueue(device, queueFamily, 0, &queue);
+        return true;
+    }
+}
@@ -0,0 +1,280 @@
+#include <Engine/Graphics/Vulkan/VKFrameScheduler.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <iterator>
+
+namespace Engine::Graphics
+{
+    namespace
+    {
+        constexpr std::uint32_t DescriptorSetsPerPool = 256;
+
+        std::uint64_t GetNanosecondsSince(std::chrono::steady_clock::time_point start)
+        {
+            auto duration = std::chrono::steady_clock::now() - start;
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+        }
+    }
+
+    VkDescriptorSet VKRecordContext::AllocateDescriptorSet(VkDescriptorSetLayout layout)
+    {
+        VKFrameScheduler::WorkerFrame& workerFrame = scheduler.GetWorkerFrame(worker);
+
+        VkDescriptorSetAllocateInfo allocateInfo = {};
+        allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocateInfo.descriptorSetCount = 1;
+        allocateInfo.pSetLayouts = &layout;
+
+        // Move on to the next pool when one runs out, a fresh pool failing means the layout can't fit.
+        while (true)
+        {
+            bool freshPool = workerFrame.currentDescriptorPool == workerFrame.descriptorPools.size();
+            if (freshPool)
+                workerFrame.descriptorPools.push_back(scheduler.CreateDescriptorPool());
+
+            allocateInfo.descriptorPool = workerFrame.descriptorPools[workerFrame.currentDescriptorPool];
+
+            VkDescriptorSet set = VK_NULL_HANDLE;
+            VkResult result = scheduler.vk.vkAllocateDescriptorSets(scheduler.device.GetDevice(), &allocateInfo, &set);
+            if (result == VK_SUCCESS)
+            {
+                ++workerFrame.descriptorSets;
+                return set;
+            }
+
+            if (freshPool || (result != VK_ERROR_OUT_OF_POOL_MEMORY && result != VK_ERROR_FRAGMENTED_POOL))
+            {
+                std::cout << "Something went wrong allocating a Vulkan descriptor set (" << result << ")." << std::endl;
+                return VK_NULL_HANDLE;
+            }
+
+            ++workerFrame.currentDescriptorPool;
+        }
+    }
+
+    VKUniformAllocation VKRecordContext::AllocateUniforms(std::size_t size)
+    {
+        return scheduler.uniformRing.Allocate(size);
+    }
+
+    VKFrameScheduler::VKFrameScheduler(VKDevice& device, std::uint32_t workerCount, std::uint32_t framesInFlight,
+                                       std::size_t uniformBytesPerFrame)
+        : device(device), vk(device.GetFunctions()), workerCount(workerCount), framesInFlight(framesInFlight),
+          uniformRing(device, uniformBytesPerFrame, framesInFlight), workers(workerCount)
+    {
+        this->workerCount = static_cast<std::uint32_t>(workers.GetThreadCount());
+
+        VkSemaphoreTypeCreateInfo typeInfo = {};
+        typeInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+        typeInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+        typeInfo.initialValue = 0;
+
+        VkSemaphoreCreateInfo semaphoreInfo = {};
+        semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        semaphoreInfo.pNext = &typeInfo;
+        vk.vkCreateSemaphore(device.GetDevice(), &semaphoreInfo, nullptr, &timeline);
+
+        VkCommandPoolCreateInfo poolInfo = {};
+        poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+        poolInfo.queueFamilyIndex = device.GetQueueFamily();
+
+        workerFrames.resize(framesInFlight * this->workerCount);
+        for (WorkerFrame& workerFrame : workerFrames)
+            vk.vkCreateCommandPool(device.GetDevice(), &poolInfo, nullptr, &workerFrame.commandPool);
+    }
+
+    VKFrameScheduler::~VKFrameScheduler()
+    {
+        WaitIdle();
+
+        for (WorkerFrame& workerFrame : workerFrames)
+        {
+            vk.vkDestroyCommandPool(device.GetDevice(), workerFrame.commandPool, nullptr);
+            for (VkDescriptorPool pool : workerFrame.descriptorPools)
+                vk.vkDestroyDescriptorPool(device.GetDevice(), pool, nullptr);
+        }
+
+        vk.vkDestroySemaphore(device.GetDevice(), timeline, nullptr);
+    }
+
+    void VKFrameScheduler::BeginFrame()
+    {
+        ++frameNumber;
+        stats = VKFrameStats();
+
+        // The previous user of this frame's resources. If its submit failed its value is never signalled,
+        // and the last frame that was submitted is what the GPU may still be using.
+        auto start = std::chrono::steady_clock::now();
+        if (frameNumber > framesInFlight)
+            WaitForTimeline(std::min(frameNumber - framesInFlight, submittedFrame));
+        stats.waitNanoseconds = GetNanosecondsSince(start);
+
+        for (std::uint32_t worker = 0; worker < workerCount; ++worker)
+        {
+            WorkerFrame& workerFrame = GetWorkerFrame(worker);
+            vk.vkResetCommandPool(device.GetDevice(), workerFrame.commandPool, 0);
+            workerFrame.usedCommandBuffers = 0;
+
+            for (std::uint32_t i = 0; i < workerFrame.currentDescriptorPool + 1 && i < workerFrame.descriptorPools.size(); ++i)
+                vk.vkResetDescriptorPool(device.GetDevice(), workerFrame.descriptorPools[i], 0);
+            workerFrame.currentDescriptorPool = 0;
+            workerFrame.descriptorSets = 0;
+        }
+
+        uniformRing.BeginFrame(GetFrameIndex());
+        submitList.clear();
+    }
+
+    void VKFrameScheduler::Record(std::uint32_t taskCount, const RecordFunction& record)
+    {
+        if (taskCount == 0)
+            return;
+
+        auto start = std::chrono::steady_clock::now();
+
+        std::size_t firstBuffer = submitList.size();
+        submitList.resize(firstBuffer + taskCount);
+
+        // Contiguous chunks, one per worker, so a worker's pool is only ever used by one thread at a time.
+        std::uint32_t chunkCount = std::min(taskCount, workerCount);
+        auto recordChunk = [this, &record, taskCount, chunkCount, firstBuffer](std::uint32_t chunk)
+        {
+            WorkerFrame& workerFrame = GetWorkerFrame(chunk);
+
+            VkCommandBufferBeginInfo beginInfo = {};
+            beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+            beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+            std::uint32_t begin = static_cast<std::uint32_t>(std::uint64_t(taskCount) * chunk / chunkCount);
+            std::uint32_t end = static_cast<std::uint32_t>(std::uint64_t(taskCount) * (chunk + 1) / chunkCount);
+            for (std::uint32_t task = begin; task < end; ++task)
+            {
+                VkCommandBuffer commandBuffer = AcquireCommandBuffer(workerFrame);
+                vk.vkBeginCommandBuffer(commandBuffer, &beginInfo);
+
+                VKRecordContext context(*this, chunk, commandBuffer);
+                record(context, task);
+
+                vk.vkEndCommandBuffer(commandBuffer);
+                submitList[firstBuffer + task] = commandBuffer;
+            }
+        };
+
+        // The calling thread takes the first chunk instead of idling.
+        for (std::uint32_t chunk = 1; chunk < chunkCount; ++chunk)
+            workers.Submit([&recordChunk, chunk] { recordChunk(chunk); });
+
+        recordChunk(0);
+        workers.Wait();
+
+        stats.recordNanoseconds += GetNanosecondsSince(start);
+    }
+
+    void VKFrameScheduler::Submit(VkSemaphore waitSemaphore, VkPipelineStageFlags waitStage, VkSemaphore signalSemaphore)
+    {
+        auto start = std::chrono::steady_clock::now();
+
+        // Binary semaphores ignore their value.
+        VkSemaphore signalSemaphores[2] = { timeline, signalSemaphore };
+        std::uint64_t signalValues[2] = { frameNumber, 0 };
+        std::uint64_t waitValue = 0;
+
+        VkTimelineSemaphoreSubmitInfo timelineInfo = {};
+        timelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+        timelineInfo.waitSemaphoreValueCount = waitSemaphore != VK_NULL_HANDLE ? 1 : 0;
+        timelineInfo.pWaitSemaphoreValues = &waitValue;
+        timelineInfo.signalSemaphoreValueCount = signalSemaphore != VK_NULL_HANDLE ? 2 : 1;
+        timelineInfo.pSignalSemaphoreValues = signalValues;
+
+        VkSubmitInfo submitInfo = {};
+        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.pNext = &timelineInfo;
+        submitInfo.waitSemaphoreCount = timelineInfo.waitSemaphoreValueCount;
+        submitInfo.pWaitSemaphores = &waitSemaphore;
+        submitInfo.pWaitDstStageMask = &waitStage;
+        submitInfo.commandBufferCount = static_cast<std::uint32_t>(submitList.size());
+        submitInfo.pCommandBuffers = submitList.data();
+        submitInfo.signalSemaphoreCount = timelineInfo.signalSemaphoreValueCount;
+        submitInfo.pSignalSemaphores = signalSemaphores;
+
+        VkResult result = vk.vkQueueSubmit(device.GetQueue(), 1, &submitInfo, VK_NULL_HANDLE);
+        if (result != VK_SUCCESS)
+            std::cout << "Something went wrong submitting frame " << frameNumber << " (" << result << ")." << std::endl;
+        else
+            submittedFrame = frameNumber;
+
+        stats.submitNanoseconds = GetNanosecondsSince(start);
+        stats.commandBuffers = static_cast<std::uint32_t>(submitList.size());
+        for (std::uint32_t worker = 0; worker < workerCount; ++worker)
+            stats.descriptorSets += GetWorkerFrame(worker).descriptorSets;
+    }
+
+    void VKFrameScheduler::WaitIdle()
+    {
+        WaitForTimeline(submittedFrame);
+    }
+
+    VKFrameScheduler::WorkerFrame& VKFrameScheduler::GetWorkerFrame(std::uint32_t worker)
+    {
+        return workerFrames[GetFrameIndex() * workerCount + worker];
+    }
+
+    VkCommandBuffer VKFrameScheduler::AcquireCommandBuffer(WorkerFrame& workerFrame)
+    {
+        if (workerFrame.usedCommandBuffers == workerFrame.commandBuffers.size())
+        {
+            VkCommandBufferAllocateInfo allocateInfo = {};
+            allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+            allocateInfo.commandPool = workerFrame.commandPool;
+            allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+            allocateInfo.commandBufferCount = 1;
+
+            VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+            vk.vkAllocateCommandBuffers(device.GetDevice(), &allocateInfo, &commandBuffer);
+            workerFrame.commandBuffers.push_back(commandBuffer);
+        }
+
+        return workerFrame.commandBuffers[workerFrame.usedCommandBuffers++];
+    }
+
+    VkDescriptorPool VKFrameScheduler::CreateDescriptorPool()
+    {
+        VkDescriptorPoolSize sizes[] =
+        {
+            { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, DescriptorSetsPerPool },
+            { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, DescriptorSetsPerPool },
+            { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, DescriptorSetsPerPool },
+            { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, DescriptorSetsPerPool * 4 },
+            { VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, DescriptorSetsPerPool * 4 },
+            { VK_DESCRIPTOR_TYPE_SAMPLER, DescriptorSetsPerPool }
+        };
+
+        VkDescriptorPoolCreateInfo poolInfo = {};
+        poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.maxSets = DescriptorSetsPerPool;
+        poolInfo.poolSizeCount = static_cast<std::uint32_t>(std::size(sizes));
+        poolInfo.pPoolSizes = sizes;
+
+        VkDescriptorPool pool = VK_NULL_HANDLE;
+        vk.vkCreateDescriptorPool(device.GetDevice(), &poolInfo, nullptr, &pool);
+        return pool;
+    }
+
+    void VKFrameScheduler::WaitForTimeline(std::uint64_t value)
+    {
+        if (value == 0)
+            return;
+
+        VkSemaphoreWaitInfo waitInfo = {};
+        waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+        waitInfo.semaphoreCount = 1;
+        waitInfo.pSemaphores = &timeline;
+        waitInfo.pValues = &value;
+        VkResult result = vk.vkWaitSemaphores(device.GetDevice(), &waitInfo, UINT64_MAX);
+        if (result != VK_SUCCESS)
+            std::cout << "Something went wrong waiting for frame " << value << " (" << result << ")." << std::endl;
+    }
+}
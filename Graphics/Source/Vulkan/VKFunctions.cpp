@@ -0,0 +1,65 @@
+#include <Engine/Graphics/Vulkan/VKFunctions.hpp>
+
+#include <iostream>
+
+namespace Engine::Graphics
+{
+    namespace
+    {
+        template<typename Function, typename Loader>
+        void Load(Function& function, const char* name, Loader&& loader, bool& complete)
+        {
+            function = reinterpret_cast<Function>(loader(name));
+            if (function == nullptr)
+            {
+                std::cout << "Missing Vulkan function \"" << name << "\"." << std::endl;
+                complete = false;
+            }
+        }
+    }
+
+    bool VKFunctions::LoadGlobal(PFN_vkGetInstanceProcAddr getInstanceProcAddr)
+    {
+        bool complete = true;
+        vkGetInstanceProcAddr = getInstanceProcAddr;
+
+        auto loader = [&](const char* name) { return vkGetInstanceProcAddr(VK_NULL_HANDLE, name); };
+#define ENGINE_VK_LOAD(Name) Load(Name, #Name, loader, complete);
+        ENGINE_VK_GLOBAL_FUNCTIONS(ENGINE_VK_LOAD)
+#undef ENGINE_VK_LOAD
+
+        return complete;
+    }
+
+    bool VKFunctions::LoadInstance(VkInstance instance, bool surface)
+    {
+        bool complete = true;
+
+        auto loader = [&](const char* name) { return vkGetInstanceProcAddr(instance, name); };
+#define ENGINE_VK_LOAD(Name) Load(Name, #Name, loader, complete);
+        ENGINE_VK_INSTANCE_FUNCTIONS(ENGINE_VK_LOAD)
+        if (surface)
+        {
+            ENGINE_VK_SURFACE_FUNCTIONS(ENGINE_VK_LOAD)
+        }
+#undef ENGINE_VK_LOAD
+
+        return complete;
+    }
+
+    bool VKFunctions::LoadDevice(VkDevice device, bool swapchain)
+    {
+        bool complete = true;
+
+        auto loader = [&](const char* name) { return vkGetDeviceProcAddr(device, name); };
+#define ENGINE_VK_LOAD(Name) Load(Name, #Name, loader, complete);
+        ENGINE_VK_DEVICE_FUNCTIONS(ENGINE_VK_LOAD)
+        if (swapchain)
+        {
+            ENGINE_VK_SWAPCHAIN_FUNCTIONS(ENGINE_VK_LOAD)
+        }
+#undef ENGINE_VK_LOAD
+
+        return complete;
+    }
+}
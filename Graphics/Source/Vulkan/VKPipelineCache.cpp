@@ -0,0 +1,86 @@
+#include <Engine/Graphics/Vulkan/VKPipelineCache.hpp>
+
+#include <Engine/Core/AtomicFile.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+namespace Engine::Graphics
+{
+    namespace
+    {
+        // Layout of `VkPipelineCacheHeaderVersionOne`, read field by field to not depend on padding.
+        bool IsCompatible(const std::vector<char>& data, const VkPhysicalDeviceProperties& properties)
+        {
+            constexpr std::size_t HeaderSize = 16 + VK_UUID_SIZE;
+            if (data.size() < HeaderSize)
+                return false;
+
+            std::uint32_t header[4];
+            std::memcpy(header, data.data(), sizeof(header));
+
+            return header[0] >= HeaderSize &&
+                   header[1] == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+                   header[2] == properties.vendorID &&
+                   header[3] == properties.deviceID &&
+                   std::memcmp(data.data() + 16, properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+        }
+    }
+
+    VKPipelineCache::VKPipelineCache(const VKDevice& device, std::string path) : device(device), path(std::move(path))
+    {
+        std::vector<char> data;
+        {
+            std::ifstream file(this->path, std::ios::binary);
+            if (file)
+                data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        }
+
+        if (!data.empty() && !IsCompatible(data, device.GetProperties()))
+        {
+            rejected = true;
+            data.clear();
+        }
+
+        VkPipelineCacheCreateInfo createInfo = {};
+        createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+        createInfo.initialDataSize = data.size();
+        createInfo.pInitialData = data.data();
+
+        const VKFunctions& vk = device.GetFunctions();
+        if (vk.vkCreatePipelineCache(device.GetDevice(), &createInfo, nullptr, &cache) != VK_SUCCESS)
+        {
+            // Drivers may still refuse data they consider stale, start over without it.
+            rejected = true;
+            createInfo.initialDataSize = 0;
+            createInfo.pInitialData = nullptr;
+            vk.vkCreatePipelineCache(device.GetDevice(), &createInfo, nullptr, &cache);
+        }
+        else
+        {
+            loadedBytes = data.size();
+        }
+    }
+
+    VKPipelineCache::~VKPipelineCache()
+    {
+        device.GetFunctions().vkDestroyPipelineCache(device.GetDevice(), cache, nullptr);
+    }
+
+    bool VKPipelineCache::Save() const
+    {
+        const VKFunctions& vk = device.GetFunctions();
+
+        std::size_t size = 0;
+        if (vk.vkGetPipelineCacheData(device.GetDevice(), cache, &size, nullptr) != VK_SUCCESS)
+            return false;
+
+        std::vector<char> data(size);
+        if (vk.vkGetPipelineCacheData(device.GetDevice(), cache, &size, data.data()) != VK_SUCCESS)
+            return false;
+
+        return Core::WriteFileAtomically(path, data.data(), size);
+    }
+}
@@ -0,0 +1,217 @@
+#include <Engine/Graphics/Vulkan/VKSwapchain.hpp>
+
+#include <SDL2/SDL_vulkan.h>
+#include <algorithm>
+#include <iostream>
+
+namespace Engine::Graphics
+{
+    namespace
+    {
+        VkSemaphore CreateSemaphore(const VKDevice& device)
+        {
+            VkSemaphoreCreateInfo createInfo = {};
+            createInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+            VkSemaphore semaphore = VK_NULL_HANDLE;
+            device.GetFunctions().vkCreateSemaphore(device.GetDevice(), &createInfo, nullptr, &semaphore);
+            return semaphore;
+        }
+    }
+
+    VKSwapchain::VKSwapchain(const VKDevice& device, std::uint32_t framesInFlight, bool vsync)
+        : device(device), vsync(vsync)
+    {
+        for (std::uint32_t i = 0; i < framesInFlight; ++i)
+            acquireSemaphores.push_back(CreateSemaphore(device));
+
+        Create();
+    }
+
+    VKSwapchain::~VKSwapchain()
+    {
+        const VKFunctions& vk = device.GetFunctions();
+        vk.vkDeviceWaitIdle(device.GetDevice());
+
+        DestroyImages();
+        vk.vkDestroySwapchainKHR(device.GetDevice(), swapchain, nullptr);
+
+        for (VkSemaphore semaphore : acquireSemaphores)
+            vk.vkDestroySemaphore(device.GetDevice(), semaphore, nullptr);
+    }
+
+    bool VKSwapchain::Acquire(std::uint32_t frame)
+    {
+        frameIndex = frame;
+
+        VkResult result = device.GetFunctions().vkAcquireNextImageKHR(device.GetDevice(), swapchain, UINT64_MAX,
+                                                                      acquireSemaphores[frameIndex], VK_NULL_HANDLE, &imageIndex);
+        if (result == VK_ERROR_OUT_OF_DATE_KHR)
+        {
+            Recreate();
+            return false;
+        }
+
+        return result == VK_SUCCESS || result == VK_SUBOPTIMAL_KHR;
+    }
+
+    bool VKSwapchain::Present()
+    {
+        VkPresentInfoKHR presentInfo = {};
+        presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+        presentInfo.waitSemaphoreCount = 1;
+        presentInfo.pWaitSemaphores = &presentSemaphores[imageIndex];
+        presentInfo.swapchainCount = 1;
+        presentInfo.pSwapchains = &swapchain;
+        presentInfo.pImageIndices = &imageIndex;
+
+        VkResult result = device.GetFunctions().vkQueuePresentKHR(device.GetQueue(), &presentInfo);
+        if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR)
+        {
+            Recreate();
+            return false;
+        }
+
+        return result == VK_SUCCESS;
+    }
+
+    void VKSwapchain::Recreate()
+    {
+        device.GetFunctions().vkDeviceWaitIdle(device.GetDevice());
+        DestroyImages();
+        Create();
+    }
+
+    void VKSwapchain::Create()
+    {
+        const VKFunctions& vk = device.GetFunctions();
+        VkPhysicalDevice physicalDevice = device.GetPhysicalDevice();
+        VkSurfaceKHR surface = device.GetSurface();
+
+        VkSurfaceCapabilitiesKHR capabilities;
+        vk.vkGetPhysicalDeviceSurfaceCapabilitiesKHR(physicalDevice, surface, &capabilities);
+
+        std::uint32_t formatCount = 0;
+        vk.vkGetPhysicalDeviceSurfaceFormatsKHR(physicalDevice, surface, &formatCount, nullptr);
+        std::vector<VkSurfaceFormatKHR> formats(formatCount);
+        vk.vkGetPhysicalDeviceSurfaceFormatsKHR(physicalDevice, surface, &formatCount, formats.data());
+
+        std::uint32_t modeCount = 0;
+        vk.vkGetPhysicalDeviceSurfacePresentModesKHR(physicalDevice, surface, &modeCount, nullptr);
+        std::vector<VkPresentModeKHR> modes(modeCount);
+        vk.vkGetPhysicalDeviceSurfacePresentModesKHR(physicalDevice, surface, &modeCount, modes.data());
+
+        if (formats.empty())
+        {
+            std::cout << "The Vulkan surface has no formats." << std::endl;
+            return;
+        }
+
+        // Prefer an sRGB format, otherwise take what the surface lists first.
+        VkSurfaceFormatKHR surfaceFormat = formats[0];
+        for (const VkSurfaceFormatKHR& candidate : formats)
+        {
+            if (candidate.format == VK_FORMAT_B8G8R8A8_SRGB || candidate.format == VK_FORMAT_R8G8B8A8_SRGB)
+            {
+                surfaceFormat = candidate;
+                break;
+            }
+        }
+
+        // FIFO is always supported.
+        VkPresentModeKHR presentMode = VK_PRESENT_MODE_FIFO_KHR;
+        if (!vsync)
+        {
+            for (VkPresentModeKHR preferred : { VK_PRESENT_MODE_MAILBOX_KHR, VK_PRESENT_MODE_IMMEDIATE_KHR })
+            {
+                if (std::find(modes.begin(), modes.end(), preferred) != modes.end())
+                {
+                    presentMode = preferred;
+                    break;
+                }
+            }
+        }
+
+        extent = capabilities.currentExtent;
+        if (extent.width == UINT32_MAX)
+        {
+            int width = 0;
+            int height = 0;
+            SDL_Vulkan_GetDrawableSize(device.GetWindow(), &width, &height);
+            extent.width = std::clamp<std::uint32_t>(width, capabilities.minImageExtent.width, capabilities.maxImageExtent.width);
+            extent.height = std::clamp<std::uint32_t>(height, capabilities.minImageExtent.height, capabilities.maxImageExtent.height);
+        }
+
+        // Minimized, there is nothing to present to.
+        if (extent.width == 0 || extent.height == 0)
+            return;
+
+        std::uint32_t imageCount = capabilities.minImageCount + 1;
+        if (capabilities.maxImageCount > 0)
+            imageCount = std::min(imageCount, capabilities.maxImageCount);
+
+        VkSwapchainKHR oldSwapchain = swapchain;
+
+        VkSwapchainCreateInfoKHR createInfo = {};
+        createInfo.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
+        createInfo.surface = surface;
+        createInfo.minImageCount = imageCount;
+        createInfo.imageFormat = surfaceFormat.format;
+        createInfo.imageColorSpace = surfaceFormat.colorSpace;
+        createInfo.imageExtent = extent;
+        createInfo.imageArrayLayers = 1;
+        createInfo.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+        createInfo.imageSharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        createInfo.preTransform = capabilities.currentTransform;
+        createInfo.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
+        createInfo.presentMode = presentMode;
+        createInfo.clipped = VK_TRUE;
+        createInfo.oldSwapchain = oldSwapchain;
+
+        VkResult result = vk.vkCreateSwapchainKHR(device.GetDevice(), &createInfo, nullptr, &swapchain);
+        vk.vkDestroySwapchainKHR(device.GetDevice(), oldSwapchain, nullptr);
+        if (result != VK_SUCCESS)
+        {
+            std::cout << "Something went wrong creating a Vulkan swapchain (" << result << ")." << std::endl;
+            swapchain = VK_NULL_HANDLE;
+            return;
+        }
+
+        format = surfaceFormat.format;
+
+        vk.vkGetSwapchainImagesKHR(device.GetDevice(), swapchain, &imageCount, nullptr);
+        images.resize(imageCount);
+        vk.vkGetSwapchainImagesKHR(device.GetDevice(), swapchain, &imageCount, images.data());
+
+        for (VkImage image : images)
+        {
+            VkImageViewCreateInfo viewInfo = {};
+            viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+            viewInfo.image = image;
+            viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+            viewInfo.format = format;
+            viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            viewInfo.subresourceRange.levelCount = 1;
+            viewInfo.subresourceRange.layerCount = 1;
+
+            VkImageView view = VK_NULL_HANDLE;
+            vk.vkCreateImageView(device.GetDevice(), &viewInfo, nullptr, &view);
+            imageViews.push_back(view);
+            presentSemaphores.push_back(CreateSemaphore(device));
+        }
+    }
+
+    void VKSwapchain::DestroyImages()
+    {
+        const VKFunctions& vk = device.GetFunctions();
+
+        for (VkImageView view : imageViews)
+            vk.vkDestroyImageView(device.GetDevice(), view, nullptr);
+        for (VkSemaphore semaphore : presentSemaphores)
+            vk.vkDestroySemaphore(device.GetDevice(), semaphore, nullptr);
+
+        imageViews.clear();
+        presentSemaphores.clear();
+        images.clear();
+    }
+}
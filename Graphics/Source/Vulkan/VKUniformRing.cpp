@@ -0,0 +1,83 @@
+#include <Engine/Graphics/Vulkan/VKUniformRing.hpp>
+
+#include <algorithm>
+#include <iostream>
+
+namespace Engine::Graphics
+{
+    VKUniformRing::VKUniformRing(const VKDevice& device, std::size_t frameSize, std::uint32_t frameCount)
+        : device(device)
+    {
+        const VKFunctions& vk = device.GetFunctions();
+        const VkPhysicalDeviceLimits& limits = device.GetProperties().limits;
+
+        alignment = static_cast<std::size_t>(std::max(limits.minUniformBufferOffsetAlignment, limits.minStorageBufferOffsetAlignment));
+        this->frameSize = (frameSize + alignment - 1) & ~(alignment - 1);
+        descriptorRange = std::min<std::size_t>(limits.maxUniformBufferRange, 65536);
+
+        VkBufferCreateInfo bufferInfo = {};
+        bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bufferInfo.size = this->frameSize * frameCount;
+        bufferInfo.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+        bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        if (vk.vkCreateBuffer(device.GetDevice(), &bufferInfo, nullptr, &buffer) != VK_SUCCESS)
+        {
+            std::cout << "Something went wrong creating a Vulkan uniform ring of " << bufferInfo.size << " bytes." << std::endl;
+            buffer = VK_NULL_HANDLE;
+            return;
+        }
+
+        VkMemoryRequirements requirements;
+        vk.vkGetBufferMemoryRequirements(device.GetDevice(), buffer, &requirements);
+
+        VkMemoryAllocateInfo allocateInfo = {};
+        allocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        allocateInfo.allocationSize = requirements.size;
+        allocateInfo.memoryTypeIndex = device.FindMemoryType(requirements.memoryTypeBits,
+                                                             VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+        void* mapped = nullptr;
+        if (allocateInfo.memoryTypeIndex == UINT32_MAX ||
+            vk.vkAllocateMemory(device.GetDevice(), &allocateInfo, nullptr, &memory) != VK_SUCCESS ||
+            vk.vkBindBufferMemory(device.GetDevice(), buffer, memory, 0) != VK_SUCCESS ||
+            vk.vkMapMemory(device.GetDevice(), memory, 0, VK_WHOLE_SIZE, 0, &mapped) != VK_SUCCESS)
+        {
+            std::cout << "Something went wrong allocating host visible memory for a Vulkan uniform ring." << std::endl;
+            return;
+        }
+
+        mapping = static_cast<unsigned char*>(mapped);
+    }
+
+    VKUniformRing::~VKUniformRing()
+    {
+        const VKFunctions& vk = device.GetFunctions();
+
+        // Freeing the memory unmaps it.
+        vk.vkDestroyBuffer(device.GetDevice(), buffer, nullptr);
+        vk.vkFreeMemory(device.GetDevice(), memory, nullptr);
+    }
+
+    void VKUniformRing::BeginFrame(std::uint32_t frameIndex)
+    {
+        frameStart = frameIndex * frameSize;
+        frameOffset.store(0, std::memory_order_relaxed);
+    }
+
+    VKUniformAllocation VKUniformRing::Allocate(std::size_t size)
+    {
+        VKUniformAllocation allocation;
+
+        // Rounding the size keeps the next allocation aligned without a compare-exchange loop.
+        std::size_t alignedSize = (size + alignment - 1) & ~(alignment - 1);
+        std::size_t offset = frameOffset.fetch_add(alignedSize, std::memory_order_relaxed);
+        if (mapping == nullptr || offset + size > frameSize)
+            return allocation;
+
+        allocation.data = mapping + frameStart + offset;
+        allocation.buffer = buffer;
+        allocation.offset = static_cast<std::uint32_t>(frameStart + offset);
+        return allocation;
+    }
+}
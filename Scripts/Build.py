@@ -1,5 +1,8 @@
 import argparse
+import glob
 import platform
+import re
+import shutil
 import sys
 import subprocess
 import os
@@ -11,26 +14,125 @@ if (SystemName != "Windows" and SystemName != "Linux" and SystemName != "Darwin"
 
 parser = argparse.ArgumentParser("Build")
 parser.add_argument("Arch", choices = ["x64", "ARM64"], help = "Target architecture, must match architecture of host machine.")
-parser.add_argument("BuildType", choices = ["Debug", "Release", "RelWithDebInfo", "MinSizeRel"], help = "Build type.")
+parser.add_argument("BuildType", choices = ["Debug", "Release", "RelWithDebInfo", "MinSizeRel", "Release-PGO"], help = "Build type. \"Release-PGO\" is a Release build with link-time and profile-guided optimization, trained on the benchmark scene.")
+parser.add_argument("--benchmark-frames", type = int, default = 600, help = "Frames of the benchmark scene to train and measure \"Release-PGO\" with.")
+parser.add_argument("--run-benchmarks", action = "store_true", help = "Run the Benchmarks after building and write the results to \"Benchmarks.json\" in the build directory.")
+parser.add_argument("--benchmark-filter", default = "", help = "Only run benchmarks whose name contains this.")
+parser.add_argument("--benchmark-baseline", default = "", help = "Results of an earlier run to compare against, fails on significant regressions. Implies --run-benchmarks.")
 args = parser.parse_args()
 
 CMakeSourceDir = "."
-CMakeBuildDir = os.path.join(".", "Build", SystemName, args.Arch, args.BuildType)
 
 # We specify both `CMAKE_BUILD_TYPE` for single-configuration generators (Make, Ninja, ...)
 # and `--config` for multi-configuration generators (Visual Studio, ...).
 # Not sure if it's required to specify both but we just do it.
-CMakeGenerateCommand = "cmake -S\"" + CMakeSourceDir + "\" -B\"" + CMakeBuildDir + "\" -DARCH=" + args.Arch + " -DBUILD_TYPE=" + args.BuildType + " -DCMAKE_BUILD_TYPE=" + args.BuildType
-CMakeBuildCommand = "cmake --build \"" + CMakeBuildDir + "\" --config " + args.BuildType
+def Build(BuildType, BuildDirName, ExtraOptions = ""):
+    CMakeBuildDir = os.path.join(".", "Build", SystemName, args.Arch, BuildDirName)
+    CMakeGenerateCommand = "cmake -S\"" + CMakeSourceDir + "\" -B\"" + CMakeBuildDir + "\" -DARCH=" + args.Arch + " -DBUILD_TYPE=" + BuildType + " -DCMAKE_BUILD_TYPE=" + BuildType + ExtraOptions
+    CMakeBuildCommand = "cmake --build \"" + CMakeBuildDir + "\" --config " + BuildType
+
+    print("CMake Build Directory: \"" + CMakeBuildDir + "\"")
+    print("CMake Generate Command: \"" + CMakeGenerateCommand + "\"")
+    print("CMake Build Command: \"" + CMakeBuildCommand + "\"")
+
+    print("Calling CMake (Generate)...")
+    subprocess.run(CMakeGenerateCommand, shell = True)
+
+    print("Calling CMake (Build)...")
+    return subprocess.run(CMakeBuildCommand, shell = True).returncode == 0
+
+# Runs the headless benchmark scene of the Application and returns its average frame time in milliseconds.
+def RunBenchmark(BuildType):
+    Executable = os.path.join(".", "Application", "Binary", SystemName, args.Arch, BuildType, "Application")
+    if (SystemName == "Windows"):
+        Executable += ".exe"
+
+    BenchmarkCommand = "\"" + Executable + "\" --benchmark " + str(args.benchmark_frames)
+    print("Benchmark Command: \"" + BenchmarkCommand + "\"")
+
+    # No window is created, but keep SDL away from the display and audio devices anyway.
+    Environment = dict(os.environ, SDL_VIDEODRIVER = "dummy", SDL_AUDIODRIVER = "dummy")
+    Result = subprocess.run(BenchmarkCommand, shell = True, env = Environment, capture_output = True, text = True)
+    print(Result.stdout, end = "")
+
+    Match = re.search(r"Benchmark scene: .* average ([0-9.]+) ms", Result.stdout)
+    if (Result.returncode != 0 or not Match):
+        print("Error: The benchmark scene failed.")
+        sys.exit(1)
+
+    return float(Match.group(1))
+
+# Runs the Benchmarks target, writes its results next to the build and compares them against the baseline if given.
+def RunBenchmarks(BuildType, BuildDirName):
+    Executable = os.path.join(".", "Benchmarks", "Binary", SystemName, args.Arch, BuildType, "Benchmarks")
+    if (SystemName == "Windows"):
+        Executable += ".exe"
+
+    JsonPath = os.path.join(".", "Build", SystemName, args.Arch, BuildDirName, "Benchmarks.json")
+    BenchmarksCommand = "\"" + Executable + "\" --json \"" + JsonPath + "\""
+    if (args.benchmark_filter):
+        BenchmarksCommand += " --filter \"" + args.benchmark_filter + "\""
+    if (args.benchmark_baseline):
+        BenchmarksCommand += " --baseline \"" + args.benchmark_baseline + "\" --fail-on-regression"
+    print("Benchmarks Command: \"" + BenchmarksCommand + "\"")
+
+    # The sprite benchmarks pick the dummy driver themselves, the OpenGL ones need a real one.
+    Environment = dict(os.environ, SDL_AUDIODRIVER = "dummy")
+    return subprocess.run(BenchmarksCommand, shell = True, env = Environment).returncode == 0
 
 print("Host Operating System: \"" + SystemName + "\"")
 print("Arichtecture: \"" + args.Arch + "\"")
-print("CMake Build Directory: \"" + CMakeBuildDir + "\"")
-print("CMake Generate Command: \"" + CMakeGenerateCommand + "\"")
-print("CMake Build Command: \"" + CMakeBuildCommand + "\"")
 
-print("Calling CMake (Generate)...")
-subprocess.run(CMakeGenerateCommand, shell = True)
+RunsBenchmarks = args.run_benchmarks or args.benchmark_baseline != ""
+
+if (args.BuildType != "Release-PGO"):
+    Built = Build(args.BuildType, args.BuildType)
+    if (RunsBenchmarks and (not Built or not RunBenchmarks(args.BuildType, args.BuildType))):
+        sys.exit(1)
+    sys.exit(0)
 
-print("Calling CMake (Build)...")
-subprocess.run(CMakeBuildCommand, shell = True)
\ No newline at end of file
+# Release-PGO:
+# 1. Build a regular Release and measure the benchmark scene as the baseline.
+# 2. Build with instrumentation and run the benchmark scene to collect profiles.
+# 3. Rebuild Core, Graphics and Application in the same directory with LTO and the profiles, GCC matches
+#    profiles to object files by path. The result replaces the Release binaries, measure it again.
+if (SystemName == "Windows"):
+    print("Error: \"Release-PGO\" is only set up for GCC and Clang.")
+    sys.exit(1)
+
+print("Building the baseline...")
+if (not Build("Release", "Release")):
+    sys.exit(1)
+BaselineMilliseconds = RunBenchmark("Release")
+
+ProfileDir = os.path.abspath(os.path.join(".", "Build", SystemName, args.Arch, "Release-PGO", "Profile"))
+shutil.rmtree(ProfileDir, ignore_errors = True)
+os.makedirs(ProfileDir)
+ProfileOptions = " -DPGO_PROFILE_DIR=\"" + ProfileDir + "\""
+
+print("Building with instrumentation...")
+if (not Build("Release", "Release-PGO", " -DPGO=Generate -DENABLE_LTO=OFF" + ProfileOptions)):
+    sys.exit(1)
+
+print("Training...")
+RunBenchmark("Release")
+
+# Clang writes raw profiles that must be merged first, GCC reads its ".gcda" files directly.
+RawProfiles = glob.glob(os.path.join(ProfileDir, "*.profraw"))
+if (RawProfiles):
+    MergeCommand = "llvm-profdata merge -output=\"" + os.path.join(ProfileDir, "Engine.profdata") + "\" " + " ".join("\"" + Profile + "\"" for Profile in RawProfiles)
+    print("Merge Command: \"" + MergeCommand + "\"")
+    if (subprocess.run(MergeCommand, shell = True).returncode != 0):
+        print("Error: Merging the profiles failed, is `llvm-profdata` of the Clang version in use on the path?")
+        sys.exit(1)
+
+print("Building with LTO and the profiles...")
+if (not Build("Release", "Release-PGO", " -DPGO=Use -DENABLE_LTO=ON" + ProfileOptions)):
+    sys.exit(1)
+OptimizedMilliseconds = RunBenchmark("Release")
+
+print("Average frame time of the benchmark scene: Release {:.3f} ms, Release-PGO {:.3f} ms, {:+.1f}%".format(
+    BaselineMilliseconds, OptimizedMilliseconds, (OptimizedMilliseconds / BaselineMilliseconds - 1.0) * 100.0))
+
+if (RunsBenchmarks and not RunBenchmarks("Release", "Release-PGO")):
+    sys.exit(1)
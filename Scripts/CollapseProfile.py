@@ -0,0 +1,112 @@
+import argparse
+import collections
+import functools
+import subprocess
+import sys
+
+parser = argparse.ArgumentParser("CollapseProfile")
+parser.add_argument("Profile", help = "Profile written by the sampling profiler, for example with \"ENGINE_SAMPLING_PROFILE=<path>\".")
+parser.add_argument("--output", default = "", help = "Where to write the collapsed stacks, standard output if not given.")
+parser.add_argument("--addr2line", default = "addr2line", help = "addr2line of the toolchain that built the profiled binary.")
+args = parser.parse_args()
+
+# Sorted by start address: (start, end, file offset, path).
+Modules = []
+ThreadNames = {}
+Stacks = []
+
+with open(args.Profile) as File:
+    for Line in File:
+        Fields = Line.split()
+        if (not Fields or Fields[0].startswith("#")):
+            continue
+        if (Fields[0] == "thread"):
+            ThreadNames[int(Fields[1])] = " ".join(Fields[2:])
+        elif (Fields[0] == "module"):
+            Modules.append((int(Fields[1], 16), int(Fields[2], 16), int(Fields[3], 16), " ".join(Fields[4:])))
+        elif (Fields[0] == "stack"):
+            Stacks.append((int(Fields[1]), int(Fields[2]), [int(Address, 16) for Address in Fields[3:]]))
+
+Modules.sort()
+
+def FindModule(Address):
+    for Module in Modules:
+        if (Module[0] <= Address < Module[1]):
+            return Module
+    return None
+
+# Executables that aren't position independent are symbolized by their absolute addresses, everything
+# else by the address relative to where it was loaded.
+@functools.lru_cache(maxsize = None)
+def IsPositionIndependent(Path):
+    try:
+        with open(Path, "rb") as File:
+            Header = File.read(18)
+        return len(Header) == 18 and Header[:4] == b"\x7fELF" and Header[16] == 3
+    except OSError:
+        return True
+
+# The first frame is the interrupted instruction, the others are return addresses. One byte back from
+# those lands in the call, which gets the right line and inlining.
+Lookups = collections.defaultdict(set)
+ResolvedStacks = []
+for Count, Thread, Addresses in Stacks:
+    Frames = []
+    for Index, Address in enumerate(Addresses):
+        Lookup = Address if Index == 0 else Address - 1
+        Module = FindModule(Lookup)
+        if (Module is None):
+            Frames.append((None, Address))
+            continue
+
+        if (IsPositionIndependent(Module[3])):
+            Lookup = Lookup - Module[0] + Module[2]
+        Lookups[Module[3]].add(Lookup)
+        Frames.append((Module[3], Lookup))
+    ResolvedStacks.append((Count, Thread, Frames))
+
+# Every address becomes its inlined functions, outermost first.
+Symbols = {}
+for Path, Addresses in Lookups.items():
+    Addresses = sorted(Addresses)
+    Input = "".join("{:#x}\n".format(Address) for Address in Addresses)
+    Result = subprocess.run([args.addr2line, "-a", "-f", "-C", "-i", "-e", Path], input = Input, capture_output = True, text = True)
+    if (Result.returncode != 0):
+        print("Warning: addr2line failed for \"" + Path + "\": " + Result.stderr.strip(), file = sys.stderr)
+        continue
+
+    # "-a" starts every address with a line of its own, then a function and location per inlined frame,
+    # innermost first.
+    Lines = Result.stdout.splitlines()
+    LineIndex = 0
+    while (LineIndex < len(Lines)):
+        Address = int(Lines[LineIndex], 16)
+        LineIndex += 1
+        Functions = []
+        while (LineIndex + 1 < len(Lines) and not Lines[LineIndex].startswith("0x")):
+            if (Lines[LineIndex] != "??"):
+                Functions.append(Lines[LineIndex])
+            LineIndex += 2
+        Symbols[(Path, Address)] = list(reversed(Functions))
+
+def FrameNames(Frame):
+    Path, Address = Frame
+    Names = Symbols.get((Path, Address)) if Path is not None else None
+    if (not Names):
+        Module = Path.rsplit("/", 1)[-1] if Path is not None else "?"
+        return ["[{}+{:#x}]".format(Module, Address)]
+    return Names
+
+Collapsed = collections.Counter()
+for Count, Thread, Frames in ResolvedStacks:
+    Names = [ThreadNames.get(Thread, "Thread " + str(Thread))]
+    for Frame in reversed(Frames):
+        Names.extend(FrameNames(Frame))
+    Collapsed[";".join(Name.replace(";", ":") for Name in Names)] += Count
+
+Output = open(args.output, "w") if args.output else sys.stdout
+for Stack, Count in sorted(Collapsed.items()):
+    Output.write(Stack + " " + str(Count) + "\n")
+if (args.output):
+    Output.close()
+    print("Collapsed " + str(sum(Collapsed.values())) + " samples into " + str(len(Collapsed)) + " stacks, \"" + args.output + "\".")